@@ -121,6 +121,26 @@ opt_set_Daemon(struct preparser_args *args, const char *arg)
     return true;
 }
 
+static bool
+opt_set_Cache(struct preparser_args *args, const char *arg)
+{
+    assert(args != NULL);
+    assert(arg == NULL);
+
+    args->cache = true;
+    return true;
+}
+
+static bool
+opt_set_Shm(struct preparser_args *args, const char *arg)
+{
+    assert(args != NULL);
+    assert(arg != NULL);
+
+    args->shm_path = arg;
+    return true;
+}
+
 static bool
 opt_set_SeekSpeed(struct preparser_args *args, const char *arg)
 {
@@ -310,6 +330,8 @@ static const struct preparser_opt options[] = {
     opt_add_string("type", opt_set_Type, "Preparser type (parse/thumbnail/thumbnail_to_files)"),
     opt_add_string("fetch", opt_set_Fetch, "Preparser fetching (local/net/all)"),
     opt_add_bool("daemon", opt_set_Daemon, "Start the preparser as a daemon reading request from the stdin"),
+    opt_add_bool("cache", opt_set_Cache, "Cache the preparse results of local files"),
+    opt_add_string("shm", opt_set_Shm, "File shared with the daemon caller to return large binary data"),
     opt_add_bool(NULL, NULL, "thumbnail and thumbnail_to_files"),
     opt_add_string("seek-speed", opt_set_SeekSpeed, "Set the seek speed (precise/fast)"),
     opt_add_integer("seek-time", opt_set_SeekTime, "Set from where to seek (ms)"),
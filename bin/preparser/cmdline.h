@@ -17,6 +17,8 @@ struct preparser_args {
     vlc_tick_t timeout;
     int types;
     bool daemon;
+    const char *shm_path;
+    bool cache;
     struct {
         int type;
         float pos;
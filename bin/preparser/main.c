@@ -12,6 +12,7 @@
 #endif
 
 #include <assert.h>
+#include <fcntl.h>
 
 #include <vlc/vlc.h>
 #include <vlc_common.h>
@@ -415,7 +416,8 @@ preparser_args_Loop(vlc_object_t *obj, vlc_preparser_t *preparser,
  *****************************************************************************/
 
 static int
-preparser_daemon_Loop(vlc_object_t *obj, vlc_preparser_t *preparser)
+preparser_daemon_Loop(vlc_object_t *obj, vlc_preparser_t *preparser,
+                      const char *shm_path)
 {
     assert(preparser != NULL);
 
@@ -451,6 +453,15 @@ preparser_daemon_Loop(vlc_object_t *obj, vlc_preparser_t *preparser)
     pp.tls_out = NULL;
 #endif
 
+    /* Large binary data are returned through the file shared with the caller,
+     * unlinked as soon as it is opened */
+    int shm_fd = -1;
+    if (shm_path != NULL) {
+        shm_fd = vlc_open(shm_path, O_RDWR);
+        vlc_unlink(shm_path);
+        vlc_preparser_msg_serdes_SetSharedMemory(pp.serdes, shm_fd);
+    }
+
     int status = VLC_SUCCESS;
     while (status == VLC_SUCCESS) {
         status = vlc_preparser_msg_serdes_Deserialize(pp.serdes, &pp.req_msg,
@@ -473,6 +484,9 @@ preparser_daemon_Loop(vlc_object_t *obj, vlc_preparser_t *preparser)
         pp.tls_out->ops->close(pp.tls_out);
     }
     vlc_preparser_msg_serdes_Delete(pp.serdes);
+    if (shm_fd != -1) {
+        vlc_close(shm_fd);
+    }
     return status;
 }
 
@@ -504,6 +518,8 @@ int main(int argc, char **argv)
         .timeout = VLC_TICK_INVALID,
         .types = 0,
         .daemon = false,
+        .shm_path = NULL,
+        .cache = false,
         .seek.type = VLC_THUMBNAILER_SEEK_NONE,
         .seek.speed = VLC_THUMBNAILER_SEEK_FAST,
         .output.file_path = NULL,
@@ -522,6 +538,7 @@ int main(int argc, char **argv)
     const char *libvlc_args[] = {
         "--verbose", args.verbosity, "--vout=vdummy", "--aout=adummy",
         "--text-renderer=tdummy",
+        args.cache ? "--preparse-cache" : "--no-preparse-cache",
     };
 
     libvlc_instance_t *vlc = libvlc_new(ARRAY_SIZE(libvlc_args), libvlc_args);
@@ -545,7 +562,7 @@ int main(int argc, char **argv)
     }
 
     if (args.daemon) {
-        ret = preparser_daemon_Loop(obj, preparser);
+        ret = preparser_daemon_Loop(obj, preparser, args.shm_path);
     } else {
         ret = preparser_args_Loop(obj, preparser, argv + args.arg_idx,
                                   argc - args.arg_idx, &args);
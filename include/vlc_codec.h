@@ -66,6 +66,9 @@ struct decoder_owner_callbacks
             /* Display rate
              * cf. decoder_GetDisplayRate */
             float       (*get_display_rate)( decoder_t * );
+            /* Display lateness
+             * cf. decoder_GetDisplayLateness */
+            int         (*get_display_lateness)( decoder_t *, vlc_tick_t * );
         } video;
         struct
         {
@@ -581,6 +584,27 @@ static inline float decoder_GetDisplayRate( decoder_t *dec )
     return dec->cbs->video.get_display_rate( dec );
 }
 
+/**
+ * This function returns the largest delay by which the video output
+ * displayed or dropped pictures late, as measured for the last queued
+ * pictures. It is 0 if they were all displayed in time.
+ * You MUST use it *only* for gathering statistics about speed.
+ *
+ * \return VLC_SUCCESS, or an error if the lateness is unknown (paused,
+ * buffering, no pictures displayed yet)
+ */
+VLC_USED
+static inline int decoder_GetDisplayLateness( decoder_t *dec,
+                                              vlc_tick_t *lateness )
+{
+    vlc_assert( dec->fmt_in->i_cat == VIDEO_ES && dec->cbs != NULL );
+
+    if( !dec->cbs->video.get_display_lateness )
+        return VLC_EGENERIC;
+
+    return dec->cbs->video.get_display_lateness( dec, lateness );
+}
+
 /** @} */
 
 /**
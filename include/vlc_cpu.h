@@ -132,6 +132,7 @@ unsigned vlc_CPU_raw(void);
 #  define VLC_CPU_SSE4_1 0x00000400
 #  define VLC_CPU_AVX    0x00002000
 #  define VLC_CPU_AVX2   0x00004000
+#  define VLC_CPU_AVX512 0x00008000
 
 #  if defined (__SSE__)
 #   define VLC_SSE
@@ -143,6 +144,11 @@ unsigned vlc_CPU_raw(void);
 #  define vlc_CPU_SSE3() ((vlc_CPU() & VLC_CPU_SSE3) != 0)
 #  define vlc_CPU_SSSE3() ((vlc_CPU() & VLC_CPU_SSSE3) != 0)
 #  define vlc_CPU_SSE4_1() ((vlc_CPU() & VLC_CPU_SSE4_1) != 0)
+#  ifdef __SSE4_1__
+#   define VLC_SSE4_1
+#  else
+#   define VLC_SSE4_1 __attribute__ ((__target__ ("sse4.1")))
+#  endif
 
 #   define vlc_CPU_AVX() ((vlc_CPU() & VLC_CPU_AVX) != 0)
 #  ifdef __AVX__
@@ -152,6 +158,13 @@ unsigned vlc_CPU_raw(void);
 #  endif
 
 #  define vlc_CPU_AVX2() ((vlc_CPU() & VLC_CPU_AVX2) != 0)
+#  ifdef __AVX2__
+#   define VLC_AVX2
+#  else
+#   define VLC_AVX2 __attribute__ ((__target__ ("avx2")))
+#  endif
+/* AVX-512 Foundation and Byte/Word instructions */
+#  define vlc_CPU_AVX512() ((vlc_CPU() & VLC_CPU_AVX512) != 0)
 
 # else
 /**
@@ -626,6 +626,23 @@ static inline vlc_frame_t *vlc_frame_ChainGather( vlc_frame_t *p_list )
  */
 VLC_API vlc_fifo_t *vlc_fifo_New(void) VLC_USED VLC_MALLOC;
 
+/**
+ * Creates a single-producer single-consumer FIFO queue of blocks.
+ *
+ * This is the same as vlc_fifo_New(), except that vlc_fifo_Put() does not
+ * take the FIFO lock as long as an internal ring of blocks is not full, and
+ * that the consumer is only signaled when it found the FIFO empty.
+ *
+ * At most one thread may call vlc_fifo_Put() at a time. At most one
+ * thread may wait on the FIFO for blocks to be queued, and it may only do so
+ * after vlc_fifo_DequeueUnlocked() or vlc_fifo_IsEmpty() found the FIFO
+ * empty, without releasing the lock in between. All other functions can be
+ * used as with any FIFO.
+ *
+ * @return the FIFO or NULL on memory error
+ */
+VLC_API vlc_fifo_t *vlc_fifo_NewSPSC(void) VLC_USED VLC_MALLOC;
+
 /**
  * Delete a FIFO created by vlc_fifo_New().
  *
@@ -823,10 +840,13 @@ VLC_API bool vlc_fifo_Held(const vlc_fifo_t *fifo) VLC_USED;
  */
 #define vlc_fifo_Assert(fifo) assert(vlc_fifo_Held(fifo))
 
-VLC_USED static inline bool vlc_fifo_IsEmpty(const vlc_fifo_t *fifo)
-{
-    return vlc_queue_IsEmpty(vlc_fifo_queue(fifo));
-}
+/**
+ * Checks whether a FIFO is empty.
+ *
+ * @note As with any unlocked check, the result is only meaningful if the
+ * FIFO is locked by the calling thread.
+ */
+VLC_API bool vlc_fifo_IsEmpty(const vlc_fifo_t *fifo) VLC_USED;
 
 static inline void vlc_fifo_Cleanup(void *fifo)
 {
@@ -853,12 +873,7 @@ static inline void vlc_fifo_Empty(vlc_fifo_t *fifo)
  * @param fifo queue
  * @param block head of a block list to queue (may be NULL)
  */
-static inline void vlc_fifo_Put(vlc_fifo_t *fifo, vlc_frame_t *block)
-{
-    vlc_fifo_Lock(fifo);
-    vlc_fifo_QueueUnlocked(fifo, block);
-    vlc_fifo_Unlock(fifo);
-}
+VLC_API void vlc_fifo_Put(vlc_fifo_t *fifo, vlc_frame_t *block);
 
 /* FIXME: not (really) thread-safe */
 VLC_USED VLC_DEPRECATED
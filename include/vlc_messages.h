@@ -62,6 +62,7 @@ typedef struct vlc_log_t
     int line; /**< Source code file line number or -1 */
     const char *func; /**< Source code calling function name or NULL */
     unsigned long tid; /**< Emitter thread ID */
+    int64_t date; /**< Emission date (vlc_tick_t), or VLC_TICK_INVALID */
 } vlc_log_t;
 
 /**
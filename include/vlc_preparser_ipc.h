@@ -250,6 +250,12 @@ struct vlc_preparser_msg_serdes {
         const struct vlc_preparser_msg_serdes_cbs *cbs;
         /** Used by the serializer module. */
         void *sys;
+        /**
+         * File descriptor of a file shared with the other process, where the
+         * serializer can pass large binary data instead of writing them with
+         * the callbacks, or -1.
+         */
+        int shm_fd;
     } owner;
 };
 
@@ -324,6 +330,25 @@ vlc_preparser_msg_serdes_Delete(struct vlc_preparser_msg_serdes *serdes)
     free(serdes);
 }
 
+/**
+ * Set the file used as a shared memory side channel.
+ *
+ * Both processes must use the same file, and only one message may be in
+ * flight at a time: the binary data of a message are overwritten by the next
+ * one.
+ *
+ * @param [in]  serdes  preparser msg serdes internal struture.
+ * @param [in]  fd      file descriptor (kept owned by the caller) or -1 to
+ *                      disable the side channel.
+ */
+static inline void
+vlc_preparser_msg_serdes_SetSharedMemory(struct vlc_preparser_msg_serdes *serdes,
+                                         int fd)
+{
+    assert(serdes != NULL);
+    serdes->owner.shm_fd = fd;
+}
+
 /**
  * Create a vlc_preparser_msg_serdes object and load a preparser msg_serdes
  * module.
@@ -180,6 +180,22 @@ VLC_USED static inline bool vlc_queue_IsEmpty(const vlc_queue_t *q)
     return q->first == NULL;
 }
 
+/**
+ * Peeks at the oldest entry (without locking).
+ *
+ * The entry remains in the queue. It can be removed with
+ * vlc_queue_DequeueUnlocked() while the queue lock is still held.
+ *
+ * @warning It is assumed that the caller already holds the queue lock;
+ * otherwise the behaviour is undefined.
+ *
+ * @return the first entry in the queue, or NULL if the queue is empty
+ */
+VLC_USED static inline void *vlc_queue_PeekUnlocked(const vlc_queue_t *q)
+{
+    return q->first;
+}
+
 /** @} */
 
 /**
@@ -292,6 +292,64 @@ static inline void vlc_tracer_TracePCR( struct vlc_tracer *tracer, const char *t
                              VLC_TRACE_END);
 }
 
+/**
+ * Trace a step of the journey of a block or a picture
+ *
+ * The steps of a same elementary stream id and pts are linked together by
+ * tracers able to, from the "start" step (when the block leaves the demuxer)
+ * to the "end" one (when its data is displayed or played).
+ *
+ * \param flow "start", "step" or "end"
+ */
+static inline void vlc_tracer_TraceFlow(struct vlc_tracer *tracer, const char *type,
+                                        const char *id, const char *stream,
+                                        const char *flow, vlc_tick_t pts)
+{
+    vlc_tracer_Trace(tracer, VLC_TRACE("type", type),
+                             VLC_TRACE("id", id),
+                             VLC_TRACE("stream", stream),
+                             VLC_TRACE("flow", flow),
+                             VLC_TRACE_TICK_NS("pts", pts),
+                             VLC_TRACE_END);
+}
+
+/**
+ * Trace the beginning of a span of work on the calling thread
+ *
+ * The span must be ended on the same thread, by vlc_tracer_TraceEnd(), and
+ * spans of a same thread must be nested.
+ *
+ * \param flow NULL, or the step of the journey of the block or picture being
+ * processed (cf. vlc_tracer_TraceFlow())
+ * \param pts pts of the processed block or picture, used only with a flow
+ */
+static inline void vlc_tracer_TraceBegin(struct vlc_tracer *tracer, const char *type,
+                                         const char *id, const char *span,
+                                         const char *flow, vlc_tick_t pts)
+{
+    if (flow == NULL || pts == VLC_TICK_INVALID)
+        vlc_tracer_Trace(tracer, VLC_TRACE("type", type),
+                                 VLC_TRACE("id", id),
+                                 VLC_TRACE("begin", span),
+                                 VLC_TRACE_END);
+    else
+        vlc_tracer_Trace(tracer, VLC_TRACE("type", type),
+                                 VLC_TRACE("id", id),
+                                 VLC_TRACE("begin", span),
+                                 VLC_TRACE("flow", flow),
+                                 VLC_TRACE_TICK_NS("pts", pts),
+                                 VLC_TRACE_END);
+}
+
+static inline void vlc_tracer_TraceEnd(struct vlc_tracer *tracer, const char *type,
+                                       const char *id, const char *span)
+{
+    vlc_tracer_Trace(tracer, VLC_TRACE("type", type),
+                             VLC_TRACE("id", id),
+                             VLC_TRACE("end", span),
+                             VLC_TRACE_END);
+}
+
 /**
  * @}
  */
@@ -25,6 +25,7 @@
 #include <assert.h>
 #include <vlc_common.h>
 #include <vlc_network.h>
+#include <vlc_threads.h>
 #include <vlc_tls.h>
 #include <vlc_url.h>
 #include "transport.h"
@@ -102,7 +103,9 @@ struct vlc_http_mgr
     vlc_object_t *obj;
     vlc_tls_client_t *creds;
     struct vlc_http_cookie_jar_t *jar;
+    vlc_mutex_t lock;
     struct vlc_http_conn *conn;
+    bool multiplexed; /**< whether conn can carry concurrent streams */
 };
 
 static struct vlc_http_conn *vlc_http_mgr_find(struct vlc_http_mgr *mgr,
@@ -117,6 +120,7 @@ static void vlc_http_mgr_release(struct vlc_http_mgr *mgr,
 {
     assert(mgr->conn == conn);
     mgr->conn = NULL;
+    mgr->multiplexed = false;
 
     vlc_http_conn_release(conn);
 }
@@ -132,15 +136,28 @@ struct vlc_http_msg *vlc_http_mgr_reuse(struct vlc_http_mgr *mgr,
         return NULL;
 
     struct vlc_http_stream *stream = vlc_http_stream_open(conn, req, payload);
-    if (stream != NULL)
-    {
-        struct vlc_http_msg *m = vlc_http_msg_get_initial(stream);
-        if (m != NULL)
-            return m;
+    if (stream == NULL)
+    {   /* Get rid of closing or reset connection */
+        vlc_http_mgr_release(mgr, conn);
+        return NULL;
     }
-    /* Get rid of closing or reset connection */
-    vlc_http_mgr_release(mgr, conn);
-    return NULL;
+
+    /* An HTTP/2 connection stays alive as long as it carries a stream, so
+     * other requests can be multiplexed while this one awaits its response.
+     * An HTTP/1 connection can only carry one request at a time anyway. */
+    bool multiplexed = mgr->multiplexed;
+
+    if (multiplexed)
+        vlc_mutex_unlock(&mgr->lock);
+
+    struct vlc_http_msg *m = vlc_http_msg_get_initial(stream);
+
+    if (multiplexed)
+        vlc_mutex_lock(&mgr->lock);
+
+    if (m == NULL && mgr->conn == conn)
+        vlc_http_mgr_release(mgr, conn);
+    return m;
 }
 
 static struct vlc_http_msg *vlc_https_request(struct vlc_http_mgr *mgr,
@@ -173,6 +190,10 @@ static struct vlc_http_msg *vlc_https_request(struct vlc_http_mgr *mgr,
             return resp; /* existing connection reused */
     }
 
+    /* Do not hold up the other requests, notably the new streams on an
+     * established HTTP/2 connection, during the TCP and TLS handshakes. */
+    vlc_mutex_unlock(&mgr->lock);
+
     char *proxy = vlc_http_proxy_find(host, port, true);
     if (proxy != NULL)
     {
@@ -183,10 +204,7 @@ static struct vlc_http_msg *vlc_https_request(struct vlc_http_mgr *mgr,
     else
         tls = vlc_https_connect(mgr->creds, host, port, &http2);
 
-    if (tls == NULL)
-        return NULL;
-
-    struct vlc_http_conn *conn;
+    struct vlc_http_conn *conn = NULL;
 
     /* For HTTPS, TLS-ALPN determines whether HTTP version 2.0 ("h2") or 1.1
      * ("http/1.1") is used.
@@ -195,21 +213,33 @@ static struct vlc_http_msg *vlc_https_request(struct vlc_http_mgr *mgr,
      * supported by the server.
      * NOTE: We do not enforce TLS version 1.2 for HTTP 2.0 explicitly.
      */
-    if (http2)
-        conn = vlc_h2_conn_create(mgr->logger, tls);
-    else
-        conn = vlc_h1_conn_create(mgr->logger, tls, false);
-
-    if (unlikely(conn == NULL))
+    if (tls != NULL)
     {
-        vlc_tls_Close(tls);
+        if (http2)
+            conn = vlc_h2_conn_create(mgr->logger, tls);
+        else
+            conn = vlc_h1_conn_create(mgr->logger, tls, false);
+
+        if (unlikely(conn == NULL))
+            vlc_tls_Close(tls);
+    }
+
+    vlc_mutex_lock(&mgr->lock);
+
+    if (conn == NULL)
         return NULL;
+
+    if (idempotent && mgr->conn != NULL && mgr->multiplexed)
+    {   /* Another request established a shared connection meanwhile */
+        vlc_http_conn_release(conn);
+        return vlc_http_mgr_reuse(mgr, host, port, req, payload);
     }
 
     if (mgr->conn != NULL)
         vlc_http_mgr_release(mgr, mgr->conn);
 
     mgr->conn = conn;
+    mgr->multiplexed = http2;
     return vlc_http_mgr_reuse(mgr, host, port, req, payload);
 }
 
@@ -278,8 +308,23 @@ struct vlc_http_msg *vlc_http_mgr_request(struct vlc_http_mgr *mgr, bool https,
     if (port && vlc_http_port_blocked(port))
         return NULL;
 
-    return (https ? vlc_https_request : vlc_http_request)(mgr, host, port, m,
+    struct vlc_http_msg *resp;
+
+    vlc_mutex_lock(&mgr->lock);
+    resp = (https ? vlc_https_request : vlc_http_request)(mgr, host, port, m,
                                                           idempotent, payload);
+    vlc_mutex_unlock(&mgr->lock);
+    return resp;
+}
+
+bool vlc_http_mgr_multiplexed(struct vlc_http_mgr *mgr)
+{
+    bool ret;
+
+    vlc_mutex_lock(&mgr->lock);
+    ret = mgr->multiplexed;
+    vlc_mutex_unlock(&mgr->lock);
+    return ret;
 }
 
 struct vlc_http_cookie_jar_t *vlc_http_mgr_get_jar(struct vlc_http_mgr *mgr)
@@ -298,7 +343,9 @@ struct vlc_http_mgr *vlc_http_mgr_create(vlc_object_t *obj,
     mgr->obj = obj;
     mgr->creds = NULL;
     mgr->jar = jar;
+    vlc_mutex_init(&mgr->lock);
     mgr->conn = NULL;
+    mgr->multiplexed = false;
     return mgr;
 }
 
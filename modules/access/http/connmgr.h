@@ -48,6 +48,9 @@ struct vlc_http_cookie_jar_t;
  * @param idempotent whether the request is idempotent
  * @param payload whether the request will carry a payload
  *
+ * This function is thread-safe. Requests made from different threads are
+ * multiplexed if the connection is HTTP/2, and serialized otherwise.
+ *
  * @return The initial HTTP response header, or NULL in case of failure.
  */
 struct vlc_http_msg *vlc_http_mgr_request(struct vlc_http_mgr *mgr, bool https,
@@ -57,6 +60,14 @@ struct vlc_http_msg *vlc_http_mgr_request(struct vlc_http_mgr *mgr, bool https,
 
 struct vlc_http_cookie_jar_t *vlc_http_mgr_get_jar(struct vlc_http_mgr *);
 
+/**
+ * Checks whether the current connection multiplexes requests
+ *
+ * @retval true if the manager is connected with HTTP/2
+ * @retval false if the manager is not connected or uses HTTP/1.x
+ */
+bool vlc_http_mgr_multiplexed(struct vlc_http_mgr *mgr);
+
 /**
  * Creates an HTTP connection manager
  *
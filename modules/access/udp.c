@@ -53,10 +53,47 @@
  */
 #define MRU 65507u
 
+#ifdef HAVE_RECVMMSG
+/* Initial size of the batched receive buffers. It fits one Ethernet frame and
+ * is grown (up to MRU) whenever a larger datagram gets truncated. Truncated
+ * datagrams are dropped, as their payload cannot be recovered. */
+# define BATCH_SLOT_SIZE 2048u
+
+struct udp_slot {
+    block_t *block;
+    struct iovec iov;
+# ifdef SO_RXQ_OVFL
+    union {
+        struct cmsghdr hdr;
+        char buf[CMSG_SPACE(sizeof (uint32_t))];
+    } control;
+# endif
+};
+
+struct udp_batch {
+    struct mmsghdr *msgs;
+    struct udp_slot *slots;
+    unsigned count; /**< number of slots in the ring */
+    unsigned next; /**< next received slot to hand out */
+    unsigned ready; /**< number of received slots */
+    size_t slot_size;
+
+    /* Statistics */
+    uint64_t calls;
+    uint64_t datagrams;
+    uint64_t truncated;
+    unsigned max_batch;
+    uint32_t drops; /**< datagrams dropped by the kernel (SO_RXQ_OVFL) */
+};
+#endif
+
 typedef struct {
     int fd;
     int timeout;
 
+#ifdef HAVE_RECVMMSG
+    struct udp_batch batch;
+#endif
     size_t length;
     char *offset;
     char buf[MRU];
@@ -132,6 +169,173 @@ static ssize_t Read(stream_t *access, void *buf, size_t len)
     return val;
 }
 
+#ifdef HAVE_RECVMMSG
+static int BatchRecv(stream_t *access)
+{
+    access_sys_t *sys = access->p_sys;
+    struct udp_batch *b = &sys->batch;
+    unsigned count = b->count;
+
+    /* Replenish the slots handed out by the previous batch */
+    for (unsigned i = 0; i < b->count; i++) {
+        struct udp_slot *slot = &b->slots[i];
+        struct msghdr *hdr = &b->msgs[i].msg_hdr;
+
+        if (slot->block == NULL || slot->block->i_buffer < b->slot_size) {
+            if (slot->block != NULL)
+                block_Release(slot->block);
+            slot->block = block_Alloc(b->slot_size);
+            if (unlikely(slot->block == NULL)) {
+                count = i;
+                break;
+            }
+        }
+
+        slot->iov.iov_base = slot->block->p_buffer;
+        slot->iov.iov_len = slot->block->i_buffer;
+        hdr->msg_iov = &slot->iov;
+        hdr->msg_iovlen = 1;
+# ifdef SO_RXQ_OVFL
+        hdr->msg_control = slot->control.buf;
+        hdr->msg_controllen = sizeof (slot->control.buf);
+# endif
+        hdr->msg_flags = 0;
+    }
+
+    if (unlikely(count == 0))
+        return -1;
+
+    struct pollfd ufd[1];
+
+    ufd[0].fd = sys->fd;
+    ufd[0].events = POLLIN;
+
+    switch (vlc_poll_i11e(ufd, 1, sys->timeout)) {
+        case 0:
+            msg_Err(access, "receive time-out");
+            return 0;
+        case -1:
+            return -1;
+    }
+
+    int val = recvmmsg(sys->fd, b->msgs, count, MSG_DONTWAIT | MSG_TRUNC,
+                       NULL);
+    if (val <= 0)
+        return -1;
+
+    b->calls++;
+    b->datagrams += val;
+    if ((unsigned)val > b->max_batch)
+        b->max_batch = val;
+
+    for (int i = 0; i < val; i++) {
+        struct msghdr *hdr = &b->msgs[i].msg_hdr;
+        unsigned len = b->msgs[i].msg_len;
+
+        if (unlikely(hdr->msg_flags & MSG_TRUNC)) {
+            b->truncated++;
+            msg_Warn(access, "%u bytes datagram truncated to %zu bytes, "
+                     "dropped", len, b->slot_size);
+            if (len > b->slot_size)
+                b->slot_size = __MIN(vlc_align(len, 1024), MRU);
+            b->msgs[i].msg_len = 0; /* skipped by BlockBatch() */
+        }
+# ifdef SO_RXQ_OVFL
+        for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(hdr); cmsg != NULL;
+             cmsg = CMSG_NXTHDR(hdr, cmsg)) {
+            if (cmsg->cmsg_level != SOL_SOCKET
+             || cmsg->cmsg_type != SO_RXQ_OVFL)
+                continue;
+
+            uint32_t drops;
+
+            memcpy(&drops, CMSG_DATA(cmsg), sizeof (drops));
+            if (drops != b->drops) {
+                msg_Warn(access, "%"PRIu32" datagram(s) dropped by the kernel",
+                         drops - b->drops);
+                b->drops = drops;
+            }
+        }
+# endif
+    }
+
+    b->next = 0;
+    b->ready = val;
+    return val;
+}
+
+static block_t *BlockBatch(stream_t *access, bool *restrict eof)
+{
+    access_sys_t *sys = access->p_sys;
+    struct udp_batch *b = &sys->batch;
+
+    for (;;) {
+        while (b->next < b->ready) {
+            unsigned i = b->next++;
+            size_t len = b->msgs[i].msg_len;
+
+            /* empty payload does *not* mean EOF here, and truncated
+             * datagrams are not handed out */
+            if (len == 0)
+                continue; /* keep the buffer for the next batch */
+
+            block_t *block = b->slots[i].block;
+
+            b->slots[i].block = NULL;
+            block->i_buffer = len;
+            return block;
+        }
+
+        switch (BatchRecv(access)) {
+            case 0:
+                *eof = true;
+                /* fall through */
+            case -1:
+                return NULL;
+        }
+    }
+}
+
+static int BatchInit(stream_t *access, unsigned count)
+{
+    access_sys_t *sys = access->p_sys;
+    struct udp_batch *b = &sys->batch;
+
+    b->msgs = vlc_obj_calloc(VLC_OBJECT(access), count, sizeof (*b->msgs));
+    b->slots = vlc_obj_calloc(VLC_OBJECT(access), count, sizeof (*b->slots));
+    if (unlikely(b->msgs == NULL || b->slots == NULL))
+        return VLC_ENOMEM;
+
+    b->count = count;
+    b->next = b->ready = 0;
+    b->slot_size = BATCH_SLOT_SIZE;
+    b->calls = b->datagrams = b->truncated = 0;
+    b->max_batch = 0;
+    b->drops = 0;
+# ifdef SO_RXQ_OVFL
+    setsockopt(sys->fd, SOL_SOCKET, SO_RXQ_OVFL, &(int){ 1 }, sizeof (int));
+# endif
+    return VLC_SUCCESS;
+}
+
+static void BatchClean(stream_t *access)
+{
+    access_sys_t *sys = access->p_sys;
+    struct udp_batch *b = &sys->batch;
+
+    for (unsigned i = 0; i < b->count; i++)
+        if (b->slots[i].block != NULL)
+            block_Release(b->slots[i].block);
+
+    if (b->calls > 0)
+        msg_Dbg(access, "received %"PRIu64" datagrams in %"PRIu64" batches "
+                "(average %.1f, max %u), %"PRIu64" truncated, "
+                "%"PRIu32" dropped", b->datagrams, b->calls,
+                (double)b->datagrams / b->calls, b->max_batch,
+                b->truncated, b->drops);
+}
+#endif
+
 /*****************************************************************************
  * Open: open the socket
  *****************************************************************************/
@@ -148,6 +352,9 @@ static int Open( vlc_object_t *p_this )
         return VLC_ENOMEM;
 
     sys->length = 0;
+#ifdef HAVE_RECVMMSG
+    sys->batch.count = 0;
+#endif
     p_access->p_sys = sys;
     p_access->pf_read = Read;
     p_access->pf_block = NULL;
@@ -217,6 +424,19 @@ static int Open( vlc_object_t *p_this )
     if( sys->timeout > 0)
         sys->timeout *= 1000;
 
+#ifdef HAVE_RECVMMSG
+    unsigned batch = var_InheritInteger( p_access, "udp-batch" );
+    if( batch > 1 )
+    {
+        if( BatchInit( p_access, batch ) )
+        {
+            net_Close( sys->fd );
+            return VLC_ENOMEM;
+        }
+        p_access->pf_read = NULL;
+        p_access->pf_block = BlockBatch;
+    }
+#endif
     return VLC_SUCCESS;
 }
 
@@ -228,10 +448,17 @@ static void Close( vlc_object_t *p_this )
     stream_t     *p_access = (stream_t*)p_this;
     access_sys_t *sys = p_access->p_sys;
 
+#ifdef HAVE_RECVMMSG
+    BatchClean( p_access );
+#endif
     net_Close( sys->fd );
 }
 
 #define TIMEOUT_TEXT N_("UDP Source timeout (sec)")
+#define BATCH_TEXT N_("Receive batch size")
+#define BATCH_LONGTEXT N_( \
+    "Maximum number of datagrams received with a single system call. " \
+    "Values of 0 or 1 disable batching.")
 
 vlc_module_begin()
     set_shortname(N_("UDP"))
@@ -240,6 +467,10 @@ vlc_module_begin()
 
     add_obsolete_integer("udp-buffer") /* since 3.0.0 */
     add_integer("udp-timeout", -1, TIMEOUT_TEXT, NULL)
+#ifdef HAVE_RECVMMSG
+    add_integer_with_range("udp-batch", 32, 0, 1024,
+                           BATCH_TEXT, BATCH_LONGTEXT)
+#endif
 
     set_capability("access", 0)
     add_shortcut("udp", "udpstream", "udp4", "udp6")
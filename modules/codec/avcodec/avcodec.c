@@ -109,6 +109,8 @@ vlc_module_begin ()
     add_obsolete_integer ( "avcodec-error-resilience" ) /* removed since 4.0.0 */
     add_obsolete_integer ( "avcodec-workaround-bugs" ) /* removed since 4.0.0 */
     add_bool( "avcodec-hurry-up", true, HURRYUP_TEXT, HURRYUP_LONGTEXT )
+    add_bool( "avcodec-adaptive-hurry-up", true, ADAPTIVE_HURRYUP_TEXT,
+              ADAPTIVE_HURRYUP_LONGTEXT )
     add_integer( "avcodec-skip-frame", 0, SKIP_FRAME_TEXT,
         SKIP_FRAME_LONGTEXT )
         change_integer_list( frame_skip_list, frame_skip_list_text )
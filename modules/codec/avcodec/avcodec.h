@@ -65,6 +65,13 @@ int ffmpeg_OpenCodec( decoder_t *p_dec, AVCodecContext *, const AVCodec * );
     "when there is not enough time. It's useful with low CPU power " \
     "but it can produce distorted pictures.")
 
+#define ADAPTIVE_HURRYUP_TEXT N_("Adaptive hurry up")
+#define ADAPTIVE_HURRYUP_LONGTEXT N_( \
+    "When hurrying up, degrade the decoding step by step according to the " \
+    "lateness of the displayed pictures: skip the loop filter, then the " \
+    "non-reference frames, so that late video loses quality before it " \
+    "stutters.")
+
 #define SKIP_FRAME_TEXT N_("Skip frame (default=0)")
 #define SKIP_FRAME_LONGTEXT N_( \
     "Force skipping of frames to speed up decoding " \
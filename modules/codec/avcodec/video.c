@@ -60,6 +60,7 @@
 #include "../../packetizer/av1_obu.h"
 #include "../../packetizer/av1.h"
 #include "../cc.h"
+#include "../framedrop.h"
 
 #define OPAQUE_REF_ONLY LIBAVCODEC_VERSION_CHECK( 59, 63, 100 )
 
@@ -96,6 +97,10 @@ typedef struct
      * regardless of lateness. */
     bool b_no_frame_drop;
     enum AVDiscard i_skip_frame;
+    enum AVDiscard i_skip_loop_filter;
+    /* degrade according to the display lateness */
+    bool b_adaptive_drop;
+    framedrop_policy_t framedrop_policy;
 
 #if OPAQUE_REF_ONLY
     uint64_t i_next_sequence_number;
@@ -591,9 +596,12 @@ static int InitVideoDecCommon( decoder_t *p_dec )
     else if( i_val == 2 ) p_context->skip_loop_filter = AVDISCARD_BIDIR;
     else if( i_val == 1 ) p_context->skip_loop_filter = AVDISCARD_NONREF;
     else p_context->skip_loop_filter = AVDISCARD_DEFAULT;
+    p_sys->i_skip_loop_filter = p_context->skip_loop_filter;
 
     /* ***** libavcodec frame skipping ***** */
     p_sys->b_hurry_up = var_CreateGetBool( p_dec, "avcodec-hurry-up" );
+    p_sys->b_adaptive_drop = var_CreateGetBool( p_dec, "avcodec-adaptive-hurry-up" );
+    framedrop_Init( &p_sys->framedrop_policy );
     p_sys->b_show_corrupted = var_CreateGetBool( p_dec, "avcodec-corrupted" );
     p_sys->b_no_frame_drop = ffmpeg_CodecForbidsFrameDrop( p_codec->id );
     if( p_sys->b_no_frame_drop )
@@ -1006,6 +1014,7 @@ static void Flush( decoder_t *p_dec )
 
     p_sys->i_late_frames = 0;
     p_sys->framedrop = FRAMEDROP_NONE;
+    framedrop_Init( &p_sys->framedrop_policy );
     cc_Flush( &p_sys->cc );
 
     /* do not flush buffers if codec hasn't been opened (theora/vorbis/VC1) */
@@ -1066,6 +1075,77 @@ static block_t * filter_earlydropped_blocks( decoder_t *p_dec, block_t *block )
     return block;
 }
 
+static void apply_framedrop_level( decoder_t *p_dec )
+{
+    decoder_sys_t *p_sys = p_dec->p_sys;
+    AVCodecContext *p_context = p_sys->p_context;
+    const enum framedrop_level level = p_sys->framedrop_policy.level;
+
+    enum AVDiscard skip_loop_filter = p_sys->i_skip_loop_filter;
+    if( level >= FRAMEDROP_LEVEL_LOOPFILTER_NONKEY )
+        skip_loop_filter = __MAX( skip_loop_filter, AVDISCARD_NONKEY );
+    else if( level >= FRAMEDROP_LEVEL_LOOPFILTER_NONREF )
+        skip_loop_filter = __MAX( skip_loop_filter, AVDISCARD_NONREF );
+    p_context->skip_loop_filter = skip_loop_filter;
+
+    if( level >= FRAMEDROP_LEVEL_SKIP_NONREF )
+        p_context->skip_frame = __MAX( p_context->skip_frame, AVDISCARD_NONREF );
+}
+
+static bool use_framedrop_policy( decoder_t *p_dec, const block_t *p_block )
+{
+    decoder_sys_t *p_sys = p_dec->p_sys;
+
+    return p_sys->b_adaptive_drop && p_sys->b_hurry_up &&
+           !p_sys->b_no_frame_drop && p_dec->b_frame_drop_allowed &&
+           ( !p_block || !(p_block->i_flags & BLOCK_FLAG_PREROLL) );
+}
+
+/* Returns the frame type of the packet to be sent, or FRAMEDROP_TYPE_COUNT
+ * if its decoding time cannot be measured. */
+static enum framedrop_type get_framedrop_type( decoder_t *p_dec,
+                                               const block_t *p_block )
+{
+    decoder_sys_t *p_sys = p_dec->p_sys;
+    AVCodecContext *p_context = p_sys->p_context;
+
+    /* With frame threading, the time spent in the calling thread is mostly
+     * queueing and waiting for a free slot, not decoding. The policy then
+     * relies on the lateness alone. */
+    if( p_context->active_thread_type & FF_THREAD_FRAME )
+        return FRAMEDROP_TYPE_COUNT;
+
+    if( p_block->i_flags & BLOCK_FLAG_TYPE_I )
+        return FRAMEDROP_TYPE_I;
+    if( p_block->i_flags & BLOCK_FLAG_TYPE_P )
+        return FRAMEDROP_TYPE_P;
+    /* Skipped frames would look deceptively cheap */
+    if( (p_block->i_flags & BLOCK_FLAG_TYPE_B) &&
+        p_context->skip_frame < AVDISCARD_NONREF )
+        return FRAMEDROP_TYPE_B;
+    return FRAMEDROP_TYPE_COUNT;
+}
+
+static void update_framedrop_level( decoder_t *p_dec,
+                                    vlc_tick_t i_pts, vlc_tick_t i_next_pts )
+{
+    decoder_sys_t *p_sys = p_dec->p_sys;
+    framedrop_policy_t *p_policy = &p_sys->framedrop_policy;
+
+    vlc_tick_t i_lateness;
+    if( decoder_GetDisplayLateness( p_dec, &i_lateness ) != VLC_SUCCESS )
+        return;
+
+    const enum framedrop_level i_old_level = p_policy->level;
+    vlc_tick_t i_period = VLC_TICK_INVALID;
+    if( i_pts != VLC_TICK_INVALID && i_next_pts != VLC_TICK_INVALID )
+        i_period = i_next_pts - i_pts;
+
+    if( framedrop_Update( p_policy, i_lateness, i_period ) != i_old_level )
+        msg_Dbg( p_dec, "video degradation level %d -> %d",
+                 (int)i_old_level, (int)p_policy->level );
+}
+
 static vlc_tick_t interpolate_next_pts( decoder_t *p_dec, AVFrame *frame )
 {
     decoder_sys_t *p_sys = p_dec->p_sys;
@@ -1414,7 +1494,12 @@ static int DecodeBlock( decoder_t *p_dec, block_t **pp_block )
         /* Check also if we should/can drop the block and move to next block
             as trying to catchup the speed*/
         if( p_dec->b_frame_drop_allowed )
+        {
             p_block = filter_earlydropped_blocks( p_dec, p_block );
+
+            if( p_sys->b_adaptive_drop )
+                apply_framedrop_level( p_dec );
+        }
     }
 
     if( !p_sys->b_no_frame_drop &&
@@ -1447,6 +1532,8 @@ static int DecodeBlock( decoder_t *p_dec, block_t **pp_block )
     do
     {
         int i_used = 0;
+        enum framedrop_type i_cost_type = FRAMEDROP_TYPE_COUNT;
+        const vlc_tick_t i_decode_start = vlc_tick_now();
 
         if( (p_block && p_block->i_buffer > 0) || b_drain )
         {
@@ -1464,6 +1551,8 @@ static int DecodeBlock( decoder_t *p_dec, block_t **pp_block )
                 pkt->dts = p_block->i_dts != VLC_TICK_INVALID ? TO_AV_TS(p_block->i_dts) : AV_NOPTS_VALUE;
                 if (p_block->i_flags & BLOCK_FLAG_TYPE_I)
                     pkt->flags |= AV_PKT_FLAG_KEY;
+                if( use_framedrop_policy( p_dec, p_block ) )
+                    i_cost_type = get_framedrop_type( p_dec, p_block );
             }
             else
             {
@@ -1549,6 +1638,12 @@ static int DecodeBlock( decoder_t *p_dec, block_t **pp_block )
         }
         bool not_received_frame = ret;
 
+        /* Without frame threading, the packet is decoded by now, even if
+         * the frame coming out, if any, is another one (reordering) */
+        if( i_cost_type != FRAMEDROP_TYPE_COUNT && i_used > 0 )
+            framedrop_AddDecodeTime( &p_sys->framedrop_policy, i_cost_type,
+                                     vlc_tick_now() - i_decode_start );
+
         if( p_block )
         {
             /* Consumed bytes */
@@ -1595,6 +1690,9 @@ static int DecodeBlock( decoder_t *p_dec, block_t **pp_block )
             b_first_output_sequence = false;
         }
 
+        if( use_framedrop_policy( p_dec, p_block ) )
+            update_framedrop_level( p_dec, i_pts, i_next_pts );
+
         if( (p_frame_info && !p_frame_info->b_display) ||
            ( !p_sys->p_va && !frame->linesize[0] ) ||
            ( p_dec->b_frame_drop_allowed && (frame->flags & AV_FRAME_FLAG_CORRUPT) &&
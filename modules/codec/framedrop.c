@@ -0,0 +1,124 @@
+/*****************************************************************************
+ * framedrop.c: video decoder degradation policy
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+
+#include <vlc_common.h>
+
+#include "framedrop.h"
+
+/* Late measures before degrading further */
+#define FRAMEDROP_LATE_COUNT 3
+/* Time to be in time before improving the quality again */
+#define FRAMEDROP_RECOVER_DELAY VLC_TICK_FROM_SEC(2)
+/* Frame duration assumed when the stream does not tell it */
+#define FRAMEDROP_DEFAULT_PERIOD VLC_TICK_FROM_MS(40)
+
+void framedrop_Init( framedrop_policy_t *p_policy )
+{
+    p_policy->level = FRAMEDROP_LEVEL_NONE;
+    for( size_t i = 0; i < FRAMEDROP_TYPE_COUNT; i++ )
+        p_policy->cost[i] = 0;
+    p_policy->late = 0;
+    p_policy->in_time = 0;
+}
+
+void framedrop_AddDecodeTime( framedrop_policy_t *p_policy,
+                              enum framedrop_type type, vlc_tick_t duration )
+{
+    assert( type < FRAMEDROP_TYPE_COUNT );
+
+    vlc_tick_t *p_cost = &p_policy->cost[type];
+
+    /* Moving average over about 8 frames */
+    if( *p_cost == 0 )
+        *p_cost = duration;
+    else
+        *p_cost += ( duration - *p_cost ) / 8;
+}
+
+static void Degrade( framedrop_policy_t *p_policy )
+{
+    if( p_policy->level == FRAMEDROP_LEVEL_MAX )
+        return;
+
+    p_policy->level++;
+
+    /* Skipping non-reference frames is not worth losing pictures when they
+     * are much cheaper to decode than the reference ones */
+    const vlc_tick_t *cost = p_policy->cost;
+    if( p_policy->level == FRAMEDROP_LEVEL_SKIP_NONREF &&
+        cost[FRAMEDROP_TYPE_B] != 0 && cost[FRAMEDROP_TYPE_P] != 0 &&
+        cost[FRAMEDROP_TYPE_B] * 4 < cost[FRAMEDROP_TYPE_P] )
+        p_policy->level++;
+}
+
+static void Recover( framedrop_policy_t *p_policy, vlc_tick_t period )
+{
+    const vlc_tick_t *cost = p_policy->cost;
+
+    /* Improve only if the most frequent frames can be decoded in time, with
+     * some margin. The non-reference ones may have been measured before they
+     * were skipped, which can only delay the recovery. */
+    if( __MAX( cost[FRAMEDROP_TYPE_P], cost[FRAMEDROP_TYPE_B] ) >= period * 3 / 4 )
+        return;
+
+    p_policy->level--;
+    if( p_policy->level == FRAMEDROP_LEVEL_SKIP_NONREF &&
+        cost[FRAMEDROP_TYPE_B] != 0 && cost[FRAMEDROP_TYPE_P] != 0 &&
+        cost[FRAMEDROP_TYPE_B] * 4 < cost[FRAMEDROP_TYPE_P] )
+        p_policy->level--;
+}
+
+enum framedrop_level framedrop_Update( framedrop_policy_t *p_policy,
+                                       vlc_tick_t lateness, vlc_tick_t period )
+{
+    if( period == VLC_TICK_INVALID || period <= 0 )
+        period = FRAMEDROP_DEFAULT_PERIOD;
+
+    if( lateness > period / 2 )
+    {
+        p_policy->in_time = 0;
+
+        /* Degrade at once if more than two frames behind */
+        if( ++p_policy->late >= FRAMEDROP_LATE_COUNT || lateness > 2 * period )
+        {
+            Degrade( p_policy );
+            p_policy->late = 0;
+        }
+    }
+    else
+    {
+        p_policy->late = 0;
+
+        if( p_policy->level != FRAMEDROP_LEVEL_NONE &&
+            ++p_policy->in_time * period >= FRAMEDROP_RECOVER_DELAY )
+        {
+            Recover( p_policy, period );
+            p_policy->in_time = 0;
+        }
+    }
+
+    return p_policy->level;
+}
@@ -0,0 +1,82 @@
+/*****************************************************************************
+ * framedrop.h: video decoder degradation policy
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifndef VLC_CODEC_FRAMEDROP_H_
+#define VLC_CODEC_FRAMEDROP_H_
+
+#include <vlc_tick.h>
+
+/*
+ * The policy is fed with the display lateness reported by the video output
+ * (cf. decoder_GetDisplayLateness()) and the time spent decoding each frame
+ * type. It tells the decoder how much it should degrade its output, one step
+ * at a time, so that a too slow decoder loses quality before it loses
+ * pictures, and loses non-reference pictures before it stutters.
+ */
+
+enum framedrop_type
+{
+    FRAMEDROP_TYPE_I,
+    FRAMEDROP_TYPE_P,
+    FRAMEDROP_TYPE_B, /**< and any other non-reference frame */
+    FRAMEDROP_TYPE_COUNT,
+};
+
+enum framedrop_level
+{
+    FRAMEDROP_LEVEL_NONE,
+    /** Skip the loop filter of non-reference frames */
+    FRAMEDROP_LEVEL_LOOPFILTER_NONREF,
+    /** Skip the non-reference frames */
+    FRAMEDROP_LEVEL_SKIP_NONREF,
+    /** Also skip the loop filter of all the non-key frames */
+    FRAMEDROP_LEVEL_LOOPFILTER_NONKEY,
+    FRAMEDROP_LEVEL_MAX = FRAMEDROP_LEVEL_LOOPFILTER_NONKEY,
+};
+
+typedef struct
+{
+    enum framedrop_level level;
+    /* Average decoding time of each frame type, or 0 if unknown */
+    vlc_tick_t cost[FRAMEDROP_TYPE_COUNT];
+    /* Consecutive late and in time measures */
+    unsigned late;
+    unsigned in_time;
+} framedrop_policy_t;
+
+void framedrop_Init( framedrop_policy_t * );
+
+/**
+ * Accounts the time spent decoding a frame of the given type.
+ */
+void framedrop_AddDecodeTime( framedrop_policy_t *, enum framedrop_type,
+                              vlc_tick_t duration );
+
+/**
+ * Updates the degradation level.
+ *
+ * \param lateness display lateness
+ * \param period duration of a frame, or VLC_TICK_INVALID if unknown
+ * \return the level to apply, until the next update
+ */
+enum framedrop_level framedrop_Update( framedrop_policy_t *,
+                                       vlc_tick_t lateness, vlc_tick_t period );
+
+#endif
@@ -422,6 +422,12 @@ static float GetDisplayRate( decoder_t *dec )
     return decoder_GetDisplayRate(bdec);
 }
 
+static int GetDisplayLateness( decoder_t *dec, vlc_tick_t *lateness )
+{
+    decoder_t *bdec = container_of(vlc_object_parent(dec), decoder_t, obj);
+    return decoder_GetDisplayLateness(bdec, lateness);
+}
+
 static int GetAttachments( decoder_t *dec,
                             input_attachment_t ***ppp_attachment,
                             int *pi_attachment )
@@ -628,6 +634,7 @@ int OpenDecoder(vlc_object_t *o)
             .queue = QueuePic,
             .get_display_date = GetDisplayDate,
             .get_display_rate = GetDisplayRate,
+            .get_display_lateness = GetDisplayLateness,
         },
         .get_attachments = GetAttachments,
     };
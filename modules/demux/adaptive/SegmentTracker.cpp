@@ -24,11 +24,13 @@
 
 #include "SegmentTracker.hpp"
 #include "SharedResources.hpp"
+#include "http/HTTPConnectionManager.h"
 #include "playlist/BasePlaylist.hpp"
 #include "playlist/BaseRepresentation.h"
 #include "playlist/BaseAdaptationSet.h"
 #include "playlist/Segment.h"
 #include "playlist/SegmentChunk.hpp"
+#include "playlist/SegmentList.h"
 #include "logic/AbstractAdaptationLogic.h"
 #include "logic/BufferingLogic.hpp"
 
@@ -155,6 +157,8 @@ SegmentTracker::Position::Position()
     rep = nullptr;
     init_sent = false;
     index_sent = false;
+    partial = false;
+    part = 0;
 }
 
 SegmentTracker::Position::Position(BaseRepresentation *rep, uint64_t number)
@@ -163,6 +167,8 @@ SegmentTracker::Position::Position(BaseRepresentation *rep, uint64_t number)
     this->number = number;
     init_sent = false;
     index_sent = false;
+    partial = false;
+    part = 0;
 }
 
 bool SegmentTracker::Position::isValid() const
@@ -176,10 +182,14 @@ std::string SegmentTracker::Position::toString() const
     std::stringstream ss;
     ss.imbue(std::locale("C"));
     if(isValid())
-        ss << "seg# " << number
-           << " " << init_sent
+    {
+        ss << "seg# " << number;
+        if(partial)
+            ss << "." << part;
+        ss << " " << init_sent
            << ":" << index_sent
            << " " << rep->getID().str();
+    }
     else
         ss << "invalid";
     return ss.str();
@@ -189,7 +199,9 @@ SegmentTracker::Position & SegmentTracker::Position::operator ++()
 {
     if(isValid())
     {
-        if(index_sent)
+        if(index_sent && partial)
+            ++part;
+        else if(index_sent)
             ++number;
         else if(init_sent)
             index_sent = true;
@@ -264,7 +276,20 @@ SegmentTracker::prepareChunk(bool switch_allowed, Position pos) const
     }
     else /* continuing, or seek */
     {
-        if(!adaptationSet->isSegmentAligned() || !pos.init_sent || !pos.index_sent)
+        if(pos.partial)
+        {
+            /* move on once all the parts of a completed segment were read */
+            const ISegment *current = pos.rep->getMediaSegment(pos.number);
+            if(current && current->isComplete() && pos.part >= current->getPartsCount())
+            {
+                ++pos.number;
+                pos.partial = false;
+                pos.part = 0;
+            }
+        }
+
+        if(!adaptationSet->isSegmentAligned() || !pos.init_sent || !pos.index_sent ||
+           pos.part > 0)
             switch_allowed = false;
 
         if(switch_allowed)
@@ -299,6 +324,25 @@ SegmentTracker::prepareChunk(bool switch_allowed, Position pos) const
     if(!datasegment && (!pos.rep->needsIndex() || pos.index_sent))
         return ChunkEntry();
 
+    /* Segments still being produced can only be read part by part */
+    ISegment *datapart = nullptr;
+    if(datasegment)
+    {
+        if(b_gap)
+        {
+            pos.partial = false;
+            pos.part = 0;
+        }
+        if(!datasegment->isComplete())
+            pos.partial = true;
+        if(pos.partial && pos.init_sent && pos.index_sent)
+        {
+            datapart = datasegment->getPart(pos.part);
+            if(!datapart) /* not announced yet */
+                return ChunkEntry();
+        }
+    }
+
     ISegment *segment = nullptr;
     if(!pos.init_sent)
     {
@@ -316,7 +360,7 @@ SegmentTracker::prepareChunk(bool switch_allowed, Position pos) const
     }
 
     if(!segment)
-        segment = datasegment;
+        segment = datapart ? datapart : datasegment;
 
     SegmentChunk *segmentChunk = segment->toChunk(resources, pos.number, pos.rep);
     if(!segmentChunk)
@@ -332,6 +376,15 @@ SegmentTracker::prepareChunk(bool switch_allowed, Position pos) const
     if(pos.rep->getPlaybackTimeDurationBySegmentNumber(pos.number, &startTime, &duration))
         startTime += VLC_TICK_0;
 
+    if(datapart && segment == datapart)
+    {
+        const Timescale timescale = pos.rep->inheritTimescale();
+        startTime += timescale.ToTime(datapart->startTime);
+        duration = timescale.ToTime(datapart->duration);
+        if(datapart->getDisplayTime() != VLC_TICK_INVALID)
+            displayTime = datapart->getDisplayTime();
+    }
+
     return ChunkEntry(segmentChunk, pos, startTime, duration, displayTime);
 }
 
@@ -365,6 +418,9 @@ ChunkInterface * SegmentTracker::getNextChunk(bool switch_allowed)
 
     /* here next == wanted chunk pos */
     bool b_gap = (next.number != chunk.pos.number);
+    /* or the segment following the last part of the previous one */
+    if(b_gap && next.partial && chunk.pos.part == 0 && chunk.pos.number == next.number + 1)
+        b_gap = false;
     const bool b_switched = (current.rep != chunk.pos.rep) || !current.rep;
     bool b_discontinuity = chunk.chunk->discontinuity && current.isValid();
     if(b_discontinuity && current.number == next.number)
@@ -436,11 +492,42 @@ ChunkInterface * SegmentTracker::getNextChunk(bool switch_allowed)
                                chunk.starttime, chunk.duration, chunk.displaytime));
 
     if(!b_gap)
+    {
         ++next;
+        prefetchChunks();
+    }
 
     return returnedChunk;
 }
 
+void SegmentTracker::prefetchChunks()
+{
+    /* Start downloading the following segments of the same representation,
+       so that they are fetched in parallel with the current one */
+    const unsigned depth = resources->getConnManager()->getParallelDownloads();
+    if(depth < 2 || !next.isValid() || !next.init_sent || !next.index_sent)
+        return;
+
+    while(chunkssequence.size() < depth - 1)
+    {
+        Position pos = next;
+        if(!chunkssequence.empty())
+        {
+            pos = chunkssequence.back().pos;
+            ++pos;
+        }
+
+        ChunkEntry chunk = prepareChunk(false, pos);
+        if(!chunk.isValid())
+        {
+            /* not available yet */
+            delete chunk.chunk;
+            break;
+        }
+        chunkssequence.push_back(chunk);
+    }
+}
+
 bool SegmentTracker::setPositionByTime(vlc_tick_t time, bool restarted, bool tryonly)
 {
     Position pos = Position(current.rep, current.number);
@@ -492,6 +579,8 @@ SegmentTracker::Position SegmentTracker::getStartPosition() const
         /* Ensure ephemere content is updated/loaded */
         bool b_updated = pos.rep->needsUpdate(pos.number) && pos.rep->runLocalUpdates(resources);
         pos.number = bufferingLogic->getStartSegmentNumber(pos.rep);
+        if(pos.isValid())
+            setLowLatencyStartPart(pos);
         pos.rep->scheduleNextUpdate(pos.number, b_updated);
         if(b_updated)
             notify(RepresentationUpdatedEvent(pos.rep));
@@ -499,6 +588,42 @@ SegmentTracker::Position SegmentTracker::getStartPosition() const
     return pos;
 }
 
+void SegmentTracker::setLowLatencyStartPart(Position &pos) const
+{
+    /* When the live edge is only available as parts, join at the part
+     * matching the live delay instead of the start of a segment */
+    const SegmentList *segmentList = pos.rep->inheritSegmentList();
+    if(!segmentList || segmentList->getSegments().empty())
+        return;
+
+    const std::vector<Segment *> &list = segmentList->getSegments();
+    if(list.back()->isComplete())
+        return;
+
+    const BasePlaylist *playlist = adaptationSet->getPlaylist();
+    const Timescale timescale = segmentList->inheritTimescale();
+    const stime_t delay = timescale.ToScaled(std::max(bufferingLogic->getLiveDelay(playlist),
+                                                      playlist->suggestedPresentationDelay));
+    stime_t ahead = 0;
+    for(auto it = list.crbegin(); it != list.crend(); ++it)
+    {
+        const Segment *seg = *it;
+        if(seg->getSequenceNumber() < pos.number || seg->getPartsCount() == 0)
+            break;
+        for(size_t i = seg->getPartsCount(); i > 0; i--)
+        {
+            ahead += seg->getPart(i - 1)->duration;
+            if(ahead >= delay)
+            {
+                pos.number = seg->getSequenceNumber();
+                pos.partial = true;
+                pos.part = i - 1;
+                return;
+            }
+        }
+    }
+}
+
 bool SegmentTracker::setStartPosition()
 {
     if(next.isValid())
@@ -555,7 +680,19 @@ vlc_tick_t SegmentTracker::getMinAheadTime() const
         if(startnumber == std::numeric_limits<uint64_t>::max())
             startnumber = bufferingLogic->getStartSegmentNumber(rep);
         if(startnumber != std::numeric_limits<uint64_t>::max())
-            return rep->getMinAheadTime(startnumber);
+        {
+            vlc_tick_t ahead = rep->getMinAheadTime(startnumber);
+            /* parts of the current segment that remain to be read */
+            const ISegment *seg = current.partial && rep == current.rep
+                                ? rep->getMediaSegment(current.number) : nullptr;
+            if(seg)
+            {
+                const Timescale timescale = rep->inheritTimescale();
+                for(size_t i = current.part + 1; i < seg->getPartsCount(); i++)
+                    ahead += timescale.ToTime(seg->getPart(i)->duration);
+            }
+            return ahead;
+        }
     }
     return 0;
 }
@@ -221,6 +221,8 @@ namespace adaptive
                     BaseRepresentation *rep;
                     bool init_sent;
                     bool index_sent;
+                    bool partial; /* segment is read part by part */
+                    size_t part;
             };
 
             void getCodecsDesc(CodecDescriptionList *) const;
@@ -257,7 +259,9 @@ namespace adaptive
             };
             std::list<ChunkEntry> chunkssequence;
             ChunkEntry prepareChunk(bool switch_allowed, Position pos) const;
+            void setLowLatencyStartPart(Position &) const;
             void resetChunksSequence();
+            void prefetchChunks();
             void setAdaptationLogic(AbstractAdaptationLogic *);
             void notify(const TrackerEvent &) const;
             bool first;
@@ -64,7 +64,8 @@ SharedResources * SharedResources::createDefault(vlc_object_t *obj,
 {
     AuthStorage *auth = new AuthStorage(obj);
     Keyring *keyring = new Keyring(obj);
-    HTTPConnectionManager *m = new HTTPConnectionManager(obj);
+    int64_t parallel = var_InheritInteger(obj, "adaptive-connections");
+    HTTPConnectionManager *m = new HTTPConnectionManager(obj, parallel > 0 ? parallel : 1);
     if(!var_InheritBool(obj, "adaptive-use-access")) /* only use http from access */
         m->addFactory(new LibVLCHTTPConnectionFactory(auth));
     m->addFactory(new StreamUrlConnectionFactory());
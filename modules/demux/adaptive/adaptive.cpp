@@ -81,6 +81,10 @@ static void Close   (vlc_object_t *);
 #define ADAPT_ACCESS_TEXT N_("Use regular HTTP modules")
 #define ADAPT_ACCESS_LONGTEXT N_("Connect using HTTP access instead of custom HTTP code")
 
+#define ADAPT_CONNECTIONS_TEXT N_("Parallel segment downloads")
+#define ADAPT_CONNECTIONS_LONGTEXT N_("Number of segments of a stream downloaded " \
+                                      "at the same time, each over its own connection")
+
 #define ADAPT_LOWLATENCY_TEXT N_("Low latency")
 #define ADAPT_LOWLATENCY_LONGTEXT N_("Overrides low latency parameters")
 
@@ -143,6 +147,8 @@ vlc_module_begin ()
                      ADAPT_MAXBUFFER_TEXT, nullptr )
         add_integer( "adaptive-lowlatency", -1, ADAPT_LOWLATENCY_TEXT, ADAPT_LOWLATENCY_LONGTEXT )
             change_integer_list(rgi_latency, ppsz_latency)
+        add_integer_with_range( "adaptive-connections", 2, 1, 8,
+                                ADAPT_CONNECTIONS_TEXT, ADAPT_CONNECTIONS_LONGTEXT )
         set_callbacks( Open, Close )
 vlc_module_end ()
 
@@ -343,6 +343,9 @@ HTTPChunkBufferedSource::HTTPChunkBufferedSource(const std::string& url, Abstrac
     done = false;
     eof = false;
     held = false;
+    transferring = false;
+    transferStartTime = VLC_TICK_INVALID;
+    transferLoad = 0;
     p_read = nullptr;
     inblockreadoffset = 0;
 }
@@ -357,6 +360,9 @@ HTTPChunkBufferedSource::~HTTPChunkBufferedSource()
     while(held) /* wait release if not in queue but currently downloaded */
         avail.wait(lock);
 
+    if(transferring) /* interrupted */
+        connManager->transferEnded(transferLoad, transferStartTime);
+
     if(p_head)
     {
         block_ChainRelease(p_head);
@@ -398,6 +404,13 @@ void HTTPChunkBufferedSource::bufferize(size_t readsize)
             return;
         }
 
+        if(!transferring && type == ChunkType::Segment)
+        {
+            transferring = true;
+            transferStartTime = vlc_tick_now();
+            transferLoad = connManager->transferStarted();
+        }
+
         if(readsize < HTTPChunkSource::CHUNK_SIZE)
             readsize = HTTPChunkSource::CHUNK_SIZE;
 
@@ -417,7 +430,8 @@ void HTTPChunkBufferedSource::bufferize(size_t readsize)
         size_t size;
         vlc_tick_t time;
         vlc_tick_t latency;
-    } rate = {0,0,0};
+        double concurrency;
+    } rate = {0,0,0,1.0};
 
     ssize_t ret = connection->read(p_block->p_buffer, readsize);
     if(ret <= 0)
@@ -430,6 +444,7 @@ void HTTPChunkBufferedSource::bufferize(size_t readsize)
         rate.size = buffered;
         rate.time = downloadEndTime - requestStartTime;
         rate.latency = responseTime - requestStartTime;
+        rate.concurrency = endTransfer();
         avail.signal();
     }
     else
@@ -450,17 +465,29 @@ void HTTPChunkBufferedSource::bufferize(size_t readsize)
             rate.size = buffered;
             rate.time = downloadEndTime - requestStartTime;
             rate.latency = responseTime - requestStartTime;
+            rate.concurrency = endTransfer();
         }
         avail.signal();
     }
 
     if(rate.size && rate.time && type == ChunkType::Segment)
     {
+        /* Concurrent transfers share the link: report the link rate,
+           not this transfer's share of it */
+        rate.time = rate.time / rate.concurrency;
         connManager->updateDownloadRate(sourceid, rate.size,
                                         rate.time, rate.latency);
     }
 }
 
+double HTTPChunkBufferedSource::endTransfer()
+{
+    if(!transferring)
+        return 1.0;
+    transferring = false;
+    return connManager->transferEnded(transferLoad, transferStartTime);
+}
+
 bool HTTPChunkBufferedSource::hasMoreData() const
 {
     mutex_locker locker {lock};
@@ -180,6 +180,7 @@ namespace adaptive
                 bool               isDone() const;
                 void               hold();
                 void               release();
+                double             endTransfer();
 
             private:
                 block_t            *p_head; /* read cache buffer */
@@ -191,6 +192,9 @@ namespace adaptive
                 bool                eof;
                 vlc::threads::condition_variable avail;
                 bool                held;
+                bool                transferring;
+                vlc_tick_t          transferStartTime;
+                vlc_tick_t          transferLoad;
         };
 
         class HTTPChunk : public AbstractChunk
@@ -25,26 +25,26 @@
 
 #include <vlc_threads.h>
 
+#include <algorithm>
 #include <atomic>
 
 using namespace adaptive::http;
 
-Downloader::Downloader()
+Downloader::Downloader(unsigned workers_)
 {
     killed = false;
-    thread_handle_valid = false;
-    current = nullptr;
-    cancel_current = false;
+    workers = workers_ ? workers_ : 1;
 }
 
 bool Downloader::start()
 {
-    if(!thread_handle_valid &&
-       vlc_clone(&thread_handle, downloaderThread, static_cast<void *>(this)))
+    while(thread_handles.size() < workers)
     {
-        return false;
+        vlc_thread_t th;
+        if(vlc_clone(&th, downloaderThread, static_cast<void *>(this)))
+            return !thread_handles.empty();
+        thread_handles.push_back(th);
     }
-    thread_handle_valid = true;
     return true;
 }
 
@@ -52,15 +52,15 @@ Downloader::~Downloader()
 {
     kill();
 
-    if(thread_handle_valid)
-        vlc_join(thread_handle, nullptr);
+    for(vlc_thread_t th : thread_handles)
+        vlc_join(th, nullptr);
 }
 
 void Downloader::kill()
 {
     vlc::threads::mutex_locker locker {lock};
     killed = true;
-    wait_cond.signal();
+    wait_cond.broadcast();
 }
 
 void Downloader::schedule(HTTPChunkBufferedSource *source)
@@ -74,9 +74,9 @@ void Downloader::schedule(HTTPChunkBufferedSource *source)
 void Downloader::cancel(HTTPChunkBufferedSource *source)
 {
     vlc::threads::mutex_locker locker {lock};
-    while (current == source)
+    while (isActive(source))
     {
-        cancel_current = true;
+        cancelled.push_back(source);
         updated_cond.wait(lock);
     }
 
@@ -87,6 +87,22 @@ void Downloader::cancel(HTTPChunkBufferedSource *source)
     }
 }
 
+bool Downloader::isActive(const HTTPChunkBufferedSource *source) const
+{
+    return std::find(active.begin(), active.end(), source) != active.end();
+}
+
+HTTPChunkBufferedSource * Downloader::getNextPending() const
+{
+    /* Oldest chunk not already being bufferized by another worker */
+    for(HTTPChunkBufferedSource *source : chunks)
+    {
+        if(!isActive(source))
+            return source;
+    }
+    return nullptr;
+}
+
 void * Downloader::downloaderThread(void *opaque)
 {
     vlc_thread_set_name("vlc-adapt-dl");
@@ -101,7 +117,8 @@ void Downloader::Run()
     {
         lock.lock();
 
-        while(chunks.empty() && !killed)
+        HTTPChunkBufferedSource *current;
+        while((current = getNextPending()) == nullptr && !killed)
             wait_cond.wait(lock);
 
         if(killed)
@@ -110,18 +127,20 @@ void Downloader::Run()
             break;
         }
 
-        current = chunks.front();
+        active.push_back(current);
         lock.unlock();
         current->bufferize(HTTPChunkSource::CHUNK_SIZE);
         lock.lock();
+        active.remove(current);
+        bool cancel_current = std::find(cancelled.begin(), cancelled.end(),
+                                        current) != cancelled.end();
         if(current->isDone() || cancel_current)
         {
-            chunks.pop_front();
+            chunks.remove(current);
             current->release();
         }
-        cancel_current = false;
-        current = nullptr;
-        updated_cond.signal();
+        cancelled.remove(current);
+        updated_cond.broadcast();
         lock.unlock();
     }
 }
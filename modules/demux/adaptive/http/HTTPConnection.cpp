@@ -28,10 +28,13 @@
 #include "../plumbing/SourceStream.hpp"
 
 #include <optional>
+#include <cassert>
 #include <cstdlib>
+#include <map>
 
 #include <vlc_stream.h>
 #include <vlc_keystore.h>
+#include <vlc_cxx_helpers.hpp>
 
 extern "C"
 {
@@ -42,6 +45,7 @@ extern "C"
 }
 
 using namespace adaptive::http;
+using vlc::threads::mutex_locker;
 
 AbstractConnection::AbstractConnection(vlc_object_t *p_object_)
 {
@@ -86,14 +90,105 @@ const ConnectionParams & AbstractConnection::getRedirection() const
     return locationparams;
 }
 
+/* Connections to an HTTPS origin share a single connection manager, so that
+ * their requests get multiplexed over one HTTP/2 session instead of each
+ * opening its own TCP and TLS session. Until the origin is known to speak
+ * HTTP/2, only one connection at a time uses the shared manager; the others,
+ * and all connections to HTTP/1.x origins, use their own manager. */
+class adaptive::http::LibVLCHTTPSessions
+{
+    public:
+        LibVLCHTTPSessions(struct vlc_http_cookie_jar_t *jar_)
+        {
+            jar = jar_;
+        }
+        ~LibVLCHTTPSessions()
+        {
+            for(auto &it : origins)
+                if(it.second.mgr)
+                    vlc_http_mgr_destroy(it.second.mgr);
+        }
+
+        struct vlc_http_mgr *acquire(vlc_object_t *obj,
+                                     const ConnectionParams &params,
+                                     bool *probing)
+        {
+            *probing = false;
+            if(params.getScheme() != "https")
+                return nullptr;
+
+            mutex_locker locker {lock};
+            Origin &origin = origins[getKey(params)];
+            if(origin.mgr == nullptr)
+            {
+                origin.mgr = vlc_http_mgr_create(obj, jar);
+                if(origin.mgr == nullptr)
+                    return nullptr;
+            }
+
+            switch(origin.state)
+            {
+                case State::Multiplexed:
+                    return origin.mgr;
+                case State::Unknown:
+                    origin.state = State::Probing;
+                    *probing = true;
+                    return origin.mgr;
+                default:
+                    return nullptr;
+            }
+        }
+
+        void probed(const ConnectionParams &params, bool responded)
+        {
+            mutex_locker locker {lock};
+            Origin &origin = origins[getKey(params)];
+            assert(origin.state == State::Probing);
+            if(!responded)
+                origin.state = State::Unknown;
+            else if(vlc_http_mgr_multiplexed(origin.mgr))
+                origin.state = State::Multiplexed;
+            else
+                origin.state = State::Serial;
+        }
+
+    private:
+        enum class State
+        {
+            Unknown,
+            Probing,
+            Multiplexed,
+            Serial,
+        };
+
+        struct Origin
+        {
+            struct vlc_http_mgr *mgr = nullptr;
+            State state = State::Unknown;
+        };
+
+        static std::string getKey(const ConnectionParams &params)
+        {
+            return params.getScheme() + "://" + params.getHostname() + ":" +
+                   std::to_string(params.getPort());
+        }
+
+        vlc::threads::mutex lock;
+        struct vlc_http_cookie_jar_t *jar;
+        std::map<std::string, Origin> origins;
+};
+
 class adaptive::http::LibVLCHTTPSource : public adaptive::BlockStreamInterface
 {
      public:
-        LibVLCHTTPSource(vlc_object_t *p_object_, struct vlc_http_cookie_jar_t *jar)
+        LibVLCHTTPSource(vlc_object_t *p_object_, struct vlc_http_cookie_jar_t *jar,
+                         LibVLCHTTPSessions *sessions_)
         {
             p_object = p_object_;
+            sessions = sessions_;
             http_mgr = vlc_http_mgr_create(p_object, jar);
             http_res = nullptr;
+            probing = false;
             totalRead = 0;
         }
         virtual ~LibVLCHTTPSource()
@@ -188,7 +283,10 @@ class adaptive::http::LibVLCHTTPSource : public adaptive::BlockStreamInterface
         vlc_object_t *p_object;
         static const struct vlc_http_resource_cbs callbacks;
         size_t totalRead;
+        LibVLCHTTPSessions *sessions;
         struct vlc_http_mgr *http_mgr;
+        bool probing;
+        ConnectionParams probedparams;
         BytesRange range;
         struct vlc_http_resource *http_res;
         std::optional<std::string> username;
@@ -237,12 +335,22 @@ class adaptive::http::LibVLCHTTPSource : public adaptive::BlockStreamInterface
             tpl->source = this;
             this->range = range;
             this->lastparams = params;
-            if (vlc_http_res_init(&tpl->resource, &this->callbacks, http_mgr,
+
+            struct vlc_http_mgr *mgr = nullptr;
+            if (sessions)
+                mgr = sessions->acquire(p_object, params, &probing);
+            if (mgr == nullptr)
+                mgr = http_mgr;
+            else if (probing)
+                probedparams = params;
+
+            if (vlc_http_res_init(&tpl->resource, &this->callbacks, mgr,
                                   params.getUrl().c_str(),
                                   ua.empty() ? nullptr : ua.c_str(),
                                   ref.empty() ? nullptr : ref.c_str()))
             {
                 std::free(tpl);
+                endProbe(false);
                 return -1;
             }
             http_res = &tpl->resource;
@@ -250,6 +358,24 @@ class adaptive::http::LibVLCHTTPSource : public adaptive::BlockStreamInterface
         }
 
         RequestStatus connect()
+        {
+            RequestStatus status = open();
+            endProbe(status == RequestStatus::Success ||
+                     status == RequestStatus::Redirection);
+            return status;
+        }
+
+    private:
+        void endProbe(bool responded)
+        {
+            if (probing)
+            {
+                sessions->probed(probedparams, responded);
+                probing = false;
+            }
+        }
+
+        RequestStatus open()
         {
             if (http_res == nullptr)
                 return RequestStatus::GenericError;
@@ -321,6 +447,7 @@ class adaptive::http::LibVLCHTTPSource : public adaptive::BlockStreamInterface
             return RequestStatus::Success;
         }
 
+    public:
         int abortandlogin()
         {
             if(http_res == nullptr)
@@ -349,10 +476,11 @@ const struct vlc_http_resource_cbs LibVLCHTTPSource::callbacks =
     LibVLCHTTPSource::validateresponse_handler,
 };
 
-LibVLCHTTPConnection::LibVLCHTTPConnection(vlc_object_t *p_object_, AuthStorage *auth)
+LibVLCHTTPConnection::LibVLCHTTPConnection(vlc_object_t *p_object_, AuthStorage *auth,
+                                           LibVLCHTTPSessions *sessions)
     : AbstractConnection( p_object_ )
 {
-    source = new adaptive::http::LibVLCHTTPSource(p_object_, auth->getJar());
+    source = new adaptive::http::LibVLCHTTPSource(p_object_, auth->getJar(), sessions);
     sourceStream = new ChunksSourceStream(p_object, source);
     stream = nullptr;
     char *psz_useragent = var_InheritString(p_object_, "http-user-agent");
@@ -599,6 +727,12 @@ LibVLCHTTPConnectionFactory::LibVLCHTTPConnectionFactory( AuthStorage *auth )
     : AbstractConnectionFactory()
 {
     authStorage = auth;
+    sessions = new LibVLCHTTPSessions(auth->getJar());
+}
+
+LibVLCHTTPConnectionFactory::~LibVLCHTTPConnectionFactory()
+{
+    delete sessions;
 }
 
 AbstractConnection * LibVLCHTTPConnectionFactory::createConnection(vlc_object_t *p_object,
@@ -607,7 +741,7 @@ AbstractConnection * LibVLCHTTPConnectionFactory::createConnection(vlc_object_t
     if((params.getScheme() != "http" && params.getScheme() != "https") ||
        params.getHostname().empty())
         return nullptr;
-    return new LibVLCHTTPConnection(p_object, authStorage);
+    return new LibVLCHTTPConnection(p_object, authStorage, sessions);
 }
 
 StreamUrlConnectionFactory::StreamUrlConnectionFactory()
@@ -42,6 +42,10 @@ AbstractConnectionManager::AbstractConnectionManager(vlc_object_t *p_object_)
 {
     p_object = p_object_;
     rateObserver = nullptr;
+    parallelDownloads = 1;
+    activeTransfers = 0;
+    transfersLoad = 0;
+    transfersLoadTime = VLC_TICK_INVALID;
 }
 
 AbstractConnectionManager::~AbstractConnectionManager()
@@ -67,17 +71,55 @@ void AbstractConnectionManager::setDownloadRateObserver(IDownloadRateObserver *o
     rateObserver = obs;
 }
 
+unsigned AbstractConnectionManager::getParallelDownloads() const
+{
+    return parallelDownloads;
+}
+
+vlc_tick_t AbstractConnectionManager::updateTransfersLoad(int delta)
+{
+    /* Integral of the number of running segment transfers over time */
+    vlc_tick_t now = vlc_tick_now();
+    if(transfersLoadTime != VLC_TICK_INVALID)
+        transfersLoad += (now - transfersLoadTime) * activeTransfers;
+    transfersLoadTime = now;
+    activeTransfers += delta;
+    return transfersLoad;
+}
+
+vlc_tick_t AbstractConnectionManager::transferStarted()
+{
+    vlc::threads::mutex_locker locker {transfersLock};
+    return updateTransfersLoad(1);
+}
+
+double AbstractConnectionManager::transferEnded(vlc_tick_t loadstart,
+                                                vlc_tick_t starttime)
+{
+    /* Returns the average number of transfers that shared the link
+       with the ending one, including itself */
+    vlc::threads::mutex_locker locker {transfersLock};
+    vlc_tick_t load = updateTransfersLoad(-1) - loadstart;
+    vlc_tick_t elapsed = transfersLoadTime - starttime;
+    if(elapsed <= 0 || load <= elapsed)
+        return 1.0;
+    return (double) load / elapsed;
+}
+
 void AbstractConnectionManager::deleteSource(AbstractChunkSource *source)
 {
     delete source;
 }
 
-HTTPConnectionManager::HTTPConnectionManager    (vlc_object_t *p_object_)
+HTTPConnectionManager::HTTPConnectionManager    (vlc_object_t *p_object_,
+                                                 unsigned parallel)
     : AbstractConnectionManager( p_object_ ),
       localAllowed(false)
 {
     vlc_mutex_init(&lock);
-    downloader = new Downloader();
+    parallelDownloads = parallel ? parallel : 1;
+    /* Segments can be fetched in parallel, playlists and keys can not */
+    downloader = new Downloader(parallelDownloads);
     downloaderhp = new Downloader();
     downloader->start();
     downloaderhp->start();
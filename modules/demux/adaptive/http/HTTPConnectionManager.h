@@ -30,6 +30,7 @@
 
 #include <vlc_common.h>
 #include <vlc_threads.h>
+#include <vlc_cxx_helpers.hpp>
 
 #include <vector>
 #include <list>
@@ -68,19 +69,28 @@ namespace adaptive
                 virtual void updateDownloadRate(const ID &, size_t,
                                                 vlc_tick_t, vlc_tick_t) override;
                 void setDownloadRateObserver(IDownloadRateObserver *);
+                unsigned getParallelDownloads() const;
+                vlc_tick_t transferStarted();
+                double transferEnded(vlc_tick_t, vlc_tick_t);
 
             protected:
                 void deleteSource(AbstractChunkSource *);
                 vlc_object_t                                       *p_object;
+                unsigned                                            parallelDownloads;
 
             private:
+                vlc_tick_t updateTransfersLoad(int);
                 IDownloadRateObserver                              *rateObserver;
+                vlc::threads::mutex                                 transfersLock;
+                unsigned                                            activeTransfers;
+                vlc_tick_t                                          transfersLoad;
+                vlc_tick_t                                          transfersLoadTime;
         };
 
         class HTTPConnectionManager : public AbstractConnectionManager
         {
             public:
-                HTTPConnectionManager           (vlc_object_t *p_object);
+                HTTPConnectionManager           (vlc_object_t *p_object, unsigned = 1);
                 virtual ~HTTPConnectionManager  ();
 
                 void    closeAllConnections ()  override;
@@ -130,6 +130,21 @@ void ISegment::setByteRange(size_t start, size_t end)
     endByte   = end;
 }
 
+size_t ISegment::getPartsCount() const
+{
+    return 0;
+}
+
+ISegment * ISegment::getPart(size_t) const
+{
+    return nullptr;
+}
+
+bool ISegment::isComplete() const
+{
+    return true;
+}
+
 void ISegment::setSequenceNumber(uint64_t seq)
 {
     sequence = seq;
@@ -220,6 +235,10 @@ void Segment::addSubSegment(SubSegment *subsegment)
     subsegments.push_back(subsegment);
 }
 
+void Segment::updateWith(Segment *)
+{
+}
+
 Segment::~Segment()
 {
     std::vector<Segment*>::iterator it;
@@ -71,6 +71,12 @@ namespace adaptive
                 virtual size_t                          getOffset       () const;
                 virtual void                            debug           (vlc_object_t *,int = 0) const;
                 virtual bool                            contains        (size_t byte) const;
+                /* Low latency segments can be fetched as a sequence of
+                 * parts, while the whole segment is still being produced.
+                 * Parts start times are relative to their segment. */
+                virtual size_t                          getPartsCount   () const;
+                virtual ISegment *                      getPart         (size_t) const;
+                virtual bool                            isComplete      () const;
                 void                                    setEncryption   (CommonEncryption &);
                 void                                    setDisplayTime  (vlc_tick_t);
                 vlc_tick_t                              getDisplayTime  () const;
@@ -103,6 +109,7 @@ namespace adaptive
                 virtual const std::vector<Segment*> & subSegments() const;
                 void debug(vlc_object_t *,int = 0) const override;
                 virtual void addSubSegment(SubSegment *);
+                virtual void updateWith(Segment *);
 
             protected:
                 std::vector<Segment *> subsegments;
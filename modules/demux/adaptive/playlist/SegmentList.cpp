@@ -112,9 +112,21 @@ void SegmentList::updateWith(AbstractMultipleSegmentBaseType *updated_,
     }
     else
     {
-        const Segment * prevSegment = segments.back();
+        Segment * prevSegment = segments.back();
         const uint64_t oldest = updated->segments.front()->getSequenceNumber();
 
+        /* complete the last segment if it was still being produced */
+        if(!prevSegment->isComplete())
+        {
+            Segment *prevUpdate = updated->getMediaSegment(prevSegment->getSequenceNumber());
+            if(prevUpdate)
+            {
+                totalLength -= prevSegment->duration;
+                prevSegment->updateWith(prevUpdate);
+                totalLength += prevSegment->duration;
+            }
+        }
+
         /* filter out known segments from the update */
         updated->pruneBySegmentNumber(prevSegment->getSequenceNumber() + 1);
 
@@ -133,6 +133,7 @@ class DummyConnectionManager : public AbstractConnectionManager
         void recycleSource(AbstractChunkSource *) override {}
         void start(AbstractChunkSource *) override {}
         void cancel(AbstractChunkSource *) override {}
+        void setParallelDownloads(unsigned n) { parallelDownloads = n; }
 
         std::map<std::string, std::vector<uint8_t>> data;
 };
@@ -731,9 +732,87 @@ static int SegmentTracker_check_HLSseeks(BaseAdaptationSet *adaptSet,
     return 0;
 }
 
+/****** check segments downloaded ahead ******/
+static int SegmentTracker_check_prefetch(BaseAdaptationSet *adaptSet,
+                                         DummyLogic *,
+                                         SegmentTracker *tracker,
+                                         SegmentTrackerListener &events)
+{
+    const stime_t START = 1337;
+    Timescale timescale(100);
+
+    ChunkInterface *currentChunk = nullptr;
+    try
+    {
+        DummyRepresentation *rep0 = new DummyRepresentation(adaptSet);
+        adaptSet->addRepresentation(rep0);
+        rep0->setID(ID("0"));
+
+        SegmentList *segmentList = nullptr;
+        try
+        {
+            segmentList = new SegmentList(rep0);
+            segmentList->addAttribute(new TimescaleAttr(timescale));
+            for(int i=0; i<5; i++)
+            {
+                Segment *seg = new Segment(rep0);
+                seg->setSequenceNumber(123 + i);
+                seg->setDiscontinuitySequenceNumber(456);
+                seg->startTime = START + 100 * i;
+                seg->duration = 100;
+                seg->setSourceUrl("sample/aac");
+                segmentList->addSegment(seg);
+            }
+        } catch (...) {
+            delete segmentList;
+            std::rethrow_exception(std::current_exception());
+        }
+        rep0->addAttribute(segmentList);
+
+        /* prefetched chunks must be returned in order */
+        Expect(tracker->setStartPosition() == true);
+        for(int i=0; i<5; i++)
+        {
+            events.reset();
+            currentChunk = tracker->getNextChunk(true);
+            Expect(currentChunk);
+            Expect(events.occured(TrackerEvent::Type::SegmentChange) == true);
+            Expect(events.segmentchanged.starttime == timescale.ToTime(START + 100 * i) + VLC_TICK_0);
+            delete currentChunk;
+            currentChunk = nullptr;
+        }
+
+        events.reset();
+        currentChunk = tracker->getNextChunk(true);
+        Expect(currentChunk == nullptr);
+        Expect(events.occured(TrackerEvent::Type::SegmentChange) == false);
+
+        /* seeking must drop prefetched chunks */
+        Expect(tracker->setPositionByTime(VLC_TICK_0 + timescale.ToTime(START + 50), false, false) == true);
+        currentChunk = tracker->getNextChunk(true);
+        Expect(currentChunk);
+        delete currentChunk;
+        currentChunk = nullptr;
+
+        events.reset();
+        Expect(tracker->setPositionByTime(VLC_TICK_0 + timescale.ToTime(START + 350), false, false) == true);
+        currentChunk = tracker->getNextChunk(true);
+        Expect(currentChunk);
+        Expect(events.segmentchanged.starttime == timescale.ToTime(START + 300) + VLC_TICK_0);
+        delete currentChunk;
+        currentChunk = nullptr;
+
+    } catch( ... ) {
+        delete currentChunk;
+        return 1;
+    }
+
+    return 0;
+}
+
 typedef decltype(SegmentTracker_check_formats) testfunc;
 
-static int Prepare_test(testfunc func)
+static int Prepare_test(testfunc func, unsigned parallel = 1)
 {
     DummyConnectionManager *connManager = nullptr;
     try
@@ -741,6 +820,8 @@ static int Prepare_test(testfunc func)
         connManager = new DummyConnectionManager;
     } catch( ... ) { return 1; }
 
+    connManager->setParallelDownloads(parallel);
+
     connManager->data.insert(mapentry("sample/aac", std::vector<uint8_t>({ 0xFF, 0xF1, 0, 0 })));
     connManager->data.insert(mapentry("sample/ac3", std::vector<uint8_t>({ 0x0b, 0x77, 0, 0, 0, 0 })));
     connManager->data.insert(mapentry("sample/aacinit", std::vector<uint8_t>({ 0xFF, 0xF1, 0, 0 })));
@@ -786,5 +867,6 @@ int SegmentTracker_test()
         Prepare_test(SegmentTracker_check_seeks) ||
         Prepare_test(SegmentTracker_check_switches) ||
         Prepare_test(SegmentTracker_check_HLSseeks) ||
+        Prepare_test(SegmentTracker_check_prefetch, 3) ||
         0;
 }
@@ -585,5 +585,60 @@ int M3U8Playlist_test()
     }
 
 
+    /* Manifest 7 */
+    const char manifest7[] =
+        "#EXTM3U\n"
+        "#EXT-X-TARGETDURATION:4\n"
+        "#EXT-X-SERVER-CONTROL:CAN-BLOCK-RELOAD=YES,PART-HOLD-BACK=3.0,HOLD-BACK=12.0\n"
+        "#EXT-X-PART-INF:PART-TARGET=1.0\n"
+        "#EXT-X-MEDIA-SEQUENCE:10\n"
+        "#EXTINF:4.0,\n"
+        "seg10.mp4\n"
+        "#EXT-X-PART:DURATION=1.0,URI=\"part11.0.mp4\"\n"
+        "#EXT-X-PART:DURATION=1.0,URI=\"part11.1.mp4\"\n"
+        "#EXT-X-PART:DURATION=1.0,URI=\"part11.2.mp4\"\n"
+        "#EXT-X-PART:DURATION=1.0,URI=\"part11.3.mp4\"\n"
+        "#EXTINF:4.0,\n"
+        "seg11.mp4\n"
+        "#EXT-X-PART:DURATION=1.0,URI=\"part12.0.mp4\"\n"
+        "#EXT-X-PART:DURATION=1.0,URI=\"part12.1.mp4\"\n"
+        "#EXT-X-PRELOAD-HINT:TYPE=PART,URI=\"part12.2.mp4\"\n";
+
+    m3u = ParseM3U8(obj, manifest7, sizeof(manifest7));
+    try
+    {
+        Expect(m3u);
+        Expect(m3u->isLive() == true);
+        Expect(m3u->isLowLatency() == true);
+        Expect(m3u->suggestedPresentationDelay == vlc_tick_from_sec(3));
+        BaseRepresentation *rep = m3u->getFirstPeriod()->getAdaptationSets().front()->
+                                  getRepresentations().front();
+        Segment *seg = rep->getMediaSegment(10);
+        Expect(seg);
+        Expect(seg->isComplete());
+        Expect(seg->getPartsCount() == 0);
+        seg = rep->getMediaSegment(11);
+        Expect(seg);
+        Expect(seg->isComplete());
+        Expect(seg->getPartsCount() == 4);
+        Expect(seg->getPart(1)->startTime == vlc_tick_from_sec(1));
+        seg = rep->getMediaSegment(12);
+        Expect(seg);
+        Expect(!seg->isComplete());
+        Expect(seg->getPartsCount() == 3);
+        Expect(seg->duration == vlc_tick_from_sec(2));
+        Expect(static_cast<HLSSegment *>(seg->getPart(2))->isHinted());
+        /* blocking reload must ask for the hinted part */
+        std::string updateurl = static_cast<HLSRepresentation *>(rep)->getUpdateUrl().toString();
+        Expect(updateurl.find("_HLS_msn=12&_HLS_part=2") != std::string::npos);
+        delete m3u;
+    }
+    catch (...)
+    {
+        delete m3u;
+        return 1;
+    }
+
+
     return 0;
 }
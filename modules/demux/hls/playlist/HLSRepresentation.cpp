@@ -44,6 +44,8 @@ HLSRepresentation::HLSRepresentation  ( BaseAdaptationSet *set ) :
     updateFailureCount = 0;
     lastUpdateTime = 0;
     targetDuration = 0;
+    partTarget = 0;
+    canBlockReload = false;
     streamFormat = StreamFormat::Type::Unknown;
     channels = 0;
 }
@@ -62,6 +64,11 @@ bool HLSRepresentation::isLive() const
     return b_live;
 }
 
+bool HLSRepresentation::isLowLatency() const
+{
+    return partTarget > 0;
+}
+
 bool HLSRepresentation::initialized() const
 {
     return b_loaded;
@@ -87,6 +94,37 @@ Url HLSRepresentation::getPlaylistUrl() const
     }
 }
 
+Url HLSRepresentation::getUpdateUrl() const
+{
+    Url url = getPlaylistUrl();
+    if(!b_loaded || !b_live || !canBlockReload)
+        return url;
+
+    const SegmentList *segmentList = inheritSegmentList();
+    if(!segmentList || segmentList->getSegments().empty())
+        return url;
+
+    /* Blocking playlist reload: the server holds the request until the
+     * next segment, or part, is available */
+    const Segment *last = segmentList->getSegments().back();
+    uint64_t msn = last->getSequenceNumber();
+    size_t part = 0;
+    if(!last->isComplete())
+    {
+        while(part < last->getPartsCount() &&
+              !static_cast<const HLSSegment *>(last->getPart(part))->isHinted())
+            part++;
+    }
+    else msn++;
+
+    std::string directives = url.toString();
+    directives += directives.find('?') == std::string::npos ? "?" : "&";
+    directives += "_HLS_msn=" + std::to_string(msn);
+    if(isLowLatency())
+        directives += "&_HLS_part=" + std::to_string(part);
+    return Url(directives);
+}
+
 void HLSRepresentation::debug(vlc_object_t *obj, int indent) const
 {
     BaseRepresentation::debug(obj, indent);
@@ -136,9 +174,13 @@ bool HLSRepresentation::needsUpdate(uint64_t number) const
         vlc_tick_t duration = targetDuration
                             ? vlc_tick_from_sec(targetDuration)
                             : VLC_TICK_FROM_SEC(2);
+        /* Low latency playlists change with every part */
+        if(partTarget)
+            duration = partTarget;
         if(updateFailureCount)
             duration /= 2;
-        if(elapsed < duration)
+        /* unless reloads block, the server then paces them */
+        if(elapsed < duration && (!canBlockReload || updateFailureCount))
             return false;
 
         if(number == std::numeric_limits<uint64_t>::max())
@@ -45,7 +45,9 @@ namespace hls
 
                 void setPlaylistUrl(const std::string &);
                 Url getPlaylistUrl() const;
+                Url getUpdateUrl() const;
                 bool isLive() const;
+                bool isLowLatency() const;
                 bool initialized() const;
                 void scheduleNextUpdate(uint64_t, bool) override;
                 bool needsUpdate(uint64_t) const override;
@@ -60,6 +62,8 @@ namespace hls
 
             protected:
                 time_t targetDuration;
+                vlc_tick_t partTarget; /* EXT-X-PART-INF */
+                bool canBlockReload; /* EXT-X-SERVER-CONTROL */
                 Url playlistUrl;
 
             private:
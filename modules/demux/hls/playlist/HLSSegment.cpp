@@ -24,6 +24,8 @@
 #include "HLSSegment.hpp"
 #include "../../adaptive/playlist/BaseRepresentation.h"
 
+#include <utility>
+
 
 using namespace hls::playlist;
 
@@ -31,10 +33,65 @@ HLSSegment::HLSSegment( ICanonicalUrl *parent, uint64_t seq ) :
     Segment( parent )
 {
     setSequenceNumber(seq);
+    complete = true;
+    hinted = false;
 }
 
 HLSSegment::~HLSSegment()
 {
+    for(HLSSegment *part : parts)
+        delete part;
+}
+
+size_t HLSSegment::getPartsCount() const
+{
+    return parts.size();
+}
+
+ISegment * HLSSegment::getPart(size_t index) const
+{
+    return index < parts.size() ? parts[index] : nullptr;
+}
+
+bool HLSSegment::isComplete() const
+{
+    return complete;
+}
+
+bool HLSSegment::isHinted() const
+{
+    return hinted;
+}
+
+void HLSSegment::updateWith(Segment *updated_)
+{
+    HLSSegment *updated = dynamic_cast<HLSSegment *>(updated_);
+    if(!updated || complete)
+        return;
+
+    /* Parts keep their index, a preload hint being replaced
+     * by the part it announced */
+    for(size_t i = 0; i < updated->parts.size(); i++)
+    {
+        if(i >= parts.size())
+        {
+            parts.push_back(updated->parts[i]);
+            updated->parts[i] = nullptr;
+        }
+        else if(parts[i]->hinted && !updated->parts[i]->hinted)
+        {
+            std::swap(parts[i], updated->parts[i]);
+        }
+    }
+
+    duration = updated->duration;
+    if(updated->complete)
+    {
+        sourceUrl = updated->sourceUrl;
+        startByte = updated->startByte;
+        endByte = updated->endByte;
+        complete = true;
+    }
 }
 
 bool HLSSegment::prepareChunk(SharedResources *res, SegmentChunk *chunk, BaseRepresentation *rep)
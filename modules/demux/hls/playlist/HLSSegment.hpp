@@ -23,6 +23,8 @@
 #include "../../adaptive/playlist/Segment.h"
 #include "../../adaptive/encryption/CommonEncryption.hpp"
 
+#include <vector>
+
 namespace hls
 {
     namespace playlist
@@ -38,10 +40,20 @@ namespace hls
             public:
                 HLSSegment( ICanonicalUrl *parent, uint64_t sequence );
                 virtual ~HLSSegment();
+                size_t getPartsCount() const override;
+                ISegment * getPart(size_t) const override;
+                bool isComplete() const override;
+                bool isHinted() const;
+                void updateWith(Segment *) override;
 
             protected:
                 bool prepareChunk(SharedResources *, SegmentChunk *,
                                   BaseRepresentation *) override;
+
+            private:
+                std::vector<HLSSegment *> parts; /* EXT-X-PART */
+                bool complete; /* listed with its own URI */
+                bool hinted; /* EXT-X-PRELOAD-HINT part */
         };
     }
 }
@@ -67,3 +67,19 @@ bool M3U8::isLive() const
     return b_live;
 }
 
+
+bool M3U8::isLowLatency() const
+{
+    for(const BasePeriod *period : periods)
+    {
+        for(const BaseAdaptationSet *adaptSet : period->getAdaptationSets())
+        {
+            for(const BaseRepresentation *rep : adaptSet->getRepresentations())
+            {
+                if(static_cast<const HLSRepresentation *>(rep)->isLowLatency())
+                    return true;
+            }
+        }
+    }
+    return false;
+}
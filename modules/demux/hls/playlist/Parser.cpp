@@ -225,7 +225,7 @@ void M3U8Parser::fillAdaptsetFromMediainfo(const AttributesTag *mediatag,
 
 bool M3U8Parser::appendSegmentsFromPlaylistURI(vlc_object_t *p_obj, HLSRepresentation *rep)
 {
-    block_t *p_block = Retrieve::HTTP(resources, ChunkType::Playlist, rep->getPlaylistUrl().toString());
+    block_t *p_block = Retrieve::HTTP(resources, ChunkType::Playlist, rep->getUpdateUrl().toString());
     if(p_block)
     {
         stream_t *substream = vlc_stream_MemoryNew(p_obj, p_block->p_buffer, p_block->i_buffer, true);
@@ -302,6 +302,14 @@ void M3U8Parser::parseSegments(vlc_object_t *, HLSRepresentation *rep, const std
     CommonEncryption encryption;
     const ValuesListTag *ctx_extinf = nullptr;
 
+    /* Low latency */
+    std::vector<HLSSegment *> parts;
+    vlc_tick_t nzPartsDuration = 0;
+    std::size_t prevpartbyterangeoffset = 0;
+    const AttributesTag *ctx_preloadhint = nullptr;
+    vlc_tick_t holdBack = 0;
+    vlc_tick_t partHoldBack = 0;
+
     std::list<HLSSegment *> segmentstoappend;
 
     std::list<Tag *>::const_iterator it;
@@ -375,6 +383,80 @@ void M3U8Parser::parseSegments(vlc_object_t *, HLSRepresentation *rep, const std
 
                 if(encryption.method != CommonEncryption::Method::None)
                     segment->setEncryption(encryption);
+
+                segment->parts.swap(parts);
+                nzPartsDuration = 0;
+            }
+            break;
+
+            case AttributesTag::EXTXPART:
+            {
+                const AttributesTag *parttag = static_cast<const AttributesTag *>(tag);
+                const Attribute *uriAttr = parttag->getAttributeByName("URI");
+                const Attribute *durAttr = parttag->getAttributeByName("DURATION");
+                if(!uriAttr || !durAttr)
+                    break;
+
+                HLSSegment *part = new (std::nothrow) HLSSegment(rep, sequenceNumber);
+                if(!part)
+                    break;
+
+                part->setSourceUrl(uriAttr->quotedString());
+                const vlc_tick_t nzDuration = vlc_tick_from_sec(durAttr->floatingPoint());
+                part->duration = timescale.ToScaled(nzDuration);
+                part->startTime = timescale.ToScaled(nzPartsDuration);
+                if(absReferenceTime != VLC_TICK_INVALID)
+                    part->setDisplayTime(absReferenceTime + nzPartsDuration);
+                nzPartsDuration += nzDuration;
+
+                const Attribute *byterangeAttr = parttag->getAttributeByName("BYTERANGE");
+                if(byterangeAttr)
+                {
+                    ByteRange range = byterangeAttr->unescapeQuotes().getByteRange();
+                    if(!range.first.has_value())
+                        range.first = prevpartbyterangeoffset;
+                    prevpartbyterangeoffset = *range.first + range.second;
+                    part->setByteRange(*range.first, prevpartbyterangeoffset - 1);
+                }
+                part->setDiscontinuitySequenceNumber(discontinuitySequence);
+                part->discontinuity = discontinuity && parts.empty();
+
+                if(encryption.method != CommonEncryption::Method::None)
+                    part->setEncryption(encryption);
+
+                parts.push_back(part);
+            }
+            break;
+
+            case AttributesTag::EXTXPRELOADHINT:
+            {
+                const AttributesTag *hinttag = static_cast<const AttributesTag *>(tag);
+                const Attribute *typeAttr = hinttag->getAttributeByName("TYPE");
+                if(typeAttr && typeAttr->value == "PART" && hinttag->getAttributeByName("URI"))
+                    ctx_preloadhint = hinttag;
+            }
+            break;
+
+            case AttributesTag::EXTXPARTINF:
+            {
+                const Attribute *targetAttr = static_cast<const AttributesTag *>(tag)->
+                                                getAttributeByName("PART-TARGET");
+                if(targetAttr)
+                    rep->partTarget = vlc_tick_from_sec(targetAttr->floatingPoint());
+            }
+            break;
+
+            case AttributesTag::EXTXSERVERCONTROL:
+            {
+                const AttributesTag *controltag = static_cast<const AttributesTag *>(tag);
+                const Attribute *attr = controltag->getAttributeByName("CAN-BLOCK-RELOAD");
+                rep->canBlockReload = attr && attr->value == "YES";
+                attr = controltag->getAttributeByName("HOLD-BACK");
+                if(attr)
+                    holdBack = vlc_tick_from_sec(attr->floatingPoint());
+                attr = controltag->getAttributeByName("PART-HOLD-BACK");
+                if(attr)
+                    partHoldBack = vlc_tick_from_sec(attr->floatingPoint());
             }
             break;
 
@@ -451,10 +533,61 @@ void M3U8Parser::parseSegments(vlc_object_t *, HLSRepresentation *rep, const std
         }
     }
 
+    /* The segment being produced is only available as parts */
+    if(rep->isLive() && (!parts.empty() || ctx_preloadhint))
+    {
+        HLSSegment *segment = new (std::nothrow) HLSSegment(rep, sequenceNumber);
+        if(segment)
+        {
+            segment->complete = false;
+            segment->startTime = timescale.ToScaled(nzStartTime);
+            segment->duration = timescale.ToScaled(nzPartsDuration);
+            if(absReferenceTime != VLC_TICK_INVALID)
+                segment->setDisplayTime(absReferenceTime);
+            segment->setDiscontinuitySequenceNumber(discontinuitySequence);
+            segment->discontinuity = discontinuity;
+            if(encryption.method != CommonEncryption::Method::None)
+                segment->setEncryption(encryption);
+            segment->parts.swap(parts);
+            totalduration += nzPartsDuration;
+
+            HLSSegment *hint = ctx_preloadhint
+                             ? new (std::nothrow) HLSSegment(rep, sequenceNumber) : nullptr;
+            if(hint)
+            {
+                hint->hinted = true;
+                hint->setSourceUrl(ctx_preloadhint->getAttributeByName("URI")->quotedString());
+                hint->startTime = timescale.ToScaled(nzPartsDuration);
+                hint->duration = timescale.ToScaled(rep->partTarget);
+                hint->setDiscontinuitySequenceNumber(discontinuitySequence);
+                hint->discontinuity = discontinuity && segment->parts.empty();
+                const Attribute *startAttr = ctx_preloadhint->getAttributeByName("BYTERANGE-START");
+                if(startAttr)
+                {
+                    const Attribute *lengthAttr = ctx_preloadhint->getAttributeByName("BYTERANGE-LENGTH");
+                    std::size_t start = startAttr->decimal();
+                    /* without length, up to the end of the resource */
+                    hint->setByteRange(start, lengthAttr ? start + lengthAttr->decimal() - 1 : 0);
+                }
+                if(encryption.method != CommonEncryption::Method::None)
+                    hint->setEncryption(encryption);
+                segment->parts.push_back(hint);
+            }
+            segmentstoappend.push_back(segment);
+        }
+    }
+    for(HLSSegment *part : parts)
+        delete part;
+
     for(HLSSegment *seg : segmentstoappend)
         segmentList->addSegment(seg);
     segmentstoappend.clear();
 
+    if(rep->isLowLatency() && partHoldBack)
+        rep->getPlaylist()->suggestedPresentationDelay = partHoldBack;
+    else if(holdBack)
+        rep->getPlaylist()->suggestedPresentationDelay = holdBack;
+
     if(rep->isLive())
     {
         rep->getPlaylist()->duration = 0;
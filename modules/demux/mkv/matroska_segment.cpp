@@ -28,10 +28,19 @@
 #include "Ebml_dispatcher.hpp"
 
 #include <vlc_arrays.h>
+#include <vlc_configuration.h>
+#include <vlc_fs.h>
+#include <vlc_hash.h>
+#include <vlc_strings.h>
 
+#include <algorithm>
+#include <ctime>
 #include <new>
 #include <iterator>
 #include <limits>
+#include <vector>
+
+#include <sys/stat.h>
 
 namespace mkv {
 
@@ -666,11 +675,173 @@ bool matroska_segment_c::Preload( )
 
     ComputeTrackPriority();
 
+    LoadIndexCache();
+
     b_preloaded = true;
 
     return true;
 }
 
+/*****************************************************************************
+ * Seek index cache
+ *****************************************************************************
+ *  The seek index of a local file, when built by scanning its clusters, is
+ *  saved in the cache directory and reloaded on the next open. The cache
+ *  is named after the file path and the segment position, and is only used
+ *  with the same file size, modification time and segment UID. Entries
+ *  older than INDEX_CACHE_MAX_AGE, and the oldest ones beyond
+ *  INDEX_CACHE_MAX_ENTRIES, are removed whenever an index is saved.
+ *****************************************************************************/
+#define INDEX_CACHE_KEY_SIZE 40
+#define INDEX_CACHE_MAX_ENTRIES 256
+#define INDEX_CACHE_MAX_AGE (30 * 24 * 3600) /* seconds */
+
+static void PruneIndexCache( const std::string & dir )
+{
+    vlc_DIR *d = vlc_opendir( dir.c_str() );
+    if( d == NULL )
+        return;
+
+    std::vector<std::pair<time_t, std::string>> entries;
+    const time_t now = time( NULL );
+    const char *psz_name;
+
+    while( ( psz_name = vlc_readdir( d ) ) != NULL )
+    {
+        const std::string path = dir + DIR_SEP + psz_name;
+        struct stat st;
+
+        if( psz_name[0] == '.' || vlc_stat( path.c_str(), &st ) ||
+            !S_ISREG( st.st_mode ) )
+            continue;
+
+        /* also catches the temporary files of interrupted saves */
+        if( now - st.st_mtime > INDEX_CACHE_MAX_AGE )
+            vlc_unlink( path.c_str() );
+        else
+            entries.emplace_back( st.st_mtime, path );
+    }
+    vlc_closedir( d );
+
+    if( entries.size() <= INDEX_CACHE_MAX_ENTRIES )
+        return;
+
+    /* oldest first */
+    std::sort( entries.begin(), entries.end() );
+    for( size_t i = 0; i < entries.size() - INDEX_CACHE_MAX_ENTRIES; i++ )
+        vlc_unlink( entries[i].second.c_str() );
+}
+
+bool matroska_segment_c::GetIndexCache( std::string & path, uint8_t *key ) const
+{
+    demux_t & demuxer = sys.demuxer;
+
+    if( !sys.b_seekable || demuxer.psz_filepath == NULL ||
+        sys.streams.empty() || &es != &sys.streams.front()->estream ||
+        !var_InheritBool( &demuxer, "mkv-index-cache" ) )
+        return false;
+
+    struct stat st;
+    if( vlc_stat( demuxer.psz_filepath, &st ) )
+        return false;
+
+    char *psz_cachedir = config_GetUserDir( VLC_CACHE_DIR );
+    if( unlikely( psz_cachedir == NULL ) )
+        return false;
+
+    uint8_t segment_pos[8];
+    SetQWBE( segment_pos, segment->GetElementPosition() );
+
+    vlc_hash_md5_t md5;
+    vlc_hash_md5_Init( &md5 );
+    vlc_hash_md5_Update( &md5, demuxer.psz_filepath, strlen( demuxer.psz_filepath ) );
+    vlc_hash_md5_Update( &md5, segment_pos, sizeof( segment_pos ) );
+
+    uint8_t digest[VLC_HASH_MD5_DIGEST_SIZE];
+    char psz_hash[VLC_HASH_MD5_DIGEST_HEX_SIZE];
+    vlc_hash_md5_Finish( &md5, digest, sizeof( digest ) );
+    vlc_hex_encode_binary( digest, sizeof( digest ), psz_hash );
+
+    path = std::string( psz_cachedir ) + DIR_SEP "mkv" DIR_SEP + psz_hash + ".idx";
+    free( psz_cachedir );
+
+    memcpy( &key[0], "VLCMKVI1", 8 );
+    SetQWBE( &key[8], st.st_size );
+    SetQWBE( &key[16], st.st_mtime );
+    memset( &key[24], 0, 16 );
+    if( p_segment_uid )
+        memcpy( &key[24], p_segment_uid->GetBuffer(),
+                std::min<size_t>( p_segment_uid->GetSize(), 16 ) );
+
+    return true;
+}
+
+void matroska_segment_c::LoadIndexCache()
+{
+    std::string path;
+    uint8_t key[INDEX_CACHE_KEY_SIZE];
+
+    if( !GetIndexCache( path, key ) )
+        return;
+
+    FILE *f = vlc_fopen( path.c_str(), "rb" );
+    if( f == NULL )
+        return;
+
+    uint8_t cached_key[INDEX_CACHE_KEY_SIZE];
+    if( fread( cached_key, sizeof( cached_key ), 1, f ) != 1 ||
+        memcmp( cached_key, key, sizeof( key ) ) )
+        msg_Dbg( &sys.demuxer, "seek index cache %s is outdated", path.c_str() );
+    else if( !_seeker.load_index( f ) )
+        msg_Warn( &sys.demuxer, "cannot load the seek index cache %s", path.c_str() );
+    else
+        msg_Dbg( &sys.demuxer, "seek index loaded from %s", path.c_str() );
+
+    fclose( f );
+}
+
+void matroska_segment_c::SaveIndexCache()
+{
+    std::string path;
+    uint8_t key[INDEX_CACHE_KEY_SIZE];
+
+    /* nothing worth saving if the cues were enough */
+    if( !_seeker._b_scanned || !GetIndexCache( path, key ) )
+        return;
+
+    const std::string dir = path.substr( 0, path.rfind( DIR_SEP_CHAR ) );
+    if( vlc_mkdir_parent( dir.c_str(), 0700 ) )
+        return;
+
+    PruneIndexCache( dir );
+
+    /* write a temporary file of its own, so that a concurrent open never
+     * reads a partial index, and concurrent saves do not mix */
+    std::string tmp_path = path + ".XXXXXX";
+    int fd = vlc_mkstemp( &tmp_path[0] );
+    if( fd == -1 )
+        return;
+
+    FILE *f = fdopen( fd, "wb" );
+    if( f == NULL )
+    {
+        vlc_close( fd );
+        vlc_unlink( tmp_path.c_str() );
+        return;
+    }
+
+    bool ok = fwrite( key, sizeof( key ), 1, f ) == 1 && _seeker.save_index( f );
+    ok = ( fclose( f ) == 0 ) && ok;
+
+    if( ok && vlc_rename( tmp_path.c_str(), path.c_str() ) == 0 )
+        msg_Dbg( &sys.demuxer, "seek index saved to %s", path.c_str() );
+    else
+    {
+        msg_Warn( &sys.demuxer, "cannot save the seek index cache %s", path.c_str() );
+        vlc_unlink( tmp_path.c_str() );
+    }
+}
+
 /* Here we try to load elements that were found in Seek Heads, but not yet parsed */
 bool matroska_segment_c::LoadSeekHeadItem( const EbmlCallbacks & ClassInfos, int64_t i_element_position )
 {
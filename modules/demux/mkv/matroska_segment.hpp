@@ -154,6 +154,8 @@ public:
     bool ESCreate( );
     void ESDestroy( );
 
+    void SaveIndexCache( );
+
     static bool CompareSegmentUIDs( const matroska_segment_c * item_a, const matroska_segment_c * item_b );
 
     bool SameFamily( const matroska_segment_c & of_segment ) const;
@@ -202,6 +204,8 @@ private:
     bool TrackInit( mkv_track_t * p_tk );
     void ComputeTrackPriority();
     bool EnsureDuration(KaxCluster &);
+    bool GetIndexCache( std::string & path, uint8_t *key ) const;
+    void LoadIndexCache( );
 
     SegmentSeeker _seeker;
 
@@ -29,6 +29,7 @@
 #include "stream_io_callback.hpp"
 
 #include <sstream>
+#include <iterator>
 #include <limits>
 
 namespace {
@@ -46,6 +47,33 @@ namespace {
 
     template<class It> It prev_( It it ) { return --it; }
     template<class It> It next_( It it ) { return ++it; }
+
+    // the index cache stores every value as a big endian 64 bits integer
+
+    bool write_u64( FILE *f, uint64_t value )
+    {
+        uint8_t buf[8];
+        SetQWBE( buf, value );
+        return fwrite( buf, sizeof( buf ), 1, f ) == 1;
+    }
+
+    bool read_u64( FILE *f, uint64_t& value )
+    {
+        uint8_t buf[8];
+        if( fread( buf, sizeof( buf ), 1, f ) != 1 )
+            return false;
+        value = GetQWBE( buf );
+        return true;
+    }
+
+    template<class T> bool read_value( FILE *f, T& value )
+    {
+        uint64_t u64;
+        if( !read_u64( f, u64 ) )
+            return false;
+        value = static_cast<T>( u64 );
+        return true;
+    }
 }
 
 namespace mkv {
@@ -348,6 +376,9 @@ SegmentSeeker::index_range( matroska_segment_c& ms, Range search_area, vlc_tick_
 
     for( ranges_t::const_iterator range_it = areas_to_search.begin(); range_it != areas_to_search.end(); ++range_it )
         index_unsearched_range( ms, *range_it, max_pts );
+
+    if( !areas_to_search.empty() )
+        _b_scanned = true;
 }
 
 void
@@ -557,4 +588,145 @@ SegmentSeeker::mkv_jump_to( matroska_segment_c& ms, fptr_t fpos )
         ms.es.I_O().setFilePointer( fpos );
 }
 
+bool
+SegmentSeeker::save_index( FILE *f ) const
+{
+    bool ok = write_u64( f, _ranges_searched.size() );
+    for( ranges_t::const_iterator it = _ranges_searched.begin(); ok && it != _ranges_searched.end(); ++it )
+        ok = write_u64( f, it->start ) && write_u64( f, it->end );
+
+    ok = ok && write_u64( f, _cluster_positions.size() );
+    for( cluster_positions_t::const_iterator it = _cluster_positions.begin(); ok && it != _cluster_positions.end(); ++it )
+        ok = write_u64( f, *it );
+
+    ok = ok && write_u64( f, _clusters.size() );
+    for( cluster_map_t::const_iterator it = _clusters.begin(); ok && it != _clusters.end(); ++it )
+        ok = write_u64( f, it->second.fpos ) && write_u64( f, it->second.pts ) &&
+             write_u64( f, it->second.duration ) && write_u64( f, it->second.size );
+
+    ok = ok && write_u64( f, _tracks_seekpoints.size() );
+    for( tracks_seekpoints_t::const_iterator it = _tracks_seekpoints.begin(); ok && it != _tracks_seekpoints.end(); ++it )
+    {
+        ok = write_u64( f, it->first ) && write_u64( f, it->second.size() );
+        for( seekpoints_t::const_iterator sp = it->second.begin(); ok && sp != it->second.end(); ++sp )
+            ok = write_u64( f, sp->fpos ) && write_u64( f, sp->pts ) &&
+                 write_u64( f, sp->trust_level );
+    }
+
+    return ok;
+}
+
+bool
+SegmentSeeker::load_index( FILE *f )
+{
+    // read everything before merging, to not use a truncated or broken index
+
+    SegmentSeeker index;
+    uint64_t count;
+
+    if( !read_u64( f, count ) )
+        return false;
+    for( ; count > 0; --count )
+    {
+        Range range( 0, 0 );
+        if( !read_value( f, range.start ) || !read_value( f, range.end ) ||
+            range.start > range.end )
+            return false;
+        index._ranges_searched.push_back( range );
+    }
+
+    if( !read_u64( f, count ) )
+        return false;
+    for( ; count > 0; --count )
+    {
+        fptr_t fpos;
+        if( !read_value( f, fpos ) )
+            return false;
+        index._cluster_positions.push_back( fpos );
+    }
+    if( !std::is_sorted( index._cluster_positions.begin(), index._cluster_positions.end() ) )
+        return false;
+
+    if( !read_u64( f, count ) )
+        return false;
+    for( ; count > 0; --count )
+    {
+        Cluster cinfo;
+        if( !read_value( f, cinfo.fpos ) || !read_value( f, cinfo.pts ) ||
+            !read_value( f, cinfo.duration ) || !read_value( f, cinfo.size ) )
+            return false;
+        index._clusters.insert( cluster_map_t::value_type( cinfo.pts, cinfo ) );
+    }
+
+    if( !read_u64( f, count ) )
+        return false;
+    for( ; count > 0; --count )
+    {
+        track_id_t track_id;
+        uint64_t seekpoints_count;
+        if( !read_value( f, track_id ) || !read_u64( f, seekpoints_count ) )
+            return false;
+
+        seekpoints_t& seekpoints = index._tracks_seekpoints[ track_id ];
+        for( ; seekpoints_count > 0; --seekpoints_count )
+        {
+            Seekpoint sp;
+            int64_t trust_level;
+            if( !read_value( f, sp.fpos ) || !read_value( f, sp.pts ) ||
+                !read_value( f, trust_level ) )
+                return false;
+            if( trust_level != Seekpoint::TRUSTED && trust_level != Seekpoint::QUESTIONABLE &&
+                trust_level != Seekpoint::DISABLED )
+                return false;
+            sp.trust_level = static_cast<Seekpoint::TrustLevel>( trust_level );
+            seekpoints.push_back( sp );
+        }
+        if( !std::is_sorted( seekpoints.begin(), seekpoints.end() ) )
+            return false;
+    }
+
+    // merge with what is already known from the cues
+
+    for( ranges_t::const_iterator it = index._ranges_searched.begin(); it != index._ranges_searched.end(); ++it )
+        mark_range_as_searched( *it );
+
+    {
+        cluster_positions_t merged;
+        merged.reserve( _cluster_positions.size() + index._cluster_positions.size() );
+        std::merge( _cluster_positions.begin(), _cluster_positions.end(),
+                    index._cluster_positions.begin(), index._cluster_positions.end(),
+                    std::back_inserter( merged ) );
+        merged.erase( std::unique( merged.begin(), merged.end() ), merged.end() );
+        _cluster_positions = std::move( merged );
+    }
+
+    _clusters.insert( index._clusters.begin(), index._clusters.end() );
+
+    for( tracks_seekpoints_t::const_iterator it = index._tracks_seekpoints.begin(); it != index._tracks_seekpoints.end(); ++it )
+    {
+        seekpoints_t& seekpoints = _tracks_seekpoints[ it->first ];
+        seekpoints_t merged;
+        merged.reserve( seekpoints.size() + it->second.size() );
+        std::merge( seekpoints.begin(), seekpoints.end(),
+                    it->second.begin(), it->second.end(),
+                    std::back_inserter( merged ) );
+
+        // same rules as add_seekpoint(): keep the most trusted duplicate
+        seekpoints.clear();
+        for( seekpoints_t::const_iterator sp = merged.begin(); sp != merged.end(); ++sp )
+        {
+            if( !seekpoints.empty() &&
+                ( seekpoints.back().fpos == sp->fpos || seekpoints.back().pts == sp->pts ) )
+            {
+                if( sp->trust_level > seekpoints.back().trust_level )
+                    seekpoints.back() = *sp;
+            }
+            else
+                seekpoints.push_back( *sp );
+        }
+    }
+
+    return true;
+}
+
 } // namespace
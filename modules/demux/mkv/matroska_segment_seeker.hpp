@@ -29,6 +29,7 @@
 #include <vector>
 #include <map>
 #include <limits>
+#include <cstdio>
 
 namespace mkv {
 
@@ -119,7 +120,11 @@ class SegmentSeeker
         void mark_range_as_searched( Range );
         ranges_t get_search_areas( fptr_t start, fptr_t end ) const;
 
+        bool load_index( FILE * );
+        bool save_index( FILE * ) const;
+
     public:
+        bool                _b_scanned = false; /* ranges were indexed by a scan */
         ranges_t            _ranges_searched;
         tracks_seekpoints_t _tracks_seekpoints;
         cluster_positions_t _cluster_positions;
@@ -82,6 +82,10 @@ vlc_module_begin ()
             N_("Preload clusters"),
             N_("Find all cluster positions by jumping cluster-to-cluster before playback") )
 
+    add_bool( "mkv-index-cache", true,
+            N_("Cache the seek index"),
+            N_("Save the seek index of local files built by scanning their clusters, and reload it on the next open.") )
+
     add_shortcut( "mka", "mkv" )
     add_file_extension("mka")
     add_file_extension("mks")
@@ -304,6 +308,12 @@ static void Close( vlc_object_t *p_this )
             p_segment->ESDestroy();
     }
 
+    if( !p_sys->streams.empty() )
+    {
+        for( matroska_segment_c *p_segment : p_sys->streams.front()->segments )
+            p_segment->SaveIndexCache();
+    }
+
     delete p_sys;
 }
 
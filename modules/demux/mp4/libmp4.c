@@ -3072,11 +3072,171 @@ static void MP4_FreeBox_stsz( MP4_Box_t *p_box )
     free( p_box->data.p_stsz->i_entry_size );
 }
 
+/* Sample size tables from this size are left in the file, and read on demand
+ * with MP4_ReadSampleSizes(), when the stream can seek fast */
+#define MP4_DEFERRED_TABLE_SIZE (256 * 1024)
+
+static bool MP4_CanDeferTable( stream_t *p_stream, const MP4_Box_t *p_box )
+{
+    bool b_fastseek = false;
+    return p_box->i_size >= MP4_DEFERRED_TABLE_SIZE &&
+           vlc_stream_Control( p_stream, STREAM_CAN_FASTSEEK,
+                               &b_fastseek ) == VLC_SUCCESS && b_fastseek;
+}
+
+/* Offset of the entries of a stsz or stz2 box from the start of its payload:
+ * version/flags, sample size or field size, sample count */
+#define MP4_SAMPLE_SIZES_OFFSET 12
+
+static uint64_t MP4_SampleSizesBytes( uint8_t i_field_size,
+                                      uint32_t i_first, uint32_t i_count )
+{
+    return ( ( (uint64_t)i_first + i_count ) * i_field_size + 7 ) / 8
+           - (uint64_t)i_first * i_field_size / 8;
+}
+
+/* p_peek points to the byte holding the size of the sample i_first */
+static void MP4_DecodeSampleSizes( const uint8_t *p_peek, uint8_t i_field_size,
+                                   uint32_t i_first, uint32_t i_count,
+                                   uint32_t *p_sizes )
+{
+    switch( i_field_size )
+    {
+        case 32:
+            for( uint32_t i = 0; i < i_count; i++ )
+                p_sizes[i] = GetDWBE( &p_peek[4 * i] );
+            break;
+        case 16:
+            for( uint32_t i = 0; i < i_count; i++ )
+                p_sizes[i] = GetWBE( &p_peek[2 * i] );
+            break;
+        case 8:
+            for( uint32_t i = 0; i < i_count; i++ )
+                p_sizes[i] = p_peek[i];
+            break;
+        default:
+            vlc_assert( i_field_size == 4 );
+            /* ISO-14496-12: if the sizes do not fill an integral number of
+             * bytes, the last byte is padded with zeros. */
+            for( uint32_t i = 0; i < i_count; i++ )
+            {
+                const uint32_t i_nibble = ( i_first & 1 ) + i;
+                const uint8_t entry = p_peek[i_nibble >> 1];
+                p_sizes[i] = ( i_nibble & 1 ) ? ( entry & 0x0F ) : ( entry >> 4 );
+            }
+            break;
+    }
+}
+
+int MP4_ReadSampleSizes( stream_t *p_stream, const MP4_Box_t *p_box,
+                         uint32_t i_first, uint32_t i_count, uint32_t *p_sizes )
+{
+    const MP4_Box_data_stsz_t *p_stsz = p_box->data.p_stsz;
+
+    if( i_first > p_stsz->i_sample_count ||
+        i_count > p_stsz->i_sample_count - i_first )
+        return VLC_EGENERIC;
+
+    if( p_stsz->i_entry_size != NULL )
+    {
+        memcpy( p_sizes, &p_stsz->i_entry_size[i_first],
+                sizeof(*p_sizes) * i_count );
+        return VLC_SUCCESS;
+    }
+
+    const uint64_t i_size = MP4_SampleSizesBytes( p_stsz->i_field_size,
+                                                  i_first, i_count );
+    if( i_size > SSIZE_MAX )
+        return VLC_EGENERIC;
+
+    uint8_t *p_buff = malloc( i_size );
+    if( unlikely(p_buff == NULL) )
+        return VLC_ENOMEM;
+
+    const uint64_t i_pos = p_box->i_pos + mp4_box_headersize( p_box )
+                         + MP4_SAMPLE_SIZES_OFFSET
+                         + (uint64_t)i_first * p_stsz->i_field_size / 8;
+    if( MP4_Seek( p_stream, i_pos ) != VLC_SUCCESS ||
+        vlc_stream_Read( p_stream, p_buff, i_size ) != (ssize_t)i_size )
+    {
+        free( p_buff );
+        return VLC_EGENERIC;
+    }
+
+    MP4_DecodeSampleSizes( p_buff, p_stsz->i_field_size, i_first, i_count,
+                           p_sizes );
+    free( p_buff );
+    return VLC_SUCCESS;
+}
+
+/* Boxes read from an in-memory stream cannot be read on demand later */
+static int MP4_LoadDeferredTables( stream_t *p_stream, MP4_Box_t *p_box )
+{
+    for( ; p_box != NULL; p_box = p_box->p_next )
+    {
+        if( ( p_box->i_type == ATOM_stsz || p_box->i_type == ATOM_stz2 ) &&
+            p_box->data.p_stsz != NULL && p_box->data.p_stsz->i_sample_size == 0 &&
+            p_box->data.p_stsz->i_sample_count > 0 &&
+            p_box->data.p_stsz->i_entry_size == NULL )
+        {
+            MP4_Box_data_stsz_t *p_stsz = p_box->data.p_stsz;
+            uint32_t *p_sizes = vlc_alloc( p_stsz->i_sample_count,
+                                           sizeof(uint32_t) );
+            if( unlikely(p_sizes == NULL) ||
+                MP4_ReadSampleSizes( p_stream, p_box, 0,
+                                     p_stsz->i_sample_count, p_sizes ) )
+            {
+                free( p_sizes );
+                return VLC_EGENERIC;
+            }
+            p_stsz->i_entry_size = p_sizes;
+        }
+
+        if( MP4_LoadDeferredTables( p_stream, p_box->p_first ) )
+            return VLC_EGENERIC;
+    }
+    return VLC_SUCCESS;
+}
+
+static int MP4_ReadSampleSizesBox( stream_t *p_stream, MP4_Box_t *p_box,
+                                   uint8_t i_field_size, bool b_deferred,
+                                   const uint8_t *p_peek )
+{
+    MP4_Box_data_stsz_t *p_stsz = p_box->data.p_stsz;
+    const uint32_t count = p_stsz->i_sample_count;
+
+    p_stsz->i_field_size = i_field_size;
+    p_stsz->i_entry_size = NULL;
+
+    if( MP4_SampleSizesBytes( i_field_size, 0, count ) >
+        p_box->i_size - mp4_box_headersize( p_box ) - MP4_SAMPLE_SIZES_OFFSET )
+        return 0;
+
+    if( b_deferred || count == 0 )
+    {
+        /* only the header was read */
+        return MP4_Seek( p_stream, p_box->i_pos + p_box->i_size ) ? 0 : 1;
+    }
+
+    p_stsz->i_entry_size = vlc_alloc( count, sizeof(uint32_t) );
+    if( unlikely( p_stsz->i_entry_size == NULL ) )
+        return 0;
+
+    MP4_DecodeSampleSizes( p_peek, i_field_size, 0, count,
+                           p_stsz->i_entry_size );
+    return 1;
+}
+
 static int MP4_ReadBox_stsz( stream_t *p_stream, MP4_Box_t *p_box )
 {
     uint32_t count;
 
-    MP4_READBOX_ENTER( MP4_Box_data_stsz_t, MP4_FreeBox_stsz );
+    const bool b_deferred = MP4_CanDeferTable( p_stream, p_box );
+
+    MP4_READBOX_ENTER_PARTIAL( MP4_Box_data_stsz_t,
+        b_deferred ? mp4_box_headersize( p_box ) + MP4_SAMPLE_SIZES_OFFSET
+                   : p_box->i_size,
+        MP4_FreeBox_stsz );
 
     MP4_GETVERSIONFLAGS( p_box->data.p_stsz );
 
@@ -3086,26 +3246,21 @@ static int MP4_ReadBox_stsz( stream_t *p_stream, MP4_Box_t *p_box )
 
     if( p_box->data.p_stsz->i_sample_size == 0 )
     {
-        if( UINT64_C(4) * count > i_read )
+        if( !MP4_ReadSampleSizesBox( p_stream, p_box, 32, b_deferred, p_peek ) )
             MP4_READBOX_EXIT( 0 );
-
-        p_box->data.p_stsz->i_entry_size =
-            vlc_alloc( count, sizeof(uint32_t) );
-        if( unlikely( !p_box->data.p_stsz->i_entry_size ) )
-            MP4_READBOX_EXIT( 0 );
-
-        for( uint32_t i = 0; i < count; i++ )
-        {
-            MP4_GET4BYTES( p_box->data.p_stsz->i_entry_size[i] );
-        }
     }
     else
+    {
         p_box->data.p_stsz->i_entry_size = NULL;
+        if( b_deferred && MP4_Seek( p_stream, p_box->i_pos + p_box->i_size ) )
+            MP4_READBOX_EXIT( 0 );
+    }
 
 #ifdef MP4_VERBOSE
-    msg_Dbg( p_stream, "read box: \"stsz\" sample-size %d sample-count %d",
+    msg_Dbg( p_stream, "read box: \"stsz\" sample-size %d sample-count %d%s",
                       p_box->data.p_stsz->i_sample_size,
-                      p_box->data.p_stsz->i_sample_count );
+                      p_box->data.p_stsz->i_sample_count,
+                      p_box->data.p_stsz->i_entry_size ? "" : " (deferred)" );
 
 #endif
     MP4_READBOX_EXIT( 1 );
@@ -3116,7 +3271,12 @@ static int MP4_ReadBox_stz2( stream_t *p_stream, MP4_Box_t *p_box )
     uint32_t count;
     uint8_t field_size;
 
-    MP4_READBOX_ENTER( MP4_Box_data_stsz_t, MP4_FreeBox_stsz );
+    const bool b_deferred = MP4_CanDeferTable( p_stream, p_box );
+
+    MP4_READBOX_ENTER_PARTIAL( MP4_Box_data_stsz_t,
+        b_deferred ? mp4_box_headersize( p_box ) + MP4_SAMPLE_SIZES_OFFSET
+                   : p_box->i_size,
+        MP4_FreeBox_stsz );
 
     MP4_GETVERSIONFLAGS( p_box->data.p_stsz );
 
@@ -3131,50 +3291,15 @@ static int MP4_ReadBox_stz2( stream_t *p_stream, MP4_Box_t *p_box )
 
     if( field_size != 4 && field_size != 8 && field_size != 16 )
         MP4_READBOX_EXIT( 0 );
-    if( ( (uint64_t)field_size * count + 7 ) / 8 > i_read )
-        MP4_READBOX_EXIT( 0 );
 
-    p_box->data.p_stsz->i_entry_size =
-            vlc_alloc( count, sizeof(uint32_t) );
-    if( unlikely( p_box->data.p_stsz->i_entry_size == NULL ) )
+    if( !MP4_ReadSampleSizesBox( p_stream, p_box, field_size, b_deferred, p_peek ) )
         MP4_READBOX_EXIT( 0 );
 
-    if( field_size == 16 )
-    {
-        for( uint32_t i = 0; i < count; i++ )
-            MP4_GET2BYTES( p_box->data.p_stsz->i_entry_size[i] );
-    }
-    else if( field_size == 8 )
-    {
-        for( uint32_t i = 0; i < count; i++ )
-            MP4_GET1BYTE( p_box->data.p_stsz->i_entry_size[i] );
-    }
-    else
-    {
-        vlc_assert( field_size == 4 );
-        count &= ~1;
-        for( uint32_t i = 0; i < count; i += 2 )
-        {
-            uint8_t entry;
-            MP4_GET1BYTE( entry );
-            p_box->data.p_stsz->i_entry_size[i] = entry >> 4;
-            p_box->data.p_stsz->i_entry_size[i + 1] = entry & 0x0F;
-        }
-        if( count < p_box->data.p_stsz->i_sample_count )
-        {
-            uint8_t entry;
-            /* ISO-14496-12: if the sizes do not fill an integral number of
-             * bytes, the last byte is padded with zeros.
-             */
-            MP4_GET1BYTE( entry );
-            p_box->data.p_stsz->i_entry_size[count] = entry >> 4;
-        }
-    }
-
 #ifdef MP4_VERBOSE
-    msg_Dbg( p_stream, "read box: \"stz2\" field-size %d sample-count %d",
+    msg_Dbg( p_stream, "read box: \"stz2\" field-size %d sample-count %d%s",
              field_size,
-             p_box->data.p_stsz->i_sample_count );
+             p_box->data.p_stsz->i_sample_count,
+             p_box->data.p_stsz->i_entry_size ? "" : " (deferred)" );
 
 #endif
     MP4_READBOX_EXIT( 1 );
@@ -3656,6 +3781,12 @@ static int MP4_ReadBox_cmov( stream_t *p_stream, MP4_Box_t *p_box )
     /* and read uncompressd moov */
     MP4_Box_t *p_moov =  MP4_ReadBox( p_stream_memory, NULL );
 
+    if( p_moov && MP4_LoadDeferredTables( p_stream_memory, p_moov->p_first ) )
+    {
+        MP4_BoxFree( p_moov );
+        p_moov = NULL;
+    }
+
     vlc_stream_Delete( p_stream_memory );
 
     if( p_moov )
@@ -919,7 +919,9 @@ typedef struct MP4_Box_data_stsz_s
     uint32_t i_sample_size;
     uint32_t i_sample_count;
 
-    uint32_t *i_entry_size; /* array , empty if i_sample_size != 0 */
+    uint8_t  i_field_size; /* bits per entry */
+    uint32_t *i_entry_size; /* array , empty if i_sample_size != 0, or if the
+                               table is left in the file (MP4_ReadSampleSizes) */
 
 } MP4_Box_data_stsz_t;
 
@@ -1887,7 +1889,7 @@ struct MP4_Box_s
                                 on i_type (or i_usertype) */
 };
 
-static inline size_t mp4_box_headersize( MP4_Box_t *p_box )
+static inline size_t mp4_box_headersize( const MP4_Box_t *p_box )
 {
     return 8
         + ( p_box->i_shortsize == 1 ? 8 : 0 )
@@ -1921,6 +1923,17 @@ static const UUID_t PS3DDSBoxUUID = {
  ****************************************************************************/
 int MP4_Seek( stream_t *p_stream, uint64_t i_pos );
 
+/*****************************************************************************
+ * MP4_ReadSampleSizes : read sizes from a stsz or stz2 box
+ *****************************************************************************
+ *  Large tables of fast seekable streams are not loaded with their box:
+ *  i_entry_size is then NULL while i_sample_size is 0, and the sizes of the
+ *  samples [i_first, i_first + i_count[ are read from the stream into
+ *  p_sizes. The stream position is not restored.
+ *****************************************************************************/
+int MP4_ReadSampleSizes( stream_t *, const MP4_Box_t *p_stsz,
+                         uint32_t i_first, uint32_t i_count, uint32_t *p_sizes );
+
 /*****************************************************************************
  * MP4_BoxGetNextChunk : Parse the entire moof box.
  *****************************************************************************
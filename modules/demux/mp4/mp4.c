@@ -125,6 +125,15 @@ typedef struct
     bool         b_fastseekable;
     bool         b_error;        /* unrecoverable */
 
+    struct
+    {
+        bool     b_enabled;     /* read chunks ahead, per track */
+        uint64_t i_next_pos;    /* position after the last sample read */
+        unsigned i_reads;       /* reads from the file */
+        unsigned i_seeks;       /* seeks done */
+        unsigned i_seeks_total; /* seeks needed without read ahead */
+    } readahead;
+
     bool            b_index_probed;     /* mFra sync points index */
     bool            b_fragments_probed; /* moof segments index created */
 
@@ -169,10 +178,12 @@ typedef struct
 
 #define DEMUX_INCREMENT VLC_TICK_FROM_MS(250) /* How far the pcr will go, each round */
 #define DEMUX_TRACK_MAX_PRELOAD VLC_TICK_FROM_SEC(15) /* maximum preloading, to deal with interleaving */
+#define DEMUX_TRACK_READAHEAD   (4 * 1024 * 1024) /* maximum read at once per track, if not interleaved */
 
 #define INVALID_PRELOAD  UINT_MAX
 #define UNKNOWN_DELTA    UINT32_MAX
 #define INVALID_PTS      VLC_TICK_MIN
+#define SAMPLE_SIZES_PAGE 4096 /* sizes read at once from tables left in the file */
 
 #define VLC_DEMUXER_EOS (VLC_DEMUXER_EGENERIC - 1)
 #define VLC_DEMUXER_FATAL (VLC_DEMUXER_EGENERIC - 2)
@@ -1458,6 +1469,7 @@ static int Open( vlc_object_t * p_this )
             msg_Warn( p_demux, "that media doesn't look interleaved, will need to seek");
         else if( i_max_continuity > DEMUX_TRACK_MAX_PRELOAD )
             msg_Warn( p_demux, "that media doesn't look properly interleaved, will need to seek");
+        p_sys->readahead.b_enabled = b_flat || i_max_continuity > DEMUX_TRACK_MAX_PRELOAD;
     }
 
     /* */
@@ -1657,6 +1669,87 @@ static uint64_t OverflowCheck( demux_t *p_demux, mp4_track_t *tk,
     return i_samplessize;
 }
 
+/* Returns the position where to stop reading ahead the chunks of a track: the
+ * next chunk of another selected track, which will be read in its turn */
+static uint64_t MP4_TrackGetReadAheadEnd( demux_sys_t *p_sys, const mp4_track_t *tk,
+                                          uint64_t i_readpos )
+{
+    uint64_t i_end = i_readpos + DEMUX_TRACK_READAHEAD;
+
+    for( unsigned i = 0; i < p_sys->i_tracks; i++ )
+    {
+        const mp4_track_t *cur = &p_sys->track[i];
+        if( cur == tk || !cur->b_ok || !cur->b_selected || MP4_isMetadata( cur ) )
+            continue;
+
+        for( uint32_t i_chunk = cur->i_chunk; i_chunk < cur->i_chunk_count; i_chunk++ )
+        {
+            const uint64_t i_offset = cur->chunk[i_chunk].i_offset;
+            if( i_offset >= i_end )
+                break;
+            if( i_offset > i_readpos )
+            {
+                i_end = i_offset;
+                break;
+            }
+        }
+    }
+
+    return i_end;
+}
+
+/* Reads samples from the chunks buffered for the track. When the samples
+ * are not buffered, reads as much of the following chunks of the track as
+ * possible in one request, instead of seeking between the tracks for every
+ * few samples */
+static block_t * MP4_TrackReadAhead( demux_t *p_demux, mp4_track_t *tk,
+                                     uint64_t i_readpos, uint32_t i_size )
+{
+    demux_sys_t *p_sys = p_demux->p_sys;
+    block_t *p_buffer = tk->p_readahead;
+
+    if( i_readpos != p_sys->readahead.i_next_pos )
+        p_sys->readahead.i_seeks_total++;
+    p_sys->readahead.i_next_pos = i_readpos + i_size;
+
+    if( p_buffer == NULL || i_readpos < tk->i_readahead_pos ||
+        i_readpos + i_size > tk->i_readahead_pos + p_buffer->i_buffer )
+    {
+        if( p_buffer )
+            block_Release( p_buffer );
+        tk->p_readahead = NULL;
+
+        const uint64_t i_end = __MAX( i_readpos + i_size,
+                                      MP4_TrackGetReadAheadEnd( p_sys, tk, i_readpos ) );
+
+        if( vlc_stream_Tell( p_demux->s ) != i_readpos )
+        {
+            if( MP4_Seek( p_demux->s, i_readpos ) != VLC_SUCCESS )
+                return NULL;
+            p_sys->readahead.i_seeks++;
+        }
+
+        p_buffer = vlc_stream_Block( p_demux->s, i_end - i_readpos );
+        if( p_buffer == NULL )
+            return NULL;
+        p_sys->readahead.i_reads++;
+
+        if( p_buffer->i_buffer < i_size )
+        {
+            block_Release( p_buffer );
+            return NULL;
+        }
+        tk->p_readahead = p_buffer;
+        tk->i_readahead_pos = i_readpos;
+    }
+
+    block_t *p_block = block_Alloc( i_size );
+    if( likely(p_block) )
+        memcpy( p_block->p_buffer,
+                &p_buffer->p_buffer[i_readpos - tk->i_readahead_pos], i_size );
+    return p_block;
+}
+
 /*****************************************************************************
  * Demux: read packet and send them to decoders
  *****************************************************************************
@@ -1698,22 +1791,31 @@ static int DemuxTrack( demux_t *p_demux, mp4_track_t *tk, uint64_t i_readpos,
         {
             block_t *p_block;
 
-            if( vlc_stream_Tell( p_demux->s ) != i_readpos )
+            if( p_sys->readahead.b_enabled )
+            {
+                p_block = MP4_TrackReadAhead( p_demux, tk, i_readpos, i_samplessize );
+            }
+            else
             {
-                if( MP4_Seek( p_demux->s, i_readpos ) != VLC_SUCCESS )
+                if( vlc_stream_Tell( p_demux->s ) != i_readpos )
                 {
-                    msg_Warn( p_demux, "track[0x%x] will be disabled (eof?)"
-                                       ": Failed to seek to %"PRIu64,
-                              tk->i_track_ID, i_readpos );
-                    MP4_TrackSelect( p_demux, tk, false );
-                    goto end;
+                    if( MP4_Seek( p_demux->s, i_readpos ) != VLC_SUCCESS )
+                    {
+                        msg_Warn( p_demux, "track[0x%x] will be disabled (eof?)"
+                                           ": Failed to seek to %"PRIu64,
+                                  tk->i_track_ID, i_readpos );
+                        MP4_TrackSelect( p_demux, tk, false );
+                        goto end;
+                    }
                 }
-            }
 
-            i_samplessize = OverflowCheck( p_demux, tk, i_readpos, i_samplessize );
+                i_samplessize = OverflowCheck( p_demux, tk, i_readpos, i_samplessize );
 
-            /* now read pes */
-            if( !(p_block = vlc_stream_Block( p_demux->s, i_samplessize )) )
+                /* now read pes */
+                p_block = vlc_stream_Block( p_demux->s, i_samplessize );
+            }
+
+            if( !p_block )
             {
                 msg_Warn( p_demux, "track[0x%x] will be disabled (eof?)"
                                    ": Failed to read %d bytes sample at %"PRIu64,
@@ -2516,6 +2618,11 @@ static void Close ( vlc_object_t * p_this )
 
     msg_Dbg( p_demux, "freeing all memory" );
 
+    if( p_sys->readahead.b_enabled )
+        msg_Dbg( p_demux, "read ahead: %u reads, %u seeks instead of %u",
+                 p_sys->readahead.i_reads, p_sys->readahead.i_seeks,
+                 p_sys->readahead.i_seeks_total );
+
     FragResetContext( p_sys );
 
     MP4_BoxFree( p_sys->p_root );
@@ -2884,18 +2991,13 @@ static int TrackCreateSamplesIndex( demux_t *p_demux,
     }
     else
     {
-        /* 2: each sample can have a different size */
+        /* 2: each sample can have a different size, use the table of the
+         * box, or read it by pages if it was left in the file */
         p_demux_track->i_sample_size = 0;
-        p_demux_track->p_sample_size =
-            calloc( p_demux_track->i_sample_count, sizeof( uint32_t ) );
-        if( p_demux_track->p_sample_size == NULL )
-            return VLC_ENOMEM;
-
-        for( uint32_t i_sample = 0; i_sample < p_demux_track->i_sample_count; i_sample++ )
-        {
-            p_demux_track->p_sample_size[i_sample] =
-                    stsz->i_entry_size[i_sample];
-        }
+        p_demux_track->p_sample_size = stsz->i_entry_size;
+        p_demux_track->sizes_page.s = p_demux->s;
+        p_demux_track->sizes_page.p_stsz = p_box;
+        p_demux_track->sizes_page.i_count = 0;
     }
 
     if ( p_demux_track->i_chunk_count && p_demux_track->i_sample_size == 0 )
@@ -4146,8 +4248,10 @@ static void MP4_TrackClean( es_out_t *out, mp4_track_t *p_track )
     }
     free( p_track->chunk );
 
-    if( !p_track->i_sample_size )
-        free( p_track->p_sample_size );
+    free( p_track->sizes_page.p_sizes );
+
+    if( p_track->p_readahead )
+        block_Release( p_track->p_readahead );
 
     ASFPacketTrackReset( &p_track->asfinfo );
 
@@ -4180,6 +4284,12 @@ static void MP4_TrackSelect( demux_t *p_demux, mp4_track_t *p_track, bool b_sele
                         p_track->p_es, false );
     }
 
+    if( !b_select && p_track->p_readahead )
+    {
+        block_Release( p_track->p_readahead );
+        p_track->p_readahead = NULL;
+    }
+
     p_track->b_selected = b_select;
 }
 
@@ -4324,6 +4434,55 @@ static inline uint32_t MP4_GetAudioFrameInfo( const mp4_track_t *p_track,
     return i_samples_per_frame;
 }
 
+/* Returns the sizes of the samples [i_first, i_last], or NULL on error */
+static const uint32_t *MP4_TrackGetSampleSizes( mp4_track_t *p_track,
+                                                uint32_t i_first, uint32_t i_last )
+{
+    if( p_track->p_sample_size )
+        return &p_track->p_sample_size[i_first];
+
+    struct mp4_track_sizes_page *p_page = &p_track->sizes_page;
+    if( i_first >= p_page->i_first &&
+        i_last - p_page->i_first < p_page->i_count )
+        return &p_page->p_sizes[i_first - p_page->i_first];
+
+    /* Start the page at the current chunk, so that the position and the
+     * sizes of its samples are always found in the same page */
+    uint32_t i_start = __MIN( i_first,
+                              p_track->chunk[p_track->i_chunk].i_sample_first );
+    uint32_t i_count = __MAX( SAMPLE_SIZES_PAGE, i_last - i_start + 1 );
+    i_count = __MIN( i_count, p_track->i_sample_count - i_start );
+
+    if( i_count > p_page->i_alloc )
+    {
+        uint32_t *p_sizes = vlc_reallocarray( p_page->p_sizes, i_count,
+                                              sizeof(*p_sizes) );
+        if( unlikely(p_sizes == NULL) )
+            return NULL;
+        p_page->p_sizes = p_sizes;
+        p_page->i_alloc = i_count;
+    }
+
+    p_page->i_count = 0;
+    if( MP4_ReadSampleSizes( p_page->s, p_page->p_stsz, i_start, i_count,
+                             p_page->p_sizes ) != VLC_SUCCESS )
+    {
+        msg_Err( p_page->s, "track[0x%x] cannot read sizes of samples %"PRIu32
+                 " to %"PRIu32, p_track->i_track_ID, i_start, i_start + i_count );
+        return NULL;
+    }
+    p_page->i_first = i_start;
+    p_page->i_count = i_count;
+
+    return &p_page->p_sizes[i_first - i_start];
+}
+
+static uint32_t MP4_TrackGetSampleSize( mp4_track_t *p_track, uint32_t i_sample )
+{
+    const uint32_t *p_size = MP4_TrackGetSampleSizes( p_track, i_sample, i_sample );
+    return p_size ? *p_size : 0;
+}
+
 static uint32_t MP4_TrackGetReadSize( mp4_track_t *p_track, uint32_t *pi_nb_samples )
 {
     uint32_t i_size = 0;
@@ -4337,7 +4496,7 @@ static uint32_t MP4_TrackGetReadSize( mp4_track_t *p_track, uint32_t *pi_nb_samp
         *pi_nb_samples = 1;
 
         if( p_track->i_sample_size == 0 ) /* all sizes are different */
-            return p_track->p_sample_size[p_track->i_sample];
+            return MP4_TrackGetSampleSize( p_track, p_track->i_sample );
         else
             return p_track->i_sample_size;
     }
@@ -4375,7 +4534,7 @@ static uint32_t MP4_TrackGetReadSize( mp4_track_t *p_track, uint32_t *pi_nb_samp
         if( p_track->i_sample_size == 0 )
         {
             *pi_nb_samples = 1;
-            return p_track->p_sample_size[p_track->i_sample];
+            return MP4_TrackGetSampleSize( p_track, p_track->i_sample );
         }
 
         /* If we are compressed but not v2 LPCM frames extensions */
@@ -4385,7 +4544,7 @@ static uint32_t MP4_TrackGetReadSize( mp4_track_t *p_track, uint32_t *pi_nb_samp
             if ( p_track->i_sample_size )
                 return p_track->i_sample_size;
             else
-                return p_track->p_sample_size[p_track->i_sample];
+                return MP4_TrackGetSampleSize( p_track, p_track->i_sample );
         }
 
         /* More regular V0 cases */
@@ -4458,12 +4617,15 @@ static uint32_t MP4_TrackGetReadSize( mp4_track_t *p_track, uint32_t *pi_nb_samp
         }
         else /* Compressed */
         {
-            for( uint32_t i=p_track->i_sample;
-                 i<p_chunk->i_sample_first+p_chunk->i_sample_count &&
-                 i<p_track->i_sample_count;
-                 i++ )
+            const uint32_t i_end = __MIN( p_chunk->i_sample_first + p_chunk->i_sample_count,
+                                          p_track->i_sample_count );
+            const uint32_t *p_sizes = p_track->i_sample < i_end
+                ? MP4_TrackGetSampleSizes( p_track, p_track->i_sample, i_end - 1 )
+                : NULL;
+
+            for( uint32_t i=p_track->i_sample; p_sizes && i<i_end; i++ )
             {
-                i_size += p_track->p_sample_size[i];
+                i_size += p_sizes[i - p_track->i_sample];
                 (*pi_nb_samples)++;
 
                 /* Try to detect compression in ISO */
@@ -4515,12 +4677,16 @@ static uint64_t MP4_TrackGetPos( mp4_track_t *p_track )
 
         i_pos += i_samples * (uint64_t) p_track->i_sample_size;
     }
-    else
+    else if( p_track->i_sample > p_track->chunk[p_track->i_chunk].i_sample_first )
     {
-        for( i_sample = p_track->chunk[p_track->i_chunk].i_sample_first;
-             i_sample < p_track->i_sample; i_sample++ )
+        const uint32_t i_first = p_track->chunk[p_track->i_chunk].i_sample_first;
+        const uint32_t *p_sizes =
+            MP4_TrackGetSampleSizes( p_track, i_first, p_track->i_sample - 1 );
+
+        for( i_sample = 0; p_sizes && i_sample < p_track->i_sample - i_first;
+             i_sample++ )
         {
-            i_pos += p_track->p_sample_size[i_sample];
+            i_pos += p_sizes[i_sample];
         }
     }
 
@@ -151,8 +151,20 @@ typedef struct
     /* sample size, p_sample_size defined only if i_sample_size == 0
         else i_sample_size is size for all sample */
     uint32_t         i_sample_size;
-    uint32_t         *p_sample_size; /* XXX perhaps add file offset if take
-//                                    too much time to do sumations each time*/
+    const uint32_t   *p_sample_size; /* stsz table, NULL if read on demand */
+    struct mp4_track_sizes_page
+    {
+        stream_t        *s;
+        const MP4_Box_t *p_stsz;
+        uint32_t        i_first;  /* first sample of the loaded page */
+        uint32_t        i_count;  /* sizes in the loaded page */
+        uint32_t        i_alloc;
+        uint32_t        *p_sizes;
+    } sizes_page;
+
+    /* chunks read ahead, for files needing to seek between tracks */
+    block_t          *p_readahead;
+    uint64_t         i_readahead_pos; /* file position of p_readahead */
 
     const MP4_Box_t *p_track;
     const MP4_Box_t *p_stbl;  /* will contain all timing information */
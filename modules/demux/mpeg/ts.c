@@ -374,6 +374,13 @@ static int Open( vlc_object_t *p_this )
     memset( p_sys, 0, sizeof( demux_sys_t ) );
     vlc_mutex_init( &p_sys->csa_lock );
 
+    p_sys->p_packets = ts_packet_pool_New( i_packet_size );
+    if( !p_sys->p_packets )
+    {
+        free( p_sys );
+        return VLC_ENOMEM;
+    }
+
     p_demux->pf_demux = Demux;
     p_demux->pf_control = Control;
 
@@ -395,6 +402,7 @@ static int Open( vlc_object_t *p_this )
     p_sys->i_packet_size = i_packet_size;
     p_sys->i_packet_header_size = i_packet_header_size;
     p_sys->i_ts_read = 50;
+    p_sys->synced.i_start = p_sys->synced.i_end = 0;
     p_sys->csa = NULL;
     p_sys->b_start_record = false;
     p_sys->record_dir_path = NULL;
@@ -410,12 +418,14 @@ static int Open( vlc_object_t *p_this )
     patpid = GetPID(p_sys, 0);
     if ( !PIDSetup( p_demux, TYPE_PAT, patpid, NULL ) )
     {
+        ts_packet_pool_Delete( p_sys->p_packets );
         free( p_sys );
         return VLC_ENOMEM;
     }
     if( !ts_psi_PAT_Attach( patpid, p_demux ) )
     {
         PIDRelease( p_demux, patpid );
+        ts_packet_pool_Delete( p_sys->p_packets );
         free( p_sys );
         return VLC_EGENERIC;
     }
@@ -589,6 +599,7 @@ static void Close( vlc_object_t *p_this )
     /* Clear up attachments */
     vlc_dictionary_clear( &p_sys->attachments, FreeDictAttachment, NULL );
 
+    ts_packet_pool_Delete( p_sys->p_packets );
     free( p_sys->record_dir_path );
     free( p_sys );
 }
@@ -1153,9 +1164,11 @@ static int Control( demux_t *p_demux, int i_query, va_list args )
     }
 
     case DEMUX_SET_TITLE:
+        p_sys->synced.i_end = p_sys->synced.i_start;
         return vlc_stream_vaControl( p_sys->stream, STREAM_SET_TITLE, args );
 
     case DEMUX_SET_SEEKPOINT:
+        p_sys->synced.i_end = p_sys->synced.i_start;
         return vlc_stream_vaControl( p_sys->stream, STREAM_SET_SEEKPOINT,
                                      args );
 
@@ -1670,7 +1683,7 @@ static void ParsePESDataChain( demux_t *p_demux, ts_pid_t *pid, block_t *p_pes,
         p_pes->i_length = FROM_SCALE_NZ(i_length);
 
         /* Can become a chain on next call due to prepcr */
-        block_t *p_chain = block_ChainGather( p_pes );
+        block_t *p_chain = ts_packet_Detach( block_ChainGather( p_pes ) );
         while ( p_chain ) {
             block_t *p_block = p_chain;
             p_chain = p_chain->p_next;
@@ -1790,20 +1803,32 @@ static bool CheckAndResync( demux_t *p_demux )
 {
     demux_sys_t *p_sys = p_demux->p_sys;
 
+    /* Sync bytes are checked for a whole run of packets at once */
+    const uint64_t i_pos = vlc_stream_Tell( p_sys->stream );
+    if( i_pos >= p_sys->synced.i_start && i_pos < p_sys->synced.i_end &&
+        (i_pos - p_sys->synced.i_start) % p_sys->i_packet_size == 0 )
+        return true;
+
     const uint8_t *p_peek;
-    if( vlc_stream_Peek( p_sys->stream, &p_peek, 1 + p_sys->i_packet_header_size )
-            != 1 + p_sys->i_packet_header_size )
+    ssize_t i_peek = vlc_stream_Peek( p_sys->stream, &p_peek,
+                                      p_sys->i_packet_size * p_sys->i_ts_read );
+    if( i_peek < 1 + p_sys->i_packet_header_size )
         return true;
 
     /* Check sync byte and re-sync if needed */
-    if( p_peek[p_sys->i_packet_header_size] == 0x47 )
+    size_t i_synced = ts_packet_CountSynced( p_peek, i_peek, p_sys->i_packet_size,
+                                             p_sys->i_packet_header_size );
+    if( i_synced > 0 )
+    {
+        p_sys->synced.i_start = i_pos;
+        p_sys->synced.i_end = i_pos + i_synced * p_sys->i_packet_size;
         return true;
+    }
 
     msg_Warn( p_demux, "lost synchro at %" PRIu64, vlc_stream_Tell( p_sys->stream ) );
 
     for( ;; )
     {
-        ssize_t i_peek = 0;
         unsigned i_skip = 0;
 
         i_peek = vlc_stream_Peek( p_sys->stream, &p_peek,
@@ -1841,11 +1866,17 @@ static block_t* ReadTSPacket( demux_t *p_demux )
     if( !CheckAndResync( p_demux) )
         return NULL;
 
-    block_t     *p_pkt;
+    block_t     *p_pkt = ts_packet_pool_Get( p_sys->p_packets );
+    if( unlikely(p_pkt == NULL) )
+        return NULL;
 
     /* Get a new TS packet */
-    if( !( p_pkt = vlc_stream_Block( p_sys->stream, p_sys->i_packet_size ) ) )
+    ssize_t i_read = vlc_stream_Read( p_sys->stream, p_pkt->p_buffer,
+                                      p_sys->i_packet_size );
+    if( i_read <= 0 )
     {
+        block_Release( p_pkt );
+
         uint64_t size;
         if( vlc_stream_GetSize( p_sys->stream, &size ) == VLC_SUCCESS &&
             size == vlc_stream_Tell( p_sys->stream ) )
@@ -1854,6 +1885,7 @@ static block_t* ReadTSPacket( demux_t *p_demux )
             msg_Dbg( p_demux, "Can't read TS packet at %"PRIu64, vlc_stream_Tell(p_sys->stream) );
         return NULL;
     }
+    p_pkt->i_buffer = i_read;
 
     if( p_pkt->i_buffer < TS_HEADER_SIZE + p_sys->i_packet_header_size )
     {
@@ -22,6 +22,8 @@
 
 #include <vlc_arrays.h>
 
+typedef struct ts_packet_pool ts_packet_pool_t;
+
 #ifdef HAVE_ARIBB24
     typedef struct arib_instance_t arib_instance_t;
 #endif
@@ -66,6 +68,16 @@ struct demux_sys_t
     /* how many TS packet we read at once */
     unsigned    i_ts_read;
 
+    /* Packets allocator */
+    ts_packet_pool_t *p_packets;
+
+    /* Stream range where sync bytes were already checked */
+    struct
+    {
+        uint64_t i_start;
+        uint64_t i_end;
+    } synced;
+
     bool        b_cc_check;
     bool        b_ignore_time_for_positions;
 
@@ -0,0 +1,129 @@
+/*****************************************************************************
+ * ts_packet.c : MPEG-TS packet allocator
+ *****************************************************************************
+ * Copyright (C) 2026 - VideoLabs, VideoLAN and VLC authors
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *****************************************************************************/
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <vlc_common.h>
+#include <vlc_block.h>
+#include <vlc_atomic.h>
+
+#include <stdlib.h>
+
+#include "ts_packet.h"
+
+#define TS_PACKET_SLAB_COUNT 32
+
+typedef struct ts_packet_slab ts_packet_slab_t;
+
+typedef struct
+{
+    block_t self;
+    ts_packet_slab_t *p_slab;
+} ts_packet_t;
+
+struct ts_packet_slab
+{
+    vlc_atomic_rc_t rc; /* one per live packet, plus one for the pool */
+    ts_packet_t packets[TS_PACKET_SLAB_COUNT];
+    uint8_t data[];
+};
+
+struct ts_packet_pool
+{
+    size_t i_packet_size;
+    ts_packet_slab_t *p_slab;
+    unsigned i_next;
+};
+
+static void ts_packet_slab_Release( ts_packet_slab_t *p_slab )
+{
+    if( vlc_atomic_rc_dec( &p_slab->rc ) )
+        free( p_slab );
+}
+
+static void ts_packet_Free( block_t *p_block )
+{
+    ts_packet_t *p_pkt = container_of( p_block, ts_packet_t, self );
+
+    ts_packet_slab_Release( p_pkt->p_slab );
+}
+
+static const struct vlc_block_callbacks ts_packet_cbs =
+{
+    ts_packet_Free,
+};
+
+ts_packet_pool_t * ts_packet_pool_New( size_t i_packet_size )
+{
+    ts_packet_pool_t *p_pool = malloc( sizeof(*p_pool) );
+    if( likely(p_pool) )
+    {
+        p_pool->i_packet_size = i_packet_size;
+        p_pool->p_slab = NULL;
+        p_pool->i_next = 0;
+    }
+    return p_pool;
+}
+
+void ts_packet_pool_Delete( ts_packet_pool_t *p_pool )
+{
+    if( p_pool->p_slab )
+        ts_packet_slab_Release( p_pool->p_slab );
+    free( p_pool );
+}
+
+block_t * ts_packet_pool_Get( ts_packet_pool_t *p_pool )
+{
+    if( p_pool->p_slab == NULL || p_pool->i_next == TS_PACKET_SLAB_COUNT )
+    {
+        if( p_pool->p_slab )
+            ts_packet_slab_Release( p_pool->p_slab );
+
+        p_pool->p_slab = malloc( sizeof(ts_packet_slab_t) +
+                                 TS_PACKET_SLAB_COUNT * p_pool->i_packet_size );
+        if( unlikely(p_pool->p_slab == NULL) )
+            return NULL;
+        vlc_atomic_rc_init( &p_pool->p_slab->rc );
+        p_pool->i_next = 0;
+    }
+
+    ts_packet_slab_t *p_slab = p_pool->p_slab;
+    unsigned i = p_pool->i_next++;
+    ts_packet_t *p_pkt = &p_slab->packets[i];
+
+    vlc_atomic_rc_inc( &p_slab->rc );
+    p_pkt->p_slab = p_slab;
+    return block_Init( &p_pkt->self, &ts_packet_cbs,
+                       &p_slab->data[i * p_pool->i_packet_size],
+                       p_pool->i_packet_size );
+}
+
+block_t * ts_packet_Detach( block_t *p_block )
+{
+    if( p_block == NULL || p_block->cbs != &ts_packet_cbs )
+        return p_block;
+
+    block_t *p_dup = block_Duplicate( p_block );
+    if( unlikely(p_dup == NULL) )
+        return p_block;
+
+    block_Release( p_block );
+    return p_dup;
+}
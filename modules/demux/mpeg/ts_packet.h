@@ -69,4 +69,36 @@ static inline ts_90khz_t GetPCR( const block_t *p_pkt )
     return i_pcr;
 }
 
+/* Packet allocator
+ *
+ * TS packets are carved out of slabs holding a few dozen packets, so that
+ * reading a packet needs neither a memory allocation nor a release. A slab
+ * is freed once all of its packets have been released. */
+typedef struct ts_packet_pool ts_packet_pool_t;
+
+ts_packet_pool_t * ts_packet_pool_New( size_t i_packet_size );
+void ts_packet_pool_Delete( ts_packet_pool_t * );
+block_t * ts_packet_pool_Get( ts_packet_pool_t * );
+
+/* Returns a block not backed by a packet slab, copying it if needed.
+ * Use it before handing a single packet down, as it would otherwise keep
+ * its whole slab alive. */
+block_t * ts_packet_Detach( block_t * );
+
+/* Returns how many consecutive packets, starting from the first one,
+ * have a valid sync byte at the given offset */
+static inline size_t ts_packet_CountSynced( const uint8_t *p_buf, size_t i_buf,
+                                            size_t i_packet_size,
+                                            size_t i_header_size )
+{
+    size_t i_count = 0;
+    for( size_t i = i_header_size; i < i_buf; i += i_packet_size )
+    {
+        if( p_buf[i] != 0x47 )
+            break;
+        i_count++;
+    }
+    return i_count;
+}
+
 #endif
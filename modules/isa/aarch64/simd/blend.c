@@ -0,0 +1,297 @@
+/*****************************************************************************
+ * blend.c: AArch64 AdvSIMD video blending functions
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <arm_neon.h>
+
+#include <vlc_common.h>
+#include <vlc_cpu.h>
+#include <vlc_plugin.h>
+#include <vlc_picture.h>
+#include "../../../video_filter/filter_picture.h"
+#include "../../../video_filter/blend.h"
+
+/* Scalar versions, for the remaining samples of each line */
+static inline unsigned div255(unsigned v)
+{
+    return ((v >> 8) + v + 1) >> 8;
+}
+
+static inline unsigned merge(unsigned d, unsigned s, unsigned f)
+{
+    return div255((255 - f) * d + s * f);
+}
+
+static inline unsigned merge10(unsigned d, unsigned s, unsigned a,
+                               unsigned alpha)
+{
+    const unsigned f = div255(alpha * a);
+
+    return f ? merge(d, s * 1023 / 255, f) : d;
+}
+
+/*
+ * 8-bits samples are blended with widening multiplications into 16-bits,
+ * where all the intermediate values fit. 10-bits samples are blended in
+ * 32-bits.
+ */
+static inline uint16x8_t div255_u16(uint16x8_t v)
+{
+    return vshrq_n_u16(vaddq_u16(vsraq_n_u16(v, v, 8), vdupq_n_u16(1)), 8);
+}
+
+static inline uint32x4_t div255_u32(uint32x4_t v)
+{
+    return vshrq_n_u32(vaddq_u32(vsraq_n_u32(v, v, 8), vdupq_n_u32(1)), 8);
+}
+
+static inline uint8x8_t weight8(uint8x8_t a, uint8x8_t alpha)
+{
+    return vmovn_u16(div255_u16(vmull_u8(a, alpha)));
+}
+
+static inline uint8x16_t weight16(uint8x16_t a, uint8x8_t alpha)
+{
+    return vcombine_u8(weight8(vget_low_u8(a), alpha),
+                       weight8(vget_high_u8(a), alpha));
+}
+
+static inline uint8x8_t merge8(uint8x8_t d, uint8x8_t s, uint8x8_t f)
+{
+    uint16x8_t v = vmull_u8(vmvn_u8(f), d);
+
+    return vmovn_u16(div255_u16(vmlal_u8(v, f, s)));
+}
+
+static inline uint8x16_t merge16(uint8x16_t d, uint8x16_t s, uint8x16_t f)
+{
+    return vcombine_u8(merge8(vget_low_u8(d), vget_low_u8(s), vget_low_u8(f)),
+                       merge8(vget_high_u8(d), vget_high_u8(s),
+                              vget_high_u8(f)));
+}
+
+/* s * 1023 / 255 is 4 * s + s / 85 */
+static inline uint16x8_t to10(uint8x8_t s)
+{
+    uint16x8_t w = vmovl_u8(s);
+    uint16x8_t r = vshlq_n_u16(w, 2);
+
+    r = vsubq_u16(r, vcgtq_u16(w, vdupq_n_u16(84)));
+    r = vsubq_u16(r, vcgtq_u16(w, vdupq_n_u16(169)));
+    return vsubq_u16(r, vcgtq_u16(w, vdupq_n_u16(254)));
+}
+
+/* Unlike 8-bits ones, 10-bits samples would be altered by a zero weight */
+static inline uint16x8_t merge10x8(uint16x8_t d, uint16x8_t s, uint8x8_t f8)
+{
+    const uint16x8_t f = vmovl_u8(f8);
+    const uint16x8_t inv = vsubq_u16(vdupq_n_u16(255), f);
+    uint32x4_t lo = vmull_u16(vget_low_u16(inv), vget_low_u16(d));
+    uint32x4_t hi = vmull_u16(vget_high_u16(inv), vget_high_u16(d));
+
+    lo = vmlal_u16(lo, vget_low_u16(f), vget_low_u16(s));
+    hi = vmlal_u16(hi, vget_high_u16(f), vget_high_u16(s));
+
+    uint16x8_t r = vcombine_u16(vmovn_u32(div255_u32(lo)),
+                                vmovn_u32(div255_u32(hi)));
+
+    return vbslq_u16(vceqq_u16(f, vdupq_n_u16(0)), d, r);
+}
+
+static void plane8_neon(uint8_t *dst, const uint8_t *src, const uint8_t *a,
+                        unsigned width, unsigned alpha)
+{
+    const uint8x8_t va = vdup_n_u8(alpha);
+    unsigned x = 0;
+
+    for (; x + 16 <= width; x += 16) {
+        uint8x16_t f = weight16(vld1q_u8(a + x), va);
+
+        vst1q_u8(dst + x, merge16(vld1q_u8(dst + x), vld1q_u8(src + x), f));
+    }
+    for (; x < width; x++)
+        dst[x] = merge(dst[x], src[x], div255(alpha * a[x]));
+}
+
+/* The even samples are de-interleaved by the loads. As the last odd sample
+ * may not be readable, the last vector is left to the scalar loop. */
+static void chroma8_neon(uint8_t *dst, const uint8_t *src, const uint8_t *a,
+                         unsigned width, unsigned alpha)
+{
+    const uint8x8_t va = vdup_n_u8(alpha);
+    unsigned x = 0;
+
+    for (; x + 16 < width; x += 16) {
+        uint8x16_t s = vld2q_u8(src + 2 * x).val[0];
+        uint8x16_t f = weight16(vld2q_u8(a + 2 * x).val[0], va);
+
+        vst1q_u8(dst + x, merge16(vld1q_u8(dst + x), s, f));
+    }
+    for (; x < width; x++)
+        dst[x] = merge(dst[x], src[2 * x], div255(alpha * a[2 * x]));
+}
+
+static void plane10_neon(uint16_t *dst, const uint8_t *src, const uint8_t *a,
+                         unsigned width, unsigned alpha)
+{
+    const uint8x8_t va = vdup_n_u8(alpha);
+    unsigned x = 0;
+
+    for (; x + 8 <= width; x += 8) {
+        uint8x8_t f = weight8(vld1_u8(a + x), va);
+
+        vst1q_u16(dst + x, merge10x8(vld1q_u16(dst + x),
+                                     to10(vld1_u8(src + x)), f));
+    }
+    for (; x < width; x++)
+        dst[x] = merge10(dst[x], src[x], a[x], alpha);
+}
+
+static void chroma10_neon(uint16_t *dst, const uint8_t *src, const uint8_t *a,
+                          unsigned width, unsigned alpha)
+{
+    const uint8x8_t va = vdup_n_u8(alpha);
+    unsigned x = 0;
+
+    for (; x + 8 < width; x += 8) {
+        uint8x8_t s = vld2_u8(src + 2 * x).val[0];
+        uint8x8_t f = weight8(vld2_u8(a + 2 * x).val[0], va);
+
+        vst1q_u16(dst + x, merge10x8(vld1q_u16(dst + x), to10(s), f));
+    }
+    for (; x < width; x++)
+        dst[x] = merge10(dst[x], src[2 * x], a[2 * x], alpha);
+}
+
+static void nv12_neon(uint8_t *dst, const uint8_t *u, const uint8_t *v,
+                      const uint8_t *a, unsigned width, unsigned alpha)
+{
+    const uint8x8_t va = vdup_n_u8(alpha);
+    unsigned x = 0;
+
+    for (; x + 16 < width; x += 16) {
+        uint8x16x2_t d = vld2q_u8(dst + 2 * x);
+        uint8x16_t f = weight16(vld2q_u8(a + 2 * x).val[0], va);
+
+        d.val[0] = merge16(d.val[0], vld2q_u8(u + 2 * x).val[0], f);
+        d.val[1] = merge16(d.val[1], vld2q_u8(v + 2 * x).val[0], f);
+        vst2q_u8(dst + 2 * x, d);
+    }
+    for (; x < width; x++) {
+        const unsigned f = div255(alpha * a[2 * x]);
+
+        dst[2 * x] = merge(dst[2 * x], u[2 * x], f);
+        dst[2 * x + 1] = merge(dst[2 * x + 1], v[2 * x], f);
+    }
+}
+
+/* The pixels are de-interleaved by components, so that each destination
+ * component is blended with the matching source one. */
+static void rgb32_neon(uint8_t *dst, const uint8_t *src, unsigned width,
+                       unsigned alpha, const int offsets[3])
+{
+    const uint8x16_t f = vdupq_n_u8(alpha);
+    unsigned x = 0;
+
+    for (; x + 16 <= width; x += 16) {
+        uint8x16x4_t d = vld4q_u8(dst + 4 * x);
+        const uint8x16x4_t s = vld4q_u8(src + 4 * x);
+
+        for (unsigned c = 0; c < 3; c++)
+            d.val[offsets[c]] = merge16(d.val[offsets[c]], s.val[c], f);
+        vst4q_u8(dst + 4 * x, d);
+    }
+    for (; x < width; x++)
+        for (unsigned c = 0; c < 3; c++) {
+            uint8_t *p = &dst[4 * x + offsets[c]];
+
+            *p = merge(*p, src[4 * x + c], alpha);
+        }
+}
+
+/* The sums wrap around in 16-bits, but the results fit: the luma one is
+ * shifted as unsigned, the chroma ones as signed. */
+static inline void yuv8(uint8x8_t *y, uint8x8_t *u, uint8x8_t *v,
+                        uint8x8_t r, uint8x8_t g, uint8x8_t b)
+{
+    const uint16x8_t round = vdupq_n_u16(128);
+    uint16x8_t t;
+
+    t = vmlal_u8(vmlal_u8(vmull_u8(r, vdup_n_u8(66)), g, vdup_n_u8(129)),
+                 b, vdup_n_u8(25));
+    *y = vadd_u8(vshrn_n_u16(vaddq_u16(t, round), 8), vdup_n_u8(16));
+
+    t = vmlsl_u8(vmlsl_u8(vmlal_u8(round, b, vdup_n_u8(112)),
+                          r, vdup_n_u8(38)), g, vdup_n_u8(74));
+    *u = vadd_u8(vmovn_u16(vreinterpretq_u16_s16(
+                     vshrq_n_s16(vreinterpretq_s16_u16(t), 8))),
+                 vdup_n_u8(128));
+
+    t = vmlsl_u8(vmlsl_u8(vmlal_u8(round, r, vdup_n_u8(112)),
+                          g, vdup_n_u8(94)), b, vdup_n_u8(18));
+    *v = vadd_u8(vmovn_u16(vreinterpretq_u16_s16(
+                     vshrq_n_s16(vreinterpretq_s16_u16(t), 8))),
+                 vdup_n_u8(128));
+}
+
+static void rgba_yuva_neon(uint8_t *y, uint8_t *u, uint8_t *v, uint8_t *a,
+                           const uint8_t *src, unsigned width)
+{
+    unsigned x = 0;
+
+    for (; x + 8 <= width; x += 8) {
+        const uint8x8x4_t p = vld4_u8(src + 4 * x);
+        uint8x8_t vy, vu, vv;
+
+        yuv8(&vy, &vu, &vv, p.val[0], p.val[1], p.val[2]);
+        vst1_u8(y + x, vy);
+        vst1_u8(u + x, vu);
+        vst1_u8(v + x, vv);
+        vst1_u8(a + x, p.val[3]);
+    }
+    for (; x < width; x++) {
+        rgb_to_yuv(&y[x], &u[x], &v[x], src[4 * x], src[4 * x + 1],
+                   src[4 * x + 2]);
+        a[x] = src[4 * x + 3];
+    }
+}
+
+static void Probe(void *data)
+{
+    if (vlc_CPU_ARM_NEON()) {
+        struct blend_functions *const f = data;
+
+        f->plane8 = plane8_neon;
+        f->chroma8 = chroma8_neon;
+        f->plane10 = plane10_neon;
+        f->chroma10 = chroma10_neon;
+        f->nv12 = nv12_neon;
+        f->rgb32 = rgb32_neon;
+        f->rgba_yuva = rgba_yuva_neon;
+    }
+}
+
+vlc_module_begin()
+    set_description("AArch64 AdvSIMD optimisation for video blending")
+    set_cpu_funcs("blend functions", Probe, 10)
+vlc_module_end()
@@ -0,0 +1,679 @@
+/*****************************************************************************
+ * blend.c: x86 SSE4.1 and AVX2 video blending functions
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <immintrin.h>
+
+#include <vlc_common.h>
+#include <vlc_cpu.h>
+#include <vlc_plugin.h>
+#include <vlc_picture.h>
+#include "../../video_filter/filter_picture.h"
+#include "../../video_filter/blend.h"
+
+/* Scalar versions, for the remaining samples of each line */
+static inline unsigned div255(unsigned v)
+{
+    return ((v >> 8) + v + 1) >> 8;
+}
+
+static inline unsigned merge(unsigned d, unsigned s, unsigned f)
+{
+    return div255((255 - f) * d + s * f);
+}
+
+static inline unsigned merge10(unsigned d, unsigned s, unsigned a,
+                               unsigned alpha)
+{
+    const unsigned f = div255(alpha * a);
+
+    return f ? merge(d, s * 1023 / 255, f) : d;
+}
+
+static void rgba_yuva_c(uint8_t *y, uint8_t *u, uint8_t *v, uint8_t *a,
+                        const uint8_t *src, unsigned width)
+{
+    for (unsigned x = 0; x < width; x++, src += 4) {
+        rgb_to_yuv(&y[x], &u[x], &v[x], src[0], src[1], src[2]);
+        a[x] = src[3];
+    }
+}
+
+/*
+ * 8-bits samples are blended in 16-bits lanes, where all the intermediate
+ * values fit. 10-bits samples are blended in 32-bits lanes.
+ */
+VLC_SSE4_1
+static inline __m128i div255_sse(__m128i v)
+{
+    v = _mm_add_epi16(_mm_srli_epi16(v, 8), v);
+    return _mm_srli_epi16(_mm_add_epi16(v, _mm_set1_epi16(1)), 8);
+}
+
+VLC_SSE4_1
+static inline __m128i div255_32_sse(__m128i v)
+{
+    v = _mm_add_epi32(_mm_srli_epi32(v, 8), v);
+    return _mm_srli_epi32(_mm_add_epi32(v, _mm_set1_epi32(1)), 8);
+}
+
+VLC_SSE4_1
+static inline __m128i weight_sse(__m128i a, __m128i alpha)
+{
+    return div255_sse(_mm_mullo_epi16(a, alpha));
+}
+
+VLC_SSE4_1
+static inline __m128i merge_sse(__m128i d, __m128i s, __m128i f)
+{
+    const __m128i inv = _mm_sub_epi16(_mm_set1_epi16(255), f);
+
+    return div255_sse(_mm_add_epi16(_mm_mullo_epi16(inv, d),
+                                    _mm_mullo_epi16(f, s)));
+}
+
+/* Merges 16 bytes, with 8 weights for each half */
+VLC_SSE4_1
+static inline __m128i merge_bytes_sse(__m128i d, __m128i s,
+                                      __m128i f_lo, __m128i f_hi)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lo = merge_sse(_mm_unpacklo_epi8(d, zero),
+                           _mm_unpacklo_epi8(s, zero), f_lo);
+    __m128i hi = merge_sse(_mm_unpackhi_epi8(d, zero),
+                           _mm_unpackhi_epi8(s, zero), f_hi);
+
+    return _mm_packus_epi16(lo, hi);
+}
+
+/* s * 1023 / 255 is 4 * s + s / 85 */
+VLC_SSE4_1
+static inline __m128i to10_sse(__m128i s)
+{
+    __m128i r = _mm_slli_epi16(s, 2);
+
+    r = _mm_sub_epi16(r, _mm_cmpgt_epi16(s, _mm_set1_epi16(84)));
+    r = _mm_sub_epi16(r, _mm_cmpgt_epi16(s, _mm_set1_epi16(169)));
+    return _mm_sub_epi16(r, _mm_cmpgt_epi16(s, _mm_set1_epi16(254)));
+}
+
+/* Unlike 8-bits ones, 10-bits samples would be altered by a zero weight */
+VLC_SSE4_1
+static inline __m128i merge10_sse(__m128i d, __m128i s, __m128i f)
+{
+    const __m128i inv = _mm_sub_epi16(_mm_set1_epi16(255), f);
+    __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi16(d, s),
+                                _mm_unpacklo_epi16(inv, f));
+    __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi16(d, s),
+                                _mm_unpackhi_epi16(inv, f));
+    __m128i r = _mm_packus_epi32(div255_32_sse(lo), div255_32_sse(hi));
+
+    return _mm_blendv_epi8(r, d, _mm_cmpeq_epi16(f, _mm_setzero_si128()));
+}
+
+VLC_SSE4_1
+static void plane8_sse4(uint8_t *dst, const uint8_t *src, const uint8_t *a,
+                        unsigned width, unsigned alpha)
+{
+    const __m128i va = _mm_set1_epi16(alpha);
+    const __m128i zero = _mm_setzero_si128();
+    unsigned x = 0;
+
+    for (; x + 16 <= width; x += 16) {
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + x));
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + x));
+        __m128i w = _mm_loadu_si128((const __m128i *)(a + x));
+
+        _mm_storeu_si128((__m128i *)(dst + x), merge_bytes_sse(d, s,
+                         weight_sse(_mm_unpacklo_epi8(w, zero), va),
+                         weight_sse(_mm_unpackhi_epi8(w, zero), va)));
+    }
+    for (; x < width; x++)
+        dst[x] = merge(dst[x], src[x], div255(alpha * a[x]));
+}
+
+/* The even samples are masked in, as 16-bits values */
+VLC_SSE4_1
+static void chroma8_sse4(uint8_t *dst, const uint8_t *src, const uint8_t *a,
+                         unsigned width, unsigned alpha)
+{
+    const __m128i va = _mm_set1_epi16(alpha);
+    const __m128i even = _mm_set1_epi16(0xFF);
+    const __m128i zero = _mm_setzero_si128();
+    unsigned x = 0;
+
+    /* The last odd sample may not be readable */
+    for (; x + 16 < width; x += 16) {
+        const __m128i *s = (const __m128i *)(src + 2 * x);
+        const __m128i *w = (const __m128i *)(a + 2 * x);
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + x));
+        __m128i lo = merge_sse(_mm_unpacklo_epi8(d, zero),
+                               _mm_and_si128(_mm_loadu_si128(s), even),
+                               weight_sse(_mm_and_si128(_mm_loadu_si128(w),
+                                                        even), va));
+        __m128i hi = merge_sse(_mm_unpackhi_epi8(d, zero),
+                               _mm_and_si128(_mm_loadu_si128(s + 1), even),
+                               weight_sse(_mm_and_si128(_mm_loadu_si128(w + 1),
+                                                        even), va));
+
+        _mm_storeu_si128((__m128i *)(dst + x), _mm_packus_epi16(lo, hi));
+    }
+    for (; x < width; x++)
+        dst[x] = merge(dst[x], src[2 * x], div255(alpha * a[2 * x]));
+}
+
+VLC_SSE4_1
+static void plane10_sse4(uint16_t *dst, const uint8_t *src, const uint8_t *a,
+                         unsigned width, unsigned alpha)
+{
+    const __m128i va = _mm_set1_epi16(alpha);
+    unsigned x = 0;
+
+    for (; x + 8 <= width; x += 8) {
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + x));
+        __m128i s = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)(src + x)));
+        __m128i w = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)(a + x)));
+
+        _mm_storeu_si128((__m128i *)(dst + x),
+                         merge10_sse(d, to10_sse(s), weight_sse(w, va)));
+    }
+    for (; x < width; x++)
+        dst[x] = merge10(dst[x], src[x], a[x], alpha);
+}
+
+VLC_SSE4_1
+static void chroma10_sse4(uint16_t *dst, const uint8_t *src, const uint8_t *a,
+                          unsigned width, unsigned alpha)
+{
+    const __m128i va = _mm_set1_epi16(alpha);
+    const __m128i even = _mm_set1_epi16(0xFF);
+    unsigned x = 0;
+
+    for (; x + 8 < width; x += 8) {
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + x));
+        __m128i s = _mm_and_si128(_mm_loadu_si128((const __m128i *)(src + 2 * x)),
+                                  even);
+        __m128i w = _mm_and_si128(_mm_loadu_si128((const __m128i *)(a + 2 * x)),
+                                  even);
+
+        _mm_storeu_si128((__m128i *)(dst + x),
+                         merge10_sse(d, to10_sse(s), weight_sse(w, va)));
+    }
+    for (; x < width; x++)
+        dst[x] = merge10(dst[x], src[2 * x], a[2 * x], alpha);
+}
+
+/* The U and V samples are interleaved as 16-bits values, like the
+ * destination bytes once unpacked. */
+VLC_SSE4_1
+static void nv12_sse4(uint8_t *dst, const uint8_t *u, const uint8_t *v,
+                      const uint8_t *a, unsigned width, unsigned alpha)
+{
+    const __m128i va = _mm_set1_epi16(alpha);
+    const __m128i even = _mm_set1_epi16(0xFF);
+    unsigned x = 0;
+
+    for (; x + 8 < width; x += 8) {
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + 2 * x));
+        __m128i su = _mm_and_si128(_mm_loadu_si128((const __m128i *)(u + 2 * x)),
+                                   even);
+        __m128i sv = _mm_and_si128(_mm_loadu_si128((const __m128i *)(v + 2 * x)),
+                                   even);
+        __m128i w = weight_sse(_mm_and_si128(
+                        _mm_loadu_si128((const __m128i *)(a + 2 * x)), even), va);
+        __m128i lo = merge_sse(_mm_unpacklo_epi8(d, _mm_setzero_si128()),
+                               _mm_unpacklo_epi16(su, sv),
+                               _mm_unpacklo_epi16(w, w));
+        __m128i hi = merge_sse(_mm_unpackhi_epi8(d, _mm_setzero_si128()),
+                               _mm_unpackhi_epi16(su, sv),
+                               _mm_unpackhi_epi16(w, w));
+
+        _mm_storeu_si128((__m128i *)(dst + 2 * x), _mm_packus_epi16(lo, hi));
+    }
+    for (; x < width; x++) {
+        const unsigned f = div255(alpha * a[2 * x]);
+
+        dst[2 * x] = merge(dst[2 * x], u[2 * x], f);
+        dst[2 * x + 1] = merge(dst[2 * x + 1], v[2 * x], f);
+    }
+}
+
+/* Builds the shuffle of 4 RGBA pixels into the destination byte order, and
+ * the weights of the destination bytes, zero for the padding ones. */
+static void rgb32_setup(uint8_t shuf[16], uint8_t weights[16],
+                        const int offsets[3], unsigned alpha)
+{
+    for (unsigned i = 0; i < 16; i++) {
+        shuf[i] = 0x80;
+        weights[i] = 0;
+    }
+    for (unsigned p = 0; p < 16; p += 4)
+        for (unsigned c = 0; c < 3; c++) {
+            shuf[p + offsets[c]] = p + c;
+            weights[p + offsets[c]] = alpha;
+        }
+}
+
+VLC_SSE4_1
+static void rgb32_sse4(uint8_t *dst, const uint8_t *src, unsigned width,
+                       unsigned alpha, const int offsets[3])
+{
+    uint8_t shuf_bytes[16], weights[16];
+    unsigned x = 0;
+
+    rgb32_setup(shuf_bytes, weights, offsets, alpha);
+
+    const __m128i shuf = _mm_loadu_si128((const __m128i *)shuf_bytes);
+    /* The pattern repeats every pixel, hence for both halves */
+    const __m128i f = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)weights));
+
+    for (; x + 4 <= width; x += 4) {
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + 4 * x));
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + 4 * x));
+
+        _mm_storeu_si128((__m128i *)(dst + 4 * x),
+                         merge_bytes_sse(d, _mm_shuffle_epi8(s, shuf), f, f));
+    }
+    for (; x < width; x++)
+        for (unsigned c = 0; c < 3; c++) {
+            uint8_t *p = &dst[4 * x + offsets[c]];
+
+            *p = merge(*p, src[4 * x + c], alpha);
+        }
+}
+
+VLC_SSE4_1
+static inline void yuv_sse(__m128i *y, __m128i *u, __m128i *v,
+                           __m128i r, __m128i g, __m128i b)
+{
+    const __m128i round = _mm_set1_epi16(128);
+    __m128i t;
+
+    /* The luma sum does not fit in 16-bits signed, but unsigned */
+    t = _mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(66)),
+                      _mm_mullo_epi16(g, _mm_set1_epi16(129)));
+    t = _mm_add_epi16(t, _mm_mullo_epi16(b, _mm_set1_epi16(25)));
+    t = _mm_srli_epi16(_mm_add_epi16(t, round), 8);
+    *y = _mm_add_epi16(t, _mm_set1_epi16(16));
+
+    t = _mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(-38)),
+                      _mm_mullo_epi16(g, _mm_set1_epi16(-74)));
+    t = _mm_add_epi16(t, _mm_mullo_epi16(b, _mm_set1_epi16(112)));
+    t = _mm_srai_epi16(_mm_add_epi16(t, round), 8);
+    *u = _mm_add_epi16(t, round);
+
+    t = _mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(112)),
+                      _mm_mullo_epi16(g, _mm_set1_epi16(-94)));
+    t = _mm_add_epi16(t, _mm_mullo_epi16(b, _mm_set1_epi16(-18)));
+    t = _mm_srai_epi16(_mm_add_epi16(t, round), 8);
+    *v = _mm_add_epi16(t, round);
+}
+
+/* Each 4 pixels are transposed to 4 bytes per component, then the double
+ * words of 2 groups are gathered. */
+VLC_SSE4_1
+static void rgba_yuva_sse4(uint8_t *y, uint8_t *u, uint8_t *v, uint8_t *a,
+                           const uint8_t *src, unsigned width)
+{
+    const __m128i shuf = _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13,
+                                       2, 6, 10, 14, 3, 7, 11, 15);
+    unsigned x = 0;
+
+    for (; x + 8 <= width; x += 8) {
+        __m128i p0 = _mm_loadu_si128((const __m128i *)(src + 4 * x));
+        __m128i p1 = _mm_loadu_si128((const __m128i *)(src + 4 * x + 16));
+        p0 = _mm_shuffle_epi8(p0, shuf);
+        p1 = _mm_shuffle_epi8(p1, shuf);
+
+        __m128i rg = _mm_unpacklo_epi32(p0, p1);
+        __m128i ba = _mm_unpackhi_epi32(p0, p1);
+        __m128i vy, vu, vv;
+
+        yuv_sse(&vy, &vu, &vv, _mm_cvtepu8_epi16(rg),
+                _mm_cvtepu8_epi16(_mm_srli_si128(rg, 8)),
+                _mm_cvtepu8_epi16(ba));
+
+        __m128i yu = _mm_packus_epi16(vy, vu);
+        __m128i vv8 = _mm_packus_epi16(vv, vv);
+
+        _mm_storel_epi64((__m128i *)(y + x), yu);
+        _mm_storel_epi64((__m128i *)(u + x), _mm_srli_si128(yu, 8));
+        _mm_storel_epi64((__m128i *)(v + x), vv8);
+        _mm_storel_epi64((__m128i *)(a + x), _mm_srli_si128(ba, 8));
+    }
+    rgba_yuva_c(y + x, u + x, v + x, a + x, src + 4 * x, width - x);
+}
+
+/*
+ * AVX2 versions: unpacking and packing within 128-bits lanes keep the order
+ * of the samples, other lane crossings are handled where needed.
+ */
+VLC_AVX2
+static inline __m256i div255_avx2(__m256i v)
+{
+    v = _mm256_add_epi16(_mm256_srli_epi16(v, 8), v);
+    return _mm256_srli_epi16(_mm256_add_epi16(v, _mm256_set1_epi16(1)), 8);
+}
+
+VLC_AVX2
+static inline __m256i div255_32_avx2(__m256i v)
+{
+    v = _mm256_add_epi32(_mm256_srli_epi32(v, 8), v);
+    return _mm256_srli_epi32(_mm256_add_epi32(v, _mm256_set1_epi32(1)), 8);
+}
+
+VLC_AVX2
+static inline __m256i weight_avx2(__m256i a, __m256i alpha)
+{
+    return div255_avx2(_mm256_mullo_epi16(a, alpha));
+}
+
+VLC_AVX2
+static inline __m256i merge_avx2(__m256i d, __m256i s, __m256i f)
+{
+    const __m256i inv = _mm256_sub_epi16(_mm256_set1_epi16(255), f);
+
+    return div255_avx2(_mm256_add_epi16(_mm256_mullo_epi16(inv, d),
+                                        _mm256_mullo_epi16(f, s)));
+}
+
+VLC_AVX2
+static inline __m256i merge_bytes_avx2(__m256i d, __m256i s,
+                                       __m256i f_lo, __m256i f_hi)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i lo = merge_avx2(_mm256_unpacklo_epi8(d, zero),
+                            _mm256_unpacklo_epi8(s, zero), f_lo);
+    __m256i hi = merge_avx2(_mm256_unpackhi_epi8(d, zero),
+                            _mm256_unpackhi_epi8(s, zero), f_hi);
+
+    return _mm256_packus_epi16(lo, hi);
+}
+
+VLC_AVX2
+static inline __m256i to10_avx2(__m256i s)
+{
+    __m256i r = _mm256_slli_epi16(s, 2);
+
+    r = _mm256_sub_epi16(r, _mm256_cmpgt_epi16(s, _mm256_set1_epi16(84)));
+    r = _mm256_sub_epi16(r, _mm256_cmpgt_epi16(s, _mm256_set1_epi16(169)));
+    return _mm256_sub_epi16(r, _mm256_cmpgt_epi16(s, _mm256_set1_epi16(254)));
+}
+
+VLC_AVX2
+static inline __m256i merge10_avx2(__m256i d, __m256i s, __m256i f)
+{
+    const __m256i inv = _mm256_sub_epi16(_mm256_set1_epi16(255), f);
+    __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(d, s),
+                                   _mm256_unpacklo_epi16(inv, f));
+    __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(d, s),
+                                   _mm256_unpackhi_epi16(inv, f));
+    __m256i r = _mm256_packus_epi32(div255_32_avx2(lo), div255_32_avx2(hi));
+
+    return _mm256_blendv_epi8(r, d, _mm256_cmpeq_epi16(f,
+                                                _mm256_setzero_si256()));
+}
+
+/* Packs 16 words into 16 bytes */
+VLC_AVX2
+static inline __m128i pack_avx2(__m256i v)
+{
+    return _mm_packus_epi16(_mm256_castsi256_si128(v),
+                            _mm256_extracti128_si256(v, 1));
+}
+
+VLC_AVX2
+static void plane8_avx2(uint8_t *dst, const uint8_t *src, const uint8_t *a,
+                        unsigned width, unsigned alpha)
+{
+    const __m256i va = _mm256_set1_epi16(alpha);
+    const __m256i zero = _mm256_setzero_si256();
+    unsigned x = 0;
+
+    for (; x + 32 <= width; x += 32) {
+        __m256i d = _mm256_loadu_si256((const __m256i *)(dst + x));
+        __m256i s = _mm256_loadu_si256((const __m256i *)(src + x));
+        __m256i w = _mm256_loadu_si256((const __m256i *)(a + x));
+
+        _mm256_storeu_si256((__m256i *)(dst + x), merge_bytes_avx2(d, s,
+                            weight_avx2(_mm256_unpacklo_epi8(w, zero), va),
+                            weight_avx2(_mm256_unpackhi_epi8(w, zero), va)));
+    }
+    plane8_sse4(dst + x, src + x, a + x, width - x, alpha);
+}
+
+VLC_AVX2
+static void chroma8_avx2(uint8_t *dst, const uint8_t *src, const uint8_t *a,
+                         unsigned width, unsigned alpha)
+{
+    const __m256i va = _mm256_set1_epi16(alpha);
+    const __m256i even = _mm256_set1_epi16(0xFF);
+    unsigned x = 0;
+
+    for (; x + 32 < width; x += 32) {
+        const __m256i *s = (const __m256i *)(src + 2 * x);
+        const __m256i *w = (const __m256i *)(a + 2 * x);
+        __m256i d = _mm256_loadu_si256((const __m256i *)(dst + x));
+        __m256i lo = merge_avx2(_mm256_cvtepu8_epi16(_mm256_castsi256_si128(d)),
+                                _mm256_and_si256(_mm256_loadu_si256(s), even),
+                                weight_avx2(_mm256_and_si256(
+                                    _mm256_loadu_si256(w), even), va));
+        __m256i hi = merge_avx2(_mm256_cvtepu8_epi16(
+                                    _mm256_extracti128_si256(d, 1)),
+                                _mm256_and_si256(_mm256_loadu_si256(s + 1), even),
+                                weight_avx2(_mm256_and_si256(
+                                    _mm256_loadu_si256(w + 1), even), va));
+
+        _mm256_storeu_si256((__m256i *)(dst + x),
+            _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0xD8));
+    }
+    chroma8_sse4(dst + x, src + 2 * x, a + 2 * x, width - x, alpha);
+}
+
+VLC_AVX2
+static void plane10_avx2(uint16_t *dst, const uint8_t *src, const uint8_t *a,
+                         unsigned width, unsigned alpha)
+{
+    const __m256i va = _mm256_set1_epi16(alpha);
+    unsigned x = 0;
+
+    for (; x + 16 <= width; x += 16) {
+        __m256i d = _mm256_loadu_si256((const __m256i *)(dst + x));
+        __m256i s = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(src + x)));
+        __m256i w = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(a + x)));
+
+        _mm256_storeu_si256((__m256i *)(dst + x),
+                            merge10_avx2(d, to10_avx2(s), weight_avx2(w, va)));
+    }
+    plane10_sse4(dst + x, src + x, a + x, width - x, alpha);
+}
+
+VLC_AVX2
+static void chroma10_avx2(uint16_t *dst, const uint8_t *src, const uint8_t *a,
+                          unsigned width, unsigned alpha)
+{
+    const __m256i va = _mm256_set1_epi16(alpha);
+    const __m256i even = _mm256_set1_epi16(0xFF);
+    unsigned x = 0;
+
+    for (; x + 16 < width; x += 16) {
+        __m256i d = _mm256_loadu_si256((const __m256i *)(dst + x));
+        __m256i s = _mm256_and_si256(
+                        _mm256_loadu_si256((const __m256i *)(src + 2 * x)), even);
+        __m256i w = _mm256_and_si256(
+                        _mm256_loadu_si256((const __m256i *)(a + 2 * x)), even);
+
+        _mm256_storeu_si256((__m256i *)(dst + x),
+                            merge10_avx2(d, to10_avx2(s), weight_avx2(w, va)));
+    }
+    chroma10_sse4(dst + x, src + 2 * x, a + 2 * x, width - x, alpha);
+}
+
+VLC_AVX2
+static void nv12_avx2(uint8_t *dst, const uint8_t *u, const uint8_t *v,
+                      const uint8_t *a, unsigned width, unsigned alpha)
+{
+    const __m256i va = _mm256_set1_epi16(alpha);
+    const __m256i even = _mm256_set1_epi16(0xFF);
+    unsigned x = 0;
+
+    for (; x + 16 < width; x += 16) {
+        __m256i d = _mm256_loadu_si256((const __m256i *)(dst + 2 * x));
+        __m256i su = _mm256_and_si256(
+                        _mm256_loadu_si256((const __m256i *)(u + 2 * x)), even);
+        __m256i sv = _mm256_and_si256(
+                        _mm256_loadu_si256((const __m256i *)(v + 2 * x)), even);
+        __m256i w = weight_avx2(_mm256_and_si256(
+                        _mm256_loadu_si256((const __m256i *)(a + 2 * x)), even),
+                        va);
+        __m256i lo = merge_avx2(_mm256_unpacklo_epi8(d, _mm256_setzero_si256()),
+                                _mm256_unpacklo_epi16(su, sv),
+                                _mm256_unpacklo_epi16(w, w));
+        __m256i hi = merge_avx2(_mm256_unpackhi_epi8(d, _mm256_setzero_si256()),
+                                _mm256_unpackhi_epi16(su, sv),
+                                _mm256_unpackhi_epi16(w, w));
+
+        _mm256_storeu_si256((__m256i *)(dst + 2 * x),
+                            _mm256_packus_epi16(lo, hi));
+    }
+    nv12_sse4(dst + 2 * x, u + 2 * x, v + 2 * x, a + 2 * x, width - x, alpha);
+}
+
+VLC_AVX2
+static void rgb32_avx2(uint8_t *dst, const uint8_t *src, unsigned width,
+                       unsigned alpha, const int offsets[3])
+{
+    uint8_t shuf_bytes[16], weights[16];
+    unsigned x = 0;
+
+    rgb32_setup(shuf_bytes, weights, offsets, alpha);
+
+    const __m256i shuf = _mm256_broadcastsi128_si256(
+                            _mm_loadu_si128((const __m128i *)shuf_bytes));
+    const __m256i f = _mm256_cvtepu8_epi16(
+                            _mm_loadu_si128((const __m128i *)weights));
+
+    for (; x + 8 <= width; x += 8) {
+        __m256i d = _mm256_loadu_si256((const __m256i *)(dst + 4 * x));
+        __m256i s = _mm256_loadu_si256((const __m256i *)(src + 4 * x));
+
+        _mm256_storeu_si256((__m256i *)(dst + 4 * x),
+                            merge_bytes_avx2(d, _mm256_shuffle_epi8(s, shuf),
+                                             f, f));
+    }
+    rgb32_sse4(dst + 4 * x, src + 4 * x, width - x, alpha, offsets);
+}
+
+VLC_AVX2
+static inline void yuv_avx2(__m256i *y, __m256i *u, __m256i *v,
+                            __m256i r, __m256i g, __m256i b)
+{
+    const __m256i round = _mm256_set1_epi16(128);
+    __m256i t;
+
+    t = _mm256_add_epi16(_mm256_mullo_epi16(r, _mm256_set1_epi16(66)),
+                         _mm256_mullo_epi16(g, _mm256_set1_epi16(129)));
+    t = _mm256_add_epi16(t, _mm256_mullo_epi16(b, _mm256_set1_epi16(25)));
+    t = _mm256_srli_epi16(_mm256_add_epi16(t, round), 8);
+    *y = _mm256_add_epi16(t, _mm256_set1_epi16(16));
+
+    t = _mm256_add_epi16(_mm256_mullo_epi16(r, _mm256_set1_epi16(-38)),
+                         _mm256_mullo_epi16(g, _mm256_set1_epi16(-74)));
+    t = _mm256_add_epi16(t, _mm256_mullo_epi16(b, _mm256_set1_epi16(112)));
+    t = _mm256_srai_epi16(_mm256_add_epi16(t, round), 8);
+    *u = _mm256_add_epi16(t, round);
+
+    t = _mm256_add_epi16(_mm256_mullo_epi16(r, _mm256_set1_epi16(112)),
+                         _mm256_mullo_epi16(g, _mm256_set1_epi16(-94)));
+    t = _mm256_add_epi16(t, _mm256_mullo_epi16(b, _mm256_set1_epi16(-18)));
+    t = _mm256_srai_epi16(_mm256_add_epi16(t, round), 8);
+    *v = _mm256_add_epi16(t, round);
+}
+
+/* As with SSE4.1, but the double words of each 8 pixels are first gathered
+ * into 8 bytes of R, G, B and A. */
+VLC_AVX2
+static void rgba_yuva_avx2(uint8_t *y, uint8_t *u, uint8_t *v, uint8_t *a,
+                           const uint8_t *src, unsigned width)
+{
+    const __m256i shuf = _mm256_setr_epi8(
+        0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15,
+        0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+    const __m256i gather = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    unsigned x = 0;
+
+    for (; x + 16 <= width; x += 16) {
+        __m256i p0 = _mm256_loadu_si256((const __m256i *)(src + 4 * x));
+        __m256i p1 = _mm256_loadu_si256((const __m256i *)(src + 4 * x + 32));
+        p0 = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(p0, shuf), gather);
+        p1 = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(p1, shuf), gather);
+
+        __m128i rg0 = _mm256_castsi256_si128(p0);
+        __m128i rg1 = _mm256_castsi256_si128(p1);
+        __m128i ba0 = _mm256_extracti128_si256(p0, 1);
+        __m128i ba1 = _mm256_extracti128_si256(p1, 1);
+        __m256i vy, vu, vv;
+
+        yuv_avx2(&vy, &vu, &vv,
+                 _mm256_cvtepu8_epi16(_mm_unpacklo_epi64(rg0, rg1)),
+                 _mm256_cvtepu8_epi16(_mm_unpackhi_epi64(rg0, rg1)),
+                 _mm256_cvtepu8_epi16(_mm_unpacklo_epi64(ba0, ba1)));
+
+        _mm_storeu_si128((__m128i *)(y + x), pack_avx2(vy));
+        _mm_storeu_si128((__m128i *)(u + x), pack_avx2(vu));
+        _mm_storeu_si128((__m128i *)(v + x), pack_avx2(vv));
+        _mm_storeu_si128((__m128i *)(a + x), _mm_unpackhi_epi64(ba0, ba1));
+    }
+    rgba_yuva_sse4(y + x, u + x, v + x, a + x, src + 4 * x, width - x);
+}
+
+static void Probe(void *data)
+{
+    struct blend_functions *const f = data;
+
+    if (vlc_CPU_SSE4_1()) {
+        f->plane8 = plane8_sse4;
+        f->chroma8 = chroma8_sse4;
+        f->plane10 = plane10_sse4;
+        f->chroma10 = chroma10_sse4;
+        f->nv12 = nv12_sse4;
+        f->rgb32 = rgb32_sse4;
+        f->rgba_yuva = rgba_yuva_sse4;
+    }
+
+    if (vlc_CPU_AVX2()) {
+        f->plane8 = plane8_avx2;
+        f->chroma8 = chroma8_avx2;
+        f->plane10 = plane10_avx2;
+        f->chroma10 = chroma10_avx2;
+        f->nv12 = nv12_avx2;
+        f->rgb32 = rgb32_avx2;
+        f->rgba_yuva = rgba_yuva_avx2;
+    }
+}
+
+vlc_module_begin()
+    set_subcategory(SUBCAT_VIDEO_VFILTER)
+    set_description("x86 SSE4.1 and AVX2 optimisation for video blending")
+    set_cpu_funcs("blend functions", Probe, 10)
+vlc_module_end()
@@ -0,0 +1,289 @@
+/*****************************************************************************
+ * chroma_yuv.c: x86 AVX2 YUV chroma conversions
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <string.h>
+#include <immintrin.h>
+
+#include <vlc_common.h>
+#include <vlc_plugin.h>
+#include <vlc_filter.h>
+#include <vlc_picture.h>
+#include <vlc_chroma_probe.h>
+#include <vlc_cpu.h>
+
+static int Open (filter_t *);
+
+static void ProbeChroma(vlc_chroma_conv_vec *vec)
+{
+#define PACKED_CHROMAS VLC_CODEC_YUYV, VLC_CODEC_UYVY, VLC_CODEC_YVYU, VLC_CODEC_VYUY
+
+    /* NV12 to I420 and YV12 is already covered by the i420_nv12 converter */
+    vlc_chroma_conv_add_in_outlist(vec, 0.75, VLC_CODEC_NV21, VLC_CODEC_I420,
+        VLC_CODEC_YV12);
+    vlc_chroma_conv_add(vec, 0.75, VLC_CODEC_NV16, VLC_CODEC_I422, false);
+    vlc_chroma_conv_add(vec, 0.75, VLC_CODEC_NV24, VLC_CODEC_I444, false);
+
+    vlc_chroma_conv_add_out_inlist(vec, 0.75, VLC_CODEC_I422, PACKED_CHROMAS);
+    vlc_chroma_conv_add_out_inlist(vec, 0.75, VLC_CODEC_I420, PACKED_CHROMAS);
+}
+
+vlc_module_begin ()
+    set_description (N_("x86 AVX2 video chroma conversions"))
+    set_callback_video_converter(Open, 250)
+    add_submodule()
+        set_callback_chroma_conv_probe(ProbeChroma)
+vlc_module_end ()
+
+/* Semiplanar NV21/16/24 to planar I420/YV12/I422/I444 */
+static void CopyLuma(filter_t *filter, picture_t *src, picture_t *dst)
+{
+    const uint8_t *src_y = src->Y_PIXELS;
+    uint8_t *dst_y = dst->Y_PIXELS;
+
+    for (unsigned y = 0; y < filter->fmt_in.video.i_height;
+         y++, dst_y += dst->Y_PITCH, src_y += src->Y_PITCH)
+        memcpy(dst_y, src_y, filter->fmt_in.video.i_width);
+}
+
+/* Each 128-bits lane is shuffled into 64-bits of U and 64-bits of V, then
+ * the quadwords are gathered per plane. */
+VLC_AVX2
+static void DeinterleaveChroma(uint8_t *dst_u, size_t dst_u_pitch,
+                               uint8_t *dst_v, size_t dst_v_pitch,
+                               const uint8_t *src, size_t src_pitch,
+                               unsigned width, unsigned height)
+{
+    const __m256i shuf = _mm256_setr_epi8(
+        0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15,
+        0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+
+    for (unsigned y = 0; y < height; y++) {
+        unsigned x = 0;
+
+        for (; x + 32 <= width; x += 32) {
+            __m256i a = _mm256_loadu_si256((const __m256i *)(src + 2 * x));
+            __m256i b = _mm256_loadu_si256((const __m256i *)(src + 2 * x + 32));
+
+            a = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(a, shuf), 0xD8);
+            b = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(b, shuf), 0xD8);
+            _mm256_storeu_si256((__m256i *)(dst_u + x),
+                                _mm256_permute2x128_si256(a, b, 0x20));
+            _mm256_storeu_si256((__m256i *)(dst_v + x),
+                                _mm256_permute2x128_si256(a, b, 0x31));
+        }
+
+        for (; x < width; x++) {
+            dst_u[x] = src[2 * x];
+            dst_v[x] = src[2 * x + 1];
+        }
+
+        src += src_pitch;
+        dst_u += dst_u_pitch;
+        dst_v += dst_v_pitch;
+    }
+}
+
+#define SEMIPLANAR_FILTERS(name, h_subsamp, v_subsamp, u, v)              \
+static void name (filter_t *filter, picture_t *src,                       \
+                  picture_t *dst)                                         \
+{                                                                         \
+    CopyLuma (filter, src, dst);                                          \
+    DeinterleaveChroma (dst->p[u].p_pixels, dst->p[u].i_pitch,            \
+                        dst->p[v].p_pixels, dst->p[v].i_pitch,            \
+                        src->p[1].p_pixels, src->p[1].i_pitch,            \
+                        filter->fmt_in.video.i_width  / h_subsamp,        \
+                        filter->fmt_in.video.i_height / v_subsamp);       \
+}                                                                         \
+VIDEO_FILTER_WRAPPER (name)                                               \
+
+SEMIPLANAR_FILTERS (Semiplanar_Planar_420_Swap, 2, 2, V_PLANE, U_PLANE)
+SEMIPLANAR_FILTERS (Semiplanar_Planar_420, 2, 2, U_PLANE, V_PLANE)
+SEMIPLANAR_FILTERS (Semiplanar_Planar_422, 2, 1, U_PLANE, V_PLANE)
+SEMIPLANAR_FILTERS (Semiplanar_Planar_444, 1, 1, U_PLANE, V_PLANE)
+
+/* Packed YUV 4:2:2 to planar YUV 4:2:2 and 4:2:0
+ *
+ * The offsets are those of the components within each pair of pixels.
+ * Each 128-bits lane (8 pixels) is shuffled into 64-bits of Y, 32-bits of U
+ * and 32-bits of V, then double words are gathered per plane. */
+VLC_AVX2
+static void UnpackLine(uint8_t *dst_y, uint8_t *dst_u, uint8_t *dst_v,
+                       const uint8_t *src, unsigned width,
+                       const uint8_t offsets[4])
+{
+    const unsigned y0 = offsets[0], u = offsets[1];
+    const unsigned y1 = offsets[2], v = offsets[3];
+    const __m256i shuf = _mm256_setr_epi8(
+        y0, y1, 4 + y0, 4 + y1, 8 + y0, 8 + y1, 12 + y0, 12 + y1,
+        u, 4 + u, 8 + u, 12 + u, v, 4 + v, 8 + v, 12 + v,
+        y0, y1, 4 + y0, 4 + y1, 8 + y0, 8 + y1, 12 + y0, 12 + y1,
+        u, 4 + u, 8 + u, 12 + u, v, 4 + v, 8 + v, 12 + v);
+    const __m256i gather = _mm256_setr_epi32(0, 1, 4, 5, 2, 6, 3, 7);
+    unsigned x = 0;
+
+    for (; x + 32 <= width; x += 32) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(src + 2 * x));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(src + 2 * x + 32));
+
+        /* Y0-15 | U0-7 V0-7 */
+        a = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(a, shuf), gather);
+        /* Y16-31 | U8-15 V8-15 */
+        b = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(b, shuf), gather);
+
+        _mm256_storeu_si256((__m256i *)(dst_y + x),
+                            _mm256_permute2x128_si256(a, b, 0x20));
+
+        if (dst_u != NULL) {
+            __m256i uv = _mm256_permute4x64_epi64(
+                _mm256_permute2x128_si256(a, b, 0x31), 0xD8);
+
+            _mm_storeu_si128((__m128i *)(dst_u + x / 2),
+                             _mm256_castsi256_si128(uv));
+            _mm_storeu_si128((__m128i *)(dst_v + x / 2),
+                             _mm256_extracti128_si256(uv, 1));
+        }
+    }
+
+    for (; x < width; x += 2) {
+        dst_y[x] = src[2 * x + y0];
+        dst_y[x + 1] = src[2 * x + y1];
+
+        if (dst_u != NULL) {
+            dst_u[x / 2] = src[2 * x + u];
+            dst_v[x / 2] = src[2 * x + v];
+        }
+    }
+}
+
+static void Unpack(filter_t *filter, picture_t *src, picture_t *dst,
+                   const uint8_t offsets[4])
+{
+    const uint8_t *in = src->p[0].p_pixels;
+    uint8_t *out_y = dst->Y_PIXELS;
+    uint8_t *out_u = dst->U_PIXELS;
+    uint8_t *out_v = dst->V_PIXELS;
+    /* Planar 4:2:0 takes the chroma samples of the even lines only */
+    const bool subsampled = filter->fmt_out.video.i_chroma == VLC_CODEC_I420;
+
+    for (unsigned y = 0; y < filter->fmt_in.video.i_height; y++) {
+        const bool chroma = !subsampled || !(y & 1);
+
+        UnpackLine(out_y, chroma ? out_u : NULL, chroma ? out_v : NULL,
+                   in, filter->fmt_in.video.i_width, offsets);
+
+        in += src->p[0].i_pitch;
+        out_y += dst->Y_PITCH;
+        if (chroma) {
+            out_u += dst->U_PITCH;
+            out_v += dst->V_PITCH;
+        }
+    }
+}
+
+#define PACKED_FILTERS(name, y0, u, y1, v)                                \
+static void name (filter_t *filter, picture_t *src,                       \
+                  picture_t *dst)                                         \
+{                                                                         \
+    static const uint8_t offsets[4] = { y0, u, y1, v };                   \
+    Unpack (filter, src, dst, offsets);                                   \
+}                                                                         \
+VIDEO_FILTER_WRAPPER (name)                                               \
+
+PACKED_FILTERS (YUYV_Planar, 0, 1, 2, 3)
+PACKED_FILTERS (UYVY_Planar, 1, 0, 3, 2)
+PACKED_FILTERS (YVYU_Planar, 0, 3, 2, 1)
+PACKED_FILTERS (VYUY_Planar, 1, 2, 3, 0)
+
+static int Open (filter_t *filter)
+{
+    if (!vlc_CPU_AVX2())
+        return VLC_EGENERIC;
+    if ((filter->fmt_in.video.i_width != filter->fmt_out.video.i_width)
+     || (filter->fmt_in.video.i_height != filter->fmt_out.video.i_height))
+        return VLC_EGENERIC;
+
+    const vlc_fourcc_t out = filter->fmt_out.video.i_chroma;
+
+    switch (filter->fmt_in.video.i_chroma)
+    {
+        /* Semiplanar to planar */
+        case VLC_CODEC_NV21:
+            switch (out)
+            {
+                case VLC_CODEC_I420:
+                    filter->ops = &Semiplanar_Planar_420_Swap_ops;
+                    break;
+                case VLC_CODEC_YV12:
+                    filter->ops = &Semiplanar_Planar_420_ops;
+                    break;
+                default:
+                    return VLC_EGENERIC;
+            }
+            break;
+
+        case VLC_CODEC_NV16:
+            if (out != VLC_CODEC_I422)
+                return VLC_EGENERIC;
+            filter->ops = &Semiplanar_Planar_422_ops;
+            break;
+
+        case VLC_CODEC_NV24:
+            if (out != VLC_CODEC_I444)
+                return VLC_EGENERIC;
+            filter->ops = &Semiplanar_Planar_444_ops;
+            break;
+
+        /* Packed to planar */
+        case VLC_CODEC_YUYV:
+        case VLC_CODEC_UYVY:
+        case VLC_CODEC_YVYU:
+        case VLC_CODEC_VYUY:
+            if (out != VLC_CODEC_I422 && out != VLC_CODEC_I420)
+                return VLC_EGENERIC;
+            if ((filter->fmt_in.video.i_width & 1)
+             || (out == VLC_CODEC_I420 && (filter->fmt_in.video.i_height & 1)))
+                return VLC_EGENERIC;
+
+            switch (filter->fmt_in.video.i_chroma)
+            {
+                case VLC_CODEC_YUYV:
+                    filter->ops = &YUYV_Planar_ops;
+                    break;
+                case VLC_CODEC_UYVY:
+                    filter->ops = &UYVY_Planar_ops;
+                    break;
+                case VLC_CODEC_YVYU:
+                    filter->ops = &YVYU_Planar_ops;
+                    break;
+                default:
+                    filter->ops = &VYUY_Planar_ops;
+                    break;
+            }
+            break;
+
+        default:
+            return VLC_EGENERIC;
+    }
+    return VLC_SUCCESS;
+}
@@ -85,6 +85,64 @@ static void Merge16BitSSE2( void *_p_dest, const void *_p_s1, const void *_p_s2,
         *p_dest++ = ( *p_s1++ + *p_s2++ + 1) >> 1;
 }
 
+#ifdef CAN_COMPILE_AVX2
+VLC_AVX
+static void Merge8BitAVX2( void *_p_dest, const void *_p_s1, const void *_p_s2,
+                    size_t i_bytes )
+{
+    uint8_t *p_dest = _p_dest;
+    const uint8_t *p_s1 = _p_s1;
+    const uint8_t *p_s2 = _p_s2;
+
+    for( ; i_bytes > 0 && ((uintptr_t)p_s1 & 31); i_bytes-- )
+        *p_dest++ = ( *p_s1++ + *p_s2++ + 1) >> 1;
+
+    for( ; i_bytes >= 32; i_bytes -= 32 )
+    {
+        __asm__  __volatile__( "vmovdqu %2,%%ymm1;"
+                               "vpavgb %1, %%ymm1, %%ymm1;"
+                               "vmovdqu %%ymm1, %0" :"=m" (*(uint8_t (*)[32])p_dest):
+                                                 "m" (*(const uint8_t (*)[32])p_s1),
+                                                 "m" (*(const uint8_t (*)[32])p_s2) : "xmm1" );
+        p_dest += 32;
+        p_s1 += 32;
+        p_s2 += 32;
+    }
+    asm volatile ("vzeroupper");
+
+    for( ; i_bytes > 0; i_bytes-- )
+        *p_dest++ = ( *p_s1++ + *p_s2++ + 1) >> 1;
+}
+
+VLC_AVX
+static void Merge16BitAVX2( void *_p_dest, const void *_p_s1, const void *_p_s2,
+                     size_t i_bytes )
+{
+    uint16_t *p_dest = _p_dest;
+    const uint16_t *p_s1 = _p_s1;
+    const uint16_t *p_s2 = _p_s2;
+
+    size_t i_words = i_bytes / 2;
+    for( ; i_words > 0 && ((uintptr_t)p_s1 & 31); i_words-- )
+        *p_dest++ = ( *p_s1++ + *p_s2++ + 1) >> 1;
+
+    for( ; i_words >= 16; i_words -= 16 )
+    {
+        __asm__  __volatile__( "vmovdqu %2,%%ymm1;"
+                               "vpavgw %1, %%ymm1, %%ymm1;"
+                               "vmovdqu %%ymm1, %0" :"=m" (*(uint16_t (*)[16])p_dest):
+                                                 "m" (*(const uint16_t (*)[16])p_s1),
+                                                 "m" (*(const uint16_t (*)[16])p_s2) : "xmm1" );
+        p_dest += 16;
+        p_s1 += 16;
+        p_s2 += 16;
+    }
+    asm volatile ("vzeroupper");
+
+    for( ; i_words > 0; i_words-- )
+        *p_dest++ = ( *p_s1++ + *p_s2++ + 1) >> 1;
+}
+#endif
 
 static void Probe(void *data)
 {
@@ -93,6 +151,12 @@ static void Probe(void *data)
 
         f->merges[0] = Merge8BitSSE2;
         f->merges[1] = Merge16BitSSE2;
+#ifdef CAN_COMPILE_AVX2
+        if (vlc_CPU_AVX2()) {
+            f->merges[0] = Merge8BitAVX2;
+            f->merges[1] = Merge16BitAVX2;
+        }
+#endif
     }
 }
 
@@ -0,0 +1,276 @@
+/*****************************************************************************
+ * transform.c: x86 AVX2 video transforms
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <immintrin.h>
+
+#include <vlc_common.h>
+#include <vlc_cpu.h>
+#include <vlc_plugin.h>
+#include "../../video_chroma/orient.h"
+
+/*
+ * Horizontal flips: each row is reversed 32 bytes at a time, from the end.
+ */
+#define HFLIP(bits, reverse) \
+VLC_AVX2 \
+static void hflip_##bits##_avx2(void *restrict dst, ptrdiff_t dst_stride, \
+                                const void *restrict src, \
+                                ptrdiff_t src_stride, int width, int height) \
+{ \
+    const int step = 32 / (bits / 8); \
+\
+    for (int y = 0; y < height; y++) { \
+        const uint##bits##_t *restrict in = \
+            (const void *)((const uint8_t *)src + y * src_stride); \
+        uint##bits##_t *restrict out = \
+            (void *)((uint8_t *)dst + y * dst_stride); \
+        int x = 0; \
+\
+        for (; x + step <= width; x += step) { \
+            __m256i v = _mm256_loadu_si256((const __m256i *)(in + x)); \
+\
+            _mm256_storeu_si256((__m256i *)(out + width - x - step), \
+                                reverse(v)); \
+        } \
+        for (; x < width; x++) \
+            out[width - 1 - x] = in[x]; \
+    } \
+}
+
+VLC_AVX2
+static inline __m256i reverse_8(__m256i v)
+{
+    const __m256i shuf = _mm256_setr_epi8(
+        15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+        15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+
+    return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, shuf), 0x4E);
+}
+
+VLC_AVX2
+static inline __m256i reverse_16(__m256i v)
+{
+    const __m256i shuf = _mm256_setr_epi8(
+        14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1,
+        14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+
+    return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, shuf), 0x4E);
+}
+
+VLC_AVX2
+static inline __m256i reverse_32(__m256i v)
+{
+    return _mm256_permutevar8x32_epi32(v,
+                                   _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+VLC_AVX2
+static inline __m256i reverse_64(__m256i v)
+{
+    return _mm256_permute4x64_epi64(v, 0x1B);
+}
+
+HFLIP(8, reverse_8)
+HFLIP(16, reverse_16)
+HFLIP(32, reverse_32)
+HFLIP(64, reverse_64)
+
+/*
+ * Transpositions: square blocks are transposed in registers, and the
+ * remaining edges pixel per pixel.
+ */
+#define TRANSPOSE(bits, size, block) \
+VLC_AVX2 \
+static void transpose_##bits##_avx2(void *restrict dst, ptrdiff_t dst_stride, \
+                                    const void *restrict src, \
+                                    ptrdiff_t src_stride, \
+                                    int src_width, int src_height) \
+{ \
+    const uint8_t *in = src; \
+    uint8_t *out = dst; \
+    int y = 0; \
+\
+    for (; y + size <= src_height; y += size) { \
+        int x = 0; \
+\
+        for (; x + size <= src_width; x += size) \
+            block(out + x * dst_stride + y * (bits / 8), dst_stride, \
+                  in + y * src_stride + x * (bits / 8), src_stride); \
+\
+        for (; x < src_width; x++) \
+            for (int i = y; i < y + size; i++) \
+                ((uint##bits##_t *)(out + x * dst_stride))[i] = \
+                    ((const uint##bits##_t *)(in + i * src_stride))[x]; \
+    } \
+\
+    for (; y < src_height; y++) \
+        for (int x = 0; x < src_width; x++) \
+            ((uint##bits##_t *)(out + x * dst_stride))[y] = \
+                ((const uint##bits##_t *)(in + y * src_stride))[x]; \
+}
+
+/* 16x16 bytes */
+VLC_AVX2
+static void block_8(uint8_t *dst, ptrdiff_t dst_stride,
+                    const uint8_t *src, ptrdiff_t src_stride)
+{
+    __m128i a[16], b[16];
+
+    for (int i = 0; i < 16; i++)
+        a[i] = _mm_loadu_si128((const __m128i *)(src + i * src_stride));
+
+    for (int i = 0; i < 8; i++) {
+        b[i] = _mm_unpacklo_epi8(a[2 * i], a[2 * i + 1]);
+        b[i + 8] = _mm_unpackhi_epi8(a[2 * i], a[2 * i + 1]);
+    }
+    for (int i = 0; i < 8; i++) {
+        a[i] = _mm_unpacklo_epi16(b[2 * i], b[2 * i + 1]);
+        a[i + 8] = _mm_unpackhi_epi16(b[2 * i], b[2 * i + 1]);
+    }
+    for (int i = 0; i < 8; i++) {
+        b[i] = _mm_unpacklo_epi32(a[2 * i], a[2 * i + 1]);
+        b[i + 8] = _mm_unpackhi_epi32(a[2 * i], a[2 * i + 1]);
+    }
+    for (int i = 0; i < 8; i++) {
+        a[i] = _mm_unpacklo_epi64(b[2 * i], b[2 * i + 1]);
+        a[i + 8] = _mm_unpackhi_epi64(b[2 * i], b[2 * i + 1]);
+    }
+
+    /* Each pass moves one bit of the row index into the column index */
+    static const unsigned char order[16] = {
+        0, 8, 4, 12, 2, 10, 6, 14, 1, 9, 5, 13, 3, 11, 7, 15,
+    };
+
+    for (int i = 0; i < 16; i++)
+        _mm_storeu_si128((__m128i *)(dst + i * dst_stride), a[order[i]]);
+}
+
+/* 8x8 words */
+VLC_AVX2
+static void block_16(uint8_t *dst, ptrdiff_t dst_stride,
+                     const uint8_t *src, ptrdiff_t src_stride)
+{
+    __m128i a[8], b[8];
+
+    for (int i = 0; i < 8; i++)
+        a[i] = _mm_loadu_si128((const __m128i *)(src + i * src_stride));
+
+    for (int i = 0; i < 4; i++) {
+        b[i] = _mm_unpacklo_epi16(a[2 * i], a[2 * i + 1]);
+        b[i + 4] = _mm_unpackhi_epi16(a[2 * i], a[2 * i + 1]);
+    }
+    for (int i = 0; i < 4; i++) {
+        a[i] = _mm_unpacklo_epi32(b[2 * i], b[2 * i + 1]);
+        a[i + 4] = _mm_unpackhi_epi32(b[2 * i], b[2 * i + 1]);
+    }
+    for (int i = 0; i < 4; i++) {
+        b[i] = _mm_unpacklo_epi64(a[2 * i], a[2 * i + 1]);
+        b[i + 4] = _mm_unpackhi_epi64(a[2 * i], a[2 * i + 1]);
+    }
+
+    static const unsigned char order[8] = { 0, 4, 2, 6, 1, 5, 3, 7 };
+
+    for (int i = 0; i < 8; i++)
+        _mm_storeu_si128((__m128i *)(dst + i * dst_stride), b[order[i]]);
+}
+
+/* 8x8 double words */
+VLC_AVX2
+static void block_32(uint8_t *dst, ptrdiff_t dst_stride,
+                     const uint8_t *src, ptrdiff_t src_stride)
+{
+    __m256i a[8], b[8];
+
+    for (int i = 0; i < 8; i++)
+        a[i] = _mm256_loadu_si256((const __m256i *)(src + i * src_stride));
+
+    for (int i = 0; i < 4; i++) {
+        b[i] = _mm256_unpacklo_epi32(a[2 * i], a[2 * i + 1]);
+        b[i + 4] = _mm256_unpackhi_epi32(a[2 * i], a[2 * i + 1]);
+    }
+    for (int i = 0; i < 4; i++) {
+        a[i] = _mm256_unpacklo_epi64(b[2 * i], b[2 * i + 1]);
+        a[i + 4] = _mm256_unpackhi_epi64(b[2 * i], b[2 * i + 1]);
+    }
+    for (int i = 0; i < 4; i++) {
+        b[i] = _mm256_permute2x128_si256(a[2 * i], a[2 * i + 1], 0x20);
+        b[i + 4] = _mm256_permute2x128_si256(a[2 * i], a[2 * i + 1], 0x31);
+    }
+
+    static const unsigned char order[8] = { 0, 2, 1, 3, 4, 6, 5, 7 };
+
+    for (int i = 0; i < 8; i++)
+        _mm256_storeu_si256((__m256i *)(dst + i * dst_stride), b[order[i]]);
+}
+
+/* 4x4 quad words */
+VLC_AVX2
+static void block_64(uint8_t *dst, ptrdiff_t dst_stride,
+                     const uint8_t *src, ptrdiff_t src_stride)
+{
+    __m256i a[4], b[4];
+
+    for (int i = 0; i < 4; i++)
+        a[i] = _mm256_loadu_si256((const __m256i *)(src + i * src_stride));
+
+    b[0] = _mm256_unpacklo_epi64(a[0], a[1]);
+    b[1] = _mm256_unpackhi_epi64(a[0], a[1]);
+    b[2] = _mm256_unpacklo_epi64(a[2], a[3]);
+    b[3] = _mm256_unpackhi_epi64(a[2], a[3]);
+
+    a[0] = _mm256_permute2x128_si256(b[0], b[2], 0x20);
+    a[1] = _mm256_permute2x128_si256(b[1], b[3], 0x20);
+    a[2] = _mm256_permute2x128_si256(b[0], b[2], 0x31);
+    a[3] = _mm256_permute2x128_si256(b[1], b[3], 0x31);
+
+    for (int i = 0; i < 4; i++)
+        _mm256_storeu_si256((__m256i *)(dst + i * dst_stride), a[i]);
+}
+
+TRANSPOSE(8, 16, block_8)
+TRANSPOSE(16, 8, block_16)
+TRANSPOSE(32, 8, block_32)
+TRANSPOSE(64, 4, block_64)
+
+static void Probe(void *data)
+{
+    if (vlc_CPU_AVX2()) {
+        struct plane_transforms *const transforms = data;
+
+        transforms->hflip[0] = hflip_8_avx2;
+        transforms->hflip[1] = hflip_16_avx2;
+        transforms->hflip[2] = hflip_32_avx2;
+        transforms->hflip[3] = hflip_64_avx2;
+        transforms->transpose[0] = transpose_8_avx2;
+        transforms->transpose[1] = transpose_16_avx2;
+        transforms->transpose[2] = transpose_32_avx2;
+        transforms->transpose[3] = transpose_64_avx2;
+    }
+}
+
+vlc_module_begin()
+    set_subcategory(SUBCAT_VIDEO_VFILTER)
+    set_description("x86 AVX2 optimisation for video transform")
+    set_cpu_funcs("video transform", Probe, 10)
+vlc_module_end()
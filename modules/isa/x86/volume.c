@@ -0,0 +1,254 @@
+/*****************************************************************************
+ * volume.c: x86 AVX2 audio volume mixer module
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <math.h>
+#include <stdint.h>
+#include <immintrin.h>
+
+#include <vlc_common.h>
+#include <vlc_plugin.h>
+#include <vlc_cpu.h>
+#include <vlc_aout.h>
+#include <vlc_aout_volume.h>
+
+/* The integer versions use the same fixed point arithmetic as the generic
+ * "integer" mixer, with the same saturation, so that the output is the same
+ * whichever mixer is used. */
+
+VLC_AVX2
+static void AmplifyFloat(audio_volume_t *volume, block_t *block, float amp)
+{
+    float *p = (float *)block->p_buffer;
+    size_t n = block->i_buffer / sizeof (*p);
+    const __m256 mult = _mm256_set1_ps(amp);
+
+    if (amp == 1.f)
+        return;
+
+    for (; n >= 8; n -= 8, p += 8)
+        _mm256_storeu_ps(p, _mm256_mul_ps(_mm256_loadu_ps(p), mult));
+    for (; n > 0; n--, p++)
+        *p *= amp;
+
+    (void) volume;
+}
+
+VLC_AVX2
+static void AmplifyDouble(audio_volume_t *volume, block_t *block, float amp)
+{
+    double *p = (double *)block->p_buffer;
+    size_t n = block->i_buffer / sizeof (*p);
+    const double d = amp;
+    const __m256d mult = _mm256_set1_pd(d);
+
+    if (d == 1.)
+        return;
+
+    for (; n >= 4; n -= 4, p += 4)
+        _mm256_storeu_pd(p, _mm256_mul_pd(_mm256_loadu_pd(p), mult));
+    for (; n > 0; n--, p++)
+        *p *= d;
+
+    (void) volume;
+}
+
+VLC_AVX2
+static void AmplifyInt(audio_volume_t *volume, block_t *block, float amp)
+{
+    int32_t *p = (int32_t *)block->p_buffer;
+    size_t n = block->i_buffer / sizeof (*p);
+    const long mult = lroundf(amp * 0x1.p24f);
+
+    if (mult == (1 << 24))
+        return;
+
+    if (mult >= INT32_MIN && mult <= INT32_MAX)
+    {
+        const __m256i m = _mm256_set1_epi32(mult);
+        const __m256i hi_max = _mm256_set1_epi32(0x7FFFFF);
+        const __m256i hi_min = _mm256_set1_epi32(-0x800000);
+        const __m256i s_max = _mm256_set1_epi32(INT32_MAX);
+        const __m256i s_min = _mm256_set1_epi32(INT32_MIN);
+
+        for (; n >= 8; n -= 8, p += 8)
+        {
+            __m256i x = _mm256_loadu_si256((const __m256i *)p);
+            /* 64-bits products of the even and odd samples */
+            __m256i even = _mm256_mul_epi32(x, m);
+            __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(x, 32), m);
+            /* Bits 24-55 are the result, bits 32-63 tell if it overflows */
+            __m256i res = _mm256_blend_epi32(_mm256_srli_epi64(even, 24),
+                                             _mm256_slli_epi64(odd, 8), 0xAA);
+            __m256i hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32),
+                                            odd, 0xAA);
+
+            res = _mm256_blendv_epi8(res, s_max,
+                                     _mm256_cmpgt_epi32(hi, hi_max));
+            res = _mm256_blendv_epi8(res, s_min,
+                                     _mm256_cmpgt_epi32(hi_min, hi));
+            _mm256_storeu_si256((__m256i *)p, res);
+        }
+    }
+
+    for (; n > 0; n--, p++)
+    {
+        int_fast64_t s = (*p * (int_fast64_t)mult) >> INT64_C(24);
+        if (s > INT32_MAX)
+            s = INT32_MAX;
+        else
+        if (s < INT32_MIN)
+            s = INT32_MIN;
+        *p = s;
+    }
+    (void) volume;
+}
+
+VLC_AVX2
+static void AmplifyShort(audio_volume_t *volume, block_t *block, float amp)
+{
+    int16_t *p = (int16_t *)block->p_buffer;
+    size_t n = block->i_buffer / sizeof (*p);
+    const long mult = lroundf(amp * 0x1.p8f);
+
+    if (mult == (1 << 8))
+        return;
+
+    /* Products must fit in 32 bits */
+    if (mult >= INT16_MIN && mult <= INT16_MAX)
+    {
+        const __m256i m = _mm256_set1_epi32(mult);
+
+        for (; n >= 16; n -= 16, p += 16)
+        {
+            __m128i lo = _mm_loadu_si128((const __m128i *)p);
+            __m128i hi = _mm_loadu_si128((const __m128i *)(p + 8));
+            __m256i a = _mm256_cvtepi16_epi32(lo);
+            __m256i b = _mm256_cvtepi16_epi32(hi);
+
+            a = _mm256_srai_epi32(_mm256_mullo_epi32(a, m), 8);
+            b = _mm256_srai_epi32(_mm256_mullo_epi32(b, m), 8);
+            /* Saturating pack, interleaved by 128-bits lane */
+            a = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8);
+            _mm256_storeu_si256((__m256i *)p, a);
+        }
+    }
+
+    for (; n > 0; n--, p++)
+    {
+        int_fast32_t s = (*p * (int_fast32_t)mult) >> 8;
+        if (s > INT16_MAX)
+            s = INT16_MAX;
+        else
+        if (s < INT16_MIN)
+            s = INT16_MIN;
+        *p = s;
+    }
+    (void) volume;
+}
+
+VLC_AVX2
+static void AmplifyByte(audio_volume_t *volume, block_t *block, float amp)
+{
+    uint8_t *p = block->p_buffer;
+    size_t n = block->i_buffer;
+    const long mult = lroundf(amp * 0x1.p8f);
+
+    if (mult == (1 << 8))
+        return;
+
+    if (mult >= -0x7FFFFF && mult <= 0x7FFFFF)
+    {
+        const __m256i m = _mm256_set1_epi32(mult);
+        const __m128i bias = _mm_set1_epi8(-128);
+
+        for (; n >= 16; n -= 16, p += 16)
+        {
+            __m128i x = _mm_xor_si128(_mm_loadu_si128((const __m128i *)p),
+                                      bias);
+            __m256i a = _mm256_cvtepi8_epi32(x);
+            __m256i b = _mm256_cvtepi8_epi32(_mm_srli_si128(x, 8));
+
+            a = _mm256_srai_epi32(_mm256_mullo_epi32(a, m), 8);
+            b = _mm256_srai_epi32(_mm256_mullo_epi32(b, m), 8);
+            a = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8);
+            x = _mm_packs_epi16(_mm256_castsi256_si128(a),
+                                _mm256_extracti128_si256(a, 1));
+            _mm_storeu_si128((__m128i *)p, _mm_xor_si128(x, bias));
+        }
+    }
+
+    for (; n > 0; n--, p++)
+    {
+        int_fast32_t s = (((int_fast8_t)(*p - 128)) * (int_fast32_t)mult) >> 8;
+        if (s > INT8_MAX)
+            s = INT8_MAX;
+        else
+        if (s < INT8_MIN)
+            s = INT8_MIN;
+        *p = s + 128;
+    }
+    (void) volume;
+}
+
+static int Probe(vlc_object_t *obj)
+{
+    audio_volume_t *volume = (audio_volume_t *)obj;
+
+    if (!vlc_CPU_AVX2())
+        return VLC_ENOTSUP;
+
+    switch (volume->format) {
+        case VLC_CODEC_FL32:
+            volume->amplify = AmplifyFloat;
+            break;
+
+        case VLC_CODEC_FL64:
+            volume->amplify = AmplifyDouble;
+            break;
+
+        case VLC_CODEC_S16N:
+            volume->amplify = AmplifyShort;
+            break;
+
+        case VLC_CODEC_S32N:
+            volume->amplify = AmplifyInt;
+            break;
+
+        case VLC_CODEC_U8:
+            volume->amplify = AmplifyByte;
+            break;
+
+        default:
+            return VLC_ENOTSUP;
+    }
+
+    return VLC_SUCCESS;
+}
+
+vlc_module_begin()
+    set_subcategory(SUBCAT_AUDIO_AFILTER)
+    set_description("x86 AVX2 optimisation for audio volume")
+    set_capability("audio volume", 20)
+    set_callback(Probe)
+vlc_module_end()
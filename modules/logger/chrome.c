@@ -0,0 +1,527 @@
+/*****************************************************************************
+ * chrome.c: Chrome/Perfetto trace event tracer plugin
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+/*
+ * Traces are written in the Trace Event Format, which both chrome://tracing
+ * and ui.perfetto.dev can open:
+ *  - "begin"/"end" traces become nested spans of the emitting thread,
+ *  - "event" traces become instant events,
+ *  - traces with a "flow" are linked by elementary stream id and pts, so that
+ *    a block can be followed from the demuxer to the display,
+ *  - other traces become counters.
+ *
+ * Each trace is formatted on the stack of the emitting thread, then copied
+ * into a buffer written to the file by a dedicated thread. If the file can't
+ * keep up, traces are dropped rather than blocking the emitting thread.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <vlc_common.h>
+#include <vlc_configuration.h>
+#include <vlc_plugin.h>
+#include <vlc_fs.h>
+#include <vlc_charset.h>
+#include <vlc_tracer.h>
+
+#include <assert.h>
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+
+#define CHROME_FILENAME "vlc-trace.json"
+
+/* Maximum size of a single formatted trace */
+#define CHROME_EVENT_SIZE 1024
+#define CHROME_BUFFER_SIZE (256 * 1024)
+
+struct chrome_buffer
+{
+    size_t size;
+    char data[CHROME_BUFFER_SIZE];
+};
+
+typedef struct
+{
+    vlc_object_t *obj;
+    FILE *stream;
+
+    vlc_mutex_t lock;
+    vlc_cond_t wait;
+    struct chrome_buffer buffers[2];
+    struct chrome_buffer *current; /* being filled */
+    struct chrome_buffer *pending; /* being written, or NULL */
+    bool stopping;
+    unsigned long dropped;
+
+    vlc_thread_t thread;
+} vlc_tracer_sys_t;
+
+struct chrome_event
+{
+    char *p;
+    char *end;
+};
+
+static void PutRaw(struct chrome_event *ev, const char *str, size_t len)
+{
+    if (ev->p == NULL)
+        return;
+    if ((size_t)(ev->end - ev->p) < len)
+    {
+        /* Mark the event as truncated */
+        ev->p = ev->end = NULL;
+        return;
+    }
+    memcpy(ev->p, str, len);
+    ev->p += len;
+}
+
+#define PutLiteral(ev, str) PutRaw(ev, str, sizeof (str) - 1)
+
+static void PutUnsigned(struct chrome_event *ev, uint64_t value)
+{
+    char buf[20];
+    size_t i = sizeof (buf);
+
+    do
+        buf[--i] = '0' + value % 10;
+    while ((value /= 10) != 0);
+
+    PutRaw(ev, &buf[i], sizeof (buf) - i);
+}
+
+static void PutInteger(struct chrome_event *ev, int64_t value)
+{
+    if (value < 0)
+    {
+        PutLiteral(ev, "-");
+        PutUnsigned(ev, -(uint64_t)value);
+    }
+    else
+        PutUnsigned(ev, value);
+}
+
+/* Written by hand, as the formatting must not depend on the locale */
+static void PutDouble(struct chrome_event *ev, double value)
+{
+    if (!isfinite(value) || fabs(value) >= 1e18)
+    {
+        PutLiteral(ev, "null");
+        return;
+    }
+
+    if (value < 0)
+    {
+        PutLiteral(ev, "-");
+        value = -value;
+    }
+
+    uint64_t micros = llround(value * 1e6);
+    char frac[7];
+
+    PutUnsigned(ev, micros / 1000000);
+    micros %= 1000000;
+    for (int i = 5; i >= 0; i--, micros /= 10)
+        frac[i + 1] = '0' + micros % 10;
+    frac[0] = '.';
+    PutRaw(ev, frac, sizeof (frac));
+}
+
+static void PutStringContent(struct chrome_event *ev, const char *str)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    for (;;)
+    {
+        /* Copy the characters not needing escaping at once */
+        const char *run = str;
+        while ((unsigned char)*str >= 0x20 && *str != 0x7F &&
+               *str != '"' && *str != '\\')
+            str++;
+        PutRaw(ev, run, str - run);
+
+        const unsigned char c = *str;
+
+        if (c == '\0')
+            break;
+        if (c == '"' || c == '\\')
+        {
+            char esc[2] = { '\\', c };
+            PutRaw(ev, esc, 2);
+        }
+        else
+        {
+            char esc[6] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF] };
+            PutRaw(ev, esc, 6);
+        }
+        str++;
+    }
+}
+
+static void PutString(struct chrome_event *ev, const char *str)
+{
+    PutLiteral(ev, "\"");
+    if (str == NULL)
+        ;
+    else if (IsUTF8(str))
+        PutStringContent(ev, str);
+    else
+        PutLiteral(ev, "invalid string");
+    PutLiteral(ev, "\"");
+}
+
+static void PutValue(struct chrome_event *ev,
+                     const struct vlc_tracer_entry *entry)
+{
+    switch (entry->type)
+    {
+        case VLC_TRACER_UINT:
+            PutUnsigned(ev, entry->value.uinteger);
+            break;
+        case VLC_TRACER_INT:
+            PutInteger(ev, entry->value.integer);
+            break;
+        case VLC_TRACER_DOUBLE:
+            PutDouble(ev, entry->value.double_);
+            break;
+        case VLC_TRACER_STRING:
+            PutString(ev, entry->value.string);
+            break;
+        default:
+            vlc_assert_unreachable();
+    }
+}
+
+static const char *GetString(const struct vlc_tracer_entry *entry)
+{
+    if (entry == NULL || entry->type != VLC_TRACER_STRING)
+        return NULL;
+    return entry->value.string;
+}
+
+/* Identifies the journey of a block, from its stream id and pts */
+static uint64_t FlowId(const char *id, const struct vlc_tracer_entry *pts)
+{
+    uint64_t hash = UINT64_C(0xcbf29ce484222325); /* FNV-1a */
+
+    if (id != NULL)
+        for (const char *p = id; *p != '\0'; p++)
+            hash = (hash ^ (unsigned char)*p) * UINT64_C(0x100000001b3);
+
+    uint64_t value = pts->value.uinteger;
+    for (int i = 0; i < 8; i++, value >>= 8)
+        hash = (hash ^ (value & 0xFF)) * UINT64_C(0x100000001b3);
+    return hash;
+}
+
+static void FormatTrace(struct chrome_event *ev, vlc_tick_t ts,
+                        const struct vlc_tracer_trace *trace)
+{
+    const struct vlc_tracer_entry *type = NULL, *id = NULL, *begin = NULL,
+                                  *end = NULL, *event = NULL, *stream = NULL,
+                                  *flow = NULL, *pts = NULL;
+    bool has_number = false;
+
+    for (const struct vlc_tracer_entry *entry = trace->entries;
+         entry->key != NULL; entry++)
+    {
+        if (!strcmp(entry->key, "type"))
+            type = entry;
+        else if (!strcmp(entry->key, "id"))
+            id = entry;
+        else if (!strcmp(entry->key, "begin"))
+            begin = entry;
+        else if (!strcmp(entry->key, "end"))
+            end = entry;
+        else if (!strcmp(entry->key, "event"))
+            event = entry;
+        else if (!strcmp(entry->key, "stream"))
+            stream = entry;
+        else if (!strcmp(entry->key, "flow"))
+            flow = entry;
+        else if (!strcmp(entry->key, "pts"))
+            pts = entry;
+
+        if (entry->type != VLC_TRACER_STRING)
+            has_number = true;
+    }
+
+    /* Spans and instant events are named after their action, counters after
+     * the stream they measure, which keeps each stream in its own track */
+    const char *name;
+    char phase;
+
+    if (begin != NULL)
+    {
+        phase = 'B';
+        name = GetString(begin);
+    }
+    else if (end != NULL)
+    {
+        phase = 'E';
+        name = GetString(end);
+    }
+    else if (event != NULL)
+    {
+        phase = 'i';
+        name = GetString(event);
+    }
+    else if (flow != NULL || stream != NULL)
+    {
+        phase = 'X';
+        name = GetString(stream);
+    }
+    else if (has_number)
+    {
+        phase = 'C';
+        name = GetString(id) != NULL ? GetString(id) : GetString(type);
+    }
+    else
+    {
+        phase = 'i';
+        name = GetString(type);
+    }
+
+    const char *cat = GetString(type) != NULL ? GetString(type) : "vlc";
+
+    PutLiteral(ev, ",\n{\"name\":\"");
+    if (phase == 'X')
+    {
+        PutStringContent(ev, cat);
+        PutLiteral(ev, " ");
+    }
+    if (name != NULL && IsUTF8(name))
+        PutStringContent(ev, name);
+    PutLiteral(ev, "\",\"cat\":");
+    PutString(ev, cat);
+    PutLiteral(ev, ",\"ph\":\"");
+    PutRaw(ev, &phase, 1);
+    PutLiteral(ev, "\",\"pid\":1,\"tid\":");
+    PutUnsigned(ev, vlc_thread_id());
+    PutLiteral(ev, ",\"ts\":");
+    PutInteger(ev, US_FROM_VLC_TICK(ts));
+
+    if (phase == 'X')
+        PutLiteral(ev, ",\"dur\":0");
+    else if (phase == 'i')
+        PutLiteral(ev, ",\"s\":\"t\"");
+
+    const char *flow_step = GetString(flow);
+    if (flow_step != NULL && pts != NULL && (phase == 'B' || phase == 'X'))
+    {
+        static const char hex[] = "0123456789abcdef";
+        uint64_t flow_id = FlowId(GetString(id), pts);
+        char buf[18] = { '0', 'x' };
+
+        for (int i = 17; i >= 2; i--, flow_id >>= 4)
+            buf[i] = hex[flow_id & 0xF];
+        PutLiteral(ev, ",\"bind_id\":\"");
+        PutRaw(ev, buf, sizeof (buf));
+        PutLiteral(ev, "\"");
+
+        if (strcmp(flow_step, "start"))
+            PutLiteral(ev, ",\"flow_in\":true");
+        if (strcmp(flow_step, "end"))
+            PutLiteral(ev, ",\"flow_out\":true");
+    }
+
+    if (phase != 'E')
+    {
+        bool first = true;
+
+        PutLiteral(ev, ",\"args\":{");
+        for (const struct vlc_tracer_entry *entry = trace->entries;
+             entry->key != NULL; entry++)
+        {
+            /* Counters can only plot numbers */
+            if (phase == 'C' && entry->type == VLC_TRACER_STRING)
+                continue;
+
+            if (!first)
+                PutLiteral(ev, ",");
+            first = false;
+            PutString(ev, entry->key);
+            PutLiteral(ev, ":");
+            PutValue(ev, entry);
+        }
+        PutLiteral(ev, "}");
+    }
+    PutLiteral(ev, "}");
+}
+
+static void Trace(void *opaque, vlc_tick_t ts,
+                  const struct vlc_tracer_trace *trace)
+{
+    vlc_tracer_sys_t *sys = opaque;
+    char buf[CHROME_EVENT_SIZE];
+    struct chrome_event ev = { buf, buf + sizeof (buf) };
+
+    FormatTrace(&ev, ts, trace);
+
+    vlc_mutex_lock(&sys->lock);
+    if (ev.p == NULL)
+    {
+        sys->dropped++;
+        goto out;
+    }
+
+    size_t len = ev.p - buf;
+    struct chrome_buffer *buffer = sys->current;
+
+    if (buffer->size + len > sizeof (buffer->data))
+    {
+        if (sys->pending != NULL)
+        {
+            /* Both buffers are full: the file is too slow */
+            sys->dropped++;
+            goto out;
+        }
+
+        sys->pending = buffer;
+        vlc_cond_signal(&sys->wait);
+
+        buffer = sys->current = &sys->buffers[buffer == sys->buffers];
+        assert(buffer->size == 0);
+    }
+
+    memcpy(buffer->data + buffer->size, buf, len);
+    buffer->size += len;
+out:
+    vlc_mutex_unlock(&sys->lock);
+}
+
+static void *Thread(void *data)
+{
+    vlc_tracer_sys_t *sys = data;
+
+    vlc_thread_set_name("vlc-tracer");
+
+    vlc_mutex_lock(&sys->lock);
+    for (;;)
+    {
+        while (sys->pending == NULL && !sys->stopping)
+            vlc_cond_wait(&sys->wait, &sys->lock);
+
+        struct chrome_buffer *buffer = sys->pending;
+        if (buffer == NULL)
+            break;
+
+        vlc_mutex_unlock(&sys->lock);
+        fwrite(buffer->data, 1, buffer->size, sys->stream);
+        buffer->size = 0;
+        vlc_mutex_lock(&sys->lock);
+
+        sys->pending = NULL;
+    }
+    vlc_mutex_unlock(&sys->lock);
+
+    return NULL;
+}
+
+static void Close(void *opaque)
+{
+    vlc_tracer_sys_t *sys = opaque;
+
+    vlc_mutex_lock(&sys->lock);
+    sys->stopping = true;
+    vlc_cond_signal(&sys->wait);
+    vlc_mutex_unlock(&sys->lock);
+    vlc_join(sys->thread, NULL);
+
+    /* No more traces can be emitted */
+    fwrite(sys->current->data, 1, sys->current->size, sys->stream);
+    fputs("\n]\n", sys->stream);
+    fclose(sys->stream);
+
+    if (sys->dropped > 0)
+        msg_Warn(sys->obj, "%lu traces dropped", sys->dropped);
+    free(sys);
+}
+
+static const struct vlc_tracer_operations chrome_ops =
+{
+    Trace,
+    Close
+};
+
+static const struct vlc_tracer_operations *Open(vlc_object_t *obj,
+                                               void **restrict sysp)
+{
+    vlc_tracer_sys_t *sys = malloc(sizeof (*sys));
+    if (unlikely(sys == NULL))
+        return NULL;
+
+    char *path = var_InheritString(obj, "chrome-tracer-file");
+    const char *filename = path != NULL ? path : CHROME_FILENAME;
+
+    /* The file holds a single JSON array, so it can't be appended to */
+    msg_Dbg(obj, "opening trace file `%s'", filename);
+    sys->stream = vlc_fopen(filename, "wt");
+    if (sys->stream == NULL)
+    {
+        msg_Err(obj, "error opening trace file `%s': %s", filename,
+                vlc_strerror_c(errno));
+        free(path);
+        free(sys);
+        return NULL;
+    }
+    free(path);
+
+    fputs("[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+          "\"args\":{\"name\":\"vlc\"}}", sys->stream);
+
+    sys->obj = obj;
+    vlc_mutex_init(&sys->lock);
+    vlc_cond_init(&sys->wait);
+    sys->buffers[0].size = sys->buffers[1].size = 0;
+    sys->current = &sys->buffers[0];
+    sys->pending = NULL;
+    sys->stopping = false;
+    sys->dropped = 0;
+
+    if (vlc_clone(&sys->thread, Thread, sys))
+    {
+        fclose(sys->stream);
+        free(sys);
+        return NULL;
+    }
+
+    *sysp = sys;
+    return &chrome_ops;
+}
+
+#define TRACEFILE_NAME_TEXT N_("Trace filename")
+#define TRACEFILE_NAME_LONGTEXT N_( \
+    "Specify the trace filename. It can be opened with chrome://tracing " \
+    "or ui.perfetto.dev.")
+
+vlc_module_begin()
+    set_shortname(N_("Chrome tracer"))
+    set_description(N_("Chrome/Perfetto trace event tracer"))
+    set_subcategory(SUBCAT_ADVANCED_MISC)
+    set_capability("tracer", 0)
+    set_callback(Open)
+
+    add_savefile("chrome-tracer-file", NULL, TRACEFILE_NAME_TEXT,
+                 TRACEFILE_NAME_LONGTEXT)
+vlc_module_end()
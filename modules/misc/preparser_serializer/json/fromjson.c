@@ -1107,7 +1107,15 @@ fromJSON_input_attachment(struct serdes_sys *sys,
         return;
     }
     ssize_t ret = 0;
-    ret = serdes_buf_read(sys, data, i_data, false);
+    if (json_get(obj, "i_shm_offset") != NULL) {
+        uint64_t offset = 0;
+        json_object_to_uint64(obj, "i_shm_offset", &offset, &err);
+        if (!err && serdes_shm_read(sys, offset, data, i_data) == VLC_SUCCESS) {
+            ret = i_data;
+        }
+    } else {
+        ret = serdes_buf_read(sys, data, i_data, false);
+    }
     if ((size_t)ret == i_data) {
         (*a)->i_data = i_data;
         free((*a)->p_data);
@@ -1206,30 +1214,26 @@ fromJSON_plane(struct serdes_sys *sys, const struct json_object *obj,
         return;
     }
 
+    /* The plane has the same layout as the serialized one: copy the pixels
+     * in place */
     size_t size = lines * pitch;
-    void *data = malloc(size);
-    if (data == NULL) {
-        *error = true;
+    if (json_get(obj, "i_shm_offset") != NULL) {
+        uint64_t offset = 0;
+        json_object_to_uint64(obj, "i_shm_offset", &offset, &err);
+        if (err || serdes_shm_read(sys, offset, p->p_pixels, size)
+                   != VLC_SUCCESS) {
+            *error = true;
+        }
         return;
     }
-    ssize_t ret = 0;
-    ret = serdes_buf_read(sys, data, size, false);
+
+    ssize_t ret = serdes_buf_read(sys, p->p_pixels, size, false);
     if (ret < 0) {
         sys->error = ret;
         *error = true;
     } else if ((size_t)ret != size) {
         *error = true;
     }
-
-    plane_t pln;
-    pln.i_lines = p->i_lines;
-    pln.i_pitch = p->i_pitch;
-    pln.i_pixel_pitch = p->i_pixel_pitch;
-    pln.i_visible_lines = p->i_visible_lines;
-    pln.i_visible_pitch = p->i_visible_pitch;
-    pln.p_pixels = data;
-    plane_CopyPixels(p, &pln);
-    free(data);
 }
 
 static void
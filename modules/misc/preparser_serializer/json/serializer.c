@@ -14,6 +14,11 @@
 #include <assert.h>
 #include <limits.h>
 #include <stdckdint.h>
+#ifndef _WIN32
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
 
 #include <vlc_common.h>
 #include <vlc_plugin.h>
@@ -263,6 +268,174 @@ serdes_buf_read(struct serdes_sys *sys, void *_data, size_t size, bool eod)
     }
 }
 
+/****************************************************************************
+ * serdes shared memory
+ *****************************************************************************/
+
+/* Granularity of the shared memory file growth */
+#define SERDES_SHM_ALIGN ((size_t)1 << 20)
+
+#ifndef _WIN32
+static void
+serdes_shm_Unmap(struct serdes_sys *sys)
+{
+    if (sys->shm.base != NULL) {
+        munmap(sys->shm.base, sys->shm.size);
+    }
+    sys->shm.base = NULL;
+    sys->shm.size = 0;
+}
+
+/**
+ * Map the first `size` bytes of the shared memory file.
+ */
+static int
+serdes_shm_Map(struct serdes_sys *sys, const struct stat *st, size_t size)
+{
+    serdes_shm_Unmap(sys);
+
+    void *base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                      sys->parent->owner.shm_fd, 0);
+    if (base == MAP_FAILED) {
+        return VLC_EGENERIC;
+    }
+    sys->shm.base = base;
+    sys->shm.size = size;
+    sys->shm.dev = st->st_dev;
+    sys->shm.ino = st->st_ino;
+    return VLC_SUCCESS;
+}
+
+/**
+ * Start a new message, dropping the mapping if the owner changed the file.
+ */
+static void
+serdes_shm_Reset(struct serdes_sys *sys)
+{
+    sys->shm.used = 0;
+    if (sys->shm.base == NULL) {
+        return;
+    }
+
+    int fd = sys->parent->owner.shm_fd;
+    struct stat st;
+    if (fd == -1 || fstat(fd, &st) != 0 || st.st_dev != sys->shm.dev
+     || st.st_ino != sys->shm.ino) {
+        serdes_shm_Unmap(sys);
+    }
+}
+
+/**
+ * Copy binary data to the shared memory.
+ *
+ * @return VLC_SUCCESS, or an error code if the data must be written inline.
+ */
+int
+serdes_shm_write(struct serdes_sys *sys, const void *data, size_t size,
+                 uint64_t *offset)
+{
+    assert(sys != NULL);
+    assert(offset != NULL);
+
+    int fd = sys->parent->owner.shm_fd;
+    if (fd == -1 || size < SERDES_SHM_MIN_SIZE) {
+        return VLC_EGENERIC;
+    }
+
+    size_t end;
+    if (ckd_add(&end, sys->shm.used, size)) {
+        return VLC_EGENERIC;
+    }
+    if (end > sys->shm.size) {
+        size_t cap;
+        if (ckd_add(&cap, end, SERDES_SHM_ALIGN - 1)) {
+            return VLC_EGENERIC;
+        }
+        cap &= ~(SERDES_SHM_ALIGN - 1);
+
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            return VLC_EGENERIC;
+        }
+        if ((uintmax_t)st.st_size < cap) {
+            if (ftruncate(fd, cap) != 0) {
+                return VLC_EGENERIC;
+            }
+        }
+        if (serdes_shm_Map(sys, &st, cap) != VLC_SUCCESS) {
+            return VLC_EGENERIC;
+        }
+    }
+
+    memcpy(sys->shm.base + sys->shm.used, data, size);
+    *offset = sys->shm.used;
+    sys->shm.used = end;
+    return VLC_SUCCESS;
+}
+
+/**
+ * Copy binary data from the shared memory.
+ */
+int
+serdes_shm_read(struct serdes_sys *sys, uint64_t offset, void *data,
+                size_t size)
+{
+    assert(sys != NULL);
+
+    int fd = sys->parent->owner.shm_fd;
+    if (fd == -1) {
+        return VLC_EGENERIC;
+    }
+
+    uint64_t end;
+    if (ckd_add(&end, offset, size)) {
+        return VLC_EGENERIC;
+    }
+    if (end > sys->shm.size) {
+        /* The writer grew the file */
+        struct stat st;
+        if (fstat(fd, &st) != 0 || (uintmax_t)st.st_size < end
+         || (uintmax_t)st.st_size > SIZE_MAX) {
+            return VLC_EGENERIC;
+        }
+        if (serdes_shm_Map(sys, &st, st.st_size) != VLC_SUCCESS) {
+            return VLC_EGENERIC;
+        }
+    }
+
+    memcpy(data, sys->shm.base + offset, size);
+    return VLC_SUCCESS;
+}
+#else /* _WIN32 */
+static void
+serdes_shm_Unmap(struct serdes_sys *sys)
+{
+    VLC_UNUSED(sys);
+}
+
+static void
+serdes_shm_Reset(struct serdes_sys *sys)
+{
+    sys->shm.used = 0;
+}
+
+int
+serdes_shm_write(struct serdes_sys *sys, const void *data, size_t size,
+                 uint64_t *offset)
+{
+    VLC_UNUSED(sys); VLC_UNUSED(data); VLC_UNUSED(size); VLC_UNUSED(offset);
+    return VLC_EGENERIC;
+}
+
+int
+serdes_shm_read(struct serdes_sys *sys, uint64_t offset, void *data,
+                size_t size)
+{
+    VLC_UNUSED(sys); VLC_UNUSED(offset); VLC_UNUSED(data); VLC_UNUSED(size);
+    return VLC_EGENERIC;
+}
+#endif
+
 /****************************************************************************
  * serdes Operations
  *****************************************************************************/
@@ -283,6 +456,7 @@ serdes_Serialize(struct vlc_preparser_msg_serdes *serdes,
     sys->error = VLC_SUCCESS;
     sys->attach_data.size = 0;
     sys->size = 0;
+    serdes_shm_Reset(sys);
 
     toJSON_vlc_preparser_msg(serdes->owner.sys, msg);
     if (sys->error != VLC_SUCCESS) {
@@ -359,6 +533,7 @@ serdes_Deserialize(struct vlc_preparser_msg_serdes *serdes,
     sys->attach_data.size = 0;
     sys->size = 0;
     sys->parent = serdes;
+    serdes_shm_Reset(sys);
 
     struct json_object obj;
     if (json_parse(sys, &obj) != 0) {
@@ -387,6 +562,7 @@ serdes_Close(struct vlc_preparser_msg_serdes *serdes)
     serdes->owner.sys = NULL;
 
     vlc_vector_clear(&sys->attach_data);
+    serdes_shm_Unmap(sys);
     free(sys);
 }
 
@@ -411,6 +587,9 @@ serdes_Open(struct vlc_preparser_msg_serdes *serdes, bool bin_data)
     sys->bin_data = bin_data;
     memset(sys->buffer, 0, sys->cap);
     vlc_vector_init(&sys->attach_data);
+    sys->shm.base = NULL;
+    sys->shm.size = 0;
+    sys->shm.used = 0;
     sys->parent = serdes;
 
     static const struct vlc_preparser_msg_serdes_operations ops = {
@@ -10,6 +10,8 @@
 #ifndef SERIALIZER_H
 #define SERIALIZER_H
 
+#include <sys/types.h>
+
 #include <vlc_common.h>
 #include <vlc_preparser_ipc.h>
 #include <vlc_memstream.h>
@@ -28,6 +30,15 @@ struct serdes_sys {
 
     struct VLC_VECTOR(uint8_t) attach_data;
 
+    /* Mapping of the shared memory side channel */
+    struct {
+        uint8_t *base;
+        size_t size;
+        size_t used;
+        dev_t dev;
+        ino_t ino;
+    } shm;
+
     size_t cap;
     size_t size;
     uint8_t buffer[];
@@ -54,6 +65,17 @@ serdes_buf_flush(struct serdes_sys *sys);
 ssize_t
 serdes_buf_read(struct serdes_sys *sys, void *_data, size_t size, bool eod);
 
+/* Binary data smaller than this are written inline, after the JSON data */
+#define SERDES_SHM_MIN_SIZE (64 * 1024)
+
+int
+serdes_shm_write(struct serdes_sys *sys, const void *data, size_t size,
+                 uint64_t *offset);
+
+int
+serdes_shm_read(struct serdes_sys *sys, uint64_t offset, void *data,
+                size_t size);
+
 
 void
 toJSON_vlc_preparser_msg(struct serdes_sys *sys,
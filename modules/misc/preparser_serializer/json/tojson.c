@@ -987,7 +987,12 @@ static void toJSON_input_attachment(struct serdes_sys *sys,
     json_stringify(string, sys, "psz_mime", (*a)->psz_mime);
     json_stringify(string, sys, "psz_description", (*a)->psz_description);
     json_stringify(number, sys, "i_data", (*a)->i_data);
-    if (sys->bin_data) {
+    uint64_t offset;
+    if (sys->bin_data && serdes_shm_write(sys, (*a)->p_data, (*a)->i_data,
+                                          &offset) == VLC_SUCCESS) {
+        json_stringify(number, sys, "i_shm_offset", offset);
+        json_stringify_last(null, sys, "p_data", NULL);
+    } else if (sys->bin_data) {
         json_stringify_last(null, sys, "p_data", NULL);
         vlc_vector_push_all(&sys->attach_data , (*a)->p_data, (*a)->i_data);
     } else {
@@ -1014,13 +1019,17 @@ static void toJSON_plane(struct serdes_sys *sys, const plane_t *plane,
         }
         return;
     }
-    if (sys->bin_data) {
+    size_t size = plane->i_pitch * plane->i_lines;
+    uint64_t offset;
+    if (sys->bin_data && serdes_shm_write(sys, plane->p_pixels, size,
+                                          &offset) == VLC_SUCCESS) {
+        json_stringify_first(null, sys, "p_pixels", NULL);
+        json_stringify(number, sys, "i_shm_offset", offset);
+    } else if (sys->bin_data) {
         json_stringify_first(null, sys, "p_pixels", NULL);
-        vlc_vector_push_all(&sys->attach_data, plane->p_pixels,
-                            plane->i_pitch * plane->i_lines);
+        vlc_vector_push_all(&sys->attach_data, plane->p_pixels, size);
     } else {
-        char *b64 = vlc_b64_encode_binary(plane->p_pixels,
-                                          plane->i_pitch * plane->i_lines);
+        char *b64 = vlc_b64_encode_binary(plane->p_pixels, size);
         json_stringify_first(string, sys, "p_pixels", b64);
         free(b64);
     }
@@ -0,0 +1,801 @@
+/*****************************************************************************
+ * readahead.c: adaptive read-ahead stream filter
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <vlc_common.h>
+#include <vlc_plugin.h>
+#include <vlc_stream.h>
+#include <vlc_fs.h>
+#include <vlc_interrupt.h>
+
+#if !defined (MAP_ANONYMOUS) && defined (MAP_ANON)
+# define MAP_ANONYMOUS MAP_ANON
+#endif
+#ifndef MAP_NORESERVE
+# define MAP_NORESERVE 0
+#endif
+
+/* Pages of discarded data are given back to the system by chunks */
+#define RELEASE_CHUNK (1 << 20)
+/* Period of the consumption and fill rates estimation */
+#define RATE_PERIOD VLC_TICK_FROM_SEC(1)
+/* Period of the statistics messages */
+#define STATS_PERIOD VLC_TICK_FROM_SEC(5)
+
+struct stream_ctrl
+{
+    struct stream_ctrl *next;
+    int query;
+    union
+    {
+        struct
+        {
+            int id;
+            bool state;
+        } id_state;
+    };
+};
+
+typedef struct
+{
+    vlc_mutex_t  lock;
+    vlc_cond_t   wait_data;
+    vlc_cond_t   wait_space;
+    vlc_thread_t thread;
+    vlc_interrupt_t *interrupt;
+
+    bool         eof;
+    bool         error;
+    bool         paused;
+
+    bool         can_seek;
+    bool         can_pace;
+    bool         can_pause;
+    uint64_t     size;
+    uint64_t     mtime;
+    vlc_tick_t   pts_delay;
+    char        *content_type;
+
+    /* Ring of buffer_size bytes, mapped once. Only the pages holding
+     * buffered data are resident (for anonymous memory). */
+    char        *buffer;
+    size_t       buffer_size;
+    int          fd; /**< backing file, or -1 for anonymous memory */
+    uint64_t     buffer_offset;
+    uint64_t     stream_offset;
+    size_t       buffer_length;
+    uint64_t     release_offset; /**< offset up to which pages are released */
+
+    size_t       back_size; /**< data kept behind the read offset */
+    size_t       ahead_min;
+    size_t       ahead_max;
+    size_t       ahead_target; /**< adaptive read-ahead size */
+    vlc_tick_t   ahead_duration;
+    size_t       seek_threshold;
+
+    /* Rates estimation, in bytes per second */
+    vlc_tick_t   rate_date;
+    vlc_tick_t   stats_date;
+    uint64_t     consumed;
+    uint64_t     received;
+    uint64_t     consume_rate;
+    uint64_t     fill_rate;
+
+    struct stream_ctrl *controls;
+} stream_sys_t;
+
+static ssize_t ThreadRead(stream_t *stream, void *buf, size_t length)
+{
+    stream_sys_t *sys = stream->p_sys;
+
+    vlc_mutex_unlock(&sys->lock);
+    assert(length > 0);
+
+    ssize_t val = vlc_stream_ReadPartial(stream->s, buf, length);
+
+    vlc_mutex_lock(&sys->lock);
+    return val;
+}
+
+static int ThreadSeek(stream_t *stream, uint64_t seek_offset)
+{
+    stream_sys_t *sys = stream->p_sys;
+
+    vlc_mutex_unlock(&sys->lock);
+
+    int val = vlc_stream_Seek(stream->s, seek_offset);
+    if (val != VLC_SUCCESS)
+        msg_Err(stream, "cannot seek (to offset %"PRIu64")", seek_offset);
+
+    vlc_mutex_lock(&sys->lock);
+
+    return (val == VLC_SUCCESS) ? 0 : -1;
+}
+
+static int ThreadControl(stream_t *stream, int query, ...)
+{
+    stream_sys_t *sys = stream->p_sys;
+
+    vlc_mutex_unlock(&sys->lock);
+
+    va_list ap;
+    int ret;
+
+    va_start(ap, query);
+    ret = vlc_stream_vaControl(stream->s, query, ap);
+    va_end(ap);
+
+    vlc_mutex_lock(&sys->lock);
+    return ret;
+}
+
+/**
+ * Gives the pages of discarded data back to the system.
+ */
+static void RingRelease(stream_sys_t *sys, bool force)
+{
+    if (sys->fd != -1)
+        return; /* the backing file holds the data, not the memory */
+
+    uint64_t end = sys->buffer_offset;
+
+    if (end <= sys->release_offset
+     || (!force && end - sys->release_offset < RELEASE_CHUNK))
+        return;
+
+    const size_t page = sysconf(_SC_PAGESIZE);
+    uint64_t start = sys->release_offset;
+    /* While the release was pending, the ring may have wrapped around and
+     * reused the positions of the oldest discarded data for buffered data.
+     * Only release the positions that no buffered data occupies. */
+    uint64_t live_end = end + sys->buffer_length;
+
+    if (live_end - start > sys->buffer_size)
+        start = live_end - sys->buffer_size;
+
+    while (start < end)
+    {
+        size_t pos = start % sys->buffer_size;
+        size_t len = __MIN(end - start, sys->buffer_size - pos);
+        /* The ring size is a multiple of the page size, so the alignment of
+         * stream offsets matches that of ring positions. */
+        size_t first = (pos + page - 1) & ~(page - 1);
+        size_t last = (pos + len) & ~(page - 1);
+
+        if (last > first)
+            madvise(sys->buffer + first, last - first, MADV_DONTNEED);
+        start += len;
+    }
+    /* The partially discarded page is released the next time */
+    sys->release_offset = end & ~(uint64_t)(page - 1);
+}
+
+/**
+ * Drops all buffered data, and restarts buffering at the given offset.
+ */
+static void RingReset(stream_sys_t *sys, uint64_t offset)
+{
+    sys->buffer_offset += sys->buffer_length;
+    sys->buffer_length = 0;
+    RingRelease(sys, true);
+    sys->buffer_offset = offset;
+    sys->release_offset = offset;
+}
+
+static void *Thread(void *data)
+{
+    vlc_thread_set_name("vlc-readahead");
+
+    stream_t *stream = data;
+    stream_sys_t *sys = stream->p_sys;
+    bool paused = false;
+
+    vlc_interrupt_set(sys->interrupt);
+
+    vlc_mutex_lock(&sys->lock);
+    while (!vlc_killed())
+    {
+        struct stream_ctrl *ctrl = sys->controls;
+
+        if (unlikely(ctrl != NULL))
+        {
+            sys->controls = ctrl->next;
+            ThreadControl(stream, ctrl->query, ctrl->id_state.id,
+                          ctrl->id_state.state);
+            free(ctrl);
+            continue;
+        }
+
+        if (sys->paused != paused)
+        {   /* Update pause state */
+            msg_Dbg(stream, paused ? "resuming" : "pausing");
+            paused = sys->paused;
+            ThreadControl(stream, STREAM_SET_PAUSE_STATE, paused);
+            continue;
+        }
+
+        if (paused || sys->error)
+        {   /* Wait for not paused and not failed */
+            vlc_cond_wait(&sys->wait_space, &sys->lock);
+            continue;
+        }
+
+        uint_fast64_t stream_offset = sys->stream_offset;
+
+        if (stream_offset < sys->buffer_offset)
+        {   /* Need to seek backward, beyond the back-seek window */
+            if (ThreadSeek(stream, stream_offset) == 0)
+            {
+                RingReset(sys, stream_offset);
+                assert(!sys->error);
+                sys->eof = false;
+            }
+            else
+            {
+                sys->error = true;
+                vlc_cond_signal(&sys->wait_data);
+            }
+            continue;
+        }
+
+        uint64_t history = stream_offset - sys->buffer_offset;
+
+        /* Skip forward if the read offset is far beyond the buffered data */
+        if (sys->can_seek
+         && history >= (sys->buffer_length + sys->seek_threshold))
+        {
+            if (ThreadSeek(stream, stream_offset) == 0)
+            {
+                RingReset(sys, stream_offset);
+                assert(!sys->error);
+                sys->eof = false;
+            }
+            else
+            {
+                sys->error = true;
+                vlc_cond_signal(&sys->wait_data);
+            }
+            continue;
+        }
+
+        if (history > sys->buffer_length)
+            history = sys->buffer_length;
+
+        /* Only keep the back-seek window behind the read offset */
+        if (history > sys->back_size)
+        {
+            size_t len = history - sys->back_size;
+
+            sys->buffer_offset += len;
+            sys->buffer_length -= len;
+            history -= len;
+            RingRelease(sys, false);
+        }
+
+        if (sys->eof)
+        {   /* Do not attempt to read at EOF - would busy loop */
+            vlc_cond_wait(&sys->wait_space, &sys->lock);
+            continue;
+        }
+
+        size_t ahead = sys->buffer_length - history;
+
+        if (ahead >= sys->ahead_target)
+        {   /* Wait for data to be read, or for the target to grow */
+            vlc_cond_wait(&sys->wait_space, &sys->lock);
+            continue;
+        }
+
+        size_t len = sys->ahead_target - ahead;
+
+        if (len > sys->buffer_size - sys->buffer_length)
+            len = sys->buffer_size - sys->buffer_length;
+        if (len == 0)
+        {   /* Buffer is full of history: discard some of it */
+            len = __MIN(history, sys->ahead_target - ahead);
+            if (len == 0)
+            {
+                vlc_cond_wait(&sys->wait_space, &sys->lock);
+                continue;
+            }
+            sys->buffer_offset += len;
+            sys->buffer_length -= len;
+            RingRelease(sys, false);
+        }
+
+        size_t offset = (sys->buffer_offset + sys->buffer_length)
+                        % sys->buffer_size;
+        /* Do not step past the sharp edge of the circular buffer */
+        if (offset + len > sys->buffer_size)
+            len = sys->buffer_size - offset;
+
+        ssize_t val = ThreadRead(stream, sys->buffer + offset, len);
+        if (val < 0)
+            continue;
+        if (val == 0)
+        {
+            assert(len > 0);
+            msg_Dbg(stream, "end of stream");
+            sys->eof = true;
+        }
+
+        assert((size_t)val <= len);
+        sys->buffer_length += val;
+        sys->received += val;
+        assert(sys->buffer_length <= sys->buffer_size);
+        vlc_cond_signal(&sys->wait_data);
+    }
+
+    sys->error = true;
+    vlc_cond_signal(&sys->wait_data);
+    vlc_mutex_unlock(&sys->lock);
+    return NULL;
+}
+
+static int Seek(stream_t *stream, uint64_t offset)
+{
+    stream_sys_t *sys = stream->p_sys;
+
+    vlc_mutex_lock(&sys->lock);
+    sys->stream_offset = offset;
+    sys->error = false;
+    vlc_cond_signal(&sys->wait_space);
+    vlc_mutex_unlock(&sys->lock);
+    return 0;
+}
+
+static size_t BufferLevel(const stream_t *stream, bool *eof)
+{
+    stream_sys_t *sys = stream->p_sys;
+
+    *eof = false;
+
+    if (sys->stream_offset < sys->buffer_offset)
+        return 0;
+    if ((sys->stream_offset - sys->buffer_offset) >= sys->buffer_length)
+    {
+        *eof = sys->eof;
+        return 0;
+    }
+    return sys->buffer_offset + sys->buffer_length - sys->stream_offset;
+}
+
+static uint64_t RateUpdate(uint64_t rate, uint64_t bytes, vlc_tick_t elapsed)
+{
+    uint64_t now = bytes * CLOCK_FREQ / elapsed;
+
+    /* Exponential moving average, faster to rise than to fall, so that the
+     * read-ahead grows quickly when consumption spikes */
+    if (now > rate)
+        return (rate + now) / 2;
+    return (7 * rate + now) / 8;
+}
+
+/**
+ * Updates the rates estimation and the read-ahead target.
+ * Called with the lock held.
+ */
+static void Measure(stream_t *stream)
+{
+    stream_sys_t *sys = stream->p_sys;
+    vlc_tick_t now = vlc_tick_now();
+    vlc_tick_t elapsed = now - sys->rate_date;
+
+    if (elapsed < RATE_PERIOD)
+        return;
+
+    if (!sys->paused)
+    {
+        sys->consume_rate = RateUpdate(sys->consume_rate, sys->consumed,
+                                       elapsed);
+        sys->fill_rate = RateUpdate(sys->fill_rate, sys->received, elapsed);
+    }
+    sys->consumed = 0;
+    sys->received = 0;
+    sys->rate_date = now;
+
+    uint64_t target = sys->consume_rate * sys->ahead_duration / CLOCK_FREQ;
+    size_t old_target = sys->ahead_target;
+
+    sys->ahead_target = VLC_CLIP(target, sys->ahead_min, sys->ahead_max);
+    if (sys->ahead_target > old_target)
+        vlc_cond_signal(&sys->wait_space);
+
+    if (now - sys->stats_date >= STATS_PERIOD)
+    {
+        bool eof;
+        size_t level = BufferLevel(stream, &eof);
+
+        var_SetInteger(stream, "readahead-level", level);
+        var_SetInteger(stream, "readahead-target", sys->ahead_target);
+        var_SetInteger(stream, "readahead-consume-rate", sys->consume_rate);
+        var_SetInteger(stream, "readahead-fill-rate", sys->fill_rate);
+        msg_Dbg(stream, "buffer: %zu/%zu bytes, consuming %"PRIu64" B/s, "
+                "filling %"PRIu64" B/s", level, sys->ahead_target,
+                sys->consume_rate, sys->fill_rate);
+        sys->stats_date = now;
+    }
+}
+
+static ssize_t Read(stream_t *stream, void *buf, size_t buflen)
+{
+    stream_sys_t *sys = stream->p_sys;
+    size_t copy, offset;
+    bool eof;
+
+    if (buflen == 0)
+        return buflen;
+
+    vlc_mutex_lock(&sys->lock);
+    if (sys->paused)
+    {
+        msg_Err(stream, "reading while paused (buggy demux?)");
+        sys->paused = false;
+        vlc_cond_signal(&sys->wait_space);
+    }
+
+    while ((copy = BufferLevel(stream, &eof)) == 0 && !eof)
+    {
+        void *data[2];
+
+        if (sys->error)
+        {
+            vlc_mutex_unlock(&sys->lock);
+            return 0;
+        }
+
+        vlc_interrupt_forward_start(sys->interrupt, data);
+        vlc_cond_wait(&sys->wait_data, &sys->lock);
+        vlc_interrupt_forward_stop(data);
+    }
+
+    offset = sys->stream_offset % sys->buffer_size;
+    if (copy > buflen)
+        copy = buflen;
+    /* Do not step past the sharp edge of the circular buffer */
+    if (offset + copy > sys->buffer_size)
+        copy = sys->buffer_size - offset;
+
+    memcpy(buf, sys->buffer + offset, copy);
+    sys->stream_offset += copy;
+    sys->consumed += copy;
+    Measure(stream);
+    vlc_cond_signal(&sys->wait_space);
+    vlc_mutex_unlock(&sys->lock);
+    return copy;
+}
+
+static int Control(stream_t *stream, int query, va_list args)
+{
+    stream_sys_t *sys = stream->p_sys;
+
+    switch (query)
+    {
+        case STREAM_CAN_SEEK:
+            *va_arg(args, bool *) = sys->can_seek;
+            break;
+        case STREAM_CAN_FASTSEEK:
+            *va_arg(args, bool *) = false;
+            break;
+        case STREAM_CAN_PAUSE:
+             *va_arg(args, bool *) = sys->can_pause;
+            break;
+        case STREAM_CAN_CONTROL_PACE:
+            *va_arg (args, bool *) = sys->can_pace;
+            break;
+        case STREAM_GET_SIZE:
+            if (sys->size == (uint64_t)-1)
+                return VLC_EGENERIC;
+            *va_arg(args, uint64_t *) = sys->size;
+            break;
+        case STREAM_GET_MTIME:
+            if (sys->mtime == (uint64_t)-1)
+                return VLC_EGENERIC;
+            *va_arg(args, uint64_t *) = sys->mtime;
+            break;
+        case STREAM_GET_PTS_DELAY:
+            *va_arg(args, vlc_tick_t *) = sys->pts_delay;
+            break;
+        case STREAM_GET_TITLE_INFO:
+        case STREAM_GET_TITLE:
+        case STREAM_GET_SEEKPOINT:
+        case STREAM_GET_META:
+            return VLC_EGENERIC;
+        case STREAM_GET_CONTENT_TYPE:
+            if (sys->content_type == NULL)
+                return VLC_EGENERIC;
+            *va_arg(args, char **) = strdup(sys->content_type);
+            return VLC_SUCCESS;
+        case STREAM_GET_SIGNAL:
+        case STREAM_GET_TAGS:
+        case STREAM_GET_TYPE:
+            return VLC_EGENERIC;
+        case STREAM_SET_PAUSE_STATE:
+        {
+            bool paused = va_arg(args, unsigned);
+
+            vlc_mutex_lock(&sys->lock);
+            sys->paused = paused;
+            vlc_cond_signal(&sys->wait_space);
+            vlc_mutex_unlock (&sys->lock);
+            break;
+        }
+        case STREAM_SET_TITLE:
+        case STREAM_SET_SEEKPOINT:
+            return VLC_EGENERIC;
+        case STREAM_SET_PRIVATE_ID_STATE:
+        {
+            struct stream_ctrl *ctrl = malloc(sizeof (*ctrl)), **pp;
+            if (unlikely(ctrl == NULL))
+                return VLC_ENOMEM;
+
+            ctrl->next = NULL;
+            ctrl->query = query;
+            ctrl->id_state.id = va_arg(args, int);
+            ctrl->id_state.state = va_arg(args, int);
+            vlc_mutex_lock(&sys->lock);
+            for (pp = &sys->controls; *pp != NULL; pp = &((*pp)->next));
+            *pp = ctrl;
+            vlc_cond_signal(&sys->wait_space);
+            vlc_mutex_unlock(&sys->lock);
+            break;
+        }
+        case STREAM_SET_PRIVATE_ID_CA:
+        case STREAM_GET_PRIVATE_ID_STATE:
+            return VLC_EGENERIC;
+        default:
+            msg_Err(stream, "unimplemented query (%d) in control", query);
+            return VLC_EGENERIC;
+    }
+    return VLC_SUCCESS;
+}
+
+/**
+ * Maps the ring, either from anonymous memory or from an unlinked temporary
+ * file in the given directory.
+ */
+static int RingMap(stream_t *stream, const char *dir)
+{
+    stream_sys_t *sys = stream->p_sys;
+    int flags = MAP_SHARED;
+
+    sys->fd = -1;
+    if (dir != NULL && *dir != '\0')
+    {
+        char *path;
+
+        if (asprintf(&path, "%s"DIR_SEP"vlc-readahead-XXXXXX", dir) < 0)
+            return VLC_ENOMEM;
+
+        sys->fd = vlc_mkstemp(path);
+        if (sys->fd == -1)
+        {
+            msg_Err(stream, "cannot create temporary file in %s: %s", dir,
+                    vlc_strerror_c(errno));
+            free(path);
+            return VLC_EGENERIC;
+        }
+        vlc_unlink(path);
+        free(path);
+
+        if (ftruncate(sys->fd, sys->buffer_size))
+        {
+            msg_Err(stream, "cannot size temporary file: %s",
+                    vlc_strerror_c(errno));
+            vlc_close(sys->fd);
+            return VLC_EGENERIC;
+        }
+    }
+    else
+        flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+
+    sys->buffer = mmap(NULL, sys->buffer_size, PROT_READ | PROT_WRITE, flags,
+                       sys->fd, 0);
+    if (sys->buffer == MAP_FAILED)
+    {
+        msg_Err(stream, "cannot map %zu bytes: %s", sys->buffer_size,
+                vlc_strerror_c(errno));
+        if (sys->fd != -1)
+            vlc_close(sys->fd);
+        return VLC_ENOMEM;
+    }
+    return VLC_SUCCESS;
+}
+
+static void RingUnmap(stream_sys_t *sys)
+{
+    munmap(sys->buffer, sys->buffer_size);
+    if (sys->fd != -1)
+        vlc_close(sys->fd);
+}
+
+static int Open(vlc_object_t *obj)
+{
+    stream_t *stream = (stream_t *)obj;
+
+    /* The filter is only inserted on request, typically for files on busy
+     * network shares, which the file access reports as fast-seekable like
+     * any other file. PID-filtered streams would suffer excessive latency
+     * though. */
+    if (vlc_stream_GetPrivateIdState(stream->s, 0, &(bool){false}) ==
+        VLC_SUCCESS)
+        return VLC_EGENERIC;
+
+    stream_sys_t *sys = malloc(sizeof (*sys));
+    if (unlikely(sys == NULL))
+        return VLC_ENOMEM;
+
+    sys->can_seek = vlc_stream_CanSeek(stream->s);
+    sys->can_pause = vlc_stream_CanPause(stream->s);
+    sys->can_pace = vlc_stream_CanPace(stream->s);
+
+    if (vlc_stream_GetSize(stream->s, &sys->size) != VLC_SUCCESS)
+        sys->size = -1;
+    if (vlc_stream_GetMTime(stream->s, &sys->mtime) != VLC_SUCCESS)
+        sys->mtime = -1;
+
+    sys->pts_delay = vlc_stream_GetPtsDelay(stream->s);
+    if (vlc_stream_GetContentType(stream->s, &sys->content_type) != VLC_SUCCESS)
+        sys->content_type = NULL;
+
+    sys->eof = false;
+    sys->error = false;
+    sys->paused = false;
+    sys->buffer_offset = 0;
+    sys->stream_offset = 0;
+    sys->buffer_length = 0;
+    sys->release_offset = 0;
+    sys->back_size = var_InheritInteger(obj, "readahead-back-size") << 10u;
+    sys->ahead_min = var_InheritInteger(obj, "readahead-min-size") << 10u;
+    sys->ahead_max = var_InheritInteger(obj, "readahead-max-size") << 10u;
+    if (sys->ahead_max < sys->ahead_min)
+        sys->ahead_max = sys->ahead_min;
+    sys->ahead_target = sys->ahead_min;
+    sys->ahead_duration =
+        VLC_TICK_FROM_MS(var_InheritInteger(obj, "readahead-duration"));
+    sys->seek_threshold = var_InheritInteger(obj, "readahead-seek-threshold");
+    sys->consumed = 0;
+    sys->received = 0;
+    sys->consume_rate = 0;
+    sys->fill_rate = 0;
+    sys->rate_date = sys->stats_date = vlc_tick_now();
+    sys->controls = NULL;
+
+    size_t size = sys->ahead_max + sys->back_size;
+    uint64_t stream_size = stream_Size(stream->s);
+    if (stream_size > 0 && size > stream_size)
+        /* No point mapping a ring larger than the source stream */
+        size = stream_size;
+
+    const size_t page = sysconf(_SC_PAGESIZE);
+    sys->buffer_size = (size + page - 1) & ~(page - 1);
+    stream->p_sys = sys;
+
+    char *dir = var_InheritString(obj, "readahead-file");
+    int val = RingMap(stream, dir);
+    free(dir);
+    if (val != VLC_SUCCESS)
+        goto error;
+
+    sys->interrupt = vlc_interrupt_create();
+    if (unlikely(sys->interrupt == NULL))
+    {
+        RingUnmap(sys);
+        goto error;
+    }
+
+    vlc_mutex_init(&sys->lock);
+    vlc_cond_init(&sys->wait_data);
+    vlc_cond_init(&sys->wait_space);
+
+    var_Create(stream, "readahead-level", VLC_VAR_INTEGER);
+    var_Create(stream, "readahead-target", VLC_VAR_INTEGER);
+    var_Create(stream, "readahead-consume-rate", VLC_VAR_INTEGER);
+    var_Create(stream, "readahead-fill-rate", VLC_VAR_INTEGER);
+
+    if (vlc_clone(&sys->thread, Thread, stream))
+    {
+        vlc_interrupt_destroy(sys->interrupt);
+        RingUnmap(sys);
+        goto error;
+    }
+
+    msg_Dbg(stream, "using %zu bytes ring (%s), read-ahead %zu to %zu bytes",
+            sys->buffer_size, sys->fd != -1 ? "file" : "memory",
+            sys->ahead_min, sys->ahead_max);
+    stream->pf_read = Read;
+    stream->pf_seek = Seek;
+    stream->pf_control = Control;
+    return VLC_SUCCESS;
+
+error:
+    free(sys->content_type);
+    free(sys);
+    return VLC_ENOMEM;
+}
+
+/**
+ * Releases allocate resources.
+ */
+static void Close (vlc_object_t *obj)
+{
+    stream_t *stream = (stream_t *)obj;
+    stream_sys_t *sys = stream->p_sys;
+
+    vlc_mutex_lock(&sys->lock);
+    vlc_interrupt_kill(sys->interrupt);
+    vlc_cond_signal(&sys->wait_space);
+    vlc_mutex_unlock(&sys->lock);
+
+    vlc_join(sys->thread, NULL);
+    vlc_interrupt_destroy(sys->interrupt);
+
+    while(sys->controls)
+    {
+        struct stream_ctrl *ctrl = sys->controls;
+        sys->controls = ctrl->next;
+        free(ctrl);
+    }
+    RingUnmap(sys);
+    free(sys->content_type);
+    free(sys);
+}
+
+vlc_module_begin()
+    set_subcategory(SUBCAT_INPUT_STREAM_FILTER)
+    set_capability("stream_filter", 0)
+    add_shortcut("readahead")
+
+    set_description(N_("Adaptive read-ahead stream filter"))
+    set_callbacks(Open, Close)
+
+    add_integer("readahead-min-size", 1 << 12, N_("Minimum read-ahead"),
+                N_("Minimum amount of data read ahead (KiB)"))
+        change_integer_range(4, 1 << 20)
+    add_integer("readahead-max-size", 1 << 16, N_("Maximum read-ahead"),
+                N_("Maximum amount of data read ahead (KiB)"))
+        change_integer_range(4, 1 << 22)
+    add_integer("readahead-back-size", 1 << 12, N_("Back-seek window"),
+                N_("Amount of already read data kept for backward "
+                   "seeking (KiB)"))
+        change_integer_range(0, 1 << 20)
+    add_integer("readahead-duration", 20000, N_("Read-ahead duration"),
+                N_("The read-ahead grows to hold that much time of "
+                   "consumption, at the measured rate (ms)"))
+        change_integer_range(0, 3600000)
+    add_integer("readahead-seek-threshold", 1 << 14, N_("Seek threshold"),
+                N_("Read-ahead forward seek threshold (bytes)"))
+        change_integer_range(0, UINT64_C(1) << 60)
+    add_directory("readahead-file", NULL, N_("Backing file directory"),
+                  N_("Back the read-ahead buffer with a temporary file in "
+                     "this directory, instead of memory"))
+vlc_module_end()
@@ -54,9 +54,13 @@
 
 #include "rtp.h"
 #include "sdp_helper.h"
+#include "udp_batch.h"
 
 #include <sys/types.h>
 #include <unistd.h>
+#ifdef HAVE_SYS_UIO_H
+#   include <sys/uio.h>
+#endif
 #ifdef HAVE_ARPA_INET_H
 #   include <arpa/inet.h>
 #endif
@@ -314,6 +318,7 @@ typedef struct rtp_sink_t
 {
     int rtp_fd;
     rtcp_sender_t *rtcp;
+    bool gso;
 } rtp_sink_t;
 
 struct sout_stream_id_sys_t
@@ -345,6 +350,7 @@ struct sout_stream_id_sys_t
     vlc_mutex_t       lock_sink;
     vlc_queue_t       queue;
     bool              dead;
+    struct udp_batch *batch;
     int               sinkc;
     rtp_sink_t       *sinkv;
     rtsp_stream_id_t *rtsp_id;
@@ -938,6 +944,7 @@ static void *Add( sout_stream_t *p_stream, const es_format_t *p_fmt, const char
     id->rtsp_id = NULL;
     vlc_queue_Init(&id->queue, offsetof (block_t, p_next));
     id->dead = true;
+    id->batch = NULL;
     id->listen.fd = NULL;
 
     id->b_first_packet = true;
@@ -1119,6 +1126,10 @@ static void *Add( sout_stream_t *p_stream, const es_format_t *p_fmt, const char
         id->rtsp_id = RtspAddId( p_sys->rtsp, id, GetDWBE( id->ssrc ),
                                  id->rtp_fmt.clock_rate, mcast_fd );
 
+    id->batch = udp_batch_New();
+    if( unlikely(id->batch == NULL) )
+        goto error;
+
     id->dead = false;
     if( vlc_clone( &id->thread, ThreadSend, id ) )
     {
@@ -1183,6 +1194,8 @@ static void Del( sout_stream_t *p_stream, void *_id )
     if( id->srtp != NULL )
         srtp_destroy( id->srtp );
 #endif
+    if( id->batch != NULL )
+        udp_batch_Delete( id->batch );
 
     /* Update SDP (sap/file) */
     if( p_sys->b_export_sap ) SapSetup( p_stream );
@@ -1332,45 +1345,82 @@ static int  HttpCallback( httpd_file_sys_t *p_args,
 /****************************************************************************
  * RTP send
  ****************************************************************************/
+#ifdef HAVE_SRTP
+static block_t *EncryptSRTP( sout_stream_id_sys_t *id, block_t *out )
+{
+    /* FIXME: this is awfully inefficient */
+    size_t len = out->i_buffer;
+    out = block_Realloc( out, 0, len + 10 );
+    if( unlikely(out == NULL) )
+        return NULL;
+    out->i_buffer = len;
+
+    int val = srtp_send( id->srtp, out->p_buffer, &len, len + 10 );
+    if( val )
+    {
+        msg_Dbg( id->p_stream, "SRTP sending error: %s",
+                 vlc_strerror_c(val) );
+        block_Release( out );
+        return NULL;
+    }
+    out->i_buffer = len;
+    return out;
+}
+#endif
+
 static void* ThreadSend( void *data )
 {
     vlc_thread_set_name("vlc-rt-send");
 
-#ifdef _WIN32
-# undef ENOBUFS
-# define ENOBUFS      WSAENOBUFS
-# undef EAGAIN
-# define EAGAIN       WSAEWOULDBLOCK
-# undef EWOULDBLOCK
-# define EWOULDBLOCK  WSAEWOULDBLOCK
-#endif
     sout_stream_id_sys_t *id = data;
     vlc_tick_t i_caching = id->i_caching;
     block_t *out;
 
     while ((out = vlc_queue_DequeueKillable(&id->queue, &id->dead)) != NULL)
     {
+        block_t *pktv[UDP_BATCH_MAX];
+        unsigned pktc = 0;
+
 #ifdef HAVE_SRTP
-        if( id->srtp )
-        {   /* FIXME: this is awfully inefficient */
-            size_t len = out->i_buffer;
-            out = block_Realloc( out, 0, len + 10 );
-            out->i_buffer = len;
-
-            int val = srtp_send( id->srtp, out->p_buffer, &len, len + 10 );
-            if( val )
-            {
-                msg_Dbg( id->p_stream, "SRTP sending error: %s",
-                         vlc_strerror_c(val) );
-                block_Release( out );
-                continue;
-            }
-            out->i_buffer = len;
-        }
+        if( id->srtp && (out = EncryptSRTP( id, out )) == NULL )
+            continue;
 #endif
-        vlc_tick_wait (out->i_dts + i_caching);
+        vlc_tick_t deadline = out->i_dts + i_caching;
+        vlc_tick_wait( deadline );
+        pktv[pktc++] = out;
+
+        /* Gather the packets that are already due, typically the other
+         * fragments of the same frame, so that they are sent together
+         * without delaying or advancing any of them. */
+        vlc_tick_t now = vlc_tick_now();
+        if( now < deadline )
+            now = deadline;
+
+        vlc_queue_Lock( &id->queue );
+        while( pktc < ARRAY_SIZE(pktv) )
+        {
+            const block_t *next = vlc_queue_PeekUnlocked( &id->queue );
 
-        ssize_t len = out->i_buffer;
+            if( next == NULL || next->i_dts + i_caching > now )
+                break;
+            pktv[pktc++] = vlc_queue_DequeueUnlocked( &id->queue );
+        }
+        vlc_queue_Unlock( &id->queue );
+
+        udp_batch_Reset( id->batch );
+        for( unsigned i = 0; i < pktc; i++ )
+        {
+#ifdef HAVE_SRTP
+            if( i > 0 && id->srtp
+             && (pktv[i] = EncryptSRTP( id, pktv[i] )) == NULL )
+                continue;
+#endif
+            struct iovec iov = {
+                .iov_base = pktv[i]->p_buffer,
+                .iov_len = pktv[i]->i_buffer,
+            };
+            udp_batch_Add( id->batch, &iov, 1 );
+        }
 
         vlc_mutex_lock( &id->lock_sink );
         unsigned deadc = 0; /* How many dead sockets? */
@@ -1381,26 +1431,33 @@ static void* ThreadSend( void *data )
 #ifdef HAVE_SRTP
             if( !id->srtp ) /* FIXME: SRTCP support */
 #endif
-                SendRTCP( id->sinkv[i].rtcp, out );
+                for( unsigned j = 0; j < pktc; j++ )
+                    if( pktv[j] != NULL )
+                        SendRTCP( id->sinkv[i].rtcp, pktv[j] );
 
-            if( send( id->sinkv[i].rtp_fd, out->p_buffer, len, 0 ) == -1
-             && net_errno != EAGAIN && net_errno != EWOULDBLOCK
-             && net_errno != ENOBUFS && net_errno != ENOMEM )
+            if( udp_batch_Send( id->batch, id->sinkv[i].rtp_fd,
+                                &id->sinkv[i].gso, NULL ) != 0 )
             {
                 int type;
                 getsockopt( id->sinkv[i].rtp_fd, SOL_SOCKET, SO_TYPE,
                             &type, &(socklen_t){ sizeof(type) });
-                if( type == SOCK_DGRAM )
-                    /* ICMP soft error: ignore and retry */
-                    send( id->sinkv[i].rtp_fd, out->p_buffer, len, 0 );
-                else
+                if( type != SOCK_DGRAM )
                     /* Broken connection */
                     deadv[deadc++] = id->sinkv[i].rtp_fd;
+                /* else ICMP soft error: ignore */
             }
         }
-        id->i_seq_sent_next = ntohs(((uint16_t *) out->p_buffer)[1]) + 1;
+        for( unsigned i = pktc; i-- > 0; )
+            if( pktv[i] != NULL )
+            {
+                id->i_seq_sent_next = ntohs(((uint16_t *) pktv[i]->p_buffer)[1]) + 1;
+                break;
+            }
         vlc_mutex_unlock( &id->lock_sink );
-        block_Release( out );
+
+        for( unsigned i = 0; i < pktc; i++ )
+            if( pktv[i] != NULL )
+                block_Release( pktv[i] );
 
         for( unsigned i = 0; i < deadc; i++ )
         {
@@ -1437,7 +1494,7 @@ static void *rtp_listen_thread( void *data )
 
 int rtp_add_sink( sout_stream_id_sys_t *id, int fd, bool rtcp_mux, uint16_t *seq )
 {
-    rtp_sink_t sink = { fd, NULL };
+    rtp_sink_t sink = { fd, NULL, udp_batch_ProbeGSO( fd ) };
     sink.rtcp = OpenRTCP( VLC_OBJECT( id->p_stream ), fd, IPPROTO_UDP,
                           rtcp_mux );
     if( sink.rtcp == NULL )
@@ -1453,7 +1510,7 @@ int rtp_add_sink( sout_stream_id_sys_t *id, int fd, bool rtcp_mux, uint16_t *seq
 
 void rtp_del_sink( sout_stream_id_sys_t *id, int fd )
 {
-    rtp_sink_t sink = { fd, NULL };
+    rtp_sink_t sink = { fd, NULL, false };
 
     /* NOTE: must be safe to use if fd is not included */
     vlc_mutex_lock( &id->lock_sink );
@@ -155,6 +155,32 @@ bool transcode_encoder_opened( const transcode_encoder_t *p_enc )
     return p_enc->p_encoder && p_enc->p_encoder->p_module;
 }
 
+transcode_latency_t *transcode_encoder_latency( transcode_encoder_t *p_enc )
+{
+    return &p_enc->latency;
+}
+
+/* Logs the statistics of a stage every TRANSCODE_LATENCY_REPORT_INTERVAL,
+ * or right away if forced. While the stage is running, only the thread
+ * updating the statistics may call it. */
+void transcode_latency_Report( vlc_object_t *p_obj, const char *psz_stage,
+                               transcode_latency_t *p_lat, bool b_force )
+{
+    vlc_tick_t now = vlc_tick_now();
+
+    if( p_lat->last_report == 0 )
+        p_lat->last_report = now;
+    if( p_lat->count == 0 || ( !b_force &&
+        now - p_lat->last_report < TRANSCODE_LATENCY_REPORT_INTERVAL ) )
+        return;
+    p_lat->last_report = now;
+
+    msg_Info( p_obj, "video %s latency: average %.3f ms, max %.3f ms "
+              "(%"PRIu64" samples)", psz_stage,
+              MS_FROM_VLC_TICK( (double)p_lat->total / p_lat->count ),
+              MS_FROM_VLC_TICK( (double)p_lat->max ), p_lat->count );
+}
+
 block_t * transcode_encoder_encode( transcode_encoder_t *p_enc, void *in )
 {
     switch( p_enc->p_encoder->fmt_in.i_cat )
@@ -23,6 +23,30 @@
 
 typedef struct transcode_encoder_t transcode_encoder_t;
 
+/** Processing time statistics of a transcoding stage */
+typedef struct
+{
+    vlc_tick_t total;
+    vlc_tick_t max;
+    uint64_t   count;
+    vlc_tick_t last_report; /**< when the statistics were last logged */
+} transcode_latency_t;
+
+/** Interval between two logs of the statistics of a running stage */
+#define TRANSCODE_LATENCY_REPORT_INTERVAL VLC_TICK_FROM_SEC(10)
+
+static inline void transcode_latency_Add( transcode_latency_t *p_lat,
+                                          vlc_tick_t duration )
+{
+    p_lat->total += duration;
+    if( duration > p_lat->max )
+        p_lat->max = duration;
+    p_lat->count++;
+}
+
+void transcode_latency_Report( vlc_object_t *, const char *,
+                               transcode_latency_t *, bool );
+
 typedef struct
 {
     vlc_fourcc_t i_codec; /* (0 if not transcode) */
@@ -43,6 +67,7 @@ typedef struct
             {
                 unsigned int i_count;
                 uint32_t     pool_size;
+                bool         b_pipeline; /**< filter in a separate thread */
             } threads;
         } video;
         struct
@@ -75,6 +100,7 @@ transcode_encoder_t * transcode_encoder_new( encoder_t *, const es_format_t * );
 void transcode_encoder_close( transcode_encoder_t * );
 
 bool transcode_encoder_opened( const transcode_encoder_t * );
+transcode_latency_t *transcode_encoder_latency( transcode_encoder_t * );
 int transcode_encoder_open( transcode_encoder_t *, const transcode_encoder_config_t * );
 int transcode_encoder_drain( transcode_encoder_t *, block_t ** );
 
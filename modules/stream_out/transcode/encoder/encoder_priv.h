@@ -31,6 +31,9 @@ struct transcode_encoder_t
     /* output buffers */
     block_t         *p_buffers;
     bool b_threaded;
+
+    /* time spent encoding each picture, written by the encoding thread */
+    transcode_latency_t latency;
 };
 
 int transcode_encoder_audio_open( transcode_encoder_t *p_enc,
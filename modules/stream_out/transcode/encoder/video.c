@@ -300,6 +300,17 @@ static picture_t *picture_fifo_LockPop( picture_fifo_t *fifo )
     return pic;
 }
 
+static block_t *EncodePicture( transcode_encoder_t *p_enc, picture_t *p_pic )
+{
+    vlc_tick_t start = vlc_tick_now();
+    block_t *p_block = vlc_encoder_EncodeVideo( p_enc->p_encoder, p_pic );
+
+    transcode_latency_Add( &p_enc->latency, vlc_tick_now() - start );
+    transcode_latency_Report( VLC_OBJECT(p_enc->p_encoder), "encode",
+                              &p_enc->latency, false );
+    return p_block;
+}
+
 static void* EncoderThread( void *obj )
 {
     vlc_thread_set_name("vlc-encoder");
@@ -322,7 +333,7 @@ static void* EncoderThread( void *obj )
         {
             /* release lock while encoding */
             vlc_mutex_unlock( &p_enc->lock_out );
-            p_block = vlc_encoder_EncodeVideo( p_enc->p_encoder, p_pic );
+            p_block = EncodePicture( p_enc, p_pic );
             picture_Release( p_pic );
             vlc_mutex_lock( &p_enc->lock_out );
 
@@ -337,7 +348,7 @@ static void* EncoderThread( void *obj )
     while( (p_pic = picture_fifo_LockPop( p_enc->pp_pics )) != NULL )
     {
         vlc_sem_post( &p_enc->picture_pool_has_room );
-        p_block = vlc_encoder_EncodeVideo( p_enc->p_encoder, p_pic );
+        p_block = EncodePicture( p_enc, p_pic );
         picture_Release( p_pic );
         block_ChainAppend( &p_enc->p_buffers, p_block );
     }
@@ -437,7 +448,9 @@ block_t * transcode_encoder_video_encode( transcode_encoder_t *p_enc, picture_t
 {
     if( !p_enc->b_threaded )
     {
-        return vlc_encoder_EncodeVideo( p_enc->p_encoder, p_pic );
+        if( p_pic == NULL )
+            return vlc_encoder_EncodeVideo( p_enc->p_encoder, NULL );
+        return EncodePicture( p_enc, p_pic );
     }
 
     vlc_sem_wait( &p_enc->picture_pool_has_room );
@@ -448,5 +461,8 @@ block_t * transcode_encoder_video_encode( transcode_encoder_t *p_enc, picture_t
     picture_fifo_Unlock( p_enc->pp_pics );
     vlc_cond_signal( &p_enc->cond );
     vlc_mutex_unlock( &p_enc->lock_out );
-    return NULL;
+
+    /* Hand over what the encoder thread has output so far, rather than
+     * holding it back until the encoder is drained. */
+    return transcode_encoder_get_output_async( p_enc );
 }
@@ -52,6 +52,12 @@
 #define VB_TEXT N_("Video bitrate")
 #define VB_LONGTEXT N_( \
     "Target bitrate of the transcoded video stream." )
+#define RENDITIONS_TEXT N_("Additional video renditions")
+#define RENDITIONS_LONGTEXT N_( \
+    "Comma-separated list of additional video outputs, as " \
+    "WIDTHxHEIGHT[:BITRATE], encoded with the same encoder from the " \
+    "decoded and filtered pictures of the main output, " \
+    "eg: renditions=\"1280x720:3000,640x360:800\"." )
 #define SCALE_TEXT N_("Video scaling")
 #define SCALE_LONGTEXT N_( \
     "Scale factor to apply to the video while transcoding (eg: 0.25)")
@@ -132,6 +138,11 @@
 #define POOL_TEXT N_("Picture pool size")
 #define POOL_LONGTEXT N_( "Defines how many pictures we allow to be in pool "\
     "between decoder/encoder threads when threads > 0" )
+#define PIPELINE_TEXT N_("Pipelined video filtering")
+#define PIPELINE_LONGTEXT N_( "Runs the video filters in their own thread, "\
+    "between the decoder and the encoder, with a queue of pool-size "\
+    "pictures. Combined with threads > 0, decoding, filtering and encoding "\
+    "run concurrently." )
 #define FORWARD_PCR_TEXT N_( "Forward PCR" )
 #define FORWARD_PCR_LONGTEXT N_( \
     "Enable PCR events forwarding to the next stream." )
@@ -167,6 +178,8 @@ vlc_module_begin ()
                 VCODEC_LONGTEXT )
     add_integer( SOUT_CFG_PREFIX "vb", 0, VB_TEXT,
                  VB_LONGTEXT )
+    add_string( SOUT_CFG_PREFIX "renditions", NULL, RENDITIONS_TEXT,
+                RENDITIONS_LONGTEXT )
     add_float( SOUT_CFG_PREFIX "scale", 0, SCALE_TEXT,
                SCALE_LONGTEXT )
     add_string( SOUT_CFG_PREFIX "fps", NULL, FPS_TEXT,
@@ -220,6 +233,8 @@ vlc_module_begin ()
         change_integer_range( 0, 32 )
     add_integer( SOUT_CFG_PREFIX "pool-size", 10, POOL_TEXT, POOL_LONGTEXT )
         change_integer_range( 1, 1000 )
+    add_bool( SOUT_CFG_PREFIX "pipeline", false, PIPELINE_TEXT,
+              PIPELINE_LONGTEXT )
     add_obsolete_bool( SOUT_CFG_PREFIX "high-priority" ) // Since 4.0.0
     add_bool( SOUT_CFG_PREFIX "forward-pcr", true, FORWARD_PCR_TEXT,
               FORWARD_PCR_LONGTEXT )
@@ -227,12 +242,12 @@ vlc_module_begin ()
 vlc_module_end ()
 
 static const char *const ppsz_sout_options[] = {
-    "venc", "vcodec", "vb",
+    "venc", "vcodec", "vb", "renditions",
     "scale", "fps", "width", "height", "vfilter", "deinterlace",
     "deinterlace-module", "threads", "aenc", "acodec", "ab", "alang",
     "afilter", "samplerate", "channels", "senc", "scodec", "soverlay",
     "sfilter", "high-priority", "maxwidth", "maxheight", "pool-size",
-    "forward-pcr", NULL
+    "pipeline", "forward-pcr", NULL
 };
 
 /*****************************************************************************
@@ -330,6 +345,59 @@ static void SetVideoEncoderConfig( sout_stream_t *p_stream, transcode_encoder_co
 
     p_cfg->video.threads.i_count = var_GetInteger( p_stream, SOUT_CFG_PREFIX "threads" );
     p_cfg->video.threads.pool_size = var_GetInteger( p_stream, SOUT_CFG_PREFIX "pool-size" );
+    p_cfg->video.threads.b_pipeline = var_GetBool( p_stream, SOUT_CFG_PREFIX "pipeline" );
+}
+
+/* Each rendition uses the main video encoder settings, with its own size
+ * and bitrate */
+static void SetVideoRenditionsConfig( sout_stream_t *p_stream,
+                                      sout_stream_sys_t *p_sys )
+{
+    char *psz_list = var_GetNonEmptyString( p_stream,
+                                            SOUT_CFG_PREFIX "renditions" );
+    if( psz_list == NULL )
+        return;
+
+    const transcode_encoder_config_t *p_main = &p_sys->venc_cfg;
+    char *psz_save;
+
+    for( const char *psz = strtok_r( psz_list, ",", &psz_save ); psz != NULL;
+         psz = strtok_r( NULL, ",", &psz_save ) )
+    {
+        unsigned i_width, i_height, i_bitrate = 0;
+
+        if( sscanf( psz, "%ux%u:%u", &i_width, &i_height, &i_bitrate ) < 2 ||
+            i_width == 0 || i_height == 0 )
+        {
+            msg_Warn( p_stream, "invalid rendition \"%s\"", psz );
+            continue;
+        }
+
+        transcode_encoder_config_t *p_cfgs =
+            realloc( p_sys->vrenditions_cfg,
+                     (p_sys->vrenditions_count + 1) * sizeof( *p_cfgs ) );
+        if( unlikely( p_cfgs == NULL ) )
+            break;
+        p_sys->vrenditions_cfg = p_cfgs;
+
+        transcode_encoder_config_t *p_cfg = &p_cfgs[p_sys->vrenditions_count++];
+        *p_cfg = *p_main;
+        p_cfg->psz_name = p_main->psz_name ? strdup( p_main->psz_name ) : NULL;
+        p_cfg->psz_lang = p_main->psz_lang ? strdup( p_main->psz_lang ) : NULL;
+        p_cfg->p_config_chain = config_ChainDuplicate( p_main->p_config_chain );
+
+        p_cfg->video.i_width = i_width;
+        p_cfg->video.i_height = i_height;
+        p_cfg->video.i_maxwidth = p_cfg->video.i_maxheight = 0;
+        p_cfg->video.f_scale = 0.f;
+        if( i_bitrate > 0 )
+            p_cfg->video.i_bitrate = i_bitrate < 16000 ? i_bitrate * 1000
+                                                       : i_bitrate;
+
+        msg_Dbg( p_stream, "video rendition %ux%u %ukb/s", i_width, i_height,
+                 p_cfg->video.i_bitrate / 1000 );
+    }
+    free( psz_list );
 }
 
 static void SetSPUEncoderConfig( sout_stream_t *p_stream, transcode_encoder_config_t *p_cfg )
@@ -458,6 +526,7 @@ static int Open( vlc_object_t *p_this )
                  p_sys->venc_cfg.video.i_height,
                  p_sys->venc_cfg.video.f_scale,
                  p_sys->venc_cfg.video.i_bitrate / 1000 );
+        SetVideoRenditionsConfig( p_stream, p_sys );
     }
 
     /* Video Filter Parameters */
@@ -517,6 +586,9 @@ static void Close( sout_stream_t *p_stream )
 
     transcode_encoder_config_clean( &p_sys->venc_cfg );
     sout_filters_config_clean( &p_sys->vfilters_cfg );
+    for( size_t i = 0; i < p_sys->vrenditions_count; i++ )
+        transcode_encoder_config_clean( &p_sys->vrenditions_cfg[i] );
+    free( p_sys->vrenditions_cfg );
 
     transcode_encoder_config_clean( &p_sys->aenc_cfg );
     sout_filters_config_clean( &p_sys->afilters_cfg );
@@ -758,7 +830,7 @@ static void Del( sout_stream_t *p_stream, void *_id )
             if( id == p_sys->id_video )
                 p_sys->id_video = NULL;
             vlc_mutex_unlock( &p_sys->lock );
-            transcode_video_clean( id );
+            transcode_video_clean( p_stream, id );
             break;
         case SPU_ES:
             dec_Delete( id->p_decoder );
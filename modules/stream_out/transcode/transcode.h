@@ -54,6 +54,9 @@ typedef struct
     /* Video */
     transcode_encoder_config_t venc_cfg;
     sout_filters_config_t vfilters_cfg;
+    /* Additional video renditions */
+    transcode_encoder_config_t *vrenditions_cfg;
+    size_t vrenditions_count;
 
     /* SPU */
     transcode_encoder_config_t senc_cfg;
@@ -74,6 +77,22 @@ typedef struct
 } sout_stream_sys_t;
 
 struct aout_filters;
+struct transcode_video_pipeline;
+
+/**
+ * Additional output of a video stream, encoded from the same pictures as the
+ * main output, after the filters and scaled to its own size.
+ */
+typedef struct
+{
+    const transcode_encoder_config_t *p_enccfg;
+    transcode_encoder_t *encoder; /**< NULL until the main encoder is open */
+    filter_chain_t  *p_conv;      /**< converter from the main encoder input */
+    vlc_fifo_t      *output_fifo;
+    void            *downstream_id;
+    char            *psz_es_id;
+    transcode_track_pcr_helper_t *pcr_helper; /**< NULL if not forwarding */
+} transcode_rendition_t;
 
 struct sout_stream_id_sys_t
 {
@@ -134,6 +153,14 @@ struct sout_stream_id_sys_t
              spu_t           *p_spu;
              vlc_decoder_device *dec_dev;
              vlc_video_context *enc_vctx_in;
+             /** Filtering thread, if the stages are pipelined */
+             struct transcode_video_pipeline *pipeline;
+             transcode_rendition_t *renditions;
+             size_t i_renditions;
+             transcode_latency_t decode_latency;
+             transcode_latency_t filter_latency;
+             /** Time spent in the queue callback by the current decode */
+             vlc_tick_t queue_duration;
          };
          struct
          {
@@ -227,7 +254,7 @@ int  transcode_audio_init   ( sout_stream_t *, const es_format_t *,
 
 /* VIDEO */
 
-void transcode_video_clean  ( sout_stream_id_sys_t * );
+void transcode_video_clean  ( sout_stream_t *, sout_stream_id_sys_t * );
 int  transcode_video_process( sout_stream_t *, sout_stream_id_sys_t *,
                                      block_t *, block_t ** );
 void transcode_video_flush  ( sout_stream_id_sys_t * );
@@ -40,6 +40,31 @@
 
 #include <math.h>
 
+/**
+ * Filtering stage, between the decoder and the encoder, when the stages are
+ * pipelined. The decoder queues its pictures, and blocks while the queue is
+ * full. The filtering thread runs the filters and the encoder on each one.
+ */
+struct transcode_video_pipeline
+{
+    sout_stream_id_sys_t *id;
+    vlc_thread_t thread;
+    vlc_mutex_t lock;
+    vlc_cond_t wait_picture; /**< signaled when a picture is queued */
+    vlc_cond_t wait_room;    /**< signaled when a picture is dequeued or done */
+    bool b_busy;             /**< a picture is being filtered */
+    bool b_abort;
+
+    unsigned i_first;
+    unsigned i_count;
+    unsigned i_size;
+    struct
+    {
+        picture_t *p_pic;
+        vlc_tick_t date; /**< when the picture was queued */
+    } queue[];
+};
+
 struct encoder_owner
 {
     encoder_t enc;
@@ -114,11 +139,203 @@ static int transcode_video_filters_init( sout_stream_t *p_stream,
                                          const es_format_t *p_dst,
                                          sout_stream_id_sys_t *id );
 
+static void PipelineWaitIdle( struct transcode_video_pipeline * );
+
+static int transcode_rendition_open( sout_stream_t *p_stream,
+                                     sout_stream_id_sys_t *id,
+                                     transcode_rendition_t *p_rend,
+                                     vlc_video_context *vctx )
+{
+    const es_format_t *p_src = transcode_encoder_format_in( id->encoder );
+
+    struct encoder_owner *p_enc_owner =
+       (struct encoder_owner *)sout_EncoderCreate( VLC_OBJECT(p_stream), sizeof(struct encoder_owner) );
+    if ( unlikely(p_enc_owner == NULL))
+        return VLC_EGENERIC;
+
+    transcode_encoder_t *encoder = transcode_encoder_new( &p_enc_owner->enc, p_src );
+    if( !encoder )
+    {
+        vlc_object_delete( &p_enc_owner->enc );
+        return VLC_EGENERIC;
+    }
+
+    p_enc_owner->id = id;
+    p_enc_owner->enc.cbs = &encoder_video_transcode_cbs;
+
+    transcode_encoder_update_format_in( encoder, p_src, p_rend->p_enccfg );
+    transcode_encoder_video_configure( VLC_OBJECT(p_stream), &id->decoder_out.video,
+                                       p_rend->p_enccfg, &p_src->video, vctx,
+                                       encoder );
+    if( transcode_encoder_open( encoder, p_rend->p_enccfg ) != VLC_SUCCESS )
+        goto error;
+
+    /* Scale the pictures of the main output */
+    filter_owner_t chain_owner = {
+       .video = &transcode_filter_video_cbs,
+       .sys = id,
+    };
+    p_rend->p_conv = filter_chain_NewVideo( p_stream, false, &chain_owner );
+    if( p_rend->p_conv == NULL )
+        goto error;
+    filter_chain_Reset( p_rend->p_conv, p_src, vctx,
+                        transcode_encoder_format_in( encoder ) );
+    if( filter_chain_AppendConverter( p_rend->p_conv, NULL ) != VLC_SUCCESS )
+        goto error;
+
+    p_rend->downstream_id =
+        id->pf_transcode_downstream_add( p_stream, id->p_decoder->fmt_in,
+                                         transcode_encoder_format_out( encoder ),
+                                         p_rend->psz_es_id );
+    if( p_rend->downstream_id == NULL )
+        goto error;
+
+    p_rend->encoder = encoder;
+    return VLC_SUCCESS;
+
+error:
+    transcode_remove_filters( &p_rend->p_conv );
+    transcode_encoder_delete( encoder );
+    return VLC_EGENERIC;
+}
+
+/* Opens the renditions which are not yet, once the main encoder is open */
+static void transcode_renditions_open( sout_stream_t *p_stream,
+                                       sout_stream_id_sys_t *id,
+                                       vlc_video_context *vctx )
+{
+    for( size_t i = 0; i < id->i_renditions; i++ )
+    {
+        transcode_rendition_t *p_rend = &id->renditions[i];
+
+        if( p_rend->encoder != NULL )
+            continue;
+        if( transcode_rendition_open( p_stream, id, p_rend, vctx ) )
+        {
+            msg_Err( p_stream, "cannot open video rendition %ux%u",
+                     p_rend->p_enccfg->video.i_width,
+                     p_rend->p_enccfg->video.i_height );
+            /* Do not hold the PCR back for a rendition without output */
+            if( p_rend->pcr_helper != NULL )
+            {
+                transcode_track_pcr_helper_Delete( p_rend->pcr_helper );
+                p_rend->pcr_helper = NULL;
+            }
+            continue;
+        }
+
+        const video_format_t *p_fmt =
+            &transcode_encoder_format_out( p_rend->encoder )->video;
+        msg_Dbg( p_stream, "video rendition %s: %ux%u", p_rend->psz_es_id,
+                 p_fmt->i_visible_width, p_fmt->i_visible_height );
+    }
+}
+
+/* Scales and encodes a picture of the main output for each rendition */
+static void transcode_renditions_encode( sout_stream_id_sys_t *id,
+                                         picture_t *p_pic )
+{
+    for( size_t i = 0; i < id->i_renditions; i++ )
+    {
+        transcode_rendition_t *p_rend = &id->renditions[i];
+
+        if( p_rend->encoder == NULL )
+            continue;
+
+        picture_t *p_scaled = filter_chain_VideoFilter( p_rend->p_conv,
+                                                        picture_Hold( p_pic ) );
+        if( p_scaled == NULL )
+            continue;
+
+        block_t *p_block = transcode_encoder_encode( p_rend->encoder, p_scaled );
+        picture_Release( p_scaled );
+        if( p_block != NULL )
+            block_FifoPut( p_rend->output_fifo, p_block );
+    }
+}
+
+/* Sends the encoded blocks of the renditions downstream */
+static void transcode_renditions_send( sout_stream_t *p_stream,
+                                       sout_stream_id_sys_t *id, bool b_drain )
+{
+    sout_stream_sys_t *p_sys = p_stream->p_sys;
+
+    for( size_t i = 0; i < id->i_renditions; i++ )
+    {
+        transcode_rendition_t *p_rend = &id->renditions[i];
+
+        if( p_rend->encoder == NULL )
+            continue;
+
+        vlc_fifo_Lock( p_rend->output_fifo );
+        block_t *p_out = vlc_fifo_DequeueAllUnlocked( p_rend->output_fifo );
+        vlc_fifo_Unlock( p_rend->output_fifo );
+
+        if( b_drain )
+        {
+            block_t *p_drained = NULL;
+            transcode_encoder_drain( p_rend->encoder, &p_drained );
+            block_ChainAppend( &p_out, p_drained );
+        }
+
+        while( p_out != NULL )
+        {
+            block_t *p_next = p_out->p_next;
+            vlc_tick_t pcr = VLC_TICK_INVALID;
+
+            p_out->p_next = NULL;
+            if( p_sys->pcr_forwarding_enabled && p_rend->pcr_helper != NULL
+             && transcode_track_pcr_helper_SignalLeavingFrame( p_rend->pcr_helper,
+                                                               p_out, &pcr ) )
+            {
+                msg_Err( p_stream, "Failed to match rendition input with "
+                         "encoder output. Disabling PCR forwarding..." );
+                p_sys->pcr_forwarding_enabled = false;
+            }
+            sout_StreamIdSend( p_stream->p_next, p_rend->downstream_id, p_out );
+            if( pcr != VLC_TICK_INVALID )
+                sout_StreamSetPCR( p_stream->p_next, pcr );
+            p_out = p_next;
+        }
+    }
+}
+
+/* Signals an input block to the PCR helpers of the renditions, as Send()
+ * does for the main output */
+static void transcode_renditions_input( sout_stream_t *p_stream,
+                                        sout_stream_id_sys_t *id,
+                                        const block_t *p_block )
+{
+    const sout_stream_sys_t *p_sys = p_stream->p_sys;
+
+    if( !p_sys->pcr_forwarding_enabled )
+        return;
+
+    for( size_t i = 0; i < id->i_renditions; i++ )
+    {
+        transcode_rendition_t *p_rend = &id->renditions[i];
+        vlc_tick_t dropped_frame_ts;
+
+        if( p_rend->pcr_helper == NULL )
+            continue;
+        transcode_track_pcr_helper_SignalEnteringFrame( p_rend->pcr_helper,
+                                                        p_block,
+                                                        &dropped_frame_ts );
+        if( dropped_frame_ts != VLC_TICK_INVALID )
+            sout_StreamSetPCR( p_stream->p_next, dropped_frame_ts );
+    }
+}
+
 static int video_update_format_decoder( decoder_t *p_dec, vlc_video_context *vctx )
 {
     struct decoder_owner *p_owner = dec_get_owner( p_dec );
     sout_stream_id_sys_t *id = p_owner->id;
 
+    /* The filters and the encoder may be reconfigured: let the filtering
+     * thread finish with the pictures of the previous format */
+    if( id->pipeline != NULL )
+        PipelineWaitIdle( id->pipeline );
+
     vlc_mutex_lock(&id->fifo.lock);
     if( id->encoder != NULL && transcode_encoder_opened( id->encoder ) )
     {
@@ -225,6 +442,10 @@ static int video_update_format_decoder( decoder_t *p_dec, vlc_video_context *vct
                                              id->p_decoder->fmt_in,
                                              transcode_encoder_format_out( id->encoder ),
                                              id->es_id );
+
+    /* The renditions are fed with the main encoder input, which does not
+     * change once it is open */
+    transcode_renditions_open( p_owner->p_stream, id, enc_vctx );
     msg_Info( p_dec, "video format update succeed" );
 
 end:
@@ -250,15 +471,15 @@ static picture_t *video_new_buffer_encoder( transcode_encoder_t *p_enc )
 }
 
 static int transcode_process_picture( sout_stream_id_sys_t *id,
-                                      picture_t *p_pic, block_t **out);
+                                      picture_t *p_pic, vlc_tick_t date,
+                                      block_t **out);
 
-static void decoder_queue_video( decoder_t *p_dec, picture_t *p_pic )
+/* Filters and encodes a picture queued at the given date */
+static void transcode_video_output( sout_stream_id_sys_t *id,
+                                    picture_t *p_pic, vlc_tick_t date )
 {
-    struct decoder_owner *p_owner = dec_get_owner( p_dec );
-    sout_stream_id_sys_t *id = p_owner->id;
-
     block_t *p_block = NULL;
-    int ret = transcode_process_picture( id, p_pic, &p_block );
+    int ret = transcode_process_picture( id, p_pic, date, &p_block );
 
     if( p_block == NULL )
         return;
@@ -276,6 +497,200 @@ static void decoder_queue_video( decoder_t *p_dec, picture_t *p_pic )
     vlc_fifo_Unlock( id->output_fifo );
 }
 
+static void *PipelineThread( void *data )
+{
+    vlc_thread_set_name("vlc-transcode-filter");
+
+    struct transcode_video_pipeline *p_pipe = data;
+
+    vlc_mutex_lock( &p_pipe->lock );
+    for( ;; )
+    {
+        while( p_pipe->i_count == 0 && !p_pipe->b_abort )
+            vlc_cond_wait( &p_pipe->wait_picture, &p_pipe->lock );
+        if( p_pipe->i_count == 0 )
+            break;
+
+        picture_t *p_pic = p_pipe->queue[p_pipe->i_first].p_pic;
+        vlc_tick_t date = p_pipe->queue[p_pipe->i_first].date;
+
+        p_pipe->i_first = (p_pipe->i_first + 1) % p_pipe->i_size;
+        p_pipe->i_count--;
+        p_pipe->b_busy = true;
+        vlc_cond_broadcast( &p_pipe->wait_room );
+        vlc_mutex_unlock( &p_pipe->lock );
+
+        transcode_video_output( p_pipe->id, p_pic, date );
+
+        vlc_mutex_lock( &p_pipe->lock );
+        p_pipe->b_busy = false;
+        vlc_cond_broadcast( &p_pipe->wait_room );
+    }
+    vlc_mutex_unlock( &p_pipe->lock );
+
+    return NULL;
+}
+
+static struct transcode_video_pipeline *PipelineNew( sout_stream_id_sys_t *id,
+                                                     unsigned i_size )
+{
+    struct transcode_video_pipeline *p_pipe;
+
+    i_size = __MAX( i_size, 1 );
+    p_pipe = malloc( sizeof( *p_pipe ) + i_size * sizeof( p_pipe->queue[0] ) );
+    if( unlikely( p_pipe == NULL ) )
+        return NULL;
+
+    p_pipe->id = id;
+    vlc_mutex_init( &p_pipe->lock );
+    vlc_cond_init( &p_pipe->wait_picture );
+    vlc_cond_init( &p_pipe->wait_room );
+    p_pipe->b_busy = false;
+    p_pipe->b_abort = false;
+    p_pipe->i_first = 0;
+    p_pipe->i_count = 0;
+    p_pipe->i_size = i_size;
+
+    if( vlc_clone( &p_pipe->thread, PipelineThread, p_pipe ) )
+    {
+        free( p_pipe );
+        return NULL;
+    }
+    return p_pipe;
+}
+
+/* Waits until the filtering thread has processed all the queued pictures */
+static void PipelineWaitIdle( struct transcode_video_pipeline *p_pipe )
+{
+    vlc_mutex_lock( &p_pipe->lock );
+    while( p_pipe->i_count > 0 || p_pipe->b_busy )
+        vlc_cond_wait( &p_pipe->wait_room, &p_pipe->lock );
+    vlc_mutex_unlock( &p_pipe->lock );
+}
+
+/* Drops the queued pictures, and waits for the one being filtered */
+static void PipelineFlush( struct transcode_video_pipeline *p_pipe )
+{
+    vlc_mutex_lock( &p_pipe->lock );
+    for( ; p_pipe->i_count > 0; p_pipe->i_count-- )
+    {
+        picture_Release( p_pipe->queue[p_pipe->i_first].p_pic );
+        p_pipe->i_first = (p_pipe->i_first + 1) % p_pipe->i_size;
+    }
+    while( p_pipe->b_busy )
+        vlc_cond_wait( &p_pipe->wait_room, &p_pipe->lock );
+    vlc_mutex_unlock( &p_pipe->lock );
+}
+
+static void PipelineDelete( struct transcode_video_pipeline *p_pipe )
+{
+    PipelineFlush( p_pipe );
+
+    vlc_mutex_lock( &p_pipe->lock );
+    p_pipe->b_abort = true;
+    vlc_cond_signal( &p_pipe->wait_picture );
+    vlc_mutex_unlock( &p_pipe->lock );
+
+    vlc_join( p_pipe->thread, NULL );
+    free( p_pipe );
+}
+
+static void PipelineQueue( struct transcode_video_pipeline *p_pipe,
+                           picture_t *p_pic )
+{
+    vlc_mutex_lock( &p_pipe->lock );
+    while( p_pipe->i_count == p_pipe->i_size )
+        vlc_cond_wait( &p_pipe->wait_room, &p_pipe->lock );
+
+    unsigned i_last = (p_pipe->i_first + p_pipe->i_count) % p_pipe->i_size;
+    p_pipe->queue[i_last].p_pic = p_pic;
+    p_pipe->queue[i_last].date = vlc_tick_now();
+    p_pipe->i_count++;
+    vlc_cond_signal( &p_pipe->wait_picture );
+    vlc_mutex_unlock( &p_pipe->lock );
+}
+
+static void decoder_queue_video( decoder_t *p_dec, picture_t *p_pic )
+{
+    struct decoder_owner *p_owner = dec_get_owner( p_dec );
+    sout_stream_id_sys_t *id = p_owner->id;
+    vlc_tick_t start = vlc_tick_now();
+
+    if( id->pipeline != NULL )
+        PipelineQueue( id->pipeline, p_pic );
+    else
+        transcode_video_output( id, p_pic, start );
+
+    id->queue_duration += vlc_tick_now() - start;
+}
+
+static int transcode_renditions_init( sout_stream_t *p_stream,
+                                      sout_stream_id_sys_t *id )
+{
+    const sout_stream_sys_t *p_sys = p_stream->p_sys;
+
+    if( p_sys->vrenditions_count == 0 )
+        return VLC_SUCCESS;
+
+    id->renditions = calloc( p_sys->vrenditions_count,
+                             sizeof( *id->renditions ) );
+    if( unlikely( id->renditions == NULL ) )
+        return VLC_ENOMEM;
+
+    for( ; id->i_renditions < p_sys->vrenditions_count; id->i_renditions++ )
+    {
+        transcode_rendition_t *p_rend = &id->renditions[id->i_renditions];
+
+        p_rend->p_enccfg = &p_sys->vrenditions_cfg[id->i_renditions];
+        p_rend->output_fifo = block_FifoNew();
+        if( p_rend->output_fifo == NULL )
+            return VLC_ENOMEM;
+        if( asprintf( &p_rend->psz_es_id, "%s/%zu", id->es_id,
+                      id->i_renditions + 1 ) < 0 )
+        {
+            block_FifoRelease( p_rend->output_fifo );
+            return VLC_ENOMEM;
+        }
+        /* Each rendition is a transcoded ES of its own for the PCR */
+        if( p_sys->pcr_forwarding_enabled )
+        {
+            p_rend->pcr_helper =
+                transcode_track_pcr_helper_New( p_sys->pcr_sync,
+                                                VLC_TICK_FROM_SEC( 4 ) );
+            if( unlikely( p_rend->pcr_helper == NULL ) )
+            {
+                block_FifoRelease( p_rend->output_fifo );
+                free( p_rend->psz_es_id );
+                return VLC_ENOMEM;
+            }
+        }
+    }
+    return VLC_SUCCESS;
+}
+
+static void transcode_renditions_clean( sout_stream_t *p_stream,
+                                        sout_stream_id_sys_t *id )
+{
+    for( size_t i = 0; i < id->i_renditions; i++ )
+    {
+        transcode_rendition_t *p_rend = &id->renditions[i];
+
+        if( p_rend->encoder != NULL )
+        {
+            transcode_encoder_delete( p_rend->encoder );
+            transcode_remove_filters( &p_rend->p_conv );
+            sout_StreamIdDel( p_stream->p_next, p_rend->downstream_id );
+        }
+        if( p_rend->pcr_helper != NULL )
+            transcode_track_pcr_helper_Delete( p_rend->pcr_helper );
+        block_FifoRelease( p_rend->output_fifo );
+        free( p_rend->psz_es_id );
+    }
+    free( id->renditions );
+    id->renditions = NULL;
+    id->i_renditions = 0;
+}
+
 int transcode_video_init( sout_stream_t *p_stream, const es_format_t *p_fmt,
                           sout_stream_id_sys_t *id )
 {
@@ -307,11 +722,40 @@ int transcode_video_init( sout_stream_t *p_stream, const es_format_t *p_fmt,
     id->p_decoder->pf_decode = NULL;
     id->p_decoder->pf_get_cc = NULL;
 
+    if( transcode_renditions_init( p_stream, id ) != VLC_SUCCESS )
+    {
+        transcode_renditions_clean( p_stream, id );
+        es_format_Clean( &id->decoder_out );
+        return VLC_ENOMEM;
+    }
+
+    if( id->p_enccfg->video.threads.b_pipeline )
+    {
+        /* The filtering thread blends the subpictures: create the SPU
+         * before it starts, rather than when the first one is pushed */
+        if( id->p_spu == NULL )
+            id->p_spu = spu_Create( p_stream, NULL );
+        id->pipeline = PipelineNew( id, id->p_enccfg->video.threads.pool_size );
+        if( id->pipeline == NULL )
+            msg_Warn( p_stream, "cannot start the filtering thread" );
+    }
+
     decoder_LoadModule( id->p_decoder, false, true );
 
     if( !id->p_decoder->p_module )
     {
         msg_Err( p_stream, "cannot find video decoder" );
+        if( id->pipeline != NULL )
+        {
+            PipelineDelete( id->pipeline );
+            id->pipeline = NULL;
+        }
+        if( id->p_spu )
+        {
+            spu_Destroy( id->p_spu );
+            id->p_spu = NULL;
+        }
+        transcode_renditions_clean( p_stream, id );
         es_format_Clean( &id->decoder_out );
         return VLC_EGENERIC;
     }
@@ -395,16 +839,26 @@ static int transcode_video_filters_init( sout_stream_t *p_stream,
 
 void transcode_video_flush( sout_stream_id_sys_t *id )
 {
+    if ( id->pipeline != NULL )
+        PipelineFlush( id->pipeline );
     if ( id->p_f_chain != NULL )
         filter_chain_VideoFlush( id->p_f_chain );
     if ( id->p_uf_chain != NULL )
         filter_chain_VideoFlush( id->p_uf_chain );
     if ( id->p_final_conv_static != NULL )
         filter_chain_VideoFlush( id->p_final_conv_static );
+    for( size_t i = 0; i < id->i_renditions; i++ )
+        if( id->renditions[i].p_conv != NULL )
+            filter_chain_VideoFlush( id->renditions[i].p_conv );
 }
 
-void transcode_video_clean( sout_stream_id_sys_t *id )
+void transcode_video_clean( sout_stream_t *p_stream, sout_stream_id_sys_t *id )
 {
+    if ( id->pipeline != NULL )
+        PipelineDelete( id->pipeline );
+
+    transcode_renditions_clean( p_stream, id );
+
     /* Close encoder, but only if one was opened. */
     if ( id->encoder )
         transcode_encoder_delete( id->encoder );
@@ -428,7 +882,8 @@ void transcode_video_clean( sout_stream_id_sys_t *id )
 void transcode_video_push_spu( sout_stream_t *p_stream, sout_stream_id_sys_t *id,
                                subpicture_t *p_subpicture )
 {
-    if( !id->p_spu )
+    /* The filtering thread reads the SPU without locking */
+    if( !id->p_spu && id->pipeline == NULL )
         id->p_spu = spu_Create( p_stream, NULL );
     if( !id->p_spu )
         subpicture_Delete( p_subpicture );
@@ -509,8 +964,12 @@ static void tag_last_block_with_flag( block_t **out, int i_flag )
 }
 
 static int transcode_process_picture( sout_stream_id_sys_t *id,
-                                      picture_t *p_pic, block_t **out)
+                                      picture_t *p_pic, vlc_tick_t date,
+                                      block_t **out)
 {
+    /* Time spent in the encoder, which is not part of the filtering stage */
+    vlc_tick_t encoding = 0;
+
     /* Run the filter and output chains; first with the picture,
      * and then with NULL as many times as we need until they
      * stop outputting frames.
@@ -545,13 +1004,20 @@ static int transcode_process_picture( sout_stream_id_sys_t *id,
             if( p_in )
             {
                 /* If a packetizer is used, multiple blocks might be returned, in w */
+                vlc_tick_t start = vlc_tick_now();
+                transcode_renditions_encode( id, p_in );
                 block_t *p_encoded = transcode_encoder_encode( id->encoder, p_in );
+                encoding += vlc_tick_now() - start;
                 picture_Release( p_in );
                 block_ChainAppend( out, p_encoded );
             }
         }
     }
 
+    transcode_latency_Add( &id->filter_latency,
+                           vlc_tick_now() - date - encoding );
+    transcode_latency_Report( VLC_OBJECT(dec_get_owner( id->p_decoder )->p_stream),
+                              "filter", &id->filter_latency, false );
     return VLC_SUCCESS;
 }
 
@@ -561,11 +1027,28 @@ int transcode_video_process( sout_stream_t *p_stream, sout_stream_id_sys_t *id,
     *out = NULL;
 
     bool b_eos = in && (in->i_flags & BLOCK_FLAG_END_OF_SEQUENCE);
-
+    bool b_drain = in == NULL;
+
+    /* The time spent queueing the decoded pictures, or filtering and
+     * encoding them without pipeline, is not part of the decoding stage */
+    id->queue_duration = 0;
+    if( in != NULL )
+        transcode_renditions_input( p_stream, id, in );
+    vlc_tick_t start = vlc_tick_now();
     int ret = id->p_decoder->pf_decode( id->p_decoder, in );
+    if( !b_drain )
+    {
+        transcode_latency_Add( &id->decode_latency,
+                               vlc_tick_now() - start - id->queue_duration );
+        transcode_latency_Report( VLC_OBJECT(p_stream), "decode",
+                                  &id->decode_latency, false );
+    }
     if( ret != VLCDEC_SUCCESS )
         return VLC_EGENERIC;
 
+    if( b_drain && id->pipeline != NULL )
+        PipelineWaitIdle( id->pipeline );
+
     /*
      * Encoder creation depends on decoder's update_format which is only
      * created once a few frames have been passed to the decoder.
@@ -598,6 +1081,21 @@ int transcode_video_process( sout_stream_t *p_stream, sout_stream_id_sys_t *id,
     if (drained != NULL)
         block_ChainRelease(drained);
 
+    if( !has_error )
+        transcode_renditions_send( p_stream, id, b_drain );
+
+    if( b_drain )
+    {
+        transcode_latency_Report( VLC_OBJECT(p_stream), "decode",
+                                  &id->decode_latency, true );
+        transcode_latency_Report( VLC_OBJECT(p_stream), "filter",
+                                  &id->filter_latency, true );
+        if( transcode_encoder_opened( id->encoder ) )
+            transcode_latency_Report( VLC_OBJECT(p_stream), "encode",
+                                      transcode_encoder_latency( id->encoder ),
+                                      true );
+    }
+
     if( b_eos )
         tag_last_block_with_flag( out, BLOCK_FLAG_END_OF_SEQUENCE );
 
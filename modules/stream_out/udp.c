@@ -39,14 +39,17 @@
 #include <vlc_network.h>
 #include <vlc_memstream.h>
 #include "sdp_helper.h"
+#include "udp_batch.h"
 
 struct sout_stream_udp
 {
     sout_access_out_t *access;
     sout_mux_t *mux;
     session_descriptor_t *sap;
+    struct udp_batch *batch;
     int fd;
     uint_fast16_t mtu;
+    bool gso;
 };
 
 static void *
@@ -144,9 +147,37 @@ static int Control(sout_stream_t *stream, int query, va_list args)
     return VLC_SUCCESS;
 }
 
+/**
+ * Sends the pending datagrams, then frees their blocks up to @p end.
+ * @return the number of bytes actually sent
+ */
+static ssize_t FlushBatch(sout_access_out_t *access, block_t *block,
+                          const block_t *end)
+{
+    struct sout_stream_udp *sys = access->p_sys;
+    size_t total = 0;
+
+    if (udp_batch_Count(sys->batch) > 0) {
+        int val = udp_batch_Send(sys->batch, sys->fd, &sys->gso, &total);
+
+        if (val != 0)
+            msg_Err(access, "send error: %s", vlc_strerror_c(val));
+        udp_batch_Reset(sys->batch);
+    }
+
+    while (block != end) {
+        block_t *next = block->p_next;
+
+        block_Release(block);
+        block = next;
+    }
+    return total;
+}
+
 static ssize_t AccessOutWrite(sout_access_out_t *access, block_t *block)
 {
     struct sout_stream_udp *sys = access->p_sys;
+    block_t *sent = block;
     ssize_t total = 0;
 
     while (block != NULL) {
@@ -169,24 +200,16 @@ static ssize_t AccessOutWrite(sout_access_out_t *access, block_t *block)
             unsent = unsent->p_next;
         } while (unsent != NULL);
 
-        /* Send */
-        struct msghdr hdr = { .msg_iov = iov, .msg_iovlen = iovlen };
-        ssize_t val = sendmsg(sys->fd, &hdr, 0);
-
-        if (val < 0)
-            msg_Err(access, "send error: %s", vlc_strerror_c(errno));
-        else
-            total += val;
-
-        /* Free */
-        do {
-            block_t *next = block->p_next;
-
-            block_Release(block);
-            block = next;
-        } while (block != unsent);
+        /* Send once the batch is full */
+        if (!udp_batch_Add(sys->batch, iov, iovlen)) {
+            total += FlushBatch(access, sent, block);
+            sent = block;
+            udp_batch_Add(sys->batch, iov, iovlen);
+        }
+        block = unsent;
     }
 
+    total += FlushBatch(access, sent, NULL);
     return total;
 }
 
@@ -200,6 +223,7 @@ static void Close(sout_stream_t *stream)
     sout_MuxDelete(sys->mux);
     sout_AccessOutDelete(sys->access);
     net_Close(sys->fd);
+    udp_batch_Delete(sys->batch);
     free(sys);
 }
 
@@ -293,6 +317,15 @@ static int Open(vlc_object_t *obj)
         goto error;
     }
 
+    sys->batch = udp_batch_New();
+    if (unlikely(sys->batch == NULL)) {
+        ret = VLC_ENOMEM;
+        goto error;
+    }
+    sys->gso = udp_batch_ProbeGSO(fd);
+    if (sys->gso)
+        msg_Dbg(stream, "using UDP segmentation offload");
+
     access = vlc_object_create(stream, sizeof (*access));
     if (unlikely(access == NULL)) {
         ret = VLC_ENOMEM;
@@ -331,6 +364,8 @@ static int Open(vlc_object_t *obj)
 error:
     if (access != NULL)
         sout_AccessOutDelete(access);
+    if (sys != NULL)
+        udp_batch_Delete(sys->batch);
     free(sys);
     net_Close(fd);
     return ret;
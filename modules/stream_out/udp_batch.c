@@ -0,0 +1,272 @@
+/*****************************************************************************
+ * udp_batch.c: batched datagram transmission
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vlc_common.h>
+#include <vlc_network.h>
+#ifdef HAVE_SYS_UIO_H
+# include <sys/uio.h>
+#endif
+#ifdef __linux__
+# include <netinet/udp.h>
+#endif
+
+#include "udp_batch.h"
+
+#ifdef _WIN32
+# undef ENOBUFS
+# define ENOBUFS      WSAENOBUFS
+# undef EAGAIN
+# define EAGAIN       WSAEWOULDBLOCK
+# undef EWOULDBLOCK
+# define EWOULDBLOCK  WSAEWOULDBLOCK
+#endif
+
+/* Maximum number of gathered buffers per datagram */
+#define UDP_BATCH_IOV 16
+
+#ifdef UDP_SEGMENT
+/* Kernels before 5.5 accept at most 64 segments per GSO super-datagram */
+# define GSO_MAX_SEGMENTS 64
+/* Largest IPv4 UDP payload */
+# define GSO_MAX_SIZE 65507
+#endif
+
+struct udp_batch
+{
+    unsigned count; /**< number of datagrams */
+    unsigned iovc; /**< number of used I/O vectors */
+
+    struct
+    {
+        unsigned iov; /**< index of the first I/O vector */
+        unsigned iovcnt;
+        size_t length;
+    } dgram[UDP_BATCH_MAX];
+
+    /* Messages are built at send time; each one carries one datagram, or a
+     * run of datagrams coalesced for segmentation offload. */
+    unsigned first[UDP_BATCH_MAX]; /**< first datagram of each message */
+#ifdef HAVE_SENDMMSG
+    struct mmsghdr msgs[UDP_BATCH_MAX];
+#else
+    struct msghdr msgs[UDP_BATCH_MAX];
+#endif
+#ifdef UDP_SEGMENT
+    union
+    {
+        struct cmsghdr hdr;
+        char buf[CMSG_SPACE(sizeof (uint16_t))];
+    } control[UDP_BATCH_MAX];
+#endif
+    struct iovec iov[UDP_BATCH_MAX * UDP_BATCH_IOV];
+};
+
+#ifdef HAVE_SENDMMSG
+# define MSGHDR(b, i) (&(b)->msgs[i].msg_hdr)
+#else
+# define MSGHDR(b, i) (&(b)->msgs[i])
+#endif
+
+struct udp_batch *udp_batch_New(void)
+{
+    struct udp_batch *b = malloc(sizeof (*b));
+
+    if (likely(b != NULL))
+        udp_batch_Reset(b);
+    return b;
+}
+
+void udp_batch_Delete(struct udp_batch *b)
+{
+    free(b);
+}
+
+bool udp_batch_ProbeGSO(int fd)
+{
+#ifdef UDP_SEGMENT
+    int type, val;
+
+    if (getsockopt(fd, SOL_SOCKET, SO_TYPE, &type,
+                   &(socklen_t){ sizeof (type) }) || type != SOCK_DGRAM)
+        return false;
+    return getsockopt(fd, IPPROTO_UDP, UDP_SEGMENT, &val,
+                      &(socklen_t){ sizeof (val) }) == 0;
+#else
+    (void) fd;
+    return false;
+#endif
+}
+
+bool udp_batch_Add(struct udp_batch *b, const struct iovec *iov,
+                   unsigned iovcnt)
+{
+    assert(iovcnt <= UDP_BATCH_IOV);
+
+    if (b->count >= UDP_BATCH_MAX)
+        return false;
+
+    size_t length = 0;
+
+    for (unsigned i = 0; i < iovcnt; i++)
+        length += iov[i].iov_len;
+
+    b->dgram[b->count].iov = b->iovc;
+    b->dgram[b->count].iovcnt = iovcnt;
+    b->dgram[b->count].length = length;
+    memcpy(b->iov + b->iovc, iov, iovcnt * sizeof (*iov));
+    b->iovc += iovcnt;
+    b->count++;
+    return true;
+}
+
+unsigned udp_batch_Count(const struct udp_batch *b)
+{
+    return b->count;
+}
+
+void udp_batch_Reset(struct udp_batch *b)
+{
+    b->count = 0;
+    b->iovc = 0;
+}
+
+/**
+ * Builds the messages for the datagrams from @p from onward.
+ * @return the number of messages
+ */
+static unsigned udp_batch_Build(struct udp_batch *b, unsigned from, bool gso)
+{
+    unsigned n = 0;
+
+    for (unsigned i = from; i < b->count; n++) {
+        struct msghdr *hdr = MSGHDR(b, n);
+        unsigned segs = 1;
+
+        memset(hdr, 0, sizeof (*hdr));
+        hdr->msg_iov = b->iov + b->dgram[i].iov;
+        hdr->msg_iovlen = b->dgram[i].iovcnt;
+        b->first[n] = i;
+
+#ifdef UDP_SEGMENT
+        if (gso) {
+            size_t seglen = b->dgram[i].length;
+            size_t total = seglen;
+
+            /* All segments but the last one must have the same length */
+            while (i + segs < b->count && segs < GSO_MAX_SEGMENTS) {
+                size_t len = b->dgram[i + segs].length;
+
+                if (len > seglen || total + len > GSO_MAX_SIZE)
+                    break;
+                hdr->msg_iovlen += b->dgram[i + segs].iovcnt;
+                total += len;
+                segs++;
+                if (len < seglen)
+                    break;
+            }
+
+            if (segs > 1) {
+                struct cmsghdr *cmsg = &b->control[n].hdr;
+                uint16_t size = seglen;
+
+                hdr->msg_control = b->control[n].buf;
+                hdr->msg_controllen = sizeof (b->control[n].buf);
+                cmsg->cmsg_level = IPPROTO_UDP;
+                cmsg->cmsg_type = UDP_SEGMENT;
+                cmsg->cmsg_len = CMSG_LEN(sizeof (size));
+                memcpy(CMSG_DATA(cmsg), &size, sizeof (size));
+            }
+        }
+#else
+        (void) gso;
+#endif
+        i += segs;
+    }
+    return n;
+}
+
+int udp_batch_Send(struct udp_batch *b, int fd, bool *gso, size_t *sent)
+{
+    bool offload = gso != NULL && *gso;
+    unsigned n = udp_batch_Build(b, 0, offload);
+    unsigned done = 0;
+    bool retried = false;
+    size_t bytes = 0;
+    int ret = 0;
+
+    while (done < n) {
+#ifdef HAVE_SENDMMSG
+        int val = sendmmsg(fd, b->msgs + done, n - done, 0);
+
+        for (int i = 0; i < val; i++)
+            bytes += b->msgs[done + i].msg_len;
+#else
+        ssize_t len = sendmsg(fd, MSGHDR(b, done), 0);
+        int val = len >= 0 ? 1 : -1;
+
+        if (len > 0)
+            bytes += len;
+#endif
+        if (val > 0) {
+            done += val;
+            retried = false;
+            continue;
+        }
+
+        int err = net_errno;
+
+        if (offload && MSGHDR(b, done)->msg_controllen > 0
+         && (err == EIO || err == EINVAL || err == EOPNOTSUPP)) {
+            /* The interface cannot segment: give up on offloading */
+            *gso = offload = false;
+            n = udp_batch_Build(b, b->first[done], false);
+            done = 0;
+            continue;
+        }
+
+        if (err == EINTR)
+            continue;
+
+        if (err == EAGAIN || err == EWOULDBLOCK || err == ENOBUFS
+         || err == ENOMEM)
+            done++; /* transient error: drop the message */
+        else if (!retried) {
+            retried = true; /* ICMP soft error: retry once */
+            continue;
+        } else {
+            ret = err;
+            done++;
+        }
+        retried = false;
+    }
+
+    if (sent != NULL)
+        *sent = bytes;
+    return ret;
+}
@@ -0,0 +1,82 @@
+/*****************************************************************************
+ * udp_batch.h: batched datagram transmission
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifndef VLC_SOUT_UDP_BATCH_H
+#define VLC_SOUT_UDP_BATCH_H
+
+#include <stdbool.h>
+
+struct iovec;
+
+/** Maximum number of datagrams in a batch */
+#define UDP_BATCH_MAX 64
+
+struct udp_batch;
+
+struct udp_batch *udp_batch_New(void) VLC_USED;
+void udp_batch_Delete(struct udp_batch *);
+
+/**
+ * Checks whether UDP generic segmentation offload can be used on a socket.
+ */
+bool udp_batch_ProbeGSO(int fd) VLC_USED;
+
+/**
+ * Appends a datagram to a batch.
+ *
+ * The datagram payload is gathered from the given I/O vectors. The memory
+ * they point to must remain valid until the batch is reset.
+ *
+ * @return false if the batch is full, true otherwise
+ */
+bool udp_batch_Add(struct udp_batch *, const struct iovec *iov,
+                   unsigned iovcnt);
+
+/**
+ * @return the number of datagrams in a batch
+ */
+unsigned udp_batch_Count(const struct udp_batch *) VLC_USED;
+
+/**
+ * Sends all datagrams of a batch through a connected socket.
+ *
+ * Datagrams are sent with as few system calls as possible, with sendmmsg()
+ * where available. If @p gso points to true, runs of equal-sized datagrams
+ * are further coalesced with UDP generic segmentation offload. If the socket
+ * or the network interface refuses offloading, it is turned off by setting
+ * the pointed boolean to false, and the remaining datagrams are sent without.
+ *
+ * Transient errors (full buffers) drop the datagram. A datagram failing with
+ * another error is retried once (e.g. after an ICMP soft error).
+ *
+ * The batch is left untouched, so it can be sent to several sockets.
+ *
+ * @param sent if not NULL, where to store the number of payload bytes
+ *             actually sent, not counting dropped datagrams
+ * @return 0 on success, or the last non-transient error
+ */
+int udp_batch_Send(struct udp_batch *, int fd, bool *gso, size_t *sent);
+
+/**
+ * Removes all datagrams from a batch.
+ */
+void udp_batch_Reset(struct udp_batch *);
+
+#endif
@@ -32,9 +32,42 @@
 #include <vlc_common.h>
 #include <vlc_picture.h>
 #include <vlc_cpu.h>
+#include <vlc_executor.h>
 #include <assert.h>
 
 #include "copy.h"
+
+/* Maximum number of stripes a frame is split in: copies are bound by the
+ * memory bandwidth, which a few threads are enough to saturate */
+#define COPY_MAX_STRIPES 4
+/* Minimum line width, in bytes, for a cache to get worker threads */
+#define COPY_POOL_MIN_WIDTH 3840
+/* Minimum size, in bytes, of the first plane of each stripe */
+#define COPY_STRIPE_MIN_SIZE (2 << 20)
+
+typedef void (*copy_conv_cb)(picture_t *, const uint8_t *[], const size_t [],
+                             unsigned, int, const copy_cache_t *);
+
+struct copy_stripe
+{
+    struct vlc_runnable runnable;
+    copy_conv_cb conv;
+    picture_t dst;
+    const uint8_t *src[3];
+    const size_t *src_pitch;
+    unsigned height;
+    int bitshift;
+    const copy_cache_t *cache;
+};
+
+struct copy_pool
+{
+    vlc_executor_t *executor;
+    unsigned count; /**< number of stripes, including the caller's one */
+    copy_cache_t caches[COPY_MAX_STRIPES - 1];
+    struct copy_stripe stripes[COPY_MAX_STRIPES - 1];
+};
+
 static void CopyPlane(uint8_t *dst, size_t dst_pitch,
                       const uint8_t *src, size_t src_pitch,
                       unsigned height, int bitshift);
@@ -51,7 +84,7 @@ static void CopyPlane(uint8_t *dst, size_t dst_pitch,
 #define ASSERT_3PLANES ASSERT_2PLANES; \
     ASSERT_PLANE(2)
 
-int CopyInitCache(copy_cache_t *cache, unsigned width)
+static int CopyInitBuffer(copy_cache_t *cache, unsigned width)
 {
 #ifdef CAN_COMPILE_SSE2
     cache->size = __MAX((width + 0x3f) & ~ 0x3f, 16384);
@@ -59,12 +92,13 @@ int CopyInitCache(copy_cache_t *cache, unsigned width)
     if (!cache->buffer)
         return VLC_EGENERIC;
 #else
-    (void) cache; (void) width;
+    (void) width;
 #endif
+    cache->pool = NULL;
     return VLC_SUCCESS;
 }
 
-void CopyCleanCache(copy_cache_t *cache)
+static void CopyCleanBuffer(copy_cache_t *cache)
 {
 #ifdef CAN_COMPILE_SSE2
     aligned_free(cache->buffer);
@@ -75,6 +109,76 @@ void CopyCleanCache(copy_cache_t *cache)
 #endif
 }
 
+static void CopyStripeRun(void *data)
+{
+    struct copy_stripe *stripe = data;
+
+    stripe->conv(&stripe->dst, stripe->src, stripe->src_pitch,
+                 stripe->height, stripe->bitshift, stripe->cache);
+}
+
+static void CopyPoolDelete(struct copy_pool *pool)
+{
+    if (pool->executor != NULL)
+        vlc_executor_Delete(pool->executor);
+    for (unsigned i = 1; i < pool->count; i++)
+        CopyCleanBuffer(&pool->caches[i - 1]);
+    free(pool);
+}
+
+static struct copy_pool *CopyPoolNew(unsigned width)
+{
+    const unsigned count = __MIN(vlc_GetCPUCount(), COPY_MAX_STRIPES);
+    if (count < 2)
+        return NULL;
+
+    struct copy_pool *pool = malloc(sizeof (*pool));
+    if (unlikely(pool == NULL))
+        return NULL;
+
+    pool->executor = NULL;
+    /* The calling thread copies the first stripe with its own cache */
+    for (pool->count = 1; pool->count < count; pool->count++)
+    {
+        struct copy_stripe *stripe = &pool->stripes[pool->count - 1];
+
+        if (CopyInitBuffer(&pool->caches[pool->count - 1], width))
+            break;
+        stripe->runnable.run = CopyStripeRun;
+        stripe->runnable.userdata = stripe;
+        stripe->cache = &pool->caches[pool->count - 1];
+    }
+
+    if (pool->count > 1)
+        pool->executor = vlc_executor_New(pool->count - 1);
+    if (pool->executor == NULL)
+    {
+        CopyPoolDelete(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+int CopyInitCache(copy_cache_t *cache, unsigned width)
+{
+    if (CopyInitBuffer(cache, width))
+        return VLC_EGENERIC;
+    /* Without a pool, copies are done by the calling thread only */
+    if (width >= COPY_POOL_MIN_WIDTH)
+        cache->pool = CopyPoolNew(width);
+    return VLC_SUCCESS;
+}
+
+void CopyCleanCache(copy_cache_t *cache)
+{
+    if (cache->pool != NULL)
+    {
+        CopyPoolDelete(cache->pool);
+        cache->pool = NULL;
+    }
+    CopyCleanBuffer(cache);
+}
+
 #ifdef CAN_COMPILE_SSE2
 /* Copy 16/64 bytes from srcp to dstp loading data with the SSE>=2 instruction
  * load and storing data with the SSE>=2 instruction store.
@@ -122,6 +226,10 @@ void CopyCleanCache(copy_cache_t *cache)
     COPY64_S(dstp, srcp, load, store, "")
 
 #ifdef COPY_TEST_NOOPTIM
+# undef vlc_CPU_AVX512
+# define vlc_CPU_AVX512() (0)
+# undef vlc_CPU_AVX2
+# define vlc_CPU_AVX2() (0)
 # undef vlc_CPU_SSE4_1
 # define vlc_CPU_SSE4_1() (0)
 # undef vlc_CPU_SSE3
@@ -460,6 +568,222 @@ static void SSE_SplitUV(uint8_t *dstu, size_t dstu_pitch,
 #undef LOAD64
 }
 
+#ifdef CAN_COMPILE_AVX2
+static const uint8_t split_shuffle_8[] = { 0, 2, 4, 6, 8, 10, 12, 14,
+                                           1, 3, 5, 7, 9, 11, 13, 15 };
+static const uint8_t split_shuffle_16[] = {  0,  1,  4,  5,  8,  9, 12, 13,
+                                             2,  3,  6,  7, 10, 11, 14, 15 };
+
+static void SplitUVTail(uint8_t *dstu, uint8_t *dstv, const uint8_t *src,
+                        unsigned x, unsigned width, uint8_t pixel_size)
+{
+    if (pixel_size == 1)
+    {
+        for (; x < width; x++) {
+            dstu[x] = src[2*x+0];
+            dstv[x] = src[2*x+1];
+        }
+    }
+    else
+    {
+        for (; x < width; x+= 2) {
+            dstu[x] = src[2*x+0];
+            dstu[x+1] = src[2*x+1];
+            dstv[x] = src[2*x+2];
+            dstv[x+1] = src[2*x+3];
+        }
+    }
+}
+
+static void InterleaveUVTail(uint8_t *dst, const uint8_t *srcu,
+                             const uint8_t *srcv, unsigned x, unsigned width,
+                             uint8_t pixel_size)
+{
+    if (pixel_size == 1)
+    {
+        for (; x < width; x++) {
+            dst[2*x+0] = srcu[x];
+            dst[2*x+1] = srcv[x];
+        }
+    }
+    else
+    {
+        for (; x < width; x+= 2) {
+            dst[2*x+0] = srcu[x];
+            dst[2*x+1] = srcu[x + 1];
+            dst[2*x+2] = srcv[x];
+            dst[2*x+3] = srcv[x + 1];
+        }
+    }
+}
+
+/* Each 128-bits lane is shuffled into 64-bits of U and 64-bits of V, then
+ * the quadwords are gathered per plane. */
+VLC_AVX
+static void AVX2_SplitUV(uint8_t *dstu, size_t dstu_pitch,
+                         uint8_t *dstv, size_t dstv_pitch,
+                         const uint8_t *src, size_t src_pitch,
+                         unsigned width, unsigned height, uint8_t pixel_size)
+{
+    assert(pixel_size == 1 || pixel_size == 2);
+    const uint8_t *shuffle = pixel_size == 1 ? split_shuffle_8
+                                             : split_shuffle_16;
+
+    for (unsigned y = 0; y < height; y++) {
+        unsigned x = 0;
+        for (; x < (width & ~31); x += 32)
+            asm volatile (
+                "vbroadcasti128 (%[shuffle]), %%ymm7\n"
+                "vmovdqu   0(%[src]), %%ymm0\n"
+                "vmovdqu  32(%[src]), %%ymm1\n"
+                "vpshufb   %%ymm7, %%ymm0, %%ymm0\n"
+                "vpshufb   %%ymm7, %%ymm1, %%ymm1\n"
+                "vpermq    $0xd8, %%ymm0, %%ymm0\n"
+                "vpermq    $0xd8, %%ymm1, %%ymm1\n"
+                "vperm2i128 $0x20, %%ymm1, %%ymm0, %%ymm2\n"
+                "vperm2i128 $0x31, %%ymm1, %%ymm0, %%ymm3\n"
+                "vmovdqu   %%ymm2, (%[dst1])\n"
+                "vmovdqu   %%ymm3, (%[dst2])\n"
+                : : [dst1]"r"(&dstu[x]), [dst2]"r"(&dstv[x]), [src]"r"(&src[2*x]), [shuffle]"r"(shuffle) : "memory", "xmm0", "xmm1", "xmm2", "xmm3", "xmm7");
+        SplitUVTail(dstu, dstv, src, x, width, pixel_size);
+        src  += src_pitch;
+        dstu += dstu_pitch;
+        dstv += dstv_pitch;
+    }
+    asm volatile ("vzeroupper");
+}
+
+VLC_AVX
+static void AVX2_InterleaveUV(uint8_t *dst, size_t dst_pitch,
+                              const uint8_t *srcu, size_t srcu_pitch,
+                              const uint8_t *srcv, size_t srcv_pitch,
+                              unsigned width, unsigned height,
+                              uint8_t pixel_size)
+{
+    assert(pixel_size == 1 || pixel_size == 2);
+
+#define INTERLEAVE64(unpackl, unpackh) \
+    asm volatile (                                    \
+        "vmovdqu   (%[src1]), %%ymm0\n"               \
+        "vmovdqu   (%[src2]), %%ymm1\n"               \
+        unpackl "  %%ymm1, %%ymm0, %%ymm2\n"          \
+        unpackh "  %%ymm1, %%ymm0, %%ymm3\n"          \
+        "vperm2i128 $0x20, %%ymm3, %%ymm2, %%ymm0\n"  \
+        "vperm2i128 $0x31, %%ymm3, %%ymm2, %%ymm1\n"  \
+        "vmovdqu   %%ymm0,  0(%[dst])\n"              \
+        "vmovdqu   %%ymm1, 32(%[dst])\n"              \
+        : : [dst]"r"(dst+2*x), [src1]"r"(srcu+x), [src2]"r"(srcv+x) \
+        : "memory", "xmm0", "xmm1", "xmm2", "xmm3")
+
+    for (unsigned y = 0; y < height; y++) {
+        unsigned x = 0;
+        if (pixel_size == 1)
+            for (; x < (width & ~31); x += 32)
+                INTERLEAVE64("vpunpcklbw", "vpunpckhbw");
+        else
+            for (; x < (width & ~31); x += 32)
+                INTERLEAVE64("vpunpcklwd", "vpunpckhwd");
+        InterleaveUVTail(dst, srcu, srcv, x, width, pixel_size);
+        srcu += srcu_pitch;
+        srcv += srcv_pitch;
+        dst  += dst_pitch;
+    }
+#undef INTERLEAVE64
+    asm volatile ("vzeroupper");
+}
+
+#ifdef CAN_COMPILE_AVX512
+/* Same as AVX2, with the quadwords of two registers gathered by vpermt2q */
+VLC_AVX
+static void AVX512_SplitUV(uint8_t *dstu, size_t dstu_pitch,
+                           uint8_t *dstv, size_t dstv_pitch,
+                           const uint8_t *src, size_t src_pitch,
+                           unsigned width, unsigned height, uint8_t pixel_size)
+{
+    assert(pixel_size == 1 || pixel_size == 2);
+    static const uint64_t gather[2][8] = {
+        { 0, 2, 4, 6, 8, 10, 12, 14 },
+        { 1, 3, 5, 7, 9, 11, 13, 15 },
+    };
+    const uint8_t *shuffle = pixel_size == 1 ? split_shuffle_8
+                                             : split_shuffle_16;
+
+    for (unsigned y = 0; y < height; y++) {
+        unsigned x = 0;
+        for (; x < (width & ~63); x += 64)
+            asm volatile (
+                "vbroadcasti32x4 (%[shuffle]), %%zmm7\n"
+                "vmovdqu64   0(%[gather]), %%zmm6\n"
+                "vmovdqu64  64(%[gather]), %%zmm5\n"
+                "vmovdqu64   0(%[src]), %%zmm0\n"
+                "vmovdqu64  64(%[src]), %%zmm1\n"
+                "vpshufb    %%zmm7, %%zmm0, %%zmm0\n"
+                "vpshufb    %%zmm7, %%zmm1, %%zmm1\n"
+                "vmovdqa64  %%zmm0, %%zmm2\n"
+                "vpermt2q   %%zmm1, %%zmm6, %%zmm0\n"
+                "vpermt2q   %%zmm1, %%zmm5, %%zmm2\n"
+                "vmovdqu64  %%zmm0, (%[dst1])\n"
+                "vmovdqu64  %%zmm2, (%[dst2])\n"
+                : : [dst1]"r"(&dstu[x]), [dst2]"r"(&dstv[x]), [src]"r"(&src[2*x]),
+                    [shuffle]"r"(shuffle), [gather]"r"(gather)
+                : "memory", "xmm0", "xmm1", "xmm2", "xmm5", "xmm6", "xmm7");
+        SplitUVTail(dstu, dstv, src, x, width, pixel_size);
+        src  += src_pitch;
+        dstu += dstu_pitch;
+        dstv += dstv_pitch;
+    }
+    asm volatile ("vzeroupper");
+}
+
+VLC_AVX
+static void AVX512_InterleaveUV(uint8_t *dst, size_t dst_pitch,
+                                const uint8_t *srcu, size_t srcu_pitch,
+                                const uint8_t *srcv, size_t srcv_pitch,
+                                unsigned width, unsigned height,
+                                uint8_t pixel_size)
+{
+    assert(pixel_size == 1 || pixel_size == 2);
+    static const uint64_t gather[2][8] = {
+        { 0, 1,  8,  9, 2, 3, 10, 11 },
+        { 4, 5, 12, 13, 6, 7, 14, 15 },
+    };
+
+#define INTERLEAVE128(unpackl, unpackh) \
+    asm volatile (                                  \
+        "vmovdqu64   0(%[gather]), %%zmm6\n"        \
+        "vmovdqu64  64(%[gather]), %%zmm5\n"        \
+        "vmovdqu64  (%[src1]), %%zmm0\n"            \
+        "vmovdqu64  (%[src2]), %%zmm1\n"            \
+        unpackl "   %%zmm1, %%zmm0, %%zmm2\n"       \
+        unpackh "   %%zmm1, %%zmm0, %%zmm3\n"       \
+        "vmovdqa64  %%zmm2, %%zmm4\n"               \
+        "vpermt2q   %%zmm3, %%zmm6, %%zmm2\n"       \
+        "vpermt2q   %%zmm3, %%zmm5, %%zmm4\n"       \
+        "vmovdqu64  %%zmm2,  0(%[dst])\n"           \
+        "vmovdqu64  %%zmm4, 64(%[dst])\n"           \
+        : : [dst]"r"(dst+2*x), [src1]"r"(srcu+x), [src2]"r"(srcv+x), \
+            [gather]"r"(gather)                     \
+        : "memory", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6")
+
+    for (unsigned y = 0; y < height; y++) {
+        unsigned x = 0;
+        if (pixel_size == 1)
+            for (; x < (width & ~63); x += 64)
+                INTERLEAVE128("vpunpcklbw", "vpunpckhbw");
+        else
+            for (; x < (width & ~63); x += 64)
+                INTERLEAVE128("vpunpcklwd", "vpunpckhwd");
+        InterleaveUVTail(dst, srcu, srcv, x, width, pixel_size);
+        srcu += srcu_pitch;
+        srcv += srcv_pitch;
+        dst  += dst_pitch;
+    }
+#undef INTERLEAVE128
+    asm volatile ("vzeroupper");
+}
+#endif /* CAN_COMPILE_AVX512 */
+#endif /* CAN_COMPILE_AVX2 */
+
 static void SSE_CopyPlane(uint8_t *dst, size_t dst_pitch,
                           const uint8_t *src, size_t src_pitch,
                           uint8_t *cache, size_t cache_size,
@@ -516,6 +840,20 @@ SSE_InterleavePlanes(uint8_t *dst, size_t dst_pitch,
                      cachev_width, hblock, bitshift);
 
         /* Copy from our cache to the destination */
+#ifdef CAN_COMPILE_AVX2
+# ifdef CAN_COMPILE_AVX512
+        if (vlc_CPU_AVX512())
+            AVX512_InterleaveUV(dst, dst_pitch, cache, w16,
+                                cache + w16 * hblock, w16,
+                                copy_pitch, hblock, pixel_size);
+        else
+# endif
+        if (vlc_CPU_AVX2())
+            AVX2_InterleaveUV(dst, dst_pitch, cache, w16,
+                              cache + w16 * hblock, w16,
+                              copy_pitch, hblock, pixel_size);
+        else
+#endif
         SSE_InterleaveUV(dst, dst_pitch, cache, w16,
                          cache + w16 * hblock, w16,
                          copy_pitch, hblock, pixel_size);
@@ -546,6 +884,18 @@ static void SSE_SplitPlanes(uint8_t *dstu, size_t dstu_pitch,
         CopyFromUswc(cache, w16, src, src_pitch, cache_width, hblock, bitshift);
 
         /* Copy from our cache to the destination */
+#ifdef CAN_COMPILE_AVX2
+# ifdef CAN_COMPILE_AVX512
+        if (vlc_CPU_AVX512())
+            AVX512_SplitUV(dstu, dstu_pitch, dstv, dstv_pitch,
+                           cache, w16, copy_pitch, hblock, pixel_size);
+        else
+# endif
+        if (vlc_CPU_AVX2())
+            AVX2_SplitUV(dstu, dstu_pitch, dstv, dstv_pitch,
+                         cache, w16, copy_pitch, hblock, pixel_size);
+        else
+#endif
         SSE_SplitUV(dstu, dstu_pitch, dstv, dstv_pitch,
                     cache, w16, copy_pitch, hblock, pixel_size);
 
@@ -641,29 +991,89 @@ static void CopyPlane(uint8_t *dst, size_t dst_pitch,
     }
 }
 
-void CopyPacked(picture_t *dst, const uint8_t *src, const size_t src_pitch,
-                unsigned height, const copy_cache_t *cache)
+/**
+ * Runs a conversion, splitting large frames in horizontal stripes that are
+ * converted in parallel by the workers of the cache.
+ * Stripes start on even lines, so that 4:2:0 chroma lines are not shared.
+ */
+static void CopyRun(copy_conv_cb conv, picture_t *dst, const uint8_t *src[],
+                    const size_t src_pitch[], unsigned src_planes,
+                    unsigned height, int bitshift, const copy_cache_t *cache)
 {
-    assert(dst);
-    assert(src); assert(src_pitch);
-    assert(height);
+    struct copy_pool *pool = cache->pool;
+    size_t count = 1;
 
+    if (pool != NULL)
+        count = __MIN(pool->count,
+                      src_pitch[0] * height / COPY_STRIPE_MIN_SIZE);
+    if (count < 2)
+    {
+        conv(dst, src, src_pitch, height, bitshift, cache);
+        return;
+    }
+
+    const unsigned step = ((height + count - 1) / count + 1) & ~1u;
+
+    for (unsigned i = 1, y = step; i < count && y < height; i++, y += step)
+    {
+        struct copy_stripe *stripe = &pool->stripes[i - 1];
+
+        stripe->dst.i_planes = dst->i_planes;
+        for (int n = 0; n < dst->i_planes; n++)
+        {
+            const unsigned d = n > 0 ? 2 : 1;
+            stripe->dst.p[n] = dst->p[n];
+            stripe->dst.p[n].p_pixels += (y / d) * dst->p[n].i_pitch;
+        }
+        for (unsigned n = 0; n < src_planes; n++)
+        {
+            const unsigned d = n > 0 ? 2 : 1;
+            stripe->src[n] = src[n] + (y / d) * src_pitch[n];
+        }
+        stripe->src_pitch = src_pitch;
+        stripe->height = __MIN(step, height - y);
+        stripe->conv = conv;
+        stripe->bitshift = bitshift;
+        vlc_executor_Submit(pool->executor, &stripe->runnable);
+    }
+
+    conv(dst, src, src_pitch, __MIN(step, height), bitshift, cache);
+    vlc_executor_WaitIdle(pool->executor);
+}
+
+static void CopyPacked_Stripe(picture_t *dst, const uint8_t *src[static 1],
+                              const size_t src_pitch[static 1], unsigned height,
+                              int bitshift, const copy_cache_t *cache)
+{
+    (void) bitshift;
 #ifdef CAN_COMPILE_SSE2
     if (vlc_CPU_SSE4_1())
-        return SSE_CopyPlane(dst->p[0].p_pixels, dst->p[0].i_pitch, src, src_pitch,
+        return SSE_CopyPlane(dst->p[0].p_pixels, dst->p[0].i_pitch,
+                             src[0], src_pitch[0],
                              cache->buffer, cache->size, height, 0);
 #else
     (void) cache;
 #endif
-        CopyPlane(dst->p[0].p_pixels, dst->p[0].i_pitch, src, src_pitch,
+        CopyPlane(dst->p[0].p_pixels, dst->p[0].i_pitch, src[0], src_pitch[0],
                   height, 0);
 }
 
-void Copy420_SP_to_SP(picture_t *dst, const uint8_t *src[static 2],
-                      const size_t src_pitch[static 2], unsigned height,
-                      const copy_cache_t *cache)
+void CopyPacked(picture_t *dst, const uint8_t *src, const size_t src_pitch,
+                unsigned height, const copy_cache_t *cache)
 {
-    ASSERT_2PLANES;
+    assert(dst);
+    assert(src); assert(src_pitch);
+    assert(height);
+
+    CopyRun(CopyPacked_Stripe, dst, &src, &src_pitch, 1, height, 0, cache);
+}
+
+static void Copy420_SP_to_SP_Stripe(picture_t *dst, const uint8_t *src[static 2],
+                                    const size_t src_pitch[static 2],
+                                    unsigned height, int bitshift,
+                                    const copy_cache_t *cache)
+{
+    (void) bitshift;
 #ifdef CAN_COMPILE_SSE2
     if (vlc_CPU_SSE2())
         return SSE_Copy420_SP_to_SP(dst, src, src_pitch, height, cache);
@@ -677,6 +1087,14 @@ void Copy420_SP_to_SP(picture_t *dst, const uint8_t *src[static 2],
               src[1], src_pitch[1], (height+1)/2, 0);
 }
 
+void Copy420_SP_to_SP(picture_t *dst, const uint8_t *src[static 2],
+                      const size_t src_pitch[static 2], unsigned height,
+                      const copy_cache_t *cache)
+{
+    ASSERT_2PLANES;
+    CopyRun(Copy420_SP_to_SP_Stripe, dst, src, src_pitch, 2, height, 0, cache);
+}
+
 #define SPLIT_PLANES(type, pitch_den) do { \
     size_t copy_pitch = __MIN(__MIN(src_pitch / pitch_den, dstu_pitch), dstv_pitch); \
     for (unsigned y = 0; y < height; y++) { \
@@ -736,11 +1154,12 @@ static void SplitPlanes16(uint8_t *dstu, size_t dstu_pitch,
         SPLIT_PLANES_SHIFTL(uint16_t, 4, (-bitshift) & 0xf);
 }
 
-void Copy420_SP_to_P(picture_t *dst, const uint8_t *src[static 2],
-                     const size_t src_pitch[static 2], unsigned height,
-                     const copy_cache_t *cache)
+static void Copy420_SP_to_P_Stripe(picture_t *dst, const uint8_t *src[static 2],
+                                   const size_t src_pitch[static 2],
+                                   unsigned height, int bitshift,
+                                   const copy_cache_t *cache)
 {
-    ASSERT_2PLANES;
+    (void) bitshift;
 #ifdef CAN_COMPILE_SSE2
     if (vlc_CPU_SSE2())
         return SSE_Copy420_SP_to_P(dst, src, src_pitch, height, 1, 0, cache);
@@ -755,13 +1174,20 @@ void Copy420_SP_to_P(picture_t *dst, const uint8_t *src[static 2],
                 src[1], src_pitch[1], (height+1)/2);
 }
 
-void Copy420_16_SP_to_P(picture_t *dst, const uint8_t *src[static 2],
-                        const size_t src_pitch[static 2], unsigned height,
-                        int bitshift, const copy_cache_t *cache)
+void Copy420_SP_to_P(picture_t *dst, const uint8_t *src[static 2],
+                     const size_t src_pitch[static 2], unsigned height,
+                     const copy_cache_t *cache)
 {
     ASSERT_2PLANES;
-    assert(bitshift >= -6 && bitshift <= 6 && (bitshift % 2 == 0));
+    CopyRun(Copy420_SP_to_P_Stripe, dst, src, src_pitch, 2, height, 0, cache);
+}
 
+static void Copy420_16_SP_to_P_Stripe(picture_t *dst,
+                                      const uint8_t *src[static 2],
+                                      const size_t src_pitch[static 2],
+                                      unsigned height, int bitshift,
+                                      const copy_cache_t *cache)
+{
 #ifdef CAN_COMPILE_SSE3
     if (vlc_CPU_SSSE3())
         return SSE_Copy420_SP_to_P(dst, src, src_pitch, height, 2, bitshift, cache);
@@ -776,6 +1202,17 @@ void Copy420_16_SP_to_P(picture_t *dst, const uint8_t *src[static 2],
                   src[1], src_pitch[1], (height+1)/2, bitshift);
 }
 
+void Copy420_16_SP_to_P(picture_t *dst, const uint8_t *src[static 2],
+                        const size_t src_pitch[static 2], unsigned height,
+                        int bitshift, const copy_cache_t *cache)
+{
+    ASSERT_2PLANES;
+    assert(bitshift >= -6 && bitshift <= 6 && (bitshift % 2 == 0));
+
+    CopyRun(Copy420_16_SP_to_P_Stripe, dst, src, src_pitch, 2, height,
+            bitshift, cache);
+}
+
 #define INTERLEAVE_UV() do { \
     for ( unsigned int line = 0; line < copy_lines; line++ ) { \
         for ( unsigned int col = 0; col < copy_pitch; col++ ) { \
@@ -812,11 +1249,12 @@ void Copy420_16_SP_to_P(picture_t *dst, const uint8_t *src[static 2],
     } \
 }while(0)
 
-void Copy420_P_to_SP(picture_t *dst, const uint8_t *src[static 3],
-                     const size_t src_pitch[static 3], unsigned height,
-                     const copy_cache_t *cache)
+static void Copy420_P_to_SP_Stripe(picture_t *dst, const uint8_t *src[static 3],
+                                   const size_t src_pitch[static 3],
+                                   unsigned height, int bitshift,
+                                   const copy_cache_t *cache)
 {
-    ASSERT_3PLANES;
+    (void) bitshift;
 #ifdef CAN_COMPILE_SSE2
     if (vlc_CPU_SSE2())
         return SSE_Copy420_P_to_SP(dst, src, src_pitch, height, 1, 0, cache);
@@ -842,12 +1280,20 @@ void Copy420_P_to_SP(picture_t *dst, const uint8_t *src[static 3],
     INTERLEAVE_UV();
 }
 
-void Copy420_16_P_to_SP(picture_t *dst, const uint8_t *src[static 3],
-                        const size_t src_pitch[static 3], unsigned height,
-                        int bitshift, const copy_cache_t *cache)
+void Copy420_P_to_SP(picture_t *dst, const uint8_t *src[static 3],
+                     const size_t src_pitch[static 3], unsigned height,
+                     const copy_cache_t *cache)
 {
     ASSERT_3PLANES;
-    assert(bitshift >= -6 && bitshift <= 6 && (bitshift % 2 == 0));
+    CopyRun(Copy420_P_to_SP_Stripe, dst, src, src_pitch, 3, height, 0, cache);
+}
+
+static void Copy420_16_P_to_SP_Stripe(picture_t *dst,
+                                      const uint8_t *src[static 3],
+                                      const size_t src_pitch[static 3],
+                                      unsigned height, int bitshift,
+                                      const copy_cache_t *cache)
+{
 #ifdef CAN_COMPILE_SSE2
     if (vlc_CPU_SSSE3())
         return SSE_Copy420_P_to_SP(dst, src, src_pitch, height, 2, bitshift, cache);
@@ -877,11 +1323,23 @@ void Copy420_16_P_to_SP(picture_t *dst, const uint8_t *src[static 3],
         INTERLEAVE_UV_SHIFTL((-bitshift) & 0xf);
 }
 
-void Copy420_P_to_P(picture_t *dst, const uint8_t *src[static 3],
-                    const size_t src_pitch[static 3], unsigned height,
-                    const copy_cache_t *cache)
+void Copy420_16_P_to_SP(picture_t *dst, const uint8_t *src[static 3],
+                        const size_t src_pitch[static 3], unsigned height,
+                        int bitshift, const copy_cache_t *cache)
 {
     ASSERT_3PLANES;
+    assert(bitshift >= -6 && bitshift <= 6 && (bitshift % 2 == 0));
+
+    CopyRun(Copy420_16_P_to_SP_Stripe, dst, src, src_pitch, 3, height,
+            bitshift, cache);
+}
+
+static void Copy420_P_to_P_Stripe(picture_t *dst, const uint8_t *src[static 3],
+                                  const size_t src_pitch[static 3],
+                                  unsigned height, int bitshift,
+                                  const copy_cache_t *cache)
+{
+    (void) bitshift;
 #ifdef CAN_COMPILE_SSE2
     if (vlc_CPU_SSE2())
         return SSE_Copy420_P_to_P(dst, src, src_pitch, height, cache);
@@ -897,6 +1355,14 @@ void Copy420_P_to_P(picture_t *dst, const uint8_t *src[static 3],
                src[2], src_pitch[2], (height+1) / 2, 0);
 }
 
+void Copy420_P_to_P(picture_t *dst, const uint8_t *src[static 3],
+                    const size_t src_pitch[static 3], unsigned height,
+                    const copy_cache_t *cache)
+{
+    ASSERT_3PLANES;
+    CopyRun(Copy420_P_to_P_Stripe, dst, src, src_pitch, 3, height, 0, cache);
+}
+
 int picture_UpdatePlanes(picture_t *picture, uint8_t *data, unsigned pitch)
 {
     /* fill in buffer info in first plane */
@@ -40,11 +40,14 @@ typedef struct {
 # ifdef CAN_COMPILE_SSE2
     uint8_t *buffer;
     size_t  size;
-# else
-    char dummy;
 # endif
+    struct copy_pool *pool;
 } copy_cache_t;
 
+/* Initializes a copy cache for lines of width bytes.
+ * For wide surfaces, a small pool of worker threads is also set up so that
+ * large frames get copied in parallel stripes. A cache must not be used by
+ * more than one thread at a time. */
 int  CopyInitCache(copy_cache_t *cache, unsigned width);
 void CopyCleanCache(copy_cache_t *cache);
 
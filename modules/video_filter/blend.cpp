@@ -28,10 +28,12 @@
 #endif
 
 #include <vlc_common.h>
+#include <vlc_cpu.h>
 #include <vlc_plugin.h>
 #include <vlc_filter.h>
 #include <vlc_picture.h>
 #include "filter_picture.h"
+#include "blend.h"
 
 /*****************************************************************************
  * Module descriptor
@@ -39,9 +41,15 @@
 static int  Open (filter_t *);
 static void Close(filter_t *);
 
+#define SIMD_TEXT N_("Use CPU-specific blending functions")
+#define SIMD_LONGTEXT N_("Use the optimized blending functions of the CPU, " \
+    "when there are any for the chromas. Only useful for benchmarking.")
+
 vlc_module_begin()
     set_description(N_("Video pictures blending"))
     set_callback_video_blending(Open, 100)
+    add_bool("blend-simd", true, SIMD_TEXT, SIMD_LONGTEXT)
+        change_volatile()
 vlc_module_end()
 
 static inline unsigned div255(unsigned v)
@@ -83,6 +91,18 @@ public:
     {
         return true;
     }
+    unsigned getX() const
+    {
+        return x;
+    }
+    unsigned getY() const
+    {
+        return y;
+    }
+    uint8_t *getPlaneLine(unsigned plane, unsigned dy, unsigned ry = 1) const
+    {
+        return &picture->p[plane].p_pixels[(y + dy) / ry * picture->p[plane].i_pitch];
+    }
 
 protected:
     template <unsigned ry>
@@ -607,6 +627,104 @@ void Blend(const CPicture &dst_data, const CPicture &src_data,
 typedef void (*blend_function_t)(const CPicture &dst_data, const CPicture &src_data,
                                  unsigned width, unsigned height, int alpha);
 
+/*
+ * Fast paths, blending whole lines with the CPU-specific functions
+ */
+static struct blend_functions funcs;
+
+/* Chroma is blended on even lines and columns only, from the co-located
+ * source sample, as the generic code does. */
+template <typename pixel, bool semiplanar, bool swap_uv>
+static void BlendLine420(const CPicture &dst, unsigned dy, unsigned dx,
+                         const uint8_t *const src[4], unsigned width,
+                         unsigned alpha)
+{
+    const unsigned x = dst.getX() + dx;
+    uint8_t *luma = dst.getPlaneLine(0, dy) + x * sizeof(pixel);
+
+    if (sizeof(pixel) == 1)
+        funcs.plane8(luma, src[0], src[3], width, alpha);
+    else
+        funcs.plane10(reinterpret_cast<uint16_t *>(luma), src[0], src[3],
+                      width, alpha);
+
+    const unsigned first = x % 2;
+    const unsigned count = (width + 1 - first) / 2;
+    if ((dst.getY() + dy) % 2 != 0 || count == 0)
+        return;
+
+    const uint8_t *cb = src[swap_uv ? 2 : 1] + first;
+    const uint8_t *cr = src[swap_uv ? 1 : 2] + first;
+    const uint8_t *a  = src[3] + first;
+    const unsigned cx = (x + first) / 2;
+
+    if (semiplanar) {
+        funcs.nv12(dst.getPlaneLine(1, dy, 2) + cx * 2, cb, cr, a,
+                   count, alpha);
+    } else if (sizeof(pixel) == 1) {
+        funcs.chroma8(dst.getPlaneLine(1, dy, 2) + cx, cb, a, count, alpha);
+        funcs.chroma8(dst.getPlaneLine(2, dy, 2) + cx, cr, a, count, alpha);
+    } else {
+        uint8_t *u = dst.getPlaneLine(1, dy, 2) + cx * sizeof(pixel);
+        uint8_t *v = dst.getPlaneLine(2, dy, 2) + cx * sizeof(pixel);
+
+        funcs.chroma10(reinterpret_cast<uint16_t *>(u), cb, a, count, alpha);
+        funcs.chroma10(reinterpret_cast<uint16_t *>(v), cr, a, count, alpha);
+    }
+}
+
+/* RGBA lines are converted by chunks of even sizes, keeping the parity of
+ * the chroma columns. The chroma kernels can read one sample past the end of
+ * the last chunk, hence the extra entry. */
+#define BLEND_CHUNK 256
+
+template <typename pixel, bool semiplanar, bool swap_uv, bool rgba>
+void BlendFast420(const CPicture &dst, const CPicture &src,
+                  unsigned width, unsigned height, int alpha)
+{
+    for (unsigned y = 0; y < height; y++) {
+        if (!rgba) {
+            const uint8_t *lines[4];
+            for (unsigned i = 0; i < 4; i++)
+                lines[i] = src.getPlaneLine(i, y) + src.getX();
+
+            BlendLine420<pixel, semiplanar, swap_uv>(dst, y, 0, lines,
+                                                     width, alpha);
+            continue;
+        }
+
+        const uint8_t *rgb = src.getPlaneLine(0, y) + src.getX() * 4;
+        for (unsigned x = 0; x < width; x += BLEND_CHUNK) {
+            uint8_t yuva[4][BLEND_CHUNK + 1];
+            const uint8_t *lines[4] = { yuva[0], yuva[1], yuva[2], yuva[3] };
+            const unsigned count = __MIN(width - x, BLEND_CHUNK);
+
+            funcs.rgba_yuva(yuva[0], yuva[1], yuva[2], yuva[3],
+                            rgb + x * 4, count);
+            BlendLine420<pixel, semiplanar, swap_uv>(dst, y, x, lines,
+                                                     count, alpha);
+        }
+    }
+}
+
+static void BlendFastRGB32(const CPicture &dst, const CPicture &src,
+                           unsigned width, unsigned height, int alpha)
+{
+    int offsets[4];
+
+    if (GetPackedRgbIndexes(dst.getFormat()->i_chroma, &offsets[0],
+                            &offsets[1], &offsets[2], &offsets[3]) != VLC_SUCCESS)
+        vlc_assert_unreachable();
+
+    /* The source is opaque, as with convertAddOpaque */
+    const unsigned a = div255(alpha * 0xFF);
+
+    for (unsigned y = 0; y < height; y++)
+        funcs.rgb32(dst.getPlaneLine(0, y) + dst.getX() * 4,
+                    src.getPlaneLine(0, y) + src.getX() * 4,
+                    width, a, offsets);
+}
+
 namespace {
 
 static const struct {
@@ -687,6 +805,45 @@ static const struct {
 #undef YUV
 };
 
+static const struct {
+    vlc_fourcc_t     dst;
+    vlc_fourcc_t     src;
+    blend_function_t blend;
+} fast_blends[] = {
+#define FAST420(csp, pixel, semiplanar, swap_uv) \
+    { csp, VLC_CODEC_YUVA, BlendFast420<pixel, semiplanar, swap_uv, false> }, \
+    { csp, VLC_CODEC_RGBA, BlendFast420<pixel, semiplanar, swap_uv, true> }
+
+    FAST420(VLC_CODEC_I420,     uint8_t,  false, false),
+    FAST420(VLC_CODEC_YV12,     uint8_t,  false, true),
+    FAST420(VLC_CODEC_NV12,     uint8_t,  true,  false),
+    FAST420(VLC_CODEC_NV21,     uint8_t,  true,  true),
+#ifdef WORDS_BIGENDIAN
+    FAST420(VLC_CODEC_I420_10B, uint16_t, false, false),
+#else
+    FAST420(VLC_CODEC_I420_10L, uint16_t, false, false),
+#endif
+
+    { VLC_CODEC_RGBX, VLC_CODEC_RGBA, BlendFastRGB32 },
+    { VLC_CODEC_XRGB, VLC_CODEC_RGBA, BlendFastRGB32 },
+    { VLC_CODEC_BGRX, VLC_CODEC_RGBA, BlendFastRGB32 },
+    { VLC_CODEC_XBGR, VLC_CODEC_RGBA, BlendFastRGB32 },
+
+#undef FAST420
+};
+
+struct FunctionsInitializer {
+    FunctionsInitializer()
+    {
+        vlc_CPU_functions_init("blend functions", &funcs);
+    }
+    bool isComplete() const
+    {
+        return funcs.plane8 && funcs.chroma8 && funcs.plane10 &&
+               funcs.chroma10 && funcs.nv12 && funcs.rgb32 && funcs.rgba_yuva;
+    }
+};
+
 struct filter_sys_t {
     filter_sys_t() : blend(NULL)
     {
@@ -747,6 +904,16 @@ static int Open(filter_t *filter)
             sys->blend = blends[i].blend;
     }
 
+    if (var_InheritBool(filter, "blend-simd")) {
+        static const FunctionsInitializer cpu;
+
+        for (size_t i = 0; i < sizeof(fast_blends) / sizeof(*fast_blends); i++) {
+            if (fast_blends[i].src == src && fast_blends[i].dst == dst &&
+                cpu.isComplete())
+                sys->blend = fast_blends[i].blend;
+        }
+    }
+
     if (!sys->blend) {
        msg_Err(filter, "no matching alpha blending routine (chroma: %4.4s -> %4.4s)",
                (char *)&src, (char *)&dst);
@@ -0,0 +1,68 @@
+/*****************************************************************************
+ * blend.h: CPU-specific functions for video blending
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#include <stdint.h>
+
+/*
+ * Each function blends one line of 8-bits source samples. A destination
+ * sample d is merged with a source sample s and an opacity f as
+ *   d = div255((255 - f) * d + f * s), div255(v) = ((v >> 8) + v + 1) >> 8
+ * with f = div255(alpha * a) where a is the source alpha, and left untouched
+ * if f is 0. The results must match the generic code exactly.
+ *
+ * The subsampled variants take the even source samples only, and may read
+ * up to one sample past the last one they use.
+ */
+
+/** Blends dst[x] with src[x] and a[x], for x < width */
+typedef void (*blend_plane8_cb)(uint8_t *dst, const uint8_t *src,
+                                const uint8_t *a, unsigned width,
+                                unsigned alpha);
+/** Blends 10-bits dst[x] with src[x] * 1023 / 255 and a[x] */
+typedef void (*blend_plane10_cb)(uint16_t *dst, const uint8_t *src,
+                                 const uint8_t *a, unsigned width,
+                                 unsigned alpha);
+/** Blends dst[2x] with u[2x], dst[2x + 1] with v[2x], both with a[2x] */
+typedef void (*blend_nv12_cb)(uint8_t *dst, const uint8_t *u,
+                              const uint8_t *v, const uint8_t *a,
+                              unsigned width, unsigned alpha);
+/** Blends RGBA pixels onto 32-bits RGB pixels without alpha, whose red,
+ * green and blue bytes are at the given offsets. As with the generic code,
+ * the source pixels are taken as opaque: f is alpha for all of them. */
+typedef void (*blend_rgb32_cb)(uint8_t *dst, const uint8_t *src,
+                               unsigned width, unsigned alpha,
+                               const int offsets[3]);
+/** Converts RGBA pixels to YUVA lines, as rgb_to_yuv() does */
+typedef void (*blend_rgba_yuva_cb)(uint8_t *y, uint8_t *u, uint8_t *v,
+                                   uint8_t *a, const uint8_t *src,
+                                   unsigned width);
+
+/**
+ * CPU-specific modules must provide all the functions, or none.
+ */
+struct blend_functions {
+    blend_plane8_cb plane8;
+    blend_plane8_cb chroma8; /**< dst[x] with src[2x] and a[2x] */
+    blend_plane10_cb plane10;
+    blend_plane10_cb chroma10; /**< dst[x] with src[2x] and a[2x] */
+    blend_nv12_cb nv12;
+    blend_rgb32_cb rgb32;
+    blend_rgba_yuva_cb rgba_yuva;
+};
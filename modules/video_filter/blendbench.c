@@ -52,6 +52,10 @@ static picture_t *Filter( filter_t *, picture_t * );
 #define LOOPS_TEXT N_("Number of time to blend")
 #define LOOPS_LONGTEXT N_("The number of time the blend will be performed")
 
+#define COMPARE_TEXT N_("Compare with the generic code")
+#define COMPARE_LONGTEXT N_("Blend again without the CPU-specific " \
+                            "functions, and check that the results match")
+
 #define ALPHA_TEXT N_("Alpha of the blended image")
 #define ALPHA_LONGTEXT N_("Alpha with which the blend image is blended")
 
@@ -80,6 +84,7 @@ vlc_module_begin ()
               LOOPS_LONGTEXT )
     add_integer_with_range( CFG_PREFIX "alpha", 128, 0, 255, ALPHA_TEXT,
               ALPHA_LONGTEXT )
+    add_bool( CFG_PREFIX "compare", true, COMPARE_TEXT, COMPARE_LONGTEXT )
 
     set_section( N_("Base image"), NULL )
     add_loadfile(CFG_PREFIX "base-image", NULL,
@@ -97,7 +102,7 @@ vlc_module_begin ()
 vlc_module_end ()
 
 static const char *const ppsz_filter_options[] = {
-    "loops", "alpha", "base-image", "base-chroma", "blend-image",
+    "loops", "alpha", "compare", "base-image", "base-chroma", "blend-image",
     "blend-chroma", NULL
 };
 
@@ -107,6 +112,7 @@ static const char *const ppsz_filter_options[] = {
 typedef struct
 {
     bool b_done;
+    bool b_compare;
     int i_loops, i_alpha;
 
     picture_t *p_base_image;
@@ -175,6 +181,7 @@ static int Create( filter_t *p_filter )
                                                   CFG_PREFIX "loops" );
     p_sys->i_alpha = var_CreateGetIntegerCommand( p_filter,
                                                   CFG_PREFIX "alpha" );
+    p_sys->b_compare = var_CreateGetBool( p_filter, CFG_PREFIX "compare" );
 
     psz_temp = var_CreateGetStringCommand( p_filter, CFG_PREFIX "base-chroma" );
     p_sys->i_base_chroma = !psz_temp || strlen( psz_temp ) != 4 ? 0 :
@@ -224,28 +231,35 @@ static void Destroy( filter_t *p_filter )
 }
 
 /*****************************************************************************
- * Render: displays previously rendered output
+ * blendbench_Run: blends the images onto a copy of the base image
  *****************************************************************************/
-static picture_t *Filter( filter_t *p_filter, picture_t *p_pic )
+static picture_t *blendbench_Run( filter_t *p_filter, bool b_simd,
+                                  vlc_tick_t *p_time )
 {
     filter_sys_t *p_sys = p_filter->p_sys;
     filter_t *p_blend;
+    picture_t *p_dst;
 
-    if( p_sys->b_done )
-        return p_pic;
+    p_dst = picture_NewFromFormat( &p_sys->p_base_image->format );
+    if( !p_dst )
+        return NULL;
+    picture_Copy( p_dst, p_sys->p_base_image );
 
     p_blend = vlc_object_create( p_filter, sizeof(filter_t) );
     if( !p_blend )
     {
-        picture_Release( p_pic );
+        picture_Release( p_dst );
         return NULL;
     }
+    var_Create( p_blend, "blend-simd", VLC_VAR_BOOL );
+    var_SetBool( p_blend, "blend-simd", b_simd );
+
     p_blend->fmt_out.video = p_sys->p_base_image->format;
     p_blend->fmt_in.video = p_sys->p_blend_image->format;
     p_blend->p_module = vlc_filter_LoadModule( p_blend, "video blending", NULL, false );
     if( !p_blend->p_module )
     {
-        picture_Release( p_pic );
+        picture_Release( p_dst );
         vlc_object_delete(p_blend);
         return NULL;
     }
@@ -254,13 +268,13 @@ static picture_t *Filter( filter_t *p_filter, picture_t *p_pic )
     vlc_tick_t time = vlc_tick_now();
     for( int i_iter = 0; i_iter < p_sys->i_loops; ++i_iter )
     {
-        filter_Blend( p_blend, p_sys->p_base_image,
+        filter_Blend( p_blend, p_dst,
                       0, 0, p_sys->p_blend_image, p_sys->i_alpha );
     }
     time = vlc_tick_now() - time;
 
-    msg_Info( p_filter, "Blended %d images in %f sec", p_sys->i_loops,
-              secf_from_vlc_tick(time) );
+    msg_Info( p_filter, "Blended %d images in %f sec%s", p_sys->i_loops,
+              secf_from_vlc_tick(time), b_simd ? "" : " (generic code)" );
     msg_Info( p_filter, "Speed is: %f images/second, %f pixels/second",
               (float) p_sys->i_loops / time * CLOCK_FREQ,
               (float) p_sys->i_loops / time * CLOCK_FREQ *
@@ -269,6 +283,66 @@ static picture_t *Filter( filter_t *p_filter, picture_t *p_pic )
 
     vlc_filter_Delete( p_blend );
 
+    *p_time = time;
+    return p_dst;
+}
+
+/*****************************************************************************
+ * blendbench_Compare: checks that both blended pictures are the same
+ *****************************************************************************/
+static bool blendbench_Compare( filter_t *p_filter, const picture_t *p_a,
+                                const picture_t *p_b )
+{
+    for( int i_plane = 0; i_plane < p_a->i_planes; i_plane++ )
+    {
+        const plane_t *a = &p_a->p[i_plane], *b = &p_b->p[i_plane];
+
+        for( int y = 0; y < a->i_visible_lines; y++ )
+        {
+            if( memcmp( &a->p_pixels[y * a->i_pitch],
+                        &b->p_pixels[y * b->i_pitch], a->i_visible_pitch ) )
+            {
+                msg_Err( p_filter, "Blended images differ from the generic "
+                         "code (plane %d, line %d)", i_plane, y );
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*****************************************************************************
+ * Render: displays previously rendered output
+ *****************************************************************************/
+static picture_t *Filter( filter_t *p_filter, picture_t *p_pic )
+{
+    filter_sys_t *p_sys = p_filter->p_sys;
+    picture_t *p_simd, *p_generic;
+    vlc_tick_t simd_time, generic_time;
+
+    if( p_sys->b_done )
+        return p_pic;
+
+    p_simd = blendbench_Run( p_filter, true, &simd_time );
+    if( !p_simd )
+    {
+        picture_Release( p_pic );
+        return NULL;
+    }
+
+    if( p_sys->b_compare )
+    {
+        p_generic = blendbench_Run( p_filter, false, &generic_time );
+        if( p_generic )
+        {
+            if( blendbench_Compare( p_filter, p_generic, p_simd ) )
+                msg_Info( p_filter, "Blended images match the generic code, "
+                          "speedup is %f", (double) generic_time / simd_time );
+            picture_Release( p_generic );
+        }
+    }
+    picture_Release( p_simd );
+
     p_sys->b_done = true;
     return p_pic;
 }
@@ -31,6 +31,7 @@
 #include <vlc_picture.h>
 
 #include "deinterlace.h" /* filter_sys_t */
+#include "helpers.h"     /* RenderBands() */
 
 #include "algo_x.h"
 
@@ -291,55 +292,73 @@ static inline void XDeintBand8x8C( uint8_t *dst, int i_dst,
         XDeintNxN( dst, i_dst, src, i_src, i_modx, 8 );
 }
 
-/*****************************************************************************
- * Public functions
- *****************************************************************************/
+/* State shared by the bands of a picture */
+typedef struct
+{
+    picture_t *p_outpic;
+    const picture_t *p_pic;
+} x_job_t;
 
-int RenderX( filter_t *p_filter, picture_t *p_outpic, picture_t *p_pic )
+/* Renders the rows of 8x8 blocks [i_start, i_end) of a plane. The last row
+ * may be shorter. */
+static void RenderXBand( void *p_opaque, int i_plane, int i_start, int i_end )
 {
-    VLC_UNUSED(p_filter);
-    int i_plane;
+    const x_job_t *p_job = p_opaque;
+    const plane_t *p_out = &p_job->p_outpic->p[i_plane];
+    const plane_t *p_in = &p_job->p_pic->p[i_plane];
 
-    /* Copy image and skip lines */
-    for( i_plane = 0 ; i_plane < p_pic->i_planes ; i_plane++ )
-    {
-        const int i_mby = ( p_outpic->p[i_plane].i_visible_lines + 7 )/8 - 1;
-        const int i_mbx = p_outpic->p[i_plane].i_visible_pitch/8;
+    const int i_mby = ( p_out->i_visible_lines + 7 )/8 - 1;
+    const int i_mbx = p_out->i_visible_pitch/8;
 
-        const int i_mody = p_outpic->p[i_plane].i_visible_lines - 8*i_mby;
-        const int i_modx = p_outpic->p[i_plane].i_visible_pitch - 8*i_mbx;
+    const int i_mody = p_out->i_visible_lines - 8*i_mby;
+    const int i_modx = p_out->i_visible_pitch - 8*i_mbx;
 
-        const int i_dst = p_outpic->p[i_plane].i_pitch;
-        const int i_src = p_pic->p[i_plane].i_pitch;
+    const int i_dst = p_out->i_pitch;
+    const int i_src = p_in->i_pitch;
+
+    int y, x;
+
+    for( y = i_start; y < __MIN( i_end, i_mby ); y++ )
+    {
+        uint8_t *dst = &p_out->p_pixels[8*y*i_dst];
+        uint8_t *src = &p_in->p_pixels[8*y*i_src];
+
+        XDeintBand8x8C( dst, i_dst, src, i_src, i_mbx, i_modx );
+    }
 
-        int y, x;
+    /* Last line (C only)*/
+    if( i_mody && y == i_mby && y < i_end )
+    {
+        uint8_t *dst = &p_out->p_pixels[8*y*i_dst];
+        uint8_t *src = &p_in->p_pixels[8*y*i_src];
 
-        for( y = 0; y < i_mby; y++ )
+        for( x = 0; x < i_mbx; x++ )
         {
-            uint8_t *dst = &p_outpic->p[i_plane].p_pixels[8*y*i_dst];
-            uint8_t *src = &p_pic->p[i_plane].p_pixels[8*y*i_src];
+            XDeintNxN( dst, i_dst, src, i_src, 8, i_mody );
 
-            XDeintBand8x8C( dst, i_dst, src, i_src, i_mbx, i_modx );
+            dst += 8;
+            src += 8;
         }
 
-        /* Last line (C only)*/
-        if( i_mody )
-        {
-            uint8_t *dst = &p_outpic->p[i_plane].p_pixels[8*y*i_dst];
-            uint8_t *src = &p_pic->p[i_plane].p_pixels[8*y*i_src];
+        if( i_modx )
+            XDeintNxN( dst, i_dst, src, i_src, i_modx, i_mody );
+    }
+}
+
+/*****************************************************************************
+ * Public functions
+ *****************************************************************************/
 
-            for( x = 0; x < i_mbx; x++ )
-            {
-                XDeintNxN( dst, i_dst, src, i_src, 8, i_mody );
+int RenderX( filter_t *p_filter, picture_t *p_outpic, picture_t *p_pic )
+{
+    x_job_t job = { .p_outpic = p_outpic, .p_pic = p_pic };
+    int pi_rows[PICTURE_PLANE_MAX];
 
-                dst += 8;
-                src += 8;
-            }
+    /* Copy image and skip lines, by rows of 8x8 blocks */
+    for( int i_plane = 0 ; i_plane < p_pic->i_planes ; i_plane++ )
+        pi_rows[i_plane] = ( p_outpic->p[i_plane].i_visible_lines + 7 )/8;
 
-            if( i_modx )
-                XDeintNxN( dst, i_dst, src, i_src, i_modx, i_mody );
-        }
-    }
+    RenderBands( p_filter, p_pic->i_planes, pi_rows, RenderXBand, &job );
 
     return VLC_SUCCESS;
 }
@@ -289,6 +289,12 @@ static int Mouse( filter_t *p_filter,
                                     "in the Phosphor framerate doubler. "\
                                     "Default: Low.")
 
+#define THREADS_TEXT N_("Deinterlace threads")
+#define THREADS_LONGTEXT N_("Number of threads rendering each picture, "\
+                            "for the Yadif and X modes. 0 selects a "\
+                            "number of threads according to the picture "\
+                            "size, up to one per CPU. Default: 1.")
+
 static void Probe(void *data)
 {
     struct deinterlace_functions *const funcs = data;
@@ -313,6 +319,9 @@ vlc_module_begin ()
                 PHOSPHOR_DIMMER_LONGTEXT )
         change_integer_list( phosphor_dimmer_list, phosphor_dimmer_list_text )
         change_safe ()
+    add_integer_with_range( FILTER_CFG_PREFIX "threads", 1, 0,
+                            DEINTERLACE_MAX_THREADS, THREADS_TEXT,
+                            THREADS_LONGTEXT )
     set_deinterlace_callback( Open )
     add_submodule()
         set_cpu_funcs("deinterlace functions", Probe, 1)
@@ -329,7 +338,7 @@ vlc_module_end ()
  * and reading logic for them implemented in Open().
  */
 static const char *const ppsz_filter_options[] = {
-    "mode", "phosphor-chroma", "phosphor-dimmer",
+    "mode", "phosphor-chroma", "phosphor-dimmer", "threads",
     NULL
 };
 
@@ -348,32 +357,50 @@ struct filter_mode_t
     deinterlace_algo     settings;
     bool                 can_pack;         /**< can handle packed pixel */
     bool                 b_high_bit_depth; /**< can handle high bit depth */
+    bool                 b_threaded;       /**< renders with RenderBands() */
 };
 static struct filter_mode_t filter_mode [] = {
     { "discard", .pf_render_single_pic = RenderDiscard,
-                 { false, false, false, true }, true, true },
+                 { false, false, false, true }, true, true, false },
     { "bob", .pf_render_ordered = RenderBob,
-                 { true, false, false, false }, true, true },
+                 { true, false, false, false }, true, true, false },
     { "progressive-scan", .pf_render_ordered = RenderBob,
-                 { true, false, false, false }, true, true },
+                 { true, false, false, false }, true, true, false },
     { "linear", .pf_render_ordered = RenderLinear,
-                 { true, false, false, false }, true, true },
+                 { true, false, false, false }, true, true, false },
     { "mean", .pf_render_single_pic = RenderMean,
-                 { false, false, false, true }, true, true },
+                 { false, false, false, true }, true, true, false },
     { "blend", .pf_render_single_pic = RenderBlend,
-                 { false, false, false, false }, true, true },
+                 { false, false, false, false }, true, true, false },
     { "yadif", .pf_render_single_pic = RenderYadifSingle,
-                 { false, true, false, false }, false, true },
+                 { false, true, false, false }, false, true, true },
     { "yadif2x", .pf_render_ordered = RenderYadif,
-                 { true, true, false, false }, false, true },
+                 { true, true, false, false }, false, true, true },
     { "x", .pf_render_single_pic = RenderX,
-                 { false, false, false, false }, false, false },
+                 { false, false, false, false }, false, false, true },
     { "phosphor", .pf_render_ordered = RenderPhosphor,
-                 { true, true, false, false }, false, false },
+                 { true, true, false, false }, false, false, false },
     { "ivtc", .pf_render_single_pic = RenderIVTC,
-                 { false, true, true, false }, false, false },
+                 { false, true, true, false }, false, false, false },
 };
 
+/**
+ * Get the number of threads for an automatic thread count.
+ *
+ * Smaller pictures do not take long enough to render to be worth handing
+ * bands over to other threads, so this uses one thread per SD picture area.
+ *
+ * @param p_fmt Input video format.
+ */
+static unsigned GetAutoThreads( const video_format_t *p_fmt )
+{
+    const uint64_t i_pixels = (uint64_t)p_fmt->i_visible_width *
+                              p_fmt->i_visible_height;
+    const unsigned i_threads = i_pixels / (720 * 576);
+
+    return VLC_CLIP( i_threads, 1, vlc_GetCPUCount() );
+}
+
 /**
  * Setup the deinterlace method to use.
  *
@@ -410,6 +437,15 @@ static int SetFilterMethod( filter_t *p_filter, const char *mode, bool pack )
             msg_Dbg( p_filter, "using %s deinterlace method", mode );
             p_sys->context.settings = filter_mode[i].settings;
             p_sys->context.pf_render_ordered = filter_mode[i].pf_render_ordered;
+
+            if( filter_mode[i].b_threaded )
+            {
+                int64_t i_threads = var_GetInteger( p_filter,
+                                                    FILTER_CFG_PREFIX "threads" );
+                if( i_threads <= 0 )
+                    i_threads = GetAutoThreads( &p_filter->fmt_in.video );
+                InitBands( p_filter, i_threads );
+            }
             return VLC_SUCCESS;
         }
     }
@@ -489,6 +525,7 @@ int Mouse( filter_t *p_filter,
 static void Close( filter_t *p_filter )
 {
     Flush( p_filter );
+    CleanBands( p_filter );
     free( p_filter->p_sys );
 }
 
@@ -547,6 +584,7 @@ notsupp:
     p_sys->chroma = chroma;
 
     InitDeinterlacingContext( &p_sys->context );
+    InitBands( p_filter, 1 );
 
     config_ChainParse( p_filter, FILTER_CFG_PREFIX, ppsz_filter_options,
                        p_filter->p_cfg );
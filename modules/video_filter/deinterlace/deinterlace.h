@@ -33,7 +33,9 @@ struct picture_t;
 struct vlc_object_t;
 
 #include <vlc_common.h>
+#include <vlc_executor.h>
 #include <vlc_mouse.h>
+#include <vlc_picture.h>
 
 /* Local algorithm headers */
 #include "algo_basic.h"
@@ -61,6 +63,49 @@ static const char *const mode_list_text[] = {
  * Data structures
  *****************************************************************************/
 
+/** Maximum number of bands a picture is split in, for parallel rendering */
+#define DEINTERLACE_MAX_THREADS 16
+
+/**
+ * Renders the units [i_start, i_end) of a plane. What a unit is (a line,
+ * a row of blocks, ...) is up to the algorithm.
+ * @see RenderBands()
+ */
+typedef void (*band_render_t)( void *p_opaque, int i_plane,
+                               int i_start, int i_end );
+
+struct deinterlace_bands;
+
+/**
+ * One band of a picture, rendered by a worker thread.
+ */
+struct deinterlace_band
+{
+    struct vlc_runnable runnable;
+    struct deinterlace_bands *p_owner;
+    unsigned i_index;
+};
+
+/**
+ * Worker threads state for the algorithms rendering bands in parallel.
+ * @see InitBands()
+ */
+struct deinterlace_bands
+{
+    vlc_executor_t *executor; /**< NULL if single-threaded */
+    unsigned i_count;         /**< Number of bands, including the caller's */
+
+    /* Current job */
+    band_render_t pf_render;
+    void *p_opaque;
+    unsigned i_jobs;          /**< Number of bands of the current job */
+    int i_planes;
+    int pi_units[PICTURE_PLANE_MAX];
+
+    /** Bands rendered by the workers; the caller renders the first one */
+    struct deinterlace_band band[DEINTERLACE_MAX_THREADS - 1];
+};
+
 /**
  * Top-level deinterlace subsystem state.
  */
@@ -73,6 +118,9 @@ typedef struct
 
     struct deinterlace_ctx   context;
 
+    /** Worker threads, for Yadif and X */
+    struct deinterlace_bands bands;
+
     /* Algorithm-specific substructures */
     union {
         phosphor_sys_t phosphor; /**< Phosphor algorithm state. */
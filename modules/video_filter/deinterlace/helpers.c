@@ -451,3 +451,104 @@ int CalculateInterlaceScore( const picture_t* p_pic_top,
     return i_score;
 }
 #undef T
+
+/*****************************************************************************
+ * Parallel rendering
+ *****************************************************************************/
+
+/* Renders one band of all the planes of the current job */
+static void RenderBand( struct deinterlace_bands *p_bands, unsigned i_index )
+{
+    const unsigned i_count = p_bands->i_jobs;
+
+    for( int i_plane = 0; i_plane < p_bands->i_planes; i_plane++ )
+    {
+        const int i_units = p_bands->pi_units[i_plane];
+        const int i_start = (int64_t)i_units * i_index / i_count;
+        const int i_end = (int64_t)i_units * (i_index + 1) / i_count;
+
+        if( i_start < i_end )
+            p_bands->pf_render( p_bands->p_opaque, i_plane, i_start, i_end );
+    }
+}
+
+static void RenderBandRun( void *p_data )
+{
+    struct deinterlace_band *p_band = p_data;
+
+    RenderBand( p_band->p_owner, p_band->i_index );
+}
+
+void InitBands( filter_t *p_filter, unsigned i_threads )
+{
+    filter_sys_t *p_sys = p_filter->p_sys;
+    struct deinterlace_bands *p_bands = &p_sys->bands;
+
+    p_bands->executor = NULL;
+    p_bands->i_count = 1;
+
+    i_threads = __MIN( i_threads, DEINTERLACE_MAX_THREADS );
+    if( i_threads < 2 )
+        return;
+
+    p_bands->executor = vlc_executor_New( i_threads - 1 );
+    if( p_bands->executor == NULL )
+    {
+        msg_Warn( p_filter, "cannot start worker threads" );
+        return;
+    }
+
+    for( unsigned i = 1; i < i_threads; i++ )
+    {
+        struct deinterlace_band *p_band = &p_bands->band[i - 1];
+
+        p_band->runnable.run = RenderBandRun;
+        p_band->runnable.userdata = p_band;
+        p_band->p_owner = p_bands;
+        p_band->i_index = i;
+    }
+    p_bands->i_count = i_threads;
+    msg_Dbg( p_filter, "rendering with %u threads", i_threads );
+}
+
+void CleanBands( filter_t *p_filter )
+{
+    filter_sys_t *p_sys = p_filter->p_sys;
+
+    if( p_sys->bands.executor != NULL )
+    {
+        vlc_executor_Delete( p_sys->bands.executor );
+        p_sys->bands.executor = NULL;
+    }
+    p_sys->bands.i_count = 1;
+}
+
+void RenderBands( filter_t *p_filter, int i_planes, const int *pi_units,
+                  band_render_t pf_render, void *p_opaque )
+{
+    filter_sys_t *p_sys = p_filter->p_sys;
+    struct deinterlace_bands *p_bands = &p_sys->bands;
+
+    assert( i_planes <= PICTURE_PLANE_MAX );
+
+    /* Do not hand out empty bands */
+    unsigned i_count = p_bands->i_count;
+    if( i_planes > 0 && pi_units[0] < (int)i_count )
+        i_count = __MAX( pi_units[0], 1 );
+
+    p_bands->pf_render = pf_render;
+    p_bands->p_opaque = p_opaque;
+    p_bands->i_jobs = i_count;
+    p_bands->i_planes = i_planes;
+    for( int i = 0; i < i_planes; i++ )
+        p_bands->pi_units[i] = pi_units[i];
+
+    for( unsigned i = 1; i < i_count; i++ )
+        vlc_executor_Submit( p_bands->executor,
+                             &p_bands->band[i - 1].runnable );
+
+    RenderBand( p_bands, 0 );
+
+    if( i_count > 1 )
+        vlc_executor_WaitIdle( p_bands->executor );
+}
@@ -165,4 +165,45 @@ int EstimateNumBlocksWithMotion( const picture_t* p_prev,
 int CalculateInterlaceScore( const picture_t* p_pic_top,
                              const picture_t* p_pic_bot );
 
+/**
+ * Helper function: starts the worker threads used by RenderBands().
+ *
+ * With a single thread, or if the threads cannot be started, RenderBands()
+ * renders everything from the calling thread.
+ *
+ * @param p_filter The filter instance.
+ * @param i_threads Number of threads, including the calling one.
+ * @see CleanBands()
+ */
+void InitBands( filter_t *p_filter, unsigned i_threads );
+
+/**
+ * Helper function: stops the worker threads started by InitBands().
+ *
+ * @param p_filter The filter instance.
+ */
+void CleanBands( filter_t *p_filter );
+
+/**
+ * Helper function: renders the planes of a picture in horizontal bands,
+ * in parallel.
+ *
+ * Each plane is cut in as many bands as there are threads, and
+ * pf_render() is called once for each band of each plane. The calls for
+ * different bands may run concurrently, so they must not write outside
+ * of their band, nor read what another band writes. The function returns
+ * once all the bands are rendered.
+ *
+ * @param p_filter The filter instance.
+ * @param i_planes Number of planes to render.
+ * @param pi_units Number of units of each plane, as understood by pf_render.
+ * @param pf_render Rendering function.
+ * @param p_opaque Data passed to pf_render.
+ * @see band_render_t
+ * @see RenderYadif()
+ * @see RenderX()
+ */
+void RenderBands( filter_t *p_filter, int i_planes, const int *pi_units,
+                  band_render_t pf_render, void *p_opaque );
+
 #endif
@@ -872,7 +872,15 @@ int vlc_aout_stream_Play(vlc_aout_stream *stream, block_t *block)
             vlc_mutex_unlock (&owner->vp.lock);
         }
 
+        struct vlc_tracer *tracer = aout_stream_tracer(stream);
+        if (tracer != NULL)
+            vlc_tracer_TraceBegin(tracer, "RENDER", stream->str_id, "filter",
+                                  "step", prefilter_pts);
+
         block = aout_FiltersPlay(stream->filters, block, stream->sync.rate);
+
+        if (tracer != NULL)
+            vlc_tracer_TraceEnd(tracer, "RENDER", stream->str_id, "filter");
         if (block == NULL)
             return ret;
         assert (block->i_pts != VLC_TICK_INVALID);
@@ -906,7 +914,14 @@ int vlc_aout_stream_Play(vlc_aout_stream *stream, block_t *block)
     /* Output */
     stream->sync.played = true;
     stream->timing.played_samples += block->i_nb_samples;
+
+    struct vlc_tracer *tracer = aout_stream_tracer(stream);
+    if (tracer != NULL)
+        vlc_tracer_TraceBegin(tracer, "RENDER", stream->str_id, "play",
+                              "end", block->i_pts);
     aout->play(aout, block, play_date);
+    if (tracer != NULL)
+        vlc_tracer_TraceEnd(tracer, "RENDER", stream->str_id, "play");
 
     atomic_fetch_add_explicit(&stream->buffers_played, 1, memory_order_relaxed);
     return ret;
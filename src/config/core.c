@@ -457,7 +457,11 @@ struct vlc_param *vlc_param_Find(const char *name)
 
     assert(name != NULL);
     p = bsearch (name, config.list, config.count, sizeof (*p), confnamecmp);
-    return (p != NULL) ? *p : NULL;
+    if (p == NULL)
+        return NULL;
+
+    vlc_plugin_LoadConfig((*p)->owner);
+    return *p;
 }
 
 module_config_t *config_FindConfig(const char *name)
@@ -501,6 +505,8 @@ void config_ResetAll(void)
     vlc_mutex_lock(&config_lock);
     for (vlc_plugin_t *p = vlc_plugins; p != NULL; p = p->next)
     {
+        vlc_plugin_LoadConfig(p);
+
         for (size_t i = 0; i < p->conf.size; i++ )
         {
             struct vlc_param *param = p->conf.params + i;
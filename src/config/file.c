@@ -405,6 +405,8 @@ int (config_SaveConfigFile) (libvlc_int_t *p_this)
         if (p->conf.count == 0)
             continue;
 
+        vlc_plugin_LoadConfig(p);
+
         fprintf( file, "[%s]", module_get_object (p_parser) );
         if( p_parser->psz_longname )
             fprintf( file, " # %s\n\n", p_parser->psz_longname );
@@ -134,6 +134,10 @@ struct decoder_video
     /* previous-frame */
     struct decoder_prevframe pf;
     vlc_tick_t pf_pts;
+
+    /* Display lateness of the last pictures, protected by the fifo lock */
+    vlc_tick_t lateness;
+    bool has_lateness;
 };
 
 struct decoder_audio
@@ -1147,6 +1151,23 @@ static float ModuleThread_GetDisplayRate( decoder_t *p_dec )
     return rate;
 }
 
+static int ModuleThread_GetDisplayLateness( decoder_t *p_dec,
+                                            vlc_tick_t *lateness )
+{
+    vlc_input_decoder_t *p_owner = dec_get_owner( p_dec );
+    int ret = VLC_EGENERIC;
+
+    vlc_fifo_Lock(p_owner->p_fifo);
+    if( p_owner->video.has_lateness && !p_owner->b_waiting
+     && !p_owner->paused )
+    {
+        *lateness = p_owner->video.lateness;
+        ret = VLC_SUCCESS;
+    }
+    vlc_fifo_Unlock(p_owner->p_fifo);
+    return ret;
+}
+
 /*****************************************************************************
  * Public functions
  *****************************************************************************/
@@ -1569,8 +1590,8 @@ static void ModuleThread_QueueVideo( decoder_t *p_dec, picture_t *p_pic )
 
     if ( tracer != NULL )
     {
-        vlc_tracer_TraceStreamPTS( tracer, "DEC", p_owner->psz_id,
-                            "OUT", p_pic->date );
+        vlc_tracer_TraceFlow( tracer, "DEC", p_owner->psz_id,
+                              "OUT", "step", p_pic->date );
     }
 
     vlc_fifo_Lock( p_owner->p_fifo );
@@ -1582,8 +1603,16 @@ static void ModuleThread_QueueVideo( decoder_t *p_dec, picture_t *p_pic )
     unsigned vout_late = 0;
     if( p_owner->video.vout != NULL )
     {
+        vlc_tick_t lateness;
+
         vout_GetResetStatistic( p_owner->video.vout, &displayed, &vout_lost,
-                                &vout_late );
+                                &vout_late, &lateness );
+        /* Keep the last measure until the vout outputs again */
+        if( displayed + vout_lost + vout_late > 0 )
+        {
+            p_owner->video.lateness = lateness;
+            p_owner->video.has_lateness = true;
+        }
     }
     if (success != VLC_SUCCESS)
         vout_lost++;
@@ -1705,8 +1734,13 @@ static void ModuleThread_QueueAudio( decoder_t *p_dec, vlc_frame_t *p_aout_buf )
 
     if ( tracer != NULL && p_aout_buf != NULL )
     {
-        vlc_tracer_TraceStreamDTS( tracer, "DEC", p_owner->psz_id, "OUT",
-                            p_aout_buf->i_pts, p_aout_buf->i_dts );
+        vlc_tracer_Trace( tracer, VLC_TRACE("type", "DEC"),
+                                  VLC_TRACE("id", p_owner->psz_id),
+                                  VLC_TRACE("stream", "OUT"),
+                                  VLC_TRACE("flow", "step"),
+                                  VLC_TRACE_TICK_NS("pts", p_aout_buf->i_pts),
+                                  VLC_TRACE_TICK_NS("dts", p_aout_buf->i_dts),
+                                  VLC_TRACE_END );
     }
 
     vlc_fifo_Lock(p_owner->p_fifo);
@@ -1784,17 +1818,24 @@ static void DecoderThread_DecodeBlock( vlc_input_decoder_t *p_owner, vlc_frame_t
 {
     decoder_t *p_dec = &p_owner->dec;
     struct vlc_tracer *tracer = vlc_object_get_tracer( &p_dec->obj );
+    /* The frame is released by the decoder */
+    const bool traced = tracer != NULL && frame != NULL;
 
     vlc_fifo_Unlock(p_owner->p_fifo);
 
-    if ( tracer != NULL && frame != NULL )
+    if ( traced )
     {
         vlc_tracer_TraceStreamDTS( tracer, "DEC", p_owner->psz_id, "IN",
                             frame->i_pts, frame->i_dts );
+        vlc_tracer_TraceBegin( tracer, "DEC", p_owner->psz_id, "decode",
+                               "step", frame->i_pts );
     }
 
     int ret = p_dec->pf_decode( p_dec, frame );
 
+    if ( traced )
+        vlc_tracer_TraceEnd( tracer, "DEC", p_owner->psz_id, "decode" );
+
     vlc_fifo_Lock(p_owner->p_fifo);
     switch( ret )
     {
@@ -2123,6 +2164,7 @@ static const struct decoder_owner_callbacks dec_video_cbs =
         .queue_cc = ModuleThread_QueueCc,
         .get_display_date = ModuleThread_GetDisplayDate,
         .get_display_rate = ModuleThread_GetDisplayRate,
+        .get_display_lateness = ModuleThread_GetDisplayLateness,
     },
     .get_attachments = InputThread_GetInputAttachments,
 };
@@ -2211,8 +2253,9 @@ CreateDecoder( vlc_object_t *p_parent, const struct vlc_input_decoder_cfg *cfg )
 
     es_format_Init( &p_owner->fmt, p_owner->cat, 0 );
 
-    /* decoder fifo */
-    p_owner->p_fifo = block_FifoNew();
+    /* decoder fifo: fed by the input thread (or by the parent decoder thread
+     * for closed captions) and drained by the decoder thread */
+    p_owner->p_fifo = vlc_fifo_NewSPSC();
     if( unlikely(p_owner->p_fifo == NULL) )
     {
         vlc_object_delete(p_dec);
@@ -2256,6 +2299,7 @@ CreateDecoder( vlc_object_t *p_parent, const struct vlc_input_decoder_cfg *cfg )
 
             decoder_prevframe_Init( &p_owner->video.pf );
             p_owner->video.pf_pts = VLC_TICK_INVALID;
+            p_owner->video.has_lateness = false;
 
             if( cfg->input_type == INPUT_TYPE_THUMBNAILING )
                 p_dec->cbs = &dec_thumbnailer_cbs;
@@ -2785,6 +2829,8 @@ void vlc_input_decoder_Flush( vlc_input_decoder_t *p_owner )
      * a row. */
     p_owner->flushing = true;
     p_owner->b_draining = false;
+    if( cat == VIDEO_ES )
+        p_owner->video.has_lateness = false;
 
     /* Flush video/spu decoder when paused: increment frames_countdown in order
      * to display one frame/subtitle */
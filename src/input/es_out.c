@@ -3119,8 +3119,13 @@ static int EsOutSend(es_out_t *out, es_out_id_t *es, block_t *p_block )
 
     if ( tracer != NULL )
     {
-        vlc_tracer_TraceStreamDTS( tracer, "DEMUX", es->id.str_id, "OUT",
-                            p_block->i_pts, p_block->i_dts);
+        vlc_tracer_Trace( tracer, VLC_TRACE("type", "DEMUX"),
+                                  VLC_TRACE("id", es->id.str_id),
+                                  VLC_TRACE("stream", "OUT"),
+                                  VLC_TRACE("flow", "start"),
+                                  VLC_TRACE_TICK_NS("pts", p_block->i_pts),
+                                  VLC_TRACE_TICK_NS("dts", p_block->i_dts),
+                                  VLC_TRACE_END );
     }
 
     struct input_stats *stats = input_priv(p_input)->stats;
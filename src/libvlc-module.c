@@ -104,6 +104,12 @@ static const char *const ppsz_snap_formats[] =
 #define OPEN_LONGTEXT N_( \
     "This stream will always be opened at VLC startup." )
 
+#define LOG_ASYNC_TEXT N_("Asynchronous logging")
+#define LOG_ASYNC_LONGTEXT N_( \
+    "Pass the messages to the log from a background thread, so that " \
+    "verbose logging does not serialize the emitting threads. Messages " \
+    "emitted faster than they can be logged are dropped and counted.")
+
 #define COLOR_TEXT N_("Color messages")
 #define COLOR_LONGTEXT N_( \
     "This enables colorization of the messages sent to the console. " \
@@ -1149,6 +1155,13 @@ static const char* const ppsz_restore_playback_desc[] = {
 #define ONEINSTANCEWHENSTARTEDFROMFILE_TEXT N_( \
     "Use only one instance when started from file manager")
 
+#define FRAME_POOL_TEXT N_("Cache data blocks")
+#define FRAME_POOL_LONGTEXT N_( \
+    "Keep released data blocks in per-thread caches, so that demuxers and " \
+    "decoders can reuse them without calling the system memory allocator. " \
+    "The cache is shared by the whole process: disabling it for one " \
+    "instance disables it for all instances in the process.")
+
 #define HPRIORITY_TEXT N_("Increase the priority of the process")
 #define HPRIORITY_LONGTEXT N_( \
     "Increasing the priority of the process will very likely improve your " \
@@ -1207,6 +1220,11 @@ static const char *const clock_sources_text[] = {
 #define PREPARSE_THREADS_LONGTEXT N_( \
     "Maximum number of threads used to preparse items" )
 
+#define PREPARSE_CACHE_TEXT N_( "Cache the preparsing results" )
+#define PREPARSE_CACHE_LONGTEXT N_( \
+    "Store the preparsing results of local files on disk, so that they are " \
+    "not parsed again until they are modified." )
+
 #define FETCH_ART_THREADS_TEXT N_( "Fetch-art threads" )
 #define FETCH_ART_THREADS_LONGTEXT N_( \
     "Maximum number of threads used to fetch art" )
@@ -2108,6 +2126,8 @@ vlc_module_begin ()
 
     set_section( N_("Performance options"), NULL )
 
+    add_bool( "frame-pool", true, FRAME_POOL_TEXT, FRAME_POOL_LONGTEXT )
+
 #if defined (LIBVLC_USE_PTHREAD)
     add_obsolete_bool( "rt-priority" ) /* since 4.0.0 */
     add_obsolete_integer( "rt-offset" ) /* since 4.0.0 */
@@ -2176,6 +2196,9 @@ vlc_module_begin ()
     add_integer( "preparse-threads", 1, PREPARSE_THREADS_TEXT,
                  PREPARSE_THREADS_LONGTEXT )
 
+    add_bool( "preparse-cache", false, PREPARSE_CACHE_TEXT,
+              PREPARSE_CACHE_LONGTEXT )
+
     add_integer( "fetch-art-threads", 1, FETCH_ART_THREADS_TEXT,
                  FETCH_ART_THREADS_LONGTEXT )
 
@@ -2233,6 +2256,7 @@ vlc_module_begin ()
     add_obsolete_string( "pidfile" ) /* since 4.0.0 */
 #endif
 
+    add_bool( "log-async", false, LOG_ASYNC_TEXT, LOG_ASYNC_LONGTEXT )
     add_bool( "color", true, COLOR_TEXT, COLOR_LONGTEXT )
     add_obsolete_bool( "advanced" ) /* since 4.0.0 */
     add_bool( "interact", true, INTERACTION_TEXT,
@@ -42,6 +42,7 @@
 #include "modules/modules.h"
 #include "config/configuration.h"
 #include "media_source/media_source.h"
+#include "misc/frame_pool.h"
 
 #include <stdio.h>                                              /* sprintf() */
 #include <string.h>
@@ -182,6 +183,11 @@ int libvlc_InternalInit( libvlc_int_t *p_libvlc, int i_argc,
 
     vlc_LogInit(p_libvlc);
 
+    /* The cache is process-wide: an instance can only turn it off, so that
+     * it does not enable it again behind the back of other instances. */
+    if (!var_InheritBool(p_libvlc, "frame-pool"))
+        vlc_frame_pool_Enable(false);
+
     char *tracer_name = var_InheritString(p_libvlc, "tracer");
     priv->tracer = vlc_tracer_Create(VLC_OBJECT(p_libvlc), tracer_name);
     free(tracer_name);
@@ -376,6 +382,13 @@ void libvlc_InternalCleanup( libvlc_int_t *p_libvlc )
     libvlc_InternalKeystoreClean( p_libvlc );
     libvlc_InternalActionsClean( p_libvlc );
 
+    struct vlc_frame_pool_stats fps;
+
+    vlc_frame_pool_GetStats(&fps);
+    msg_Dbg(p_libvlc, "frame cache: %"PRIu64" hits, %"PRIu64" refills, "
+            "%"PRIu64" misses, %"PRIu64" bytes resident",
+            fps.hits, fps.refills, fps.misses, fps.resident);
+
     /* Save the configuration */
     if( !var_InheritBool( p_libvlc, "ignore-config" ) )
         config_AutoSaveConfigFile( p_libvlc );
@@ -113,6 +113,7 @@ unsigned vlc_CPU_raw(void)
     {
         char *p, *cap;
         uint_fast32_t core_caps = 0;
+        unsigned avx512 = 0;
 
         if (strncmp(line, "flags", 5))
             continue;
@@ -136,8 +137,15 @@ unsigned vlc_CPU_raw(void)
                 core_caps |= VLC_CPU_AVX;
             if (!strcmp (cap, "avx2"))
                 core_caps |= VLC_CPU_AVX2;
+            if (!strcmp (cap, "avx512f"))
+                avx512 |= 1;
+            if (!strcmp (cap, "avx512bw"))
+                avx512 |= 2;
         }
 
+        if (avx512 == 3)
+            core_caps |= VLC_CPU_AVX512;
+
         /* Take the intersection of capabilities of each processor */
         all_caps &= core_caps;
     }
@@ -26,12 +26,32 @@
 #endif
 
 #include <assert.h>
+#include <stdatomic.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <vlc_common.h>
 #include <vlc_block.h>
 #include "../libvlc.h"
 
+/* Number of block chains that can be queued without locking (SPSC mode) */
+#define FIFO_RING_SIZE 256
+
+/**
+ * Lock-free staging area for single-producer single-consumer FIFOs.
+ *
+ * The producer fills the ring without taking the FIFO lock. Whoever holds
+ * the lock acts as the consumer and moves the ring content to the queue
+ * before looking at it, so that the ring is invisible to lock holders.
+ */
+struct vlc_fifo_ring
+{
+    atomic_size_t head; /**< next slot to read (written with the lock held) */
+    atomic_size_t tail; /**< next slot to write (written by the producer) */
+    atomic_bool waiting; /**< the consumer found the FIFO empty */
+    block_t *slots[FIFO_RING_SIZE];
+};
+
 /**
  * Internal state for block queues
  */
@@ -40,39 +60,135 @@ struct vlc_fifo_t
     vlc_queue_t         q;
     size_t              i_depth;
     size_t              i_size;
+    struct vlc_fifo_ring *ring;
 };
 
 static_assert (offsetof (block_fifo_t, q) == 0, "Problems in <vlc_block.h>");
 
+/**
+ * Appends a block chain to the queue, without signaling.
+ */
+static bool vlc_fifo_Append(block_fifo_t *fifo, block_t *block)
+{
+    bool was_empty = vlc_queue_IsEmpty(&fifo->q);
+    block_t *last = block;
+
+    for (block_t *b = block; b != NULL; b = b->p_next) {
+        fifo->i_depth++;
+        fifo->i_size += b->i_buffer;
+        last = b;
+    }
+
+    /* Same as vlc_queue_EnqueueUnlocked(), see queue.c about aliasing */
+    memcpy(fifo->q.lastp, &block, sizeof (block));
+    if (last != NULL)
+        fifo->q.lastp = (struct vlc_queue_entry **)&last->p_next;
+    return was_empty;
+}
+
+/**
+ * Moves blocks from the lock-free ring to the queue.
+ */
+static void vlc_fifo_Absorb(block_fifo_t *fifo)
+{
+    struct vlc_fifo_ring *r = fifo->ring;
+
+    vlc_mutex_assert(&fifo->q.lock);
+
+    if (r == NULL)
+        return;
+
+    size_t head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    size_t tail = atomic_load(&r->tail);
+
+    if (head == tail)
+        return;
+
+    do
+        vlc_fifo_Append(fifo, r->slots[head++ % FIFO_RING_SIZE]);
+    while (head != tail);
+
+    atomic_store_explicit(&r->head, head, memory_order_release);
+}
+
+/**
+ * Checks for emptiness from the consumer side.
+ *
+ * If the FIFO is empty, the producer is asked to signal the next block.
+ * This is the only case where the lock-free producer needs the lock.
+ */
+static bool vlc_fifo_Drained(block_fifo_t *fifo)
+{
+    struct vlc_fifo_ring *r = fifo->ring;
+
+    vlc_fifo_Absorb(fifo);
+    if (r == NULL || !vlc_queue_IsEmpty(&fifo->q))
+        return vlc_queue_IsEmpty(&fifo->q);
+
+    atomic_store(&r->waiting, true);
+    /* Check again, in case the producer did not see the flag */
+    vlc_fifo_Absorb(fifo);
+    return vlc_queue_IsEmpty(&fifo->q);
+}
+
 bool vlc_fifo_Held(const block_fifo_t *fifo)
 {
     return vlc_mutex_held(&fifo->q.lock);
 }
 
+bool vlc_fifo_IsEmpty(const block_fifo_t *fifo)
+{
+    struct vlc_fifo_ring *r = fifo->ring;
+
+    if (!vlc_queue_IsEmpty(&fifo->q))
+        return false;
+    if (r == NULL)
+        return true;
+
+    /* This may be called without the lock, so the ring is left alone. */
+    atomic_store(&r->waiting, true);
+    return atomic_load_explicit(&r->head, memory_order_relaxed)
+        == atomic_load(&r->tail);
+}
+
 size_t vlc_fifo_GetCount(const block_fifo_t *fifo)
 {
     vlc_mutex_assert(&fifo->q.lock);
+    vlc_fifo_Absorb((block_fifo_t *)fifo);
     return fifo->i_depth;
 }
 
 size_t vlc_fifo_GetBytes(const block_fifo_t *fifo)
 {
     vlc_mutex_assert(&fifo->q.lock);
+    vlc_fifo_Absorb((block_fifo_t *)fifo);
     return fifo->i_size;
 }
 
 void vlc_fifo_QueueUnlocked(block_fifo_t *fifo, block_t *block)
 {
-    for (block_t *b = block; b != NULL; b = b->p_next) {
-        fifo->i_depth++;
-        fifo->i_size += b->i_buffer;
+    if (fifo->ring == NULL) {
+        for (block_t *b = block; b != NULL; b = b->p_next) {
+            fifo->i_depth++;
+            fifo->i_size += b->i_buffer;
+        }
+
+        vlc_queue_EnqueueUnlocked(&fifo->q, block);
+        return;
     }
 
-    vlc_queue_EnqueueUnlocked(&fifo->q, block);
+    /* Preserve the order with respect to lock-free insertions */
+    vlc_fifo_Absorb(fifo);
+    /* There is only one consumer, which waits only if the FIFO is empty */
+    if (vlc_fifo_Append(fifo, block) && block != NULL)
+        vlc_queue_Signal(&fifo->q);
 }
 
 block_t *vlc_fifo_DequeueUnlocked(block_fifo_t *fifo)
 {
+    if (fifo->ring != NULL && vlc_fifo_Drained(fifo))
+        return NULL;
+
     block_t *block = vlc_queue_DequeueUnlocked(&fifo->q);
 
     if (block != NULL) {
@@ -87,27 +203,80 @@ block_t *vlc_fifo_DequeueUnlocked(block_fifo_t *fifo)
 
 block_t *vlc_fifo_DequeueAllUnlocked(block_fifo_t *fifo)
 {
+    vlc_fifo_Absorb(fifo);
     fifo->i_depth = 0;
     fifo->i_size = 0;
     return vlc_queue_DequeueAllUnlocked(&fifo->q);
 }
 
-block_fifo_t *vlc_fifo_New( void )
+void vlc_fifo_Put(block_fifo_t *fifo, block_t *block)
+{
+    struct vlc_fifo_ring *r = fifo->ring;
+
+    if (r != NULL && block != NULL) {
+        size_t tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+        size_t head = atomic_load_explicit(&r->head, memory_order_acquire);
+
+        if (tail - head < FIFO_RING_SIZE) {
+            r->slots[tail % FIFO_RING_SIZE] = block;
+            atomic_store(&r->tail, tail + 1);
+
+            /* Wake the consumer up only if it found the FIFO empty */
+            if (atomic_load(&r->waiting)
+             && atomic_exchange(&r->waiting, false)) {
+                vlc_fifo_Lock(fifo);
+                vlc_fifo_Signal(fifo);
+                vlc_fifo_Unlock(fifo);
+            }
+            return;
+        }
+        /* The ring is full: fall back to the queue */
+    }
+
+    vlc_fifo_Lock(fifo);
+    vlc_fifo_QueueUnlocked(fifo, block);
+    vlc_fifo_Unlock(fifo);
+}
+
+static block_fifo_t *vlc_fifo_Create(bool spsc)
 {
     block_fifo_t *p_fifo = malloc( sizeof( block_fifo_t ) );
 
-    if (likely(p_fifo != NULL)) {
-        vlc_queue_Init(&p_fifo->q, offsetof (block_t, p_next));
-        p_fifo->i_depth = 0;
-        p_fifo->i_size = 0;
+    if (unlikely(p_fifo == NULL))
+        return NULL;
+
+    p_fifo->ring = NULL;
+    if (spsc) {
+        p_fifo->ring = malloc(sizeof (*p_fifo->ring));
+        if (unlikely(p_fifo->ring == NULL)) {
+            free(p_fifo);
+            return NULL;
+        }
+        atomic_init(&p_fifo->ring->head, 0);
+        atomic_init(&p_fifo->ring->tail, 0);
+        atomic_init(&p_fifo->ring->waiting, false);
     }
 
+    vlc_queue_Init(&p_fifo->q, offsetof (block_t, p_next));
+    p_fifo->i_depth = 0;
+    p_fifo->i_size = 0;
     return p_fifo;
 }
 
+block_fifo_t *vlc_fifo_New( void )
+{
+    return vlc_fifo_Create(false);
+}
+
+block_fifo_t *vlc_fifo_NewSPSC( void )
+{
+    return vlc_fifo_Create(true);
+}
+
 void vlc_fifo_Delete( block_fifo_t *p_fifo )
 {
     vlc_fifo_Empty(p_fifo);
+    free( p_fifo->ring );
     free( p_fifo );
 }
 
@@ -118,13 +287,12 @@ block_t *vlc_fifo_Get(block_fifo_t *fifo)
     vlc_testcancel();
 
     vlc_fifo_Lock(fifo);
-    while (vlc_fifo_IsEmpty(fifo))
+    while ((block = vlc_fifo_DequeueUnlocked(fifo)) == NULL)
     {
         vlc_fifo_CleanupPush(fifo);
         vlc_fifo_Wait(fifo);
         vlc_cleanup_pop();
     }
-    block = vlc_fifo_DequeueUnlocked(fifo);
     vlc_fifo_Unlock(fifo);
 
     return block;
@@ -135,6 +303,7 @@ block_t *vlc_fifo_Show( block_fifo_t *p_fifo )
     block_t *b;
 
     vlc_fifo_Lock(p_fifo);
+    vlc_fifo_Absorb(p_fifo);
     assert(p_fifo->q.first != NULL);
     b = (block_t *)p_fifo->q.first;
     vlc_fifo_Unlock(p_fifo);
@@ -0,0 +1,317 @@
+/*****************************************************************************
+ * frame_pool.c: frame allocator cache
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#include <vlc_common.h>
+#include <vlc_frame.h>
+#include <vlc_threads.h>
+
+#include "frame_pool.h"
+
+/* Size classes are powers of two, from 256 bytes to 64 KiB of capacity
+ * (including the padding). Larger frames bypass the cache. */
+#define CLASS_MIN_SHIFT 8
+#define CLASS_COUNT     9
+
+/* Maximum bytes kept in the cache of each thread, per class */
+#define THREAD_CACHE_BYTES (256 << 10)
+/* Maximum number of frames kept in the cache of each thread, per class */
+#define THREAD_CACHE_COUNT 16
+/* Maximum bytes kept in the shared depot, per class */
+#define DEPOT_BYTES        (2 << 20)
+
+struct vlc_frame_pooled
+{
+    vlc_frame_t self;
+    struct vlc_frame_pooled *next; /**< free list linkage */
+    unsigned class;
+};
+
+/** Offset of the frame data from the start of the allocation */
+#define DATA_OFFSET \
+    ((sizeof (struct vlc_frame_pooled) + VLC_FRAME_ALIGN - 1) \
+     & ~(size_t)(VLC_FRAME_ALIGN - 1))
+
+struct vlc_frame_list
+{
+    struct vlc_frame_pooled *head;
+    unsigned count;
+};
+
+struct vlc_frame_cache
+{
+    struct vlc_frame_list lists[CLASS_COUNT];
+    bool registered;
+
+    /* Statistics not yet merged into the global ones */
+    uint64_t hits;
+    uint64_t misses;
+    int64_t resident;
+};
+
+static struct
+{
+    vlc_mutex_t lock;
+    struct vlc_frame_list lists[CLASS_COUNT];
+} depot = { VLC_STATIC_MUTEX, { { NULL, 0 } } };
+
+#if defined (HAVE_ALIGNED_ALLOC) && !defined (FUZZING_BUILD_MODE_UNSAFE_FOR_PRODUCTION)
+static atomic_bool enabled = true;
+#else
+static atomic_bool enabled = false;
+#endif
+
+static struct
+{
+    atomic_uint_least64_t hits;
+    atomic_uint_least64_t refills;
+    atomic_uint_least64_t misses;
+    atomic_int_least64_t resident;
+} stats;
+
+static thread_local struct vlc_frame_cache cache;
+
+static vlc_once_t cache_once = VLC_STATIC_ONCE;
+static vlc_threadvar_t cache_key;
+
+static size_t vlc_frame_pool_Capacity(unsigned class)
+{
+    return (size_t)1 << (CLASS_MIN_SHIFT + class);
+}
+
+static unsigned vlc_frame_pool_CacheLimit(unsigned class)
+{
+    unsigned max = THREAD_CACHE_BYTES / vlc_frame_pool_Capacity(class);
+
+    return max < THREAD_CACHE_COUNT ? max : THREAD_CACHE_COUNT;
+}
+
+static struct vlc_frame_pooled *vlc_frame_list_Pop(struct vlc_frame_list *l)
+{
+    struct vlc_frame_pooled *p = l->head;
+
+    if (p != NULL) {
+        l->head = p->next;
+        l->count--;
+    }
+    return p;
+}
+
+static void vlc_frame_list_Push(struct vlc_frame_list *l,
+                                struct vlc_frame_pooled *p)
+{
+    p->next = l->head;
+    l->head = p;
+    l->count++;
+}
+
+static void vlc_frame_cache_Publish(struct vlc_frame_cache *c)
+{
+    atomic_fetch_add_explicit(&stats.hits, c->hits, memory_order_relaxed);
+    atomic_fetch_add_explicit(&stats.misses, c->misses, memory_order_relaxed);
+    atomic_fetch_add_explicit(&stats.resident, c->resident,
+                              memory_order_relaxed);
+    c->hits = c->misses = 0;
+    c->resident = 0;
+}
+
+/**
+ * Moves frames from a thread cache to the depot, keeping @p keep of them.
+ * Frames that do not fit in the depot are given back to the system.
+ */
+static void vlc_frame_cache_Drain(struct vlc_frame_cache *c, unsigned class,
+                                  unsigned keep)
+{
+    struct vlc_frame_list *l = &c->lists[class];
+    const size_t capacity = vlc_frame_pool_Capacity(class);
+    const unsigned max = DEPOT_BYTES / capacity;
+    struct vlc_frame_pooled *excess = NULL;
+
+    vlc_mutex_lock(&depot.lock);
+    while (l->count > keep) {
+        struct vlc_frame_pooled *p = vlc_frame_list_Pop(l);
+
+        if (depot.lists[class].count < max)
+            vlc_frame_list_Push(&depot.lists[class], p);
+        else {
+            p->next = excess;
+            excess = p;
+            c->resident -= DATA_OFFSET + capacity;
+        }
+    }
+    vlc_mutex_unlock(&depot.lock);
+
+    while (excess != NULL) {
+        struct vlc_frame_pooled *next = excess->next;
+
+        free(excess);
+        excess = next;
+    }
+}
+
+static void vlc_frame_cache_Destroy(void *data)
+{
+    struct vlc_frame_cache *c = data;
+
+    for (unsigned i = 0; i < CLASS_COUNT; i++)
+        vlc_frame_cache_Drain(c, i, 0);
+    vlc_frame_cache_Publish(c);
+    c->registered = false;
+}
+
+static void vlc_frame_pool_InitOnce(void *data)
+{
+    (void) data;
+    if (vlc_threadvar_create(&cache_key, vlc_frame_cache_Destroy))
+        abort();
+}
+
+static struct vlc_frame_cache *vlc_frame_cache_Get(void)
+{
+    struct vlc_frame_cache *c = &cache;
+
+    if (unlikely(!c->registered)) {
+        /* Register the cache so that it gets drained when the thread exits */
+        vlc_once(&cache_once, vlc_frame_pool_InitOnce, NULL);
+        vlc_threadvar_set(cache_key, c);
+        c->registered = true;
+    }
+    return c;
+}
+
+static void vlc_frame_pool_Release(vlc_frame_t *frame)
+{
+    struct vlc_frame_pooled *p = container_of(frame, struct vlc_frame_pooled,
+                                              self);
+    struct vlc_frame_cache *c = vlc_frame_cache_Get();
+    const unsigned class = p->class;
+    const unsigned limit = vlc_frame_pool_CacheLimit(class);
+
+    vlc_frame_list_Push(&c->lists[class], p);
+    c->resident += DATA_OFFSET + vlc_frame_pool_Capacity(class);
+
+    if (c->lists[class].count > limit) {
+        /* Keep half of the cache, so that alternating allocations and
+         * releases do not hit the depot every time. */
+        vlc_frame_cache_Drain(c, class, limit / 2);
+        vlc_frame_cache_Publish(c);
+    }
+}
+
+static const struct vlc_frame_callbacks vlc_frame_pool_cbs =
+{
+    vlc_frame_pool_Release,
+};
+
+static struct vlc_frame_pooled *vlc_frame_pool_Refill(struct vlc_frame_cache *c,
+                                                      unsigned class)
+{
+    struct vlc_frame_list *l = &c->lists[class];
+    unsigned count = vlc_frame_pool_CacheLimit(class) / 2;
+    struct vlc_frame_pooled *p;
+
+    vlc_mutex_lock(&depot.lock);
+    p = vlc_frame_list_Pop(&depot.lists[class]);
+    if (p != NULL) {
+        struct vlc_frame_pooled *extra;
+
+        while (count-- > 0
+            && (extra = vlc_frame_list_Pop(&depot.lists[class])) != NULL)
+            vlc_frame_list_Push(l, extra);
+    }
+    vlc_mutex_unlock(&depot.lock);
+
+    if (p != NULL) {
+        /* Frames moved from the depot to the thread cache remain resident,
+         * the one being handed out does not. */
+        c->resident -= DATA_OFFSET + vlc_frame_pool_Capacity(class);
+        atomic_fetch_add_explicit(&stats.refills, 1, memory_order_relaxed);
+        vlc_frame_cache_Publish(c);
+    }
+    return p;
+}
+
+vlc_frame_t *vlc_frame_pool_Alloc(size_t size)
+{
+    if (!atomic_load_explicit(&enabled, memory_order_relaxed))
+        return NULL;
+
+    /* Same layout as heap frames: padding on both sides */
+    const size_t needed = 2 * VLC_FRAME_PADDING + size;
+    unsigned class = 0;
+
+    while (vlc_frame_pool_Capacity(class) < needed)
+        if (++class >= CLASS_COUNT)
+            return NULL;
+
+    struct vlc_frame_cache *c = vlc_frame_cache_Get();
+    const size_t capacity = vlc_frame_pool_Capacity(class);
+    struct vlc_frame_pooled *p = vlc_frame_list_Pop(&c->lists[class]);
+
+    if (likely(p != NULL)) {
+        c->hits++;
+        c->resident -= DATA_OFFSET + capacity;
+    } else {
+        p = vlc_frame_pool_Refill(c, class);
+        if (p == NULL) {
+            p = aligned_alloc(VLC_FRAME_ALIGN, DATA_OFFSET + capacity);
+            if (unlikely(p == NULL))
+                return NULL;
+            c->misses++;
+        }
+    }
+
+    p->class = class;
+
+    unsigned char *buf = (unsigned char *)p + DATA_OFFSET;
+    vlc_frame_t *f = vlc_frame_Init(&p->self, &vlc_frame_pool_cbs,
+                                    buf, capacity);
+
+    f->p_buffer = buf + VLC_FRAME_PADDING;
+    f->i_buffer = size;
+    return f;
+}
+
+void vlc_frame_pool_Enable(bool on)
+{
+#if defined (HAVE_ALIGNED_ALLOC) && !defined (FUZZING_BUILD_MODE_UNSAFE_FOR_PRODUCTION)
+    atomic_store_explicit(&enabled, on, memory_order_relaxed);
+#else
+    (void) on;
+#endif
+}
+
+void vlc_frame_pool_GetStats(struct vlc_frame_pool_stats *st)
+{
+    int64_t resident;
+
+    st->hits = atomic_load_explicit(&stats.hits, memory_order_relaxed);
+    st->refills = atomic_load_explicit(&stats.refills, memory_order_relaxed);
+    st->misses = atomic_load_explicit(&stats.misses, memory_order_relaxed);
+    resident = atomic_load_explicit(&stats.resident, memory_order_relaxed);
+    st->resident = resident > 0 ? resident : 0;
+}
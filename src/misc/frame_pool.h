@@ -0,0 +1,86 @@
+/*****************************************************************************
+ * frame_pool.h: frame allocator cache
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifndef VLC_FRAME_POOL_H
+#define VLC_FRAME_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Initial memory alignment of data frame.
+ * @note This must be a multiple of sizeof(void*) and a power of two.
+ * libavcodec AVX optimizations require at least 32-bytes. */
+#define VLC_FRAME_ALIGN        32
+
+/** Initial reserved header and footer size. */
+#ifdef FUZZING_BUILD_MODE_UNSAFE_FOR_PRODUCTION
+# define VLC_FRAME_PADDING      0 /* Don't hide buffer overflows */
+#else
+# define VLC_FRAME_PADDING      32 /* Avoid <= 32 bytes reallocs */
+#endif
+
+/**
+ * \defgroup frame_pool Frame allocator cache
+ * \ingroup frame
+ *
+ * Small and medium frames are allocated from power-of-two size classes.
+ * Released frames are kept in a per-thread cache, backed by a bounded
+ * process-wide depot, so that most allocations need neither a lock nor a
+ * call to the system allocator.
+ * @{
+ */
+
+struct vlc_frame_pool_stats
+{
+    uint64_t hits; /**< allocations served from a thread cache */
+    uint64_t refills; /**< allocations served from the shared depot */
+    uint64_t misses; /**< allocations served by the system allocator */
+    uint64_t resident; /**< bytes held by released frames */
+};
+
+/**
+ * Allocates a frame from the cache.
+ *
+ * @return a frame, or NULL if the cache is disabled, if the size is too
+ * large for the cache, or on memory error
+ */
+struct vlc_frame_t *vlc_frame_pool_Alloc(size_t size);
+
+/**
+ * Enables or disables the cache.
+ *
+ * The setting is process-wide, and shared by all LibVLC instances.
+ * Frames allocated while the cache was enabled remain valid, and get back to
+ * the cache when released.
+ */
+void vlc_frame_pool_Enable(bool enabled);
+
+/**
+ * Retrieves approximate cache statistics.
+ *
+ * Statistics of each thread are merged lazily, so recent activity may not be
+ * accounted for yet.
+ */
+void vlc_frame_pool_GetStats(struct vlc_frame_pool_stats *stats);
+
+/** @} */
+
+#endif
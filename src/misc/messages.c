@@ -38,6 +38,8 @@
 
 #include <vlc_common.h>
 #include <vlc_threads.h>
+#include <vlc_atomic.h>
+#include <vlc_list.h>
 #include <vlc_interface.h>
 #include <vlc_charset.h>
 #include <vlc_modules.h>
@@ -153,6 +155,7 @@ void vlc_vaLog(struct vlc_logger *const *loggerp, int type,
     msg.line = line;
     msg.func = func;
     msg.tid = vlc_thread_id();
+    msg.date = vlc_tick_now();
 
     /* Pass message to the callback */
     vlc_vaLogCallback(logger, type, &msg, format, args);
@@ -212,6 +215,8 @@ static void vlc_vaLogEarly(void *d, int type, const vlc_log_t *item,
     log->meta.file = item->file;
     log->meta.line = item->line;
     log->meta.func = item->func;
+    log->meta.tid = item->tid;
+    log->meta.date = item->date;
 
     if (vasprintf(&log->msg, format, ap) == -1)
         log->msg = NULL;
@@ -419,6 +424,343 @@ static struct vlc_logger *vlc_LogModuleCreate(vlc_object_t *parent)
     return &module->frontend;
 }
 
+/**
+ * Asynchronous message log.
+ *
+ * Each emitting thread formats its messages into a ring buffer of its own,
+ * without locking, and a background thread passes them on to another log.
+ * The messages of the different threads are merged by emission date.
+ * Messages that do not fit in a full ring are counted and reported as lost.
+ */
+#define LOG_RING_SLOTS 128
+#define LOG_TEXT_SIZE  256
+
+struct vlc_log_slot {
+    int type;
+    vlc_log_t meta;
+    char module[32];
+    char *header; /**< local copy, or NULL */
+    char *long_text; /**< when the message does not fit in text[] */
+    char text[LOG_TEXT_SIZE];
+};
+
+struct vlc_log_ring {
+    struct vlc_log_ring *next; /**< immutable once published */
+    atomic_ulong owner; /**< emitting thread ID, or 0 if free */
+    atomic_size_t head; /**< written by the owner only */
+    atomic_size_t tail; /**< written by the drain thread only */
+    struct vlc_log_slot slots[LOG_RING_SLOTS];
+};
+
+struct vlc_logger_async {
+    struct vlc_logger logger;
+    struct vlc_logger *backend;
+    uint64_t id;
+    struct vlc_log_ring *_Atomic rings;
+    atomic_uint_least64_t overflows;
+    atomic_uint wake;
+    atomic_bool stop;
+    vlc_thread_t thread;
+    struct vlc_list node; /**< in async_loggers.list */
+};
+
+/* Live asynchronous logs, for the threads to give their ring back on exit */
+static struct {
+    vlc_mutex_t lock;
+    struct vlc_list list;
+    uint64_t next_id;
+} async_loggers = { VLC_STATIC_MUTEX, VLC_LIST_INITIALIZER(&async_loggers.list), 1 };
+
+/* Ring of the calling thread in the last asynchronous log it used */
+static thread_local struct vlc_log_cache {
+    uint64_t logger_id;
+    struct vlc_log_ring *ring;
+    bool registered;
+} log_cache;
+
+static vlc_once_t log_cache_once = VLC_STATIC_ONCE;
+static vlc_threadvar_t log_cache_key;
+
+static void vlc_LogAsyncThreadExit(void *data)
+{
+    struct vlc_log_cache *cache = data;
+
+    vlc_mutex_lock(&async_loggers.lock);
+    struct vlc_logger_async *async;
+    vlc_list_foreach(async, &async_loggers.list, node)
+        if (async->id == cache->logger_id) {
+            /* The log is still alive: its ring can be reused */
+            atomic_store_explicit(&cache->ring->owner, 0,
+                                  memory_order_release);
+            break;
+        }
+    vlc_mutex_unlock(&async_loggers.lock);
+    cache->logger_id = 0;
+    cache->registered = false;
+}
+
+static void vlc_LogAsyncInitOnce(void *data)
+{
+    (void) data;
+    if (vlc_threadvar_create(&log_cache_key, vlc_LogAsyncThreadExit))
+        abort();
+}
+
+static struct vlc_log_ring *vlc_LogAsyncGetRing(struct vlc_logger_async *async)
+{
+    if (likely(log_cache.logger_id == async->id))
+        return log_cache.ring;
+
+    const unsigned long tid = vlc_thread_id();
+    struct vlc_log_ring *ring;
+
+    /* Reuse the ring this thread left behind when it switched to another
+     * log, or that of an exited thread, if any */
+    for (ring = atomic_load_explicit(&async->rings, memory_order_acquire);
+         ring != NULL; ring = ring->next) {
+        unsigned long expected = 0;
+
+        if (atomic_load_explicit(&ring->owner, memory_order_acquire) == tid)
+            break;
+        if (atomic_compare_exchange_strong_explicit(&ring->owner, &expected,
+                                                    tid, memory_order_acquire,
+                                                    memory_order_relaxed))
+            break;
+    }
+
+    if (ring == NULL) {
+        ring = malloc(sizeof (*ring));
+        if (unlikely(ring == NULL))
+            return NULL;
+
+        atomic_init(&ring->owner, tid);
+        atomic_init(&ring->head, 0);
+        atomic_init(&ring->tail, 0);
+        ring->next = atomic_load_explicit(&async->rings, memory_order_relaxed);
+        while (!atomic_compare_exchange_weak_explicit(&async->rings,
+                                                      &ring->next, ring,
+                                                      memory_order_release,
+                                                      memory_order_relaxed));
+    }
+
+    if (unlikely(!log_cache.registered)) {
+        /* Give the ring back when the thread exits */
+        vlc_once(&log_cache_once, vlc_LogAsyncInitOnce, NULL);
+        vlc_threadvar_set(log_cache_key, &log_cache);
+        log_cache.registered = true;
+    }
+    /* The ring of a previous log, if any, stays with that log */
+    log_cache.logger_id = async->id;
+    log_cache.ring = ring;
+    return ring;
+}
+
+static void vlc_vaLogAsync(void *d, int type, const vlc_log_t *item,
+                           const char *format, va_list ap)
+{
+    struct vlc_logger *logger = d;
+    struct vlc_logger_async *async =
+        container_of(logger, struct vlc_logger_async, logger);
+    struct vlc_log_ring *ring = vlc_LogAsyncGetRing(async);
+
+    if (unlikely(ring == NULL))
+        return;
+
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+    if (head - tail >= LOG_RING_SLOTS) {
+        atomic_fetch_add_explicit(&async->overflows, 1, memory_order_relaxed);
+        return;
+    }
+
+    struct vlc_log_slot *slot = &ring->slots[head % LOG_RING_SLOTS];
+    va_list aq;
+
+    slot->type = type;
+    slot->meta = *item;
+    /* The module name may be on the stack of the caller */
+    strlcpy(slot->module, item->psz_module, sizeof (slot->module));
+    slot->meta.psz_module = slot->module;
+    slot->header = item->psz_header ? strdup(item->psz_header) : NULL;
+    slot->meta.psz_header = slot->header;
+    slot->long_text = NULL;
+
+    va_copy(aq, ap);
+    int len = vsnprintf(slot->text, sizeof (slot->text), format, aq);
+    va_end(aq);
+    if (len >= (int)sizeof (slot->text)
+     && vasprintf(&slot->long_text, format, ap) == -1)
+        slot->long_text = NULL;
+
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+
+    if (atomic_exchange_explicit(&async->wake, 1, memory_order_release) == 0)
+        vlc_atomic_notify_one(&async->wake);
+}
+
+static void vlc_LogAsyncEmit(struct vlc_logger *backend, int type,
+                             const vlc_log_t *item, const char *format, ...)
+{
+    va_list ap;
+
+    va_start(ap, format);
+    backend->ops->log(backend, type, item, format, ap);
+    va_end(ap);
+}
+
+/* Passes the pending messages on, oldest first, and tells whether any was */
+static bool vlc_LogAsyncDrain(struct vlc_logger_async *async)
+{
+    uint64_t lost = atomic_exchange_explicit(&async->overflows, 0,
+                                             memory_order_relaxed);
+    bool drained = false;
+
+    if (lost > 0) {
+        const vlc_log_t meta = {
+            .i_object_id = (uintptr_t)(void *)async,
+            .psz_object_type = "logger",
+            .psz_module = "async",
+            .line = -1,
+            .tid = vlc_thread_id(),
+            .date = vlc_tick_now(),
+        };
+
+        vlc_LogAsyncEmit(async->backend, VLC_MSG_WARN, &meta,
+                         "%"PRIu64" message(s) lost (log buffer full)", lost);
+    }
+
+    for (;;) {
+        struct vlc_log_ring *best = NULL;
+        struct vlc_log_slot *best_slot = NULL;
+
+        for (struct vlc_log_ring *ring = atomic_load_explicit(&async->rings,
+                                                      memory_order_acquire);
+             ring != NULL; ring = ring->next) {
+            size_t tail = atomic_load_explicit(&ring->tail,
+                                               memory_order_relaxed);
+
+            if (atomic_load_explicit(&ring->head,
+                                     memory_order_acquire) == tail)
+                continue;
+
+            struct vlc_log_slot *slot = &ring->slots[tail % LOG_RING_SLOTS];
+
+            if (best_slot == NULL || slot->meta.date < best_slot->meta.date) {
+                best = ring;
+                best_slot = slot;
+            }
+        }
+
+        if (best == NULL)
+            break;
+
+        const char *text = best_slot->long_text ? best_slot->long_text
+                                                : best_slot->text;
+        int canc = vlc_savecancel();
+        vlc_LogAsyncEmit(async->backend, best_slot->type, &best_slot->meta,
+                         "%s", text);
+        vlc_restorecancel(canc);
+        free(best_slot->long_text);
+        free(best_slot->header);
+        atomic_fetch_add_explicit(&best->tail, 1, memory_order_release);
+        drained = true;
+    }
+    return drained;
+}
+
+static void *vlc_LogAsyncThread(void *data)
+{
+    struct vlc_logger_async *async = data;
+
+    vlc_thread_set_name("vlc-log");
+
+    for (;;) {
+        /* Sequentially consistent, so that the rings are not drained before
+         * the wake flag is cleared: otherwise a message written in between
+         * would neither be drained nor wake the thread up */
+        atomic_exchange_explicit(&async->wake, 0, memory_order_seq_cst);
+        bool stop = atomic_load_explicit(&async->stop, memory_order_acquire);
+
+        if (vlc_LogAsyncDrain(async))
+            continue;
+        if (stop)
+            break;
+        vlc_atomic_wait(&async->wake, 0);
+    }
+    return NULL;
+}
+
+static void vlc_LogAsyncClose(void *d)
+{
+    struct vlc_logger *logger = d;
+    struct vlc_logger_async *async =
+        container_of(logger, struct vlc_logger_async, logger);
+
+    vlc_mutex_lock(&async_loggers.lock);
+    vlc_list_remove(&async->node);
+    vlc_mutex_unlock(&async_loggers.lock);
+
+    atomic_store_explicit(&async->stop, true, memory_order_release);
+    atomic_store_explicit(&async->wake, 1, memory_order_release);
+    vlc_atomic_notify_one(&async->wake);
+    vlc_join(async->thread, NULL);
+
+    for (struct vlc_log_ring *ring = atomic_load(&async->rings), *next;
+         ring != NULL; ring = next) {
+        next = ring->next;
+        free(ring);
+    }
+
+    async->backend->ops->destroy(async->backend);
+    free(async);
+}
+
+static const struct vlc_logger_operations async_ops = {
+    vlc_vaLogAsync,
+    vlc_LogAsyncClose,
+};
+
+static struct vlc_logger *vlc_LogAsyncCreate(struct vlc_logger *backend)
+{
+    struct vlc_logger_async *async = malloc(sizeof (*async));
+    if (unlikely(async == NULL))
+        return NULL;
+
+    async->logger.ops = &async_ops;
+    async->backend = backend;
+    atomic_init(&async->rings, NULL);
+    atomic_init(&async->overflows, 0);
+    atomic_init(&async->wake, 0);
+    atomic_init(&async->stop, false);
+
+    vlc_mutex_lock(&async_loggers.lock);
+    async->id = async_loggers.next_id++;
+    vlc_list_append(&async->node, &async_loggers.list);
+    vlc_mutex_unlock(&async_loggers.lock);
+
+    if (vlc_clone(&async->thread, vlc_LogAsyncThread, async)) {
+        vlc_mutex_lock(&async_loggers.lock);
+        vlc_list_remove(&async->node);
+        vlc_mutex_unlock(&async_loggers.lock);
+        free(async);
+        return NULL;
+    }
+    return &async->logger;
+}
+
+/* Makes a log asynchronous if so configured */
+static struct vlc_logger *vlc_LogAsyncWrap(libvlc_int_t *vlc,
+                                           struct vlc_logger *logger)
+{
+    if (logger == &discard_log || !var_InheritBool(vlc, "log-async"))
+        return logger;
+
+    struct vlc_logger *async = vlc_LogAsyncCreate(logger);
+
+    return (async != NULL) ? async : logger;
+}
+
 /**
  * Initializes the messages logging subsystem and drain the early messages to
  * the configured log.
@@ -429,7 +771,7 @@ void vlc_LogInit(libvlc_int_t *vlc)
     if (logger == NULL)
         logger = &discard_log;
 
-    vlc_LogSwitch(vlc->obj.logger, logger);
+    vlc_LogSwitch(vlc->obj.logger, vlc_LogAsyncWrap(vlc, logger));
 }
 
 /**
@@ -564,7 +906,7 @@ void vlc_LogSet(libvlc_int_t *vlc, const struct vlc_logger_operations *ops,
     if (logger == NULL)
         logger = &discard_log;
 
-    vlc_LogSwitch(vlc->obj.logger, logger);
+    vlc_LogSwitch(vlc->obj.logger, vlc_LogAsyncWrap(vlc, logger));
     vlc_LogSpam(VLC_OBJECT(vlc));
 }
 
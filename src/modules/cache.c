@@ -57,7 +57,7 @@
 #ifdef HAVE_DYNAMIC_PLUGINS
 /* Sub-version number
  * (only used to avoid breakage in dev version when cache structure changes) */
-#define CACHE_SUBVERSION_NUM 36
+#define CACHE_SUBVERSION_NUM 37
 
 /* Cache filename */
 #define CACHE_NAME "plugins.dat"
@@ -189,8 +189,17 @@ static int vlc_cache_load_config(struct vlc_param *param, block_t *file)
     LOAD_FLAG (param->unsaved);
     LOAD_FLAG (param->safe);
     LOAD_FLAG (param->obsolete);
-    LOAD_STRING (cfg->psz_type);
     LOAD_STRING (cfg->psz_name);
+    return 0;
+error:
+    return -1;
+}
+
+static int vlc_cache_load_config_desc(struct vlc_param *param, block_t *file)
+{
+    module_config_t *cfg = &param->item;
+
+    LOAD_STRING (cfg->psz_type);
     LOAD_STRING (cfg->psz_text);
     LOAD_STRING (cfg->psz_longtext);
     LOAD_IMMEDIATE (cfg->list_count);
@@ -200,17 +209,20 @@ static int vlc_cache_load_config(struct vlc_param *param, block_t *file)
         const char *psz;
         LOAD_STRING(psz);
         cfg->orig.psz = (char *)psz;
-        atomic_init(&param->value.str, NULL);
-        vlc_param_SetString(param, psz);
+
+        /* The item is not visible to other threads yet: there is no need for
+         * vlc_param_SetString() and its RCU synchronization. */
+        char *str = (psz != NULL && psz[0] != '\0') ? strdup(psz) : NULL;
+        atomic_store_explicit(&param->value.str, str, memory_order_relaxed);
+        cfg->value.psz = str;
 
         if (cfg->list_count)
             cfg->list.psz = xmalloc (cfg->list_count * sizeof (char *));
         for (unsigned i = 0; i < cfg->list_count; i++)
         {
             LOAD_STRING (cfg->list.psz[i]);
-            if (cfg->list.psz[i] == NULL /* NULL -> empty string */
-             && (cfg->list.psz[i] = calloc (1, 1)) == NULL)
-                goto error;
+            if (cfg->list.psz[i] == NULL) /* NULL -> empty string */
+                cfg->list.psz[i] = "";
         }
     }
     else
@@ -234,23 +246,62 @@ static int vlc_cache_load_config(struct vlc_param *param, block_t *file)
         LOAD_ARRAY(cfg->list.i, cfg->list_count);
     }
 
-    cfg->list_text = xmalloc (cfg->list_count * sizeof (char *));
+    /* Most items have no choices: do not allocate empty tables for them */
+    if (cfg->list_count)
+        cfg->list_text = xmalloc (cfg->list_count * sizeof (char *));
     for (unsigned i = 0; i < cfg->list_count; i++)
     {
         LOAD_STRING (cfg->list_text[i]);
-        if (cfg->list_text[i] == NULL /* NULL -> empty string */
-         && (cfg->list_text[i] = calloc (1, 1)) == NULL)
-            goto error;
+        if (cfg->list_text[i] == NULL) /* NULL -> empty string */
+            cfg->list_text[i] = "";
     }
 
     return 0;
 error:
-    return -1; /* FIXME: leaks */
+    /* Drop the choices: they may be incomplete */
+    if (IsConfigStringType (cfg->i_type))
+    {
+        free(cfg->list.psz);
+        cfg->list.psz = NULL;
+    }
+    else
+        cfg->list.i = NULL;
+    free(cfg->list_text);
+    cfg->list_text = NULL;
+    cfg->list_count = 0;
+    return -1;
+}
+
+static void vlc_cache_load_plugin_desc(void *data)
+{
+    vlc_plugin_t *plugin = data;
+
+    if (plugin->conf.desc == NULL)
+        return; /* not loaded from the cache */
+
+    block_t file;
+
+    block_Init(&file, NULL, (void *)plugin->conf.desc, plugin->conf.desc_size);
+
+    /* The cache file was checked when it was loaded, but only for the sizes
+     * of the descriptors blocks. If the descriptors are corrupted anyway,
+     * the remaining items keep null defaults. */
+    for (size_t i = 0; i < plugin->conf.size; i++)
+        if (vlc_cache_load_config_desc(plugin->conf.params + i, &file))
+            break;
+
+    plugin->conf.desc = NULL;
+}
+
+void vlc_plugin_LoadConfig(vlc_plugin_t *plugin)
+{
+    vlc_once(&plugin->conf.once, vlc_cache_load_plugin_desc, plugin);
 }
 
 static int vlc_cache_load_plugin_config(vlc_plugin_t *plugin, block_t *file)
 {
     uint16_t lines;
+    uint32_t size;
 
     /* Calculate the structure length */
     LOAD_IMMEDIATE (lines);
@@ -270,7 +321,8 @@ static int vlc_cache_load_plugin_config(vlc_plugin_t *plugin, block_t *file)
 
     plugin->conf.size = lines;
 
-    /* Do the duplication job */
+    /* Only load what is needed to index the items and parse the command line
+     * for now. The rest is left in the file until vlc_plugin_LoadConfig(). */
     for (size_t i = 0; i < lines; i++)
     {
         struct vlc_param *param = plugin->conf.params + i;
@@ -288,6 +340,14 @@ static int vlc_cache_load_plugin_config(vlc_plugin_t *plugin, block_t *file)
         param->owner = plugin;
     }
 
+    LOAD_IMMEDIATE (size);
+
+    const void *desc;
+    if (vlc_cache_load_array(&desc, 1, size, file))
+        goto error;
+
+    plugin->conf.desc = desc;
+    plugin->conf.desc_size = size;
     return 0;
 error:
     return -1; /* FIXME: leaks */
@@ -444,7 +504,10 @@ vlc_plugin_t *vlc_cache_load(libvlc_int_t *p_this, const char *dir,
         return NULL;
     }
 
-    vlc_plugin_t *cache = NULL;
+    /* Keep the plugins in the order of the file, i.e. the order in which they
+     * were found when the cache was saved. The directory scan then finds each
+     * plugin at the head of the list in vlc_cache_lookup(). */
+    vlc_plugin_t *cache = NULL, **tailp = &cache;
 
     while (file->i_buffer > 0)
     {
@@ -460,8 +523,9 @@ vlc_plugin_t *vlc_cache_load(libvlc_int_t *p_this, const char *dir,
             goto error;
         }
 
-        plugin->next = cache;
-        cache = plugin;
+        plugin->next = NULL;
+        *tailp = plugin;
+        tailp = &plugin->next;
     }
 
     file->p_next = *backingp;
@@ -528,8 +592,17 @@ static int CacheSaveConfig(FILE *file, const struct vlc_param *param)
     SAVE_FLAG (param->unsaved);
     SAVE_FLAG (param->safe);
     SAVE_FLAG (param->obsolete);
-    SAVE_STRING (cfg->psz_type);
     SAVE_STRING (cfg->psz_name);
+    return 0;
+error:
+    return -1;
+}
+
+static int CacheSaveConfigDesc(FILE *file, const struct vlc_param *param)
+{
+    const module_config_t *cfg = &param->item;
+
+    SAVE_STRING (cfg->psz_type);
     SAVE_STRING (cfg->psz_text);
     SAVE_STRING (cfg->psz_longtext);
     SAVE_IMMEDIATE (cfg->list_count);
@@ -563,9 +636,13 @@ error:
     return -1;
 }
 
-static int CacheSaveModuleConfig(FILE *file, const vlc_plugin_t *plugin)
+static int CacheSaveModuleConfig(FILE *file, vlc_plugin_t *plugin)
 {
     uint16_t lines = plugin->conf.size;
+    uint32_t size = 0;
+
+    /* The plug-in may come from the previous cache file */
+    vlc_plugin_LoadConfig(plugin);
 
     SAVE_IMMEDIATE (lines);
 
@@ -573,6 +650,26 @@ static int CacheSaveModuleConfig(FILE *file, const vlc_plugin_t *plugin)
         if (CacheSaveConfig(file, plugin->conf.params + i))
            goto error;
 
+    /* Descriptors, prefixed with their size so that loading can skip them */
+    long offset = ftell(file);
+    if (offset < 0)
+        goto error;
+
+    SAVE_IMMEDIATE (size);
+
+    for (size_t i = 0; i < lines; i++)
+        if (CacheSaveConfigDesc(file, plugin->conf.params + i))
+           goto error;
+
+    long end = ftell(file);
+    if (end < 0 || fseek(file, offset, SEEK_SET))
+        goto error;
+
+    size = end - offset - sizeof (size);
+    SAVE_IMMEDIATE (size);
+
+    if (fseek(file, end, SEEK_SET))
+        goto error;
     return 0;
 error:
     return -1;
@@ -623,7 +720,7 @@ static int CacheSaveBank(FILE *file, vlc_plugin_t *const *cache, size_t n)
 
     for (size_t i = 0; i < n; i++)
     {
-        const vlc_plugin_t *plugin = cache[i];
+        vlc_plugin_t *plugin = cache[i];
         uint32_t count = plugin->modules_count;
 
         SAVE_IMMEDIATE(count);
@@ -107,6 +107,9 @@ vlc_plugin_t *vlc_plugin_create(void)
     plugin->conf.count = 0;
     plugin->conf.booleans = 0;
 #ifdef HAVE_DYNAMIC_PLUGINS
+    plugin->conf.once = (vlc_once_t) VLC_STATIC_ONCE;
+    plugin->conf.desc = NULL;
+    plugin->conf.desc_size = 0;
     plugin->unloadable = true;
     atomic_init(&plugin->handle, 0);
     plugin->abspath = NULL;
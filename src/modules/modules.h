@@ -25,6 +25,7 @@
 
 # include <stdatomic.h>
 # include <vlc_plugin.h>
+# include <vlc_threads.h>
 
 struct vlc_param;
 
@@ -46,6 +47,11 @@ typedef struct vlc_plugin_t
         size_t size; /**< Total count of all items */
         size_t count; /**< Count of real options (excludes hints) */
         size_t booleans; /**< Count of options that are of boolean type */
+#ifdef HAVE_DYNAMIC_PLUGINS
+        vlc_once_t once; /**< Descriptors built by vlc_plugin_LoadConfig() */
+        const void *desc; /**< Cached descriptors not built yet (or NULL) */
+        size_t desc_size; /**< Byte size of the cached descriptors */
+#endif
     } conf;
 
 #ifdef HAVE_DYNAMIC_PLUGINS
@@ -182,4 +188,23 @@ vlc_plugin_t *vlc_cache_lookup(vlc_plugin_t **, const char *relpath);
 
 void CacheSave(libvlc_int_t *, const char *, vlc_plugin_t *const *, size_t);
 
+/**
+ * Builds the configuration descriptors of a plug-in.
+ *
+ * The configuration items of a plug-in loaded from the plugins cache only
+ * have their name, type, short name and flags until this function is called:
+ * the texts, default values, ranges and choices are left in the cache file.
+ * This must be called before any other member of the plug-in configuration
+ * items is accessed. It only does any work the first time, and is
+ * thread-safe.
+ */
+#ifdef HAVE_DYNAMIC_PLUGINS
+void vlc_plugin_LoadConfig(vlc_plugin_t *);
+#else
+static inline void vlc_plugin_LoadConfig(vlc_plugin_t *plugin)
+{
+    (void) plugin;
+}
+#endif
+
 #endif /* !LIBVLC_MODULES_H */
@@ -0,0 +1,448 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/*****************************************************************************
+ * cache.c: persistent cache of the preparse results
+ *****************************************************************************
+ * Copyright © 2026 VideoLAN and VLC authors
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#include <vlc_common.h>
+#include <vlc_configuration.h>
+#include <vlc_fs.h>
+#include <vlc_hash.h>
+#include <vlc_input_item.h>
+#include <vlc_preparser.h>
+#include <vlc_preparser_ipc.h>
+#include <vlc_strings.h>
+#include <vlc_url.h>
+#include <vlc_vector.h>
+
+#include "cache.h"
+
+/* Magic, file size, modification time and parse options */
+#define CACHE_KEY_SIZE 28
+
+/* Entries are spread over sub-directories named after the first byte of
+ * their hash. Each sub-directory is pruned once per process, the first time
+ * an entry is stored in it: entries unused for CACHE_MAX_AGE are removed,
+ * then the least recently used ones beyond the count and size limits. */
+#define CACHE_SHARDS 256
+#define CACHE_SHARD_MAX_ENTRIES 1024
+#define CACHE_SHARD_MAX_SIZE (8 << 20) /* bytes */
+#define CACHE_MAX_AGE (90 * 24 * 3600) /* seconds */
+/* Age of the temporary files left behind by interrupted stores */
+#define CACHE_TMP_MAX_AGE (24 * 3600) /* seconds */
+
+struct preparser_cache {
+    vlc_object_t *parent;
+
+    /* The serializer is not reentrant */
+    vlc_mutex_t lock;
+    struct vlc_preparser_msg_serdes *serdes;
+    /* Sub-directories pruned by this process */
+    uint8_t pruned[CACHE_SHARDS / 8];
+};
+
+static ssize_t
+cache_Write(const void *data, size_t size, void *userdata)
+{
+    FILE *stream = userdata;
+
+    size_t ret = fwrite(data, 1, size, stream);
+    if (ret == 0 && size != 0) {
+        errno = EIO;
+        return -1;
+    }
+    return ret;
+}
+
+static ssize_t
+cache_Read(void *data, size_t size, void *userdata)
+{
+    FILE *stream = userdata;
+
+    size_t ret = fread(data, 1, size, stream);
+    if (ret == 0 && ferror(stream)) {
+        errno = EIO;
+        return -1;
+    }
+    return ret;
+}
+
+/**
+ * Get the path, the key and the sub-directory of the cache entry of an item.
+ */
+static char *
+cache_GetEntry(input_item_t *item, int options, uint8_t *key,
+               unsigned *shard)
+{
+    vlc_mutex_lock(&item->lock);
+    char *uri = strdup(item->psz_uri);
+    vlc_mutex_unlock(&item->lock);
+    if (uri == NULL) {
+        return NULL;
+    }
+
+    /* Only local files can be validated without opening them */
+    char *filepath = vlc_uri2path(uri);
+    struct stat st;
+    if (filepath == NULL || vlc_stat(filepath, &st) != 0
+     || !S_ISREG(st.st_mode)) {
+        free(filepath);
+        free(uri);
+        return NULL;
+    }
+    free(filepath);
+
+    char *cachedir = config_GetUserDir(VLC_CACHE_DIR);
+    if (unlikely(cachedir == NULL)) {
+        free(uri);
+        return NULL;
+    }
+
+    uint8_t digest[VLC_HASH_MD5_DIGEST_SIZE];
+    char hash[VLC_HASH_MD5_DIGEST_HEX_SIZE];
+    vlc_hash_md5_t md5;
+    vlc_hash_md5_Init(&md5);
+    vlc_hash_md5_Update(&md5, uri, strlen(uri));
+    vlc_hash_md5_Finish(&md5, digest, sizeof(digest));
+    vlc_hex_encode_binary(digest, sizeof(digest), hash);
+    free(uri);
+
+    char *path;
+    if (asprintf(&path, "%s" DIR_SEP "preparser" DIR_SEP "%.2s" DIR_SEP "%s",
+                 cachedir, hash, hash) == -1) {
+        path = NULL;
+    }
+    free(cachedir);
+    *shard = digest[0];
+
+    /* Only the sub-items option changes the parse result, the fetched meta
+     * are not part of it */
+    memcpy(&key[0], "VLCPRC01", 8);
+    SetQWBE(&key[8], st.st_size);
+    SetQWBE(&key[16], st.st_mtime);
+    SetDWBE(&key[24], options & VLC_PREPARSER_OPTION_SUBITEMS);
+
+    return path;
+}
+
+/**
+ * Mark an entry as recently used.
+ *
+ * Rewrite the first byte of the key, which is the same for all entries, so
+ * that the modification time of the file is updated.
+ */
+static void
+cache_Touch(const char *path)
+{
+    FILE *stream = vlc_fopen(path, "r+b");
+    if (stream == NULL) {
+        return;
+    }
+    fwrite("V", 1, 1, stream);
+    fclose(stream);
+}
+
+struct cache_file {
+    time_t mtime;
+    uint64_t size;
+    char *path;
+};
+
+static int
+cache_file_Compare(const void *a, const void *b)
+{
+    const struct cache_file *fa = a, *fb = b;
+
+    return (fa->mtime > fb->mtime) - (fa->mtime < fb->mtime);
+}
+
+/**
+ * Remove the outdated entries of a cache sub-directory.
+ */
+static void
+cache_Prune(const char *dir)
+{
+    vlc_DIR *d = vlc_opendir(dir);
+    if (d == NULL) {
+        return;
+    }
+
+    struct VLC_VECTOR(struct cache_file) files = VLC_VECTOR_INITIALIZER;
+    const time_t now = time(NULL);
+    uint64_t total = 0;
+    const char *name;
+
+    while ((name = vlc_readdir(d)) != NULL) {
+        char *path;
+        struct stat st;
+
+        if (name[0] == '.'
+         || asprintf(&path, "%s" DIR_SEP "%s", dir, name) == -1) {
+            continue;
+        }
+        if (vlc_stat(path, &st) != 0 || !S_ISREG(st.st_mode)) {
+            free(path);
+            continue;
+        }
+
+        /* Entry names are plain hashes, temporary files have a suffix */
+        bool tmp = strchr(name, '.') != NULL;
+        if (now - st.st_mtime > (tmp ? CACHE_TMP_MAX_AGE : CACHE_MAX_AGE)) {
+            vlc_unlink(path);
+            free(path);
+            continue;
+        }
+
+        struct cache_file file = { st.st_mtime, st.st_size, path };
+        if (tmp || !vlc_vector_push(&files, file)) {
+            free(path);
+            continue;
+        }
+        total += st.st_size;
+    }
+    vlc_closedir(d);
+
+    /* Least recently used first */
+    if (files.size > 0) {
+        qsort(files.data, files.size, sizeof(*files.data),
+              cache_file_Compare);
+    }
+    for (size_t i = 0; i < files.size; i++) {
+        if (files.size - i > CACHE_SHARD_MAX_ENTRIES
+         || total > CACHE_SHARD_MAX_SIZE) {
+            vlc_unlink(files.data[i].path);
+            total -= files.data[i].size;
+        }
+        free(files.data[i].path);
+    }
+    vlc_vector_destroy(&files);
+}
+
+int
+preparser_cache_Load(struct preparser_cache *cache, input_item_t *item,
+                     int options, struct vlc_preparser_msg *msg)
+{
+    assert(cache != NULL);
+
+    uint8_t key[CACHE_KEY_SIZE];
+    unsigned shard;
+    char *path = cache_GetEntry(item, options, key, &shard);
+    if (path == NULL) {
+        return VLC_ENOENT;
+    }
+
+    FILE *stream = vlc_fopen(path, "rb");
+    if (stream == NULL) {
+        free(path);
+        return VLC_ENOENT;
+    }
+
+    /* Outdated entries are overwritten once the item is parsed again */
+    uint8_t cached_key[CACHE_KEY_SIZE];
+    if (fread(cached_key, sizeof(cached_key), 1, stream) != 1
+     || memcmp(cached_key, key, sizeof(key)) != 0) {
+        fclose(stream);
+        free(path);
+        return VLC_ENOENT;
+    }
+
+    /* Keep the entries in use from being pruned, without rewriting them at
+     * every use */
+    struct stat st;
+    bool touch = vlc_stat(path, &st) == 0
+              && time(NULL) - st.st_mtime > CACHE_MAX_AGE / 2;
+
+    vlc_mutex_lock(&cache->lock);
+    int ret = vlc_preparser_msg_serdes_Deserialize(cache->serdes, msg, stream);
+    vlc_mutex_unlock(&cache->lock);
+    fclose(stream);
+    if (ret == VLC_SUCCESS && touch) {
+        cache_Touch(path);
+    }
+    free(path);
+    if (ret != VLC_SUCCESS) {
+        return VLC_EGENERIC;
+    }
+
+    if (msg->type != VLC_PREPARSER_MSG_TYPE_RES
+     || msg->req_type != VLC_PREPARSER_MSG_REQ_TYPE_PARSE
+     || msg->res.item == NULL || msg->res.subtree != NULL
+     || input_item_Update(item, msg->res.item) != VLC_SUCCESS) {
+        vlc_preparser_msg_Clean(msg);
+        return VLC_EGENERIC;
+    }
+    return VLC_SUCCESS;
+}
+
+/**
+ * Copy an item, without the meta it held before being parsed.
+ */
+static input_item_t *
+cache_CopyResult(input_item_t *item, const vlc_meta_t *caller_meta)
+{
+    input_item_t *result = input_item_Copy(item);
+    if (result == NULL || result->p_meta == NULL) {
+        return result;
+    }
+
+    vlc_meta_t *meta = result->p_meta;
+    for (int i = 0; i < VLC_META_TYPE_COUNT; i++) {
+        const char *value = vlc_meta_Get(meta, i);
+        const char *before = vlc_meta_Get(caller_meta, i);
+
+        if (value != NULL && before != NULL && strcmp(value, before) == 0) {
+            vlc_meta_Set(meta, i, NULL);
+        }
+    }
+
+    char **names = vlc_meta_CopyExtraNames(caller_meta);
+    for (size_t i = 0; names != NULL && names[i] != NULL; i++) {
+        const char *value = vlc_meta_GetExtra(meta, names[i]);
+        const char *before = vlc_meta_GetExtra(caller_meta, names[i]);
+
+        if (value != NULL && strcmp(value, before) == 0) {
+            vlc_meta_SetExtra(meta, names[i], NULL);
+        }
+        free(names[i]);
+    }
+    free(names);
+    return result;
+}
+
+void
+preparser_cache_Store(struct preparser_cache *cache, input_item_t *item,
+                      int options, const vlc_meta_t *caller_meta,
+                      input_attachment_t *const *attachments, size_t count)
+{
+    assert(cache != NULL);
+
+    uint8_t key[CACHE_KEY_SIZE];
+    unsigned shard;
+    char *path = cache_GetEntry(item, options, key, &shard);
+    if (path == NULL) {
+        return;
+    }
+
+    char *tmp_path = NULL;
+    char *dir = strrchr(path, DIR_SEP_CHAR);
+    assert(dir != NULL);
+    *dir = '\0';
+    int ret = vlc_mkdir_parent(path, 0700);
+    if (ret == 0) {
+        vlc_mutex_lock(&cache->lock);
+        bool prune = !(cache->pruned[shard / 8] & (1 << (shard % 8)));
+        cache->pruned[shard / 8] |= 1 << (shard % 8);
+        vlc_mutex_unlock(&cache->lock);
+
+        if (prune) {
+            cache_Prune(path);
+        }
+    }
+    *dir = DIR_SEP_CHAR;
+    if (ret != 0 || asprintf(&tmp_path, "%s.XXXXXX", path) == -1) {
+        free(path);
+        return;
+    }
+
+    struct vlc_preparser_msg msg;
+    vlc_preparser_msg_Init(&msg, VLC_PREPARSER_MSG_TYPE_RES,
+                           VLC_PREPARSER_MSG_REQ_TYPE_PARSE);
+    msg.res.status = VLC_SUCCESS;
+    msg.res.item = cache_CopyResult(item, caller_meta);
+    if (msg.res.item == NULL) {
+        vlc_preparser_msg_Clean(&msg);
+        free(tmp_path);
+        free(path);
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (vlc_vector_push(&msg.res.attachments, attachments[i])) {
+            vlc_input_attachment_Hold(attachments[i]);
+        }
+    }
+
+    /* Write a temporary file, so that a concurrent load never reads a partial
+     * entry */
+    FILE *stream = NULL;
+    int fd = vlc_mkstemp(tmp_path);
+    if (fd != -1) {
+        stream = fdopen(fd, "wb");
+        if (stream == NULL) {
+            vlc_close(fd);
+            vlc_unlink(tmp_path);
+        }
+    }
+    if (stream != NULL) {
+        ret = fwrite(key, sizeof(key), 1, stream) == 1 ? VLC_SUCCESS
+                                                      : VLC_EGENERIC;
+        if (ret == VLC_SUCCESS) {
+            vlc_mutex_lock(&cache->lock);
+            ret = vlc_preparser_msg_serdes_Serialize(cache->serdes, &msg,
+                                                     stream);
+            vlc_mutex_unlock(&cache->lock);
+        }
+        if (fclose(stream) != 0) {
+            ret = VLC_EGENERIC;
+        }
+        if (ret == VLC_SUCCESS && vlc_rename(tmp_path, path) == 0) {
+            msg_Dbg(cache->parent, "preparse result saved to %s", path);
+        } else {
+            msg_Warn(cache->parent, "cannot save the preparse result to %s",
+                     path);
+            vlc_unlink(tmp_path);
+        }
+    }
+
+    vlc_preparser_msg_Clean(&msg);
+    free(tmp_path);
+    free(path);
+}
+
+struct preparser_cache *
+preparser_cache_New(vlc_object_t *parent)
+{
+    if (!var_InheritBool(parent, "preparse-cache")) {
+        return NULL;
+    }
+
+    struct preparser_cache *cache = malloc(sizeof(*cache));
+    if (cache == NULL) {
+        return NULL;
+    }
+
+    static const struct vlc_preparser_msg_serdes_cbs cbs = {
+        .write = cache_Write,
+        .read = cache_Read,
+    };
+    /* Attachments are only deserialized from binary data */
+    cache->serdes = vlc_preparser_msg_serdes_Create(parent, &cbs, true);
+    if (cache->serdes == NULL) {
+        msg_Warn(parent, "preparse cache disabled: no serializer");
+        free(cache);
+        return NULL;
+    }
+    cache->parent = parent;
+    vlc_mutex_init(&cache->lock);
+    memset(cache->pruned, 0, sizeof(cache->pruned));
+    return cache;
+}
+
+void
+preparser_cache_Delete(struct preparser_cache *cache)
+{
+    assert(cache != NULL);
+    vlc_preparser_msg_serdes_Delete(cache->serdes);
+    free(cache);
+}
@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/*****************************************************************************
+ * cache.h: persistent cache of the preparse results
+ *****************************************************************************
+ * Copyright © 2026 VideoLAN and VLC authors
+ *****************************************************************************/
+
+#ifndef PREPARSER_CACHE_H
+#define PREPARSER_CACHE_H 1
+
+#include <vlc_common.h>
+#include <vlc_input_item.h>
+#include <vlc_preparser_ipc.h>
+
+struct preparser_cache;
+
+/**
+ * Create the preparse cache.
+ *
+ * @return the cache, or NULL if it is disabled or not available.
+ */
+struct preparser_cache *
+preparser_cache_New(vlc_object_t *parent);
+
+void
+preparser_cache_Delete(struct preparser_cache *cache);
+
+/**
+ * Update an item from its cached preparse result.
+ *
+ * Only local files are cached, the entries are keyed by the file size and
+ * modification time, and by the parse options.
+ *
+ * @param [out] msg     parse response holding the cached attachments, to be
+ *                      cleaned with vlc_preparser_msg_Clean() on success.
+ *
+ * @return VLC_SUCCESS if the item was updated, or an error code if the item
+ *         must be parsed.
+ */
+int
+preparser_cache_Load(struct preparser_cache *cache, input_item_t *item,
+                     int options, struct vlc_preparser_msg *msg);
+
+/**
+ * Store the preparse result of an item.
+ *
+ * Only the elementary streams, the duration and the meta read by the parse
+ * are stored. Old and least recently used entries are evicted meanwhile.
+ *
+ * @param caller_meta   meta of the item before it was parsed, which are left
+ *                      out of the entry unless the parse changed them
+ */
+void
+preparser_cache_Store(struct preparser_cache *cache, input_item_t *item,
+                      int options, const vlc_meta_t *caller_meta,
+                      input_attachment_t *const *attachments, size_t count);
+
+#endif /* PREPARSER_CACHE_H */
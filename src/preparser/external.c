@@ -16,6 +16,7 @@
 #endif
 
 #include <assert.h>
+#include <sys/stat.h>
 
 #include <vlc_common.h>
 #include <vlc_configuration.h>
@@ -133,6 +134,11 @@ struct preparser_process_thread {
 
     /* The thread serializer */
     struct vlc_preparser_msg_serdes *serdes;
+
+    /* File shared with the current process to return large binary data
+     * (thumbnails, attachments) */
+    int shm_fd;
+    char *shm_path;
 };
 
 /*****************************************************************************
@@ -554,6 +560,58 @@ preparser_pool_QueueTake(struct preparser_process_pool *pool)
     return task;
 }
 
+/**
+ * Release the shared memory file of the process.
+ */
+static void
+preparser_pool_ReleaseShm(struct preparser_process_thread *thread)
+{
+    vlc_preparser_msg_serdes_SetSharedMemory(thread->serdes, -1);
+    if (thread->shm_path != NULL) {
+        /* Already unlinked, unless the process did not open it */
+        vlc_unlink(thread->shm_path);
+        free(thread->shm_path);
+        thread->shm_path = NULL;
+    }
+    if (thread->shm_fd != -1) {
+        vlc_close(thread->shm_fd);
+        thread->shm_fd = -1;
+    }
+}
+
+/**
+ * Create the shared memory file of a new process, preferably in a tmpfs.
+ */
+static void
+preparser_pool_CreateShm(struct preparser_process_thread *thread)
+{
+#ifndef _WIN32
+    const char *dir = "/dev/shm";
+    struct stat st;
+    if (vlc_stat(dir, &st) != 0 || !S_ISDIR(st.st_mode)) {
+        dir = getenv("TMPDIR");
+        if (dir == NULL) {
+            dir = "/tmp";
+        }
+    }
+
+    char *path = NULL;
+    if (asprintf(&path, "%s/" VLC_PREPARSER_PATH "-XXXXXX", dir) < 0) {
+        return;
+    }
+    int fd = vlc_mkstemp(path);
+    if (fd == -1) {
+        free(path);
+        return;
+    }
+    thread->shm_fd = fd;
+    thread->shm_path = path;
+    vlc_preparser_msg_serdes_SetSharedMemory(thread->serdes, fd);
+#else
+    VLC_UNUSED(thread);
+#endif
+}
+
 static int
 preparser_pool_SpawnProcess(struct preparser_process_thread *thread)
 {
@@ -571,15 +629,29 @@ preparser_pool_SpawnProcess(struct preparser_process_thread *thread)
         return VLC_ENOMEM;
     }
 
+    /* A new file for each process, which unlinks it once opened */
+    preparser_pool_ReleaseShm(thread);
+    preparser_pool_CreateShm(thread);
+
     const char *argv[] = {
         "--timeout-tick",
         str_timeout,
         "--types",
         str_types,
         "--daemon",
+        NULL, /* --cache */
+        NULL, /* --shm */
+        NULL, /* shm_path */
         NULL,
     };
-    int argc = ARRAY_SIZE(argv);
+    int argc = 5;
+    if (var_InheritBool(pool->parent, "preparse-cache")) {
+        argv[argc++] = "--cache";
+    }
+    if (thread->shm_path != NULL) {
+        argv[argc++] = "--shm";
+        argv[argc++] = thread->shm_path;
+    }
 
     char *path = NULL;
 #ifdef _WIN32
@@ -711,6 +783,8 @@ preparser_pool_SpawnThreadLocked(struct preparser_process_pool *pool)
     thread->owner = pool;
     thread->task = NULL;
     thread->stopped = false;
+    thread->shm_fd = -1;
+    thread->shm_path = NULL;
 
     static struct vlc_preparser_msg_serdes_cbs cbs = {
         .write = write_cbs,
@@ -724,6 +798,7 @@ preparser_pool_SpawnThreadLocked(struct preparser_process_pool *pool)
 
     if (preparser_pool_SpawnProcess(thread) != VLC_SUCCESS) {
         msg_Err(pool->parent, "Fail to create Process in process_pool");
+        preparser_pool_ReleaseShm(thread);
         vlc_preparser_msg_serdes_Delete(thread->serdes);
         free(thread);
         return VLC_EGENERIC;
@@ -733,6 +808,7 @@ preparser_pool_SpawnThreadLocked(struct preparser_process_pool *pool)
     int ret = vlc_clone(&thread->thread, preparser_pool_Run, thread);
     if (ret != 0) {
         vlc_process_Terminate(thread->process, false);
+        preparser_pool_ReleaseShm(thread);
         vlc_preparser_msg_serdes_Delete(thread->serdes);
         free(thread);
         return VLC_EGENERIC;
@@ -785,6 +861,7 @@ preparser_pool_JoinStoppedThreadsLocked(struct preparser_process_pool *pool)
         vlc_join(t->thread, NULL);
         if (t->process != NULL)
             vlc_process_Terminate(t->process, false);
+        preparser_pool_ReleaseShm(t);
         vlc_preparser_msg_serdes_Delete(t->serdes);
         free(t);
     }
@@ -913,6 +990,7 @@ preparser_pool_Delete(struct preparser_process_pool *pool)
         if (thread->process != NULL) {
             vlc_process_Terminate(thread->process, false);
         }
+        preparser_pool_ReleaseShm(thread);
         vlc_preparser_msg_serdes_Delete(thread->serdes);
         free(thread);
     }
@@ -35,6 +35,7 @@
 #include "input/input_interface.h"
 #include "input/input_internal.h"
 #include "fetcher.h"
+#include "cache.h"
 
 union vlc_preparser_cbs_internal
 {
@@ -47,6 +48,7 @@ struct preparser_sys
 {
     vlc_object_t* owner;
     input_fetcher_t* fetcher;
+    struct preparser_cache *cache;
     vlc_executor_t *parser;
     vlc_executor_t *thumbnailer;
     vlc_executor_t *thumbnailer_to_files;
@@ -84,6 +86,10 @@ struct vlc_preparser_req_owner
     int preparse_status;
     atomic_bool interrupted;
 
+    /* Parse result to store in the cache */
+    bool cacheable;
+    struct VLC_VECTOR(input_attachment_t *) attachments;
+
     struct vlc_runnable runnable; /**< to be passed to the executor */
 
     struct vlc_list node; /**< node of vlc_preparser_t.submitted_tasks */
@@ -112,6 +118,10 @@ PreparserRequestDelete(struct vlc_preparser_req *req)
 {
     struct vlc_preparser_req_owner *req_owner = preparser_req_get_owner(req);
     input_item_Release(req_owner->item);
+    input_attachment_t *attachment;
+    vlc_vector_foreach(attachment, &req_owner->attachments)
+        vlc_input_attachment_Release(attachment);
+    vlc_vector_clear(&req_owner->attachments);
     for (size_t i = 0; i < req_owner->output_count; ++i)
         free(req_owner->outputs[i].file_path);
     free(req_owner->outputs);
@@ -148,6 +158,8 @@ PreparserRequestNew(struct preparser_sys *preparser, void (*run)(void *), input_
     req_owner->pic = NULL;
     req_owner->outputs = NULL;
     req_owner->output_count = 0;
+    req_owner->cacheable = preparser->cache != NULL;
+    vlc_vector_init(&req_owner->attachments);
     vlc_atomic_rc_init(&req_owner->rc);
 
     static const struct vlc_preparser_req_operations ops = {
@@ -233,6 +245,9 @@ OnParserSubtreeAdded(input_item_t *item, input_item_node_t *subtree,
     if (atomic_load(&req_owner->interrupted))
         return;
 
+    /* Sub-items are not cached */
+    req_owner->cacheable = false;
+
     if (req_owner->cbs.parser->on_subtree_added)
         req_owner->cbs.parser->on_subtree_added(req, subtree,
                                                 req_owner->userdata);
@@ -250,6 +265,19 @@ OnParserAttachmentsAdded(input_item_t *item,
     if (atomic_load(&req_owner->interrupted))
         return;
 
+    if (req_owner->cacheable)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (!vlc_vector_push(&req_owner->attachments, array[i]))
+            {
+                req_owner->cacheable = false;
+                break;
+            }
+            vlc_input_attachment_Hold(array[i]);
+        }
+    }
+
     if (req_owner->cbs.parser->on_attachments_added)
         req_owner->cbs.parser->on_attachments_added(req, array, count,
                                                     req_owner->userdata);
@@ -312,6 +340,59 @@ Parse(struct vlc_preparser_req *req, vlc_tick_t deadline)
     input_item_parser_id_Release(parser);
 }
 
+static bool
+ParseFromCache(struct vlc_preparser_req *req)
+{
+    struct vlc_preparser_req_owner *req_owner = preparser_req_get_owner(req);
+    struct preparser_cache *cache = req_owner->preparser->cache;
+
+    struct vlc_preparser_msg msg;
+    if (cache == NULL ||
+        preparser_cache_Load(cache, req_owner->item, req_owner->options,
+                             &msg) != VLC_SUCCESS)
+        return false;
+
+    if (msg.res.attachments.size > 0)
+        OnParserAttachmentsAdded(req_owner->item, msg.res.attachments.data,
+                                 msg.res.attachments.size, req);
+    vlc_preparser_msg_Clean(&msg);
+
+    /* Already in the cache */
+    req_owner->cacheable = false;
+    req_owner->preparse_status = VLC_SUCCESS;
+    return true;
+}
+
+static vlc_meta_t *
+CopyItemMeta(input_item_t *item)
+{
+    vlc_meta_t *meta = vlc_meta_New();
+    if (meta == NULL)
+        return NULL;
+
+    vlc_mutex_lock(&item->lock);
+    if (item->p_meta != NULL)
+        vlc_meta_Merge(meta, item->p_meta);
+    vlc_mutex_unlock(&item->lock);
+    return meta;
+}
+
+static void
+StoreInCache(struct vlc_preparser_req *req, const vlc_meta_t *caller_meta)
+{
+    struct vlc_preparser_req_owner *req_owner = preparser_req_get_owner(req);
+
+    if (!req_owner->cacheable || caller_meta == NULL ||
+        req_owner->preparse_status != VLC_SUCCESS ||
+        atomic_load(&req_owner->interrupted))
+        return;
+
+    preparser_cache_Store(req_owner->preparser->cache, req_owner->item,
+                          req_owner->options, caller_meta,
+                          req_owner->attachments.data,
+                          req_owner->attachments.size);
+}
+
 static int
 Fetch(struct vlc_preparser_req *req)
 {
@@ -346,7 +427,18 @@ ParserRun(void *userdata)
             goto end;
         }
 
-        Parse(req, deadline);
+        if (!ParseFromCache(req))
+        {
+            /* The meta set before parsing, by the caller or a previous
+             * fetch, do not belong in the cache */
+            vlc_meta_t *caller_meta = req_owner->cacheable
+                                    ? CopyItemMeta(req_owner->item) : NULL;
+
+            Parse(req, deadline);
+            StoreInCache(req, caller_meta);
+            if (caller_meta != NULL)
+                vlc_meta_Delete(caller_meta);
+        }
     }
 
     PreparserRemoveTask(preparser, req);
@@ -958,6 +1050,9 @@ static void preparser_Delete(void *opaque)
     if( preparser->fetcher )
         input_fetcher_Delete( preparser->fetcher );
 
+    if (preparser->cache != NULL)
+        preparser_cache_Delete(preparser->cache);
+
     if (preparser->thumbnailer != NULL)
         vlc_executor_Delete(preparser->thumbnailer);
 
@@ -991,11 +1086,13 @@ vlc_preparser_internal_New(vlc_preparser_t *owner, vlc_object_t *parent,
     preparser->timeout = cfg->timeout;
     preparser->owner = parent;
 
+    preparser->cache = NULL;
     if (request_type & VLC_PREPARSER_TYPE_PARSE)
     {
         preparser->parser = vlc_executor_New(parser_threads);
         if (!preparser->parser)
             goto error_parser;
+        preparser->cache = preparser_cache_New(parent);
     }
     else
         preparser->parser = NULL;
@@ -1050,6 +1147,8 @@ error_thumbnail:
     if (preparser->fetcher != NULL)
         input_fetcher_Delete(preparser->fetcher);
 error_fetcher:
+    if (preparser->cache != NULL)
+        preparser_cache_Delete(preparser->cache);
     if (preparser->parser != NULL)
         vlc_executor_Delete(preparser->parser);
 error_parser:
@@ -40,6 +40,7 @@ vlc_preparser_msg_serdes_Create(vlc_object_t *obj,
         return NULL;
     }
     msg_serdes->owner.cbs = cbs;
+    msg_serdes->owner.shm_fd = -1;
 
     module_t **mods = NULL;
     size_t strict = 0;
@@ -0,0 +1,136 @@
+/*****************************************************************************
+ * fifo.c: Test for block FIFOs
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#undef NDEBUG
+#include <assert.h>
+
+#include <vlc_common.h>
+#include <vlc_block.h>
+#include <vlc_threads.h>
+
+#define COUNT 100000
+
+static size_t block_size(unsigned i)
+{
+    return 1 + (i % 7);
+}
+
+static void test_accounting(block_fifo_t *fifo)
+{
+    vlc_fifo_Lock(fifo);
+    assert(vlc_fifo_IsEmpty(fifo));
+    assert(vlc_fifo_GetCount(fifo) == 0);
+    vlc_fifo_Unlock(fifo);
+
+    for (unsigned i = 0; i < 1000; i++) {
+        block_t *block = block_Alloc(block_size(i));
+        assert(block != NULL);
+        block->i_dts = i;
+
+        if (i & 1)
+            vlc_fifo_Put(fifo, block);
+        else {
+            vlc_fifo_Lock(fifo);
+            vlc_fifo_QueueUnlocked(fifo, block);
+            vlc_fifo_Unlock(fifo);
+        }
+    }
+
+    size_t bytes = 0;
+
+    for (unsigned i = 0; i < 1000; i++)
+        bytes += block_size(i);
+
+    assert(vlc_fifo_Show(fifo)->i_dts == 0);
+
+    vlc_fifo_Lock(fifo);
+    assert(!vlc_fifo_IsEmpty(fifo));
+    assert(vlc_fifo_GetCount(fifo) == 1000);
+    assert(vlc_fifo_GetBytes(fifo) == bytes);
+
+    for (unsigned i = 0; i < 1000; i++) {
+        block_t *block = vlc_fifo_DequeueUnlocked(fifo);
+
+        assert(block != NULL);
+        assert(block->i_dts == (vlc_tick_t)i);
+        block_Release(block);
+    }
+    assert(vlc_fifo_DequeueUnlocked(fifo) == NULL);
+    assert(vlc_fifo_GetCount(fifo) == 0);
+    assert(vlc_fifo_GetBytes(fifo) == 0);
+    vlc_fifo_Unlock(fifo);
+}
+
+static void *producer(void *data)
+{
+    block_fifo_t *fifo = data;
+
+    for (unsigned i = 0; i < COUNT; i++) {
+        block_t *block = block_Alloc(block_size(i));
+        assert(block != NULL);
+        block->i_dts = i;
+        vlc_fifo_Put(fifo, block);
+    }
+    return NULL;
+}
+
+static void test_threads(block_fifo_t *fifo)
+{
+    vlc_thread_t th;
+
+    assert(vlc_clone(&th, producer, fifo) == 0);
+
+    for (unsigned i = 0; i < COUNT; i++) {
+        block_t *block = vlc_fifo_Get(fifo);
+
+        assert(block->i_dts == (vlc_tick_t)i);
+        assert(block->i_buffer == block_size(i));
+        block_Release(block);
+    }
+
+    vlc_join(th, NULL);
+
+    vlc_fifo_Lock(fifo);
+    assert(vlc_fifo_IsEmpty(fifo));
+    assert(vlc_fifo_GetCount(fifo) == 0);
+    vlc_fifo_Unlock(fifo);
+}
+
+int main(void)
+{
+    block_fifo_t *fifo;
+
+    fifo = vlc_fifo_New();
+    assert(fifo != NULL);
+    test_accounting(fifo);
+    test_threads(fifo);
+    vlc_fifo_Delete(fifo);
+
+    fifo = vlc_fifo_NewSPSC();
+    assert(fifo != NULL);
+    test_accounting(fifo);
+    test_threads(fifo);
+    vlc_fifo_Delete(fifo);
+    return 0;
+}
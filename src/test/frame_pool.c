@@ -0,0 +1,126 @@
+/*****************************************************************************
+ * src/test/frame_pool.c
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#undef NDEBUG
+
+#include <assert.h>
+#include <string.h>
+
+#include <vlc_common.h>
+#include <vlc_frame.h>
+#include <vlc_threads.h>
+
+#include "../misc/frame_pool.h"
+
+static void test_alloc(void)
+{
+    struct vlc_frame_pool_stats before, after;
+
+    vlc_frame_t *f = vlc_frame_pool_Alloc(1000);
+    assert(f != NULL);
+    assert(f->i_buffer == 1000);
+    assert(((uintptr_t)f->p_buffer % VLC_FRAME_ALIGN) == 0);
+    assert(f->p_buffer - f->p_start == VLC_FRAME_PADDING);
+    assert(f->p_start + f->i_size >= f->p_buffer + f->i_buffer);
+    memset(f->p_buffer, 0x5a, f->i_buffer);
+    f->i_pts = 42;
+    vlc_frame_Release(f);
+
+    /* The same size class must be reused, with reset properties */
+    vlc_frame_t *g = vlc_frame_pool_Alloc(990);
+    assert(g == f);
+    assert(g->i_buffer == 990);
+    assert(g->i_pts == VLC_TICK_INVALID);
+    assert(g->p_next == NULL);
+    vlc_frame_Release(g);
+
+    /* Too large for the cache */
+    assert(vlc_frame_pool_Alloc(1 << 20) == NULL);
+
+    /* Fill the thread cache beyond its limit, so statistics get merged */
+    vlc_frame_t *frames[64];
+
+    vlc_frame_pool_GetStats(&before);
+    for (size_t i = 0; i < ARRAY_SIZE(frames); i++) {
+        frames[i] = vlc_frame_pool_Alloc(100);
+        assert(frames[i] != NULL);
+    }
+    for (size_t i = 0; i < ARRAY_SIZE(frames); i++)
+        vlc_frame_Release(frames[i]);
+    vlc_frame_pool_GetStats(&after);
+    assert(after.misses > before.misses);
+    assert(after.resident > 0);
+}
+
+static void test_disable(void)
+{
+    vlc_frame_pool_Enable(false);
+    assert(vlc_frame_pool_Alloc(100) == NULL);
+    vlc_frame_pool_Enable(true);
+}
+
+static void *release_thread(void *data)
+{
+    vlc_frame_t **frames = data;
+
+    for (size_t i = 0; frames[i] != NULL; i++)
+        vlc_frame_Release(frames[i]);
+    return NULL;
+}
+
+static void test_threads(void)
+{
+    struct vlc_frame_pool_stats before, after;
+    vlc_frame_t *frames[9];
+    vlc_thread_t th;
+
+    for (size_t i = 0; i < ARRAY_SIZE(frames) - 1; i++) {
+        frames[i] = vlc_frame_pool_Alloc(4000);
+        assert(frames[i] != NULL);
+    }
+    frames[ARRAY_SIZE(frames) - 1] = NULL;
+
+    /* Frames released by an exiting thread go to the shared depot... */
+    assert(vlc_clone(&th, release_thread, frames) == 0);
+    vlc_join(th, NULL);
+
+    /* ...from which this thread gets them back */
+    vlc_frame_pool_GetStats(&before);
+    vlc_frame_t *f = vlc_frame_pool_Alloc(4000);
+    assert(f != NULL);
+    vlc_frame_pool_GetStats(&after);
+    assert(after.refills == before.refills + 1);
+    vlc_frame_Release(f);
+}
+
+int main(void)
+{
+#ifndef HAVE_ALIGNED_ALLOC
+    return 77;
+#endif
+    test_alloc();
+    test_disable();
+    test_threads();
+    return 0;
+}
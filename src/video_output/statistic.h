@@ -31,6 +31,8 @@ typedef struct {
     atomic_uint displayed;
     atomic_uint lost;
     atomic_uint late;
+    /* Largest display lateness, in vlc_tick_t */
+    atomic_llong lateness;
 } vout_statistic_t;
 
 static inline void vout_statistic_Init(vout_statistic_t *stat)
@@ -38,6 +40,7 @@ static inline void vout_statistic_Init(vout_statistic_t *stat)
     atomic_init(&stat->displayed, 0);
     atomic_init(&stat->lost, 0);
     atomic_init(&stat->late, 0);
+    atomic_init(&stat->lateness, 0);
 }
 
 static inline void vout_statistic_Clean(vout_statistic_t *stat)
@@ -48,12 +51,15 @@ static inline void vout_statistic_Clean(vout_statistic_t *stat)
 static inline void vout_statistic_GetReset(vout_statistic_t *stat,
                                            unsigned *restrict displayed,
                                            unsigned *restrict lost,
-                                           unsigned *restrict late)
+                                           unsigned *restrict late,
+                                           vlc_tick_t *restrict lateness)
 {
     *displayed = atomic_exchange_explicit(&stat->displayed, 0,
                                           memory_order_relaxed);
     *lost = atomic_exchange_explicit(&stat->lost, 0, memory_order_relaxed);
     *late = atomic_exchange_explicit(&stat->late, 0, memory_order_relaxed);
+    *lateness = atomic_exchange_explicit(&stat->lateness, 0,
+                                         memory_order_relaxed);
 }
 
 static inline void vout_statistic_AddDisplayed(vout_statistic_t *stat,
@@ -73,4 +79,18 @@ static inline void vout_statistic_AddLate(vout_statistic_t *stat, int late)
     atomic_fetch_add_explicit(&stat->late, late, memory_order_relaxed);
 }
 
+/* Keeps the largest lateness since the last reset */
+static inline void vout_statistic_AddLateness(vout_statistic_t *stat,
+                                              vlc_tick_t lateness)
+{
+    long long prev = atomic_load_explicit(&stat->lateness,
+                                          memory_order_relaxed);
+
+    while (prev < lateness
+        && !atomic_compare_exchange_weak_explicit(&stat->lateness, &prev,
+                                                  lateness,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed));
+}
+
 #endif
@@ -272,11 +272,13 @@ static void vout_UpdateWindowSizeLocked(vout_thread_sys_t *vout)
 
 /* */
 void vout_GetResetStatistic(vout_thread_t *vout, unsigned *restrict displayed,
-                            unsigned *restrict lost, unsigned *restrict late)
+                            unsigned *restrict lost, unsigned *restrict late,
+                            vlc_tick_t *restrict lateness)
 {
     vout_thread_sys_t *sys = VOUT_THREAD_TO_SYS(vout);
     assert(!sys->dummy);
-    vout_statistic_GetReset( &sys->statistic, displayed, lost, late );
+    vout_statistic_GetReset( &sys->statistic, displayed, lost, late,
+                             lateness );
 }
 
 bool vout_IsEmpty(vout_thread_t *vout)
@@ -1033,6 +1035,7 @@ static bool IsPictureLateToProcess(vout_thread_sys_t *vout, const video_format_t
             vlc_tracer_TraceEvent(tracer, "RENDER", sys->str_id, "toolate");
 
         msg_Warn(&vout->obj, "picture is too late to be displayed (missing %"PRId64" ms)", MS_FROM_VLC_TICK(late));
+        vout_statistic_AddLateness(&sys->statistic, late);
         return true;
     }
     return false;
@@ -1140,9 +1143,17 @@ static picture_t *PreparePicture(vout_thread_sys_t *vout, bool reuse_decoded,
         sys->displayed.timestamp     = decoded->date;
         sys->displayed.is_interlaced = !decoded->b_progressive;
 
+        struct vlc_tracer *tracer = GetTracer(sys);
+        if (tracer != NULL)
+            vlc_tracer_TraceBegin(tracer, "RENDER", sys->str_id, "filter",
+                                  "step", decoded->date);
+
         vout_chrono_Start(&sys->chrono.static_filter);
         picture = filter_chain_VideoFilter(sys->filter.chain_static, sys->displayed.decoded);
         vout_chrono_Stop(&sys->chrono.static_filter);
+
+        if (tracer != NULL)
+            vlc_tracer_TraceEnd(tracer, "RENDER", sys->str_id, "filter");
     }
 
     vlc_mutex_unlock(&sys->filter.lock);
@@ -1474,6 +1485,7 @@ static int RenderPicture(vout_thread_sys_t *sys,
                 vlc_tracer_TraceEvent(tracer, "RENDER", sys->str_id, "late");
             msg_Dbg(vd, "picture displayed late (missing %"PRId64" ms)", MS_FROM_VLC_TICK(late));
             vout_statistic_AddLate(&sys->statistic, 1);
+            vout_statistic_AddLateness(&sys->statistic, late);
 
             /* vd->prepare took too much time. Tell the clock that the pts was
              * rendered late. */
@@ -1531,7 +1543,12 @@ static int RenderPicture(vout_thread_sys_t *sys,
         system_now = vlc_tick_now();
 
     /* Display the direct buffer returned by vout_RenderPicture */
+    if (tracer != NULL)
+        vlc_tracer_TraceBegin(tracer, "RENDER", sys->str_id, "display",
+                              "end", pts);
     vout_display_Display(vd, todisplay);
+    if (tracer != NULL)
+        vlc_tracer_TraceEnd(tracer, "RENDER", sys->str_id, "display");
     vlc_clock_Lock(sys->clock);
     vlc_tick_t drift = vlc_clock_UpdateVideo(sys->clock,
                                              system_now,
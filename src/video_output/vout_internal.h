@@ -232,9 +232,13 @@ void vout_ChangeSpuDelay( vout_thread_t *, size_t channel_id, vlc_tick_t delay )
 
 /**
  * This function will return and reset internal statistics.
+ *
+ * The lateness is the largest delay by which a picture was displayed or
+ * dropped late since the previous call, or 0 if none was.
  */
 void vout_GetResetStatistic( vout_thread_t *p_vout, unsigned *pi_displayed,
-                             unsigned *pi_lost, unsigned *pi_late );
+                             unsigned *pi_lost, unsigned *pi_late,
+                             vlc_tick_t *pi_lateness );
 
 /**
  * This function will force to display next pictures while paused
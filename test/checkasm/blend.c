@@ -0,0 +1,334 @@
+/*****************************************************************************
+ * blend.c: video blending functions test and benchmark
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <string.h>
+
+#include <vlc_common.h>
+#include <vlc_cpu.h>
+#include <vlc_picture.h>
+
+#include "../../modules/video_filter/filter_picture.h"
+#include "../../modules/video_filter/blend.h"
+#include "checkasm.h"
+
+/* Same as the generic code of the blend filter */
+static unsigned div255(unsigned v)
+{
+    return ((v >> 8) + v + 1) >> 8;
+}
+
+static unsigned merge(unsigned d, unsigned s, unsigned f)
+{
+    return div255((255 - f) * d + s * f);
+}
+
+static void plane8_c(uint8_t *dst, const uint8_t *src, const uint8_t *a,
+                     unsigned width, unsigned alpha)
+{
+    for (unsigned x = 0; x < width; x++) {
+        const unsigned f = div255(alpha * a[x]);
+
+        if (f > 0)
+            dst[x] = merge(dst[x], src[x], f);
+    }
+}
+
+static void chroma8_c(uint8_t *dst, const uint8_t *src, const uint8_t *a,
+                      unsigned width, unsigned alpha)
+{
+    for (unsigned x = 0; x < width; x++) {
+        const unsigned f = div255(alpha * a[2 * x]);
+
+        if (f > 0)
+            dst[x] = merge(dst[x], src[2 * x], f);
+    }
+}
+
+static void plane10_c(uint16_t *dst, const uint8_t *src, const uint8_t *a,
+                      unsigned width, unsigned alpha)
+{
+    for (unsigned x = 0; x < width; x++) {
+        const unsigned f = div255(alpha * a[x]);
+
+        if (f > 0)
+            dst[x] = merge(dst[x], src[x] * 1023 / 255, f);
+    }
+}
+
+static void chroma10_c(uint16_t *dst, const uint8_t *src, const uint8_t *a,
+                       unsigned width, unsigned alpha)
+{
+    for (unsigned x = 0; x < width; x++) {
+        const unsigned f = div255(alpha * a[2 * x]);
+
+        if (f > 0)
+            dst[x] = merge(dst[x], src[2 * x] * 1023 / 255, f);
+    }
+}
+
+static void nv12_c(uint8_t *dst, const uint8_t *u, const uint8_t *v,
+                   const uint8_t *a, unsigned width, unsigned alpha)
+{
+    for (unsigned x = 0; x < width; x++) {
+        const unsigned f = div255(alpha * a[2 * x]);
+
+        if (f > 0) {
+            dst[2 * x] = merge(dst[2 * x], u[2 * x], f);
+            dst[2 * x + 1] = merge(dst[2 * x + 1], v[2 * x], f);
+        }
+    }
+}
+
+static void rgb32_c(uint8_t *dst, const uint8_t *src, unsigned width,
+                    unsigned alpha, const int offsets[3])
+{
+    for (unsigned x = 0; x < width; x++, dst += 4, src += 4)
+        for (unsigned c = 0; c < 3; c++)
+            dst[offsets[c]] = merge(dst[offsets[c]], src[c], alpha);
+}
+
+static void rgba_yuva_c(uint8_t *y, uint8_t *u, uint8_t *v, uint8_t *a,
+                        const uint8_t *src, unsigned width)
+{
+    for (unsigned x = 0; x < width; x++, src += 4) {
+        rgb_to_yuv(&y[x], &u[x], &v[x], src[0], src[1], src[2]);
+        a[x] = src[3];
+    }
+}
+
+#define MAX_WIDTH 1920
+
+static const unsigned widths[] = {
+    1, 2, 7, 15, 16, 17, 31, 33, 64, 255, 720, MAX_WIDTH,
+};
+
+/* SIMD code must not round fully transparent nor opaque samples */
+static void RandomizeAlpha(uint8_t *a, size_t size)
+{
+    checkasm_randomize(a, size);
+    for (size_t i = 0; i < size; i++)
+        switch (checkasm_rand() & 3) {
+            case 0: a[i] = 0; break;
+            case 1: a[i] = 255; break;
+        }
+}
+
+static unsigned RandomAlpha(void)
+{
+    return 1 + checkasm_rand() % 255;
+}
+
+static void check_plane8(blend_plane8_cb cb, const char *name, unsigned step)
+{
+    CHECKASM_ALIGN(uint8_t src[2 * MAX_WIDTH]);
+    CHECKASM_ALIGN(uint8_t a[2 * MAX_WIDTH]);
+    CHECKASM_ALIGN(uint8_t dst_ref[MAX_WIDTH]);
+    CHECKASM_ALIGN(uint8_t dst_new[MAX_WIDTH]);
+
+    checkasm_declare(void, uint8_t *, const uint8_t *, const uint8_t *,
+                     unsigned, unsigned);
+
+    for (size_t i = 0; i < ARRAY_SIZE(widths); i++) {
+        const unsigned width = widths[i];
+        /* The last odd source sample is not readable */
+        const size_t src_size = step * width - (step - 1);
+
+        if (!checkasm_check_func(cb, "%s_%u", name, width))
+            continue;
+
+        const unsigned alpha = (i & 1) ? 255 : RandomAlpha();
+        uint8_t *s = src + sizeof (src) - src_size;
+        uint8_t *w = a + sizeof (a) - src_size;
+
+        RANDOMIZE_BUF(src);
+        RandomizeAlpha(a, sizeof (a));
+        RANDOMIZE_BUF(dst_ref);
+        memcpy(dst_new, dst_ref, sizeof (dst_new));
+
+        checkasm_call_ref(dst_ref, s, w, width, alpha);
+        checkasm_call_new(dst_new, s, w, width, alpha);
+        checkasm_check1d(uint8_t, dst_ref, dst_new, sizeof (dst_ref), "dst");
+
+        checkasm_bench_new(dst_new, s, w, width, alpha);
+    }
+    checkasm_report("%s", name);
+}
+
+static void check_plane10(blend_plane10_cb cb, const char *name,
+                          unsigned step)
+{
+    CHECKASM_ALIGN(uint8_t src[2 * MAX_WIDTH]);
+    CHECKASM_ALIGN(uint8_t a[2 * MAX_WIDTH]);
+    CHECKASM_ALIGN(uint16_t dst_ref[MAX_WIDTH]);
+    CHECKASM_ALIGN(uint16_t dst_new[MAX_WIDTH]);
+
+    checkasm_declare(void, uint16_t *, const uint8_t *, const uint8_t *,
+                     unsigned, unsigned);
+
+    for (size_t i = 0; i < ARRAY_SIZE(widths); i++) {
+        const unsigned width = widths[i];
+        const size_t src_size = step * width - (step - 1);
+
+        if (!checkasm_check_func(cb, "%s_%u", name, width))
+            continue;
+
+        const unsigned alpha = (i & 1) ? 255 : RandomAlpha();
+        uint8_t *s = src + sizeof (src) - src_size;
+        uint8_t *w = a + sizeof (a) - src_size;
+
+        RANDOMIZE_BUF(src);
+        RandomizeAlpha(a, sizeof (a));
+        checkasm_randomize_mask16(dst_ref, MAX_WIDTH, 0x3FF);
+        memcpy(dst_new, dst_ref, sizeof (dst_new));
+
+        checkasm_call_ref(dst_ref, s, w, width, alpha);
+        checkasm_call_new(dst_new, s, w, width, alpha);
+        checkasm_check1d(uint16_t, dst_ref, dst_new, MAX_WIDTH, "dst");
+
+        checkasm_bench_new(dst_new, s, w, width, alpha);
+    }
+    checkasm_report("%s", name);
+}
+
+static void check_nv12(blend_nv12_cb cb)
+{
+    CHECKASM_ALIGN(uint8_t u[2 * MAX_WIDTH]);
+    CHECKASM_ALIGN(uint8_t v[2 * MAX_WIDTH]);
+    CHECKASM_ALIGN(uint8_t a[2 * MAX_WIDTH]);
+    CHECKASM_ALIGN(uint8_t dst_ref[2 * MAX_WIDTH]);
+    CHECKASM_ALIGN(uint8_t dst_new[2 * MAX_WIDTH]);
+
+    checkasm_declare(void, uint8_t *, const uint8_t *, const uint8_t *,
+                     const uint8_t *, unsigned, unsigned);
+
+    for (size_t i = 0; i < ARRAY_SIZE(widths); i++) {
+        const unsigned width = widths[i];
+        const size_t src_size = 2 * width - 1;
+
+        if (!checkasm_check_func(cb, "nv12_%u", width))
+            continue;
+
+        const unsigned alpha = (i & 1) ? 255 : RandomAlpha();
+        uint8_t *su = u + sizeof (u) - src_size;
+        uint8_t *sv = v + sizeof (v) - src_size;
+        uint8_t *w = a + sizeof (a) - src_size;
+
+        RANDOMIZE_BUF(u);
+        RANDOMIZE_BUF(v);
+        RandomizeAlpha(a, sizeof (a));
+        RANDOMIZE_BUF(dst_ref);
+        memcpy(dst_new, dst_ref, sizeof (dst_new));
+
+        checkasm_call_ref(dst_ref, su, sv, w, width, alpha);
+        checkasm_call_new(dst_new, su, sv, w, width, alpha);
+        checkasm_check1d(uint8_t, dst_ref, dst_new, sizeof (dst_ref), "dst");
+
+        checkasm_bench_new(dst_new, su, sv, w, width, alpha);
+    }
+    checkasm_report("nv12");
+}
+
+static void check_rgb32(blend_rgb32_cb cb)
+{
+    /* RGBX, XRGB, BGRX and XBGR */
+    static const int offsets[][3] = {
+        { 0, 1, 2 }, { 1, 2, 3 }, { 2, 1, 0 }, { 3, 2, 1 },
+    };
+    CHECKASM_ALIGN(uint8_t src[4 * MAX_WIDTH]);
+    CHECKASM_ALIGN(uint8_t dst_ref[4 * MAX_WIDTH]);
+    CHECKASM_ALIGN(uint8_t dst_new[4 * MAX_WIDTH]);
+
+    checkasm_declare(void, uint8_t *, const uint8_t *, unsigned, unsigned,
+                     const int *);
+
+    for (size_t i = 0; i < ARRAY_SIZE(widths); i++) {
+        const unsigned width = widths[i];
+        const int *off = offsets[i % ARRAY_SIZE(offsets)];
+
+        if (!checkasm_check_func(cb, "rgb32_%u", width))
+            continue;
+
+        const unsigned alpha = (i & 1) ? 255 : RandomAlpha();
+
+        RANDOMIZE_BUF(src);
+        RANDOMIZE_BUF(dst_ref);
+        memcpy(dst_new, dst_ref, sizeof (dst_new));
+
+        checkasm_call_ref(dst_ref, src, width, alpha, off);
+        checkasm_call_new(dst_new, src, width, alpha, off);
+        checkasm_check1d(uint8_t, dst_ref, dst_new, sizeof (dst_ref), "dst");
+
+        checkasm_bench_new(dst_new, src, width, alpha, off);
+    }
+    checkasm_report("rgb32");
+}
+
+static void check_rgba_yuva(blend_rgba_yuva_cb cb)
+{
+    CHECKASM_ALIGN(uint8_t src[4 * MAX_WIDTH]);
+    CHECKASM_ALIGN(uint8_t ref[4][MAX_WIDTH]);
+    CHECKASM_ALIGN(uint8_t new[4][MAX_WIDTH]);
+
+    checkasm_declare(void, uint8_t *, uint8_t *, uint8_t *, uint8_t *,
+                     const uint8_t *, unsigned);
+
+    for (size_t i = 0; i < ARRAY_SIZE(widths); i++) {
+        const unsigned width = widths[i];
+
+        if (!checkasm_check_func(cb, "rgba_yuva_%u", width))
+            continue;
+
+        RANDOMIZE_BUF(src);
+        CLEAR_BUF(ref);
+        CLEAR_BUF(new);
+
+        checkasm_call_ref(ref[0], ref[1], ref[2], ref[3], src, width);
+        checkasm_call_new(new[0], new[1], new[2], new[3], src, width);
+        checkasm_check1d(uint8_t, ref[0], new[0], MAX_WIDTH, "y");
+        checkasm_check1d(uint8_t, ref[1], new[1], MAX_WIDTH, "u");
+        checkasm_check1d(uint8_t, ref[2], new[2], MAX_WIDTH, "v");
+        checkasm_check1d(uint8_t, ref[3], new[3], MAX_WIDTH, "a");
+
+        checkasm_bench_new(new[0], new[1], new[2], new[3], src, width);
+    }
+    checkasm_report("rgba_yuva");
+}
+
+void checkasm_check_blend(void)
+{
+    struct blend_functions f = {
+        plane8_c, chroma8_c, plane10_c, chroma10_c, nv12_c, rgb32_c,
+        rgba_yuva_c,
+    };
+
+    vlc_CPU_functions_init("blend functions", &f);
+
+    check_plane8(f.plane8, "plane8", 1);
+    check_plane8(f.chroma8, "chroma8", 2);
+    check_plane10(f.plane10, "plane10", 1);
+    check_plane10(f.chroma10, "chroma10", 2);
+    check_nv12(f.nv12);
+    check_rgb32(f.rgb32);
+    check_rgba_yuva(f.rgba_yuva);
+}
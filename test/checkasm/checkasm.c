@@ -0,0 +1,110 @@
+/*****************************************************************************
+ * checkasm.c: SIMD kernels test and benchmark suite
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "../libvlc/test.h"
+
+#include <vlc_common.h>
+#include <vlc_cpu.h>
+
+#include "../../lib/libvlc_internal.h"
+#include "checkasm.h"
+
+/* Each CPU level is tested in this order, and inherits the previous ones. */
+static const CheckasmCpuInfo cpus[] = {
+#if defined (__i386__) || defined (__x86_64__)
+    { "SSE2",    "sse2",    VLC_CPU_SSE2 },
+    { "SSE3",    "sse3",    VLC_CPU_SSE3 },
+    { "SSSE3",   "ssse3",   VLC_CPU_SSSE3 },
+    { "SSE4.1",  "sse41",   VLC_CPU_SSE4_1 },
+    { "AVX",     "avx",     VLC_CPU_AVX },
+    { "AVX2",    "avx2",    VLC_CPU_AVX2 },
+    { "AVX-512", "avx512",  VLC_CPU_AVX512 },
+#elif defined (__aarch64__)
+    { "NEON",    "neon",    VLC_CPU_ARM_NEON },
+    { "SVE",     "sve",     VLC_CPU_ARM_SVE },
+#elif defined (__arm__)
+    { "ARMv6",   "armv6",   VLC_CPU_ARMv6 },
+    { "NEON",    "neon",    VLC_CPU_ARM_NEON },
+#elif defined (__ppc__) || defined (__ppc64__) || defined (__powerpc__)
+    { "AltiVec", "altivec", VLC_CPU_ALTIVEC },
+#elif defined (__riscv)
+    { "B",       "rvb",     VLC_CPU_RV_B },
+    { "V",       "rvv",     VLC_CPU_RV_V },
+#endif
+    { 0 }
+};
+
+static const CheckasmTest tests[] = {
+    { "blend",       checkasm_check_blend },
+    { "chroma",      checkasm_check_chroma },
+    { "copy",        checkasm_check_copy },
+    { "deinterlace", checkasm_check_deinterlace },
+    { "transform",   checkasm_check_transform },
+    { "volume",      checkasm_check_volume },
+    { 0 }
+};
+
+static libvlc_instance_t *vlc;
+
+vlc_object_t *checkasm_vlc_object(void)
+{
+    return VLC_OBJECT(vlc->p_libvlc_int);
+}
+
+static void SetCPUFlags(CheckasmCpu flags)
+{
+    /* Masks the detected capabilities: everything that dispatches on
+     * vlc_CPU(), including modules probing, sees the current level only. */
+    vlc_CPU_set(flags);
+}
+
+int main(int argc, char *argv[])
+{
+    static const char *const args[] = {
+        "--ignore-config", "--quiet",
+    };
+
+    /* No test_init(): benchmarks may legitimately run for long */
+    test_setup();
+
+    vlc = libvlc_new(ARRAY_SIZE(args), args);
+    if (vlc == NULL)
+    {
+        fprintf(stderr, "checkasm: cannot create LibVLC instance\n");
+        return 1;
+    }
+
+    CheckasmConfig cfg = {
+        .cpu_flags = cpus,
+        .tests = tests,
+        .cpu = vlc_CPU(),
+        .set_cpu_flags = SetCPUFlags,
+    };
+
+    int ret = checkasm_main(&cfg, argc, (const char **)argv);
+
+    vlc_CPU_set(-1U);
+    libvlc_release(vlc);
+    return ret;
+}
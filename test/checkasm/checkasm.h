@@ -0,0 +1,42 @@
+/*****************************************************************************
+ * checkasm.h: SIMD kernels test and benchmark suite
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifndef VLC_TEST_CHECKASM_H
+#define VLC_TEST_CHECKASM_H 1
+
+#include <checkasm/test.h>
+#include <checkasm/utils.h>
+
+/**
+ * Returns the LibVLC root object.
+ *
+ * Tests use it as parent of the objects they create, and to look up
+ * modules from the plugins bank.
+ */
+vlc_object_t *checkasm_vlc_object(void);
+
+void checkasm_check_blend(void);
+void checkasm_check_chroma(void);
+void checkasm_check_copy(void);
+void checkasm_check_deinterlace(void);
+void checkasm_check_transform(void);
+void checkasm_check_volume(void);
+
+#endif
@@ -0,0 +1,362 @@
+/*****************************************************************************
+ * chroma.c: video chroma converters test and benchmark
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <vlc_common.h>
+#include <vlc_es.h>
+#include <vlc_filter.h>
+#include <vlc_picture.h>
+
+#include "checkasm.h"
+
+typedef void (*convert_cb)(filter_t *, picture_t *, picture_t *);
+
+/*
+ * Semi-planar and packed YUV to planar YUV references
+ */
+static void CopyPlane(plane_t *restrict dst, const plane_t *restrict src)
+{
+    for (int y = 0; y < dst->i_visible_lines; y++)
+        memcpy(dst->p_pixels + y * dst->i_pitch,
+               src->p_pixels + y * src->i_pitch, dst->i_visible_pitch);
+}
+
+static void SplitPlane(plane_t *restrict dst0, plane_t *restrict dst1,
+                       const plane_t *restrict src)
+{
+    for (int y = 0; y < dst0->i_visible_lines; y++)
+    {
+        const uint8_t *in = src->p_pixels + y * src->i_pitch;
+        uint8_t *out0 = dst0->p_pixels + y * dst0->i_pitch;
+        uint8_t *out1 = dst1->p_pixels + y * dst1->i_pitch;
+
+        for (int x = 0; x < dst0->i_visible_pitch; x++)
+        {
+            out0[x] = in[2 * x];
+            out1[x] = in[2 * x + 1];
+        }
+    }
+}
+
+static void SemiPlanarToPlanar(filter_t *filter, picture_t *dst,
+                               picture_t *src)
+{
+    CopyPlane(&dst->p[0], &src->p[0]);
+    SplitPlane(&dst->p[1], &dst->p[2], &src->p[1]);
+    (void) filter;
+}
+
+static void SemiPlanarToPlanarSwap(filter_t *filter, picture_t *dst,
+                                   picture_t *src)
+{
+    CopyPlane(&dst->p[0], &src->p[0]);
+    SplitPlane(&dst->p[2], &dst->p[1], &src->p[1]);
+    (void) filter;
+}
+
+static void PackedToI422(picture_t *dst, const picture_t *src,
+                         unsigned y0, unsigned u, unsigned y1, unsigned v)
+{
+    for (int y = 0; y < dst->p[0].i_visible_lines; y++)
+    {
+        const uint8_t *in = src->p[0].p_pixels + y * src->p[0].i_pitch;
+        uint8_t *out_y = dst->p[0].p_pixels + y * dst->p[0].i_pitch;
+        uint8_t *out_u = dst->p[1].p_pixels + y * dst->p[1].i_pitch;
+        uint8_t *out_v = dst->p[2].p_pixels + y * dst->p[2].i_pitch;
+
+        for (int x = 0; x < dst->p[1].i_visible_pitch; x++)
+        {
+            out_y[2 * x]     = in[4 * x + y0];
+            out_y[2 * x + 1] = in[4 * x + y1];
+            out_u[x] = in[4 * x + u];
+            out_v[x] = in[4 * x + v];
+        }
+    }
+}
+
+/* Same as the generic converter: chroma is sampled from the even lines */
+static void PackedToI420(picture_t *dst, const picture_t *src,
+                         unsigned y0, unsigned u, unsigned y1, unsigned v)
+{
+    for (int y = 0; y < dst->p[0].i_visible_lines; y++)
+    {
+        const uint8_t *in = src->p[0].p_pixels + y * src->p[0].i_pitch;
+        uint8_t *out_y = dst->p[0].p_pixels + y * dst->p[0].i_pitch;
+        uint8_t *out_u = dst->p[1].p_pixels + (y / 2) * dst->p[1].i_pitch;
+        uint8_t *out_v = dst->p[2].p_pixels + (y / 2) * dst->p[2].i_pitch;
+
+        for (int x = 0; x < dst->p[1].i_visible_pitch; x++)
+        {
+            out_y[2 * x]     = in[4 * x + y0];
+            out_y[2 * x + 1] = in[4 * x + y1];
+            if (y & 1)
+                continue;
+            out_u[x] = in[4 * x + u];
+            out_v[x] = in[4 * x + v];
+        }
+    }
+}
+
+#define PACKED_TO_PLANAR(name, y0, u, y1, v) \
+static void name##_I422(filter_t *filter, picture_t *dst, picture_t *src) \
+{ \
+    PackedToI422(dst, src, y0, u, y1, v); \
+    (void) filter; \
+} \
+\
+static void name##_I420(filter_t *filter, picture_t *dst, picture_t *src) \
+{ \
+    PackedToI420(dst, src, y0, u, y1, v); \
+    (void) filter; \
+}
+
+PACKED_TO_PLANAR(YUYV, 0, 1, 2, 3)
+PACKED_TO_PLANAR(UYVY, 1, 0, 3, 2)
+PACKED_TO_PLANAR(YVYU, 0, 3, 2, 1)
+PACKED_TO_PLANAR(VYUY, 1, 2, 3, 0)
+
+/*
+ * Planar YUV to RGB references
+ *
+ * The C plugin uses lookup tables, and does not round like the SIMD one.
+ * This is a scalar model of the 16-bit fixed point SSE2 arithmetic.
+ */
+static int MulHigh(int a, int b)
+{
+    return (a * b) >> 16;
+}
+
+static int Sat16(int v)
+{
+    return __MIN(__MAX(v, INT16_MIN), INT16_MAX);
+}
+
+static void I420ToRGB32(picture_t *dst, const picture_t *src,
+                        unsigned r, unsigned g, unsigned b, unsigned x)
+{
+    for (int y = 0; y < dst->p[0].i_visible_lines; y++)
+    {
+        const uint8_t *in_y = src->p[0].p_pixels + y * src->p[0].i_pitch;
+        const uint8_t *in_u = src->p[1].p_pixels + (y / 2) * src->p[1].i_pitch;
+        const uint8_t *in_v = src->p[2].p_pixels + (y / 2) * src->p[2].i_pitch;
+        uint8_t *out = dst->p[0].p_pixels + y * dst->p[0].i_pitch;
+
+        for (int i = 0; i < dst->p[0].i_visible_pitch / 4; i++)
+        {
+            const int u = (in_u[i / 2] - 128) * 8;
+            const int v = (in_v[i / 2] - 128) * 8;
+            const int cb = MulHigh(u, 0x4093);
+            const int cr = MulHigh(v, 0x3312);
+            const int cg = Sat16(MulHigh(u, -0x0c83) + MulHigh(v, -0x1a04));
+            const int l = MulHigh((in_y[i] > 16 ? in_y[i] - 16 : 0) * 8,
+                                  0x253f);
+
+            out[4 * i + r] = clip_uint8_vlc(l + cr);
+            out[4 * i + g] = clip_uint8_vlc(l + cg);
+            out[4 * i + b] = clip_uint8_vlc(l + cb);
+            out[4 * i + x] = 0;
+        }
+    }
+}
+
+#define I420_TO_RGB32(name, r, g, b, x) \
+static void I420_##name(filter_t *filter, picture_t *dst, picture_t *src) \
+{ \
+    I420ToRGB32(dst, src, r, g, b, x); \
+    (void) filter; \
+}
+
+/* Byte offsets of each component in memory */
+I420_TO_RGB32(XRGB, 2, 1, 0, 3)
+I420_TO_RGB32(RGBX, 3, 2, 1, 0)
+I420_TO_RGB32(BGRX, 1, 2, 3, 0)
+I420_TO_RGB32(XBGR, 0, 1, 2, 3)
+
+/* Semi-planar and packed YUV converters */
+#if defined (__i386__) || defined (__x86_64__)
+# define CHROMA_YUV "chroma_yuv_avx2"
+#else
+# define CHROMA_YUV "chroma_yuv_neon"
+#endif
+
+static const struct
+{
+    const char *name;
+    vlc_fourcc_t in;
+    vlc_fourcc_t out;
+    const char *module; /**< optimised module to check */
+    convert_cb ref;
+} converters[] = {
+    { "i420_xrgb", VLC_CODEC_I420, VLC_CODEC_XRGB, "i420_rgb_sse2", I420_XRGB },
+    { "i420_rgbx", VLC_CODEC_I420, VLC_CODEC_RGBX, "i420_rgb_sse2", I420_RGBX },
+    { "i420_bgrx", VLC_CODEC_I420, VLC_CODEC_BGRX, "i420_rgb_sse2", I420_BGRX },
+    { "i420_xbgr", VLC_CODEC_I420, VLC_CODEC_XBGR, "i420_rgb_sse2", I420_XBGR },
+    { "nv12_i420", VLC_CODEC_NV12, VLC_CODEC_I420, CHROMA_YUV,
+      SemiPlanarToPlanar },
+    { "nv21_i420", VLC_CODEC_NV21, VLC_CODEC_I420, CHROMA_YUV,
+      SemiPlanarToPlanarSwap },
+    { "nv16_i422", VLC_CODEC_NV16, VLC_CODEC_I422, CHROMA_YUV,
+      SemiPlanarToPlanar },
+    { "nv24_i444", VLC_CODEC_NV24, VLC_CODEC_I444, CHROMA_YUV,
+      SemiPlanarToPlanar },
+    { "yuyv_i422", VLC_CODEC_YUYV, VLC_CODEC_I422, CHROMA_YUV, YUYV_I422 },
+    { "uyvy_i422", VLC_CODEC_UYVY, VLC_CODEC_I422, CHROMA_YUV, UYVY_I422 },
+    { "yvyu_i422", VLC_CODEC_YVYU, VLC_CODEC_I422, CHROMA_YUV, YVYU_I422 },
+    { "vyuy_i422", VLC_CODEC_VYUY, VLC_CODEC_I422, CHROMA_YUV, VYUY_I422 },
+    { "yuyv_i420", VLC_CODEC_YUYV, VLC_CODEC_I420, CHROMA_YUV, YUYV_I420 },
+    { "uyvy_i420", VLC_CODEC_UYVY, VLC_CODEC_I420, CHROMA_YUV, UYVY_I420 },
+    { "yvyu_i420", VLC_CODEC_YVYU, VLC_CODEC_I420, CHROMA_YUV, YVYU_I420 },
+    { "vyuy_i420", VLC_CODEC_VYUY, VLC_CODEC_I420, CHROMA_YUV, VYUY_I420 },
+};
+
+/* Even sizes, as the SIMD converters require, but not all multiple of the
+ * vector sizes. The last one is used for benchmarking. */
+static const struct {
+    unsigned width;
+    unsigned height;
+} sizes[] = {
+    { 16, 2 }, { 64, 48 }, { 718, 478 }, { 1920, 1080 },
+};
+
+static picture_t *BufferNew(filter_t *filter)
+{
+    return picture_Hold(filter->owner.sys);
+}
+
+static const struct filter_video_callbacks filter_cbs = {
+    .buffer_new = BufferNew,
+};
+
+/** Runs the converter module, writing to the given picture */
+static void Convert(filter_t *filter, picture_t *dst, picture_t *src)
+{
+    filter->owner.sys = dst;
+
+    picture_t *out = filter->ops->filter_video(filter, picture_Hold(src));
+    if (out != NULL)
+        picture_Release(out);
+}
+
+static filter_t *CreateFilter(vlc_fourcc_t in, vlc_fourcc_t out,
+                              unsigned width, unsigned height)
+{
+    filter_t *filter = vlc_object_create(checkasm_vlc_object(),
+                                         sizeof (*filter));
+    if (unlikely(filter == NULL))
+        abort();
+
+    es_format_Init(&filter->fmt_in, VIDEO_ES, in);
+    video_format_Setup(&filter->fmt_in.video, in, width, height,
+                       width, height, 1, 1);
+    es_format_Init(&filter->fmt_out, VIDEO_ES, out);
+    video_format_Setup(&filter->fmt_out.video, out, width, height,
+                       width, height, 1, 1);
+    filter->owner.video = &filter_cbs;
+    return filter;
+}
+
+static void DeleteFilter(filter_t *filter)
+{
+    vlc_filter_UnloadModule(filter);
+    es_format_Clean(&filter->fmt_out);
+    es_format_Clean(&filter->fmt_in);
+    vlc_object_delete(filter);
+}
+
+static picture_t *NewPicture(const video_format_t *fmt)
+{
+    picture_t *pic = picture_NewFromFormat(fmt);
+    if (unlikely(pic == NULL))
+        abort();
+
+    for (int i = 0; i < pic->i_planes; i++)
+        memset(pic->p[i].p_pixels, 0, pic->p[i].i_pitch * pic->p[i].i_lines);
+    return pic;
+}
+
+static void check_converter(size_t index)
+{
+    static const char *const planes[] = { "plane0", "plane1", "plane2" };
+    const char *name = converters[index].name;
+    const convert_cb ref = converters[index].ref;
+
+    checkasm_declare(void, filter_t *, picture_t *, picture_t *);
+
+    for (size_t i = 0; i < ARRAY_SIZE(sizes); i++)
+    {
+        filter_t *filter = CreateFilter(converters[index].in,
+                                        converters[index].out,
+                                        sizes[i].width, sizes[i].height);
+
+        filter->p_module = vlc_filter_LoadModule(filter, "video converter",
+                                                 converters[index].module,
+                                                 true);
+
+        /* Without a suitable optimised module, the reference is tested
+         * against itself, which registers it for the next CPU levels. */
+        const convert_cb conv = (filter->p_module != NULL) ? Convert : ref;
+        const CheckasmKey key = (filter->p_module != NULL)
+                              ? (CheckasmKey)filter->ops : (CheckasmKey)ref;
+
+        if (checkasm_check_key(key, "%s_%ux%u", name,
+                               sizes[i].width, sizes[i].height))
+        {
+            picture_t *src = NewPicture(&filter->fmt_in.video);
+            picture_t *dst_ref = NewPicture(&filter->fmt_out.video);
+            picture_t *dst_new = NewPicture(&filter->fmt_out.video);
+
+            for (int p = 0; p < src->i_planes; p++)
+                checkasm_randomize(src->p[p].p_pixels,
+                                   src->p[p].i_pitch * src->p[p].i_lines);
+
+            checkasm_call(ref, filter, dst_ref, src);
+            checkasm_call_checked(conv, filter, dst_new, src);
+
+            for (int p = 0; p < dst_ref->i_planes; p++)
+                checkasm_check2d(uint8_t,
+                                 dst_ref->p[p].p_pixels, dst_ref->p[p].i_pitch,
+                                 dst_new->p[p].p_pixels, dst_new->p[p].i_pitch,
+                                 dst_ref->p[p].i_visible_pitch,
+                                 dst_ref->p[p].i_visible_lines, planes[p]);
+
+            if (i == ARRAY_SIZE(sizes) - 1)
+                checkasm_bench(conv, filter, dst_new, src);
+
+            picture_Release(dst_new);
+            picture_Release(dst_ref);
+            picture_Release(src);
+        }
+
+        DeleteFilter(filter);
+    }
+    checkasm_report("%s", name);
+}
+
+void checkasm_check_chroma(void)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(converters); i++)
+        check_converter(i);
+}
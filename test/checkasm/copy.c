@@ -0,0 +1,212 @@
+/*****************************************************************************
+ * copy.c: picture copy and semi-planar conversions test and benchmark
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+
+#include <vlc_common.h>
+#include <vlc_cpu.h>
+#include <vlc_es.h>
+#include <vlc_picture.h>
+
+#include "../../modules/video_chroma/copy.h"
+#include "checkasm.h"
+
+/* The copy functions dispatch internally on these capabilities */
+#if defined (__i386__) || defined (__x86_64__)
+# define COPY_CPU_MASK (VLC_CPU_SSE2 | VLC_CPU_SSE3 | VLC_CPU_SSSE3 | \
+                        VLC_CPU_SSE4_1 | VLC_CPU_AVX2 | VLC_CPU_AVX512)
+#else
+# define COPY_CPU_MASK 0
+#endif
+
+struct copy_conv
+{
+    const char *name;
+    vlc_fourcc_t src;
+    vlc_fourcc_t dst;
+    int bitshift;
+    union
+    {
+        void (*conv)(picture_t *, const uint8_t *[], const size_t [], unsigned,
+                     const copy_cache_t *);
+        void (*conv16)(picture_t *, const uint8_t *[], const size_t [],
+                       unsigned, int, const copy_cache_t *);
+    };
+};
+
+static const struct copy_conv convs[] = {
+    { "nv12_i420", VLC_CODEC_NV12, VLC_CODEC_I420, 0,
+      .conv = Copy420_SP_to_P },
+    { "nv12_nv12", VLC_CODEC_NV12, VLC_CODEC_NV12, 0,
+      .conv = Copy420_SP_to_SP },
+    { "i420_i420", VLC_CODEC_I420, VLC_CODEC_I420, 0,
+      .conv = Copy420_P_to_P },
+    { "i420_nv12", VLC_CODEC_I420, VLC_CODEC_NV12, 0,
+      .conv = Copy420_P_to_SP },
+    { "p010_i42010l", VLC_CODEC_P010, VLC_CODEC_I420_10L, 6,
+      .conv16 = Copy420_16_SP_to_P },
+    { "i42010l_p010", VLC_CODEC_I420_10L, VLC_CODEC_P010, -6,
+      .conv16 = Copy420_16_P_to_SP },
+};
+
+/* The last size is large enough to be split across worker threads, and is
+ * used for benchmarking. */
+static const struct {
+    unsigned width;
+    unsigned height;
+} sizes[] = {
+    { 65, 39 }, { 1280, 720 }, { 3840, 2160 },
+};
+
+static void Copy(const struct copy_conv *conv, picture_t *dst,
+                 picture_t *src, const copy_cache_t *cache)
+{
+    const uint8_t *planes[3] = {
+        src->p[0].p_pixels, src->p[1].p_pixels, src->p[2].p_pixels,
+    };
+    const size_t pitches[3] = {
+        src->p[0].i_pitch, src->p[1].i_pitch, src->p[2].i_pitch,
+    };
+
+    if (conv->bitshift == 0)
+        conv->conv(dst, planes, pitches, src->format.i_visible_height, cache);
+    else
+        conv->conv16(dst, planes, pitches, src->format.i_visible_height,
+                     conv->bitshift, cache);
+}
+
+/** Runs the plain C code paths of the same functions */
+static void CopyRef(const struct copy_conv *conv, picture_t *dst,
+                    picture_t *src, const copy_cache_t *cache)
+{
+    vlc_CPU_set(0);
+    Copy(conv, dst, src, cache);
+    vlc_CPU_set(checkasm_get_cpu_flags());
+}
+
+static picture_t *NewPicture(vlc_fourcc_t chroma, unsigned width,
+                             unsigned height)
+{
+    video_format_t fmt;
+
+    video_format_Init(&fmt, 0);
+    video_format_Setup(&fmt, chroma, width, height, width, height, 1, 1);
+
+    picture_t *pic = picture_NewFromFormat(&fmt);
+    if (unlikely(pic == NULL))
+        abort();
+    return pic;
+}
+
+static void RandomizePicture(picture_t *pic)
+{
+    const vlc_chroma_description_t *dsc =
+        vlc_fourcc_GetChromaDescription(pic->format.i_chroma);
+
+    for (int i = 0; i < pic->i_planes; i++)
+    {
+        plane_t *p = &pic->p[i];
+
+        if (dsc->pixel_size == 1)
+        {
+            checkasm_randomize(p->p_pixels, p->i_pitch * p->i_lines);
+            continue;
+        }
+
+        /* Keep samples in range: shifts would otherwise drop bits */
+        const uint16_t mask = ((1 << dsc->pixel_bits) - 1)
+                           << (pic->format.i_chroma == VLC_CODEC_P010 ? 6 : 0);
+
+        for (int y = 0; y < p->i_lines; y++)
+            checkasm_randomize_mask16((uint16_t *)(p->p_pixels + y * p->i_pitch),
+                                      p->i_pitch / 2, mask);
+    }
+}
+
+static void CheckPictures(const picture_t *ref, const picture_t *new)
+{
+    static const char *const planes[] = { "plane0", "plane1", "plane2" };
+    const vlc_chroma_description_t *dsc =
+        vlc_fourcc_GetChromaDescription(ref->format.i_chroma);
+
+    for (int i = 0; i < ref->i_planes; i++)
+    {
+        const plane_t *a = &ref->p[i], *b = &new->p[i];
+
+        if (dsc->pixel_size == 1)
+            checkasm_check2d(uint8_t, a->p_pixels, a->i_pitch,
+                             b->p_pixels, b->i_pitch,
+                             a->i_visible_pitch, a->i_visible_lines,
+                             planes[i]);
+        else
+            checkasm_check2d(uint16_t, (const uint16_t *)a->p_pixels,
+                             a->i_pitch, (const uint16_t *)b->p_pixels,
+                             b->i_pitch, a->i_visible_pitch / 2,
+                             a->i_visible_lines, planes[i]);
+    }
+}
+
+static void check_conv(const struct copy_conv *conv)
+{
+    const CheckasmKey key = 1 + (vlc_CPU() & COPY_CPU_MASK);
+
+    checkasm_declare(void, const struct copy_conv *, picture_t *, picture_t *,
+                     const copy_cache_t *);
+
+    for (size_t i = 0; i < ARRAY_SIZE(sizes); i++)
+    {
+        const unsigned width = sizes[i].width, height = sizes[i].height;
+
+        if (!checkasm_check_key(key, "%s_%ux%u", conv->name, width, height))
+            continue;
+
+        picture_t *src = NewPicture(conv->src, width, height);
+        picture_t *dst_ref = NewPicture(conv->dst, width, height);
+        picture_t *dst_new = NewPicture(conv->dst, width, height);
+        copy_cache_t cache;
+
+        if (CopyInitCache(&cache, src->p[0].i_pitch))
+            abort();
+
+        RandomizePicture(src);
+        checkasm_call(CopyRef, conv, dst_ref, src, &cache);
+        checkasm_call_checked(Copy, conv, dst_new, src, &cache);
+        CheckPictures(dst_ref, dst_new);
+
+        if (i == ARRAY_SIZE(sizes) - 1)
+            checkasm_bench(Copy, conv, dst_new, src, &cache);
+
+        CopyCleanCache(&cache);
+        picture_Release(dst_new);
+        picture_Release(dst_ref);
+        picture_Release(src);
+    }
+    checkasm_report("%s", conv->name);
+}
+
+void checkasm_check_copy(void)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(convs); i++)
+        check_conv(&convs[i]);
+}
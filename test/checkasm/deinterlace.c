@@ -0,0 +1,310 @@
+/*****************************************************************************
+ * deinterlace.c: deinterlacing kernels test and benchmark
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vlc_common.h>
+#include <vlc_configuration.h>
+#include <vlc_cpu.h>
+#include <vlc_filter.h>
+#include <vlc_picture.h>
+
+#include "../../modules/video_filter/deinterlace/merge.h"
+#include "../../modules/video_filter/deinterlace/common.h"
+#include "../../modules/video_filter/deinterlace/yadif.h"
+#include "checkasm.h"
+
+#define MERGE_MAX 4096
+
+static void check_merge(merge_cb merge, unsigned bits)
+{
+    CHECKASM_ALIGN(uint8_t src1[MERGE_MAX + 16]);
+    CHECKASM_ALIGN(uint8_t src2[MERGE_MAX + 16]);
+    CHECKASM_ALIGN(uint8_t dst_ref[MERGE_MAX + 16]);
+    CHECKASM_ALIGN(uint8_t dst_new[MERGE_MAX + 16]);
+    static const size_t lengths[] = { 2, 14, 16, 18, 62, 720, 1920, MERGE_MAX };
+
+    checkasm_declare(void, void *, const void *, const void *, size_t);
+
+    for (size_t i = 0; i < ARRAY_SIZE(lengths); i++)
+    {
+        const size_t len = lengths[i];
+
+        if (!checkasm_check_func(merge, "merge%u_%zu", bits, len))
+            continue;
+
+        /* Exercise the unaligned head of the SIMD loops, keeping elements
+         * naturally aligned. */
+        const size_t offset = (checkasm_rand() & 15) & ~(size_t)(bits / 8 - 1);
+
+        RANDOMIZE_BUF(src1);
+        RANDOMIZE_BUF(src2);
+        CLEAR_BUF(dst_ref);
+        CLEAR_BUF(dst_new);
+
+        checkasm_call_ref(dst_ref + offset, src1 + offset, src2 + offset, len);
+        checkasm_call_new(dst_new + offset, src1 + offset, src2 + offset, len);
+        checkasm_check1d(uint8_t, dst_ref, dst_new, sizeof (dst_ref), "dst");
+
+        checkasm_bench_new(dst_new + offset, src1 + offset, src2 + offset,
+                           len);
+    }
+    checkasm_report("merge%u", bits);
+}
+
+typedef void (*yadif_cb)(uint8_t *, uint8_t *, uint8_t *, uint8_t *,
+                         int, int, int, int, int);
+
+static yadif_cb GetYadif(void)
+{
+#if defined (HAVE_X86ASM)
+    if (vlc_CPU_SSSE3())
+        return vlcpriv_yadif_filter_line_ssse3;
+    if (vlc_CPU_SSE2())
+        return vlcpriv_yadif_filter_line_sse2;
+#endif
+    (void) yadif_filter_line_c_16bit; /* no SIMD version to check */
+    return yadif_filter_line_c;
+}
+
+#define YADIF_STRIDE 2048
+#define YADIF_LINES  5
+#define YADIF_MARGIN 32
+
+static void check_yadif(void)
+{
+    /* The kernel looks up to two lines above and below, and a few pixels
+     * left and right of the current line. */
+    CHECKASM_ALIGN(uint8_t prev[YADIF_LINES * YADIF_STRIDE]);
+    CHECKASM_ALIGN(uint8_t cur[YADIF_LINES * YADIF_STRIDE]);
+    CHECKASM_ALIGN(uint8_t next[YADIF_LINES * YADIF_STRIDE]);
+    CHECKASM_ALIGN(uint8_t dst_ref[YADIF_STRIDE]);
+    CHECKASM_ALIGN(uint8_t dst_new[YADIF_STRIDE]);
+    static const int widths[] = { 8, 16, 24, 719, 720, 1920 };
+    const size_t line = 2 * YADIF_STRIDE + YADIF_MARGIN;
+
+    checkasm_declare(void, uint8_t *, uint8_t *, uint8_t *, uint8_t *,
+                     int, int, int, int, int);
+
+    for (int mode = 0; mode <= 2; mode += 2)
+    {
+        if (!checkasm_check_func(GetYadif(), "yadif_mode%d", mode))
+            continue;
+
+        for (int parity = 0; parity < 2; parity++)
+            for (size_t i = 0; i < ARRAY_SIZE(widths); i++)
+            {
+                const int w = widths[i];
+
+                RANDOMIZE_BUF(prev);
+                RANDOMIZE_BUF(cur);
+                RANDOMIZE_BUF(next);
+                CLEAR_BUF(dst_ref);
+                CLEAR_BUF(dst_new);
+
+                checkasm_call_ref(dst_ref, prev + line, cur + line,
+                                  next + line, w, YADIF_STRIDE, -YADIF_STRIDE,
+                                  parity, mode);
+                checkasm_call_new(dst_new, prev + line, cur + line,
+                                  next + line, w, YADIF_STRIDE, -YADIF_STRIDE,
+                                  parity, mode);
+                /* SIMD versions may write past the width, by design */
+                checkasm_check1d(uint8_t, dst_ref, dst_new, w, "dst");
+            }
+
+        checkasm_bench_new(dst_new, prev + line, cur + line, next + line,
+                           1920, YADIF_STRIDE, -YADIF_STRIDE, 0, mode);
+    }
+    checkasm_report("yadif");
+}
+
+static picture_t *BandsBufferNew(filter_t *filter)
+{
+    return picture_NewFromFormat(&filter->fmt_out.video);
+}
+
+static const struct filter_video_callbacks bands_cbs = {
+    .buffer_new = BandsBufferNew,
+};
+
+static filter_t *CreateDeinterlacer(const char *mode, unsigned threads,
+                                    unsigned width, unsigned height,
+                                    config_chain_t **cfg)
+{
+    filter_t *filter = vlc_object_create(checkasm_vlc_object(),
+                                         sizeof (*filter));
+    if (unlikely(filter == NULL))
+        abort();
+
+    es_format_Init(&filter->fmt_in, VIDEO_ES, VLC_CODEC_I420);
+    video_format_Setup(&filter->fmt_in.video, VLC_CODEC_I420, width, height,
+                       width, height, 1, 1);
+    filter->fmt_in.video.i_frame_rate = 25;
+    filter->fmt_in.video.i_frame_rate_base = 1;
+    es_format_Copy(&filter->fmt_out, &filter->fmt_in);
+    filter->owner.video = &bands_cbs;
+
+    char chain[64], *name;
+
+    snprintf(chain, sizeof (chain), "deinterlace{mode=%s,threads=%u}",
+             mode, threads);
+    *cfg = NULL;
+    free(config_ChainCreate(&name, cfg, chain));
+    free(name);
+    filter->p_cfg = *cfg;
+
+    filter->p_module = vlc_filter_LoadModule(filter, "video filter",
+                                             "deinterlace", true);
+    return filter;
+}
+
+static void DeleteDeinterlacer(filter_t *filter, config_chain_t *cfg)
+{
+    if (filter->p_module != NULL)
+        vlc_filter_UnloadModule(filter);
+    config_ChainDestroy(cfg);
+    es_format_Clean(&filter->fmt_out);
+    es_format_Clean(&filter->fmt_in);
+    vlc_object_delete(filter);
+}
+
+static void ReleaseChain(picture_t *pic)
+{
+    vlc_picture_chain_t chain = picture_GetAndResetChain(pic);
+
+    picture_Release(pic);
+    while (!vlc_picture_chain_IsEmpty(&chain))
+        picture_Release(vlc_picture_chain_PopFront(&chain));
+}
+
+#define BANDS_THREADS 4
+#define BANDS_FRAMES  4
+
+/* Checks that rendering in parallel bands gives the same output as
+ * rendering from a single thread. */
+static void check_bands(const char *mode, CheckasmKey key)
+{
+    static const char *const planes[] = { "plane0", "plane1", "plane2" };
+    /* Include sizes with fewer lines or blocks than bands, and sizes that
+     * are not multiple of the X block size. */
+    static const struct {
+        unsigned width;
+        unsigned height;
+    } sizes[] = {
+        { 16, 6 }, { 68, 42 }, { 720, 576 }, { 1918, 1080 },
+    };
+
+    for (size_t i = 0; i < ARRAY_SIZE(sizes); i++)
+    {
+        if (!checkasm_check_key(key, "bands_%s_%ux%u", mode,
+                                sizes[i].width, sizes[i].height))
+            continue;
+
+        config_chain_t *cfg_ref, *cfg_new;
+        filter_t *ref = CreateDeinterlacer(mode, 1, sizes[i].width,
+                                           sizes[i].height, &cfg_ref);
+        filter_t *new = CreateDeinterlacer(mode, BANDS_THREADS,
+                                           sizes[i].width, sizes[i].height,
+                                           &cfg_new);
+
+        if (ref->p_module == NULL || new->p_module == NULL)
+        {
+            if (checkasm_fail())
+                fprintf(stderr, "cannot load the deinterlace filter\n");
+            DeleteDeinterlacer(new, cfg_new);
+            DeleteDeinterlacer(ref, cfg_ref);
+            continue;
+        }
+
+        for (unsigned f = 0; f < BANDS_FRAMES; f++)
+        {
+            picture_t *src = picture_NewFromFormat(&ref->fmt_in.video);
+            if (unlikely(src == NULL))
+                abort();
+
+            for (int p = 0; p < src->i_planes; p++)
+                checkasm_randomize(src->p[p].p_pixels,
+                                   src->p[p].i_pitch * src->p[p].i_lines);
+            src->date = VLC_TICK_0 + f * VLC_TICK_FROM_MS(40);
+            src->b_progressive = false;
+            src->b_top_field_first = true;
+            src->i_nb_fields = 2;
+
+            picture_t *out_ref = ref->ops->filter_video(ref,
+                                                        picture_Hold(src));
+            picture_t *out_new = new->ops->filter_video(new,
+                                                        picture_Hold(src));
+            picture_Release(src);
+
+            for (picture_t *a = out_ref, *b = out_new;
+                 a != NULL || b != NULL; a = a->p_next, b = b->p_next)
+            {
+                if (a == NULL || b == NULL)
+                {
+                    if (checkasm_fail())
+                        fprintf(stderr, "output count mismatch\n");
+                    break;
+                }
+
+                for (int p = 0; p < a->i_planes; p++)
+                    checkasm_check2d(uint8_t,
+                                     a->p[p].p_pixels, a->p[p].i_pitch,
+                                     b->p[p].p_pixels, b->p[p].i_pitch,
+                                     a->p[p].i_visible_pitch,
+                                     a->p[p].i_visible_lines, planes[p]);
+            }
+
+            if (out_ref != NULL)
+                ReleaseChain(out_ref);
+            if (out_new != NULL)
+                ReleaseChain(out_new);
+        }
+
+        DeleteDeinterlacer(new, cfg_new);
+        DeleteDeinterlacer(ref, cfg_ref);
+    }
+    checkasm_report("bands_%s", mode);
+}
+
+void checkasm_check_deinterlace(void)
+{
+    struct deinterlace_functions funcs;
+
+    memset(&funcs, 0, sizeof (funcs));
+    vlc_CPU_functions_init("deinterlace functions", &funcs);
+
+    if (funcs.merges[0] != NULL)
+        check_merge(funcs.merges[0], 8);
+    if (funcs.merges[1] != NULL)
+        check_merge(funcs.merges[1], 16);
+
+    check_yadif();
+
+    /* Yadif renders through the kernel checked above, X in plain C */
+    check_bands("yadif", (CheckasmKey)GetYadif());
+    check_bands("yadif2x", (CheckasmKey)GetYadif());
+    check_bands("x", (CheckasmKey)check_bands);
+}
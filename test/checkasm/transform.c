@@ -0,0 +1,152 @@
+/*****************************************************************************
+ * transform.c: video plane transforms test and benchmark
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <vlc_common.h>
+#include <vlc_cpu.h>
+
+#include "../../modules/video_chroma/orient.h"
+#include "checkasm.h"
+
+/* Same as the generic implementations of the transform filter */
+#define TRANSFORMS(bits) \
+static void hflip_##bits(void *restrict dst, ptrdiff_t dst_stride, \
+                         const void *restrict src, ptrdiff_t src_stride, \
+                         int width, int height) \
+{ \
+    const uint##bits##_t *restrict src_pixels = src; \
+    uint##bits##_t *restrict dst_pixels = dst; \
+\
+    dst_stride /= bits / 8; \
+    src_stride /= bits / 8; \
+    dst_pixels += width - 1; \
+\
+    for (int y = 0; y < height; y++) { \
+        for (int x = 0; x < width; x++) \
+            dst_pixels[-x] = src_pixels[x]; \
+\
+        src_pixels += src_stride; \
+        dst_pixels += dst_stride; \
+    } \
+} \
+\
+static void transpose_##bits(void *restrict dst, ptrdiff_t dst_stride, \
+                             const void *restrict src, ptrdiff_t src_stride, \
+                             int src_width, int src_height) \
+{ \
+    const uint##bits##_t *restrict src_pixels = src; \
+    uint##bits##_t *restrict dst_pixels = dst; \
+\
+    dst_stride /= bits / 8; \
+    src_stride /= bits / 8; \
+\
+    for (int y = 0; y < src_height; y++) { \
+        for (int x = 0; x < src_width; x++) \
+            dst_pixels[x * dst_stride] = src_pixels[x]; \
+        src_pixels += src_stride; \
+        dst_pixels++; \
+    } \
+}
+
+TRANSFORMS(8)
+TRANSFORMS(16)
+TRANSFORMS(32)
+TRANSFORMS(64)
+
+#define MAX_SIZE 256 /* pixels, in each dimension */
+#define MAX_BYTES (MAX_SIZE * MAX_SIZE * 8)
+
+static const struct {
+    int width;
+    int height;
+} sizes[] = {
+    { 1, 1 }, { 7, 3 }, { 16, 16 }, { 33, 17 }, { 64, 48 }, { 255, 129 },
+    { MAX_SIZE, MAX_SIZE },
+};
+
+static void check_plane(plane_transform_cb cb, const char *name,
+                        unsigned order, bool swap,
+                        uint8_t *src, uint8_t *dst_ref, uint8_t *dst_new)
+{
+    const unsigned bits = 8u << order;
+
+    checkasm_declare(void, void *, ptrdiff_t, const void *, ptrdiff_t,
+                     int, int);
+
+    if (!checkasm_check_func(cb, "%s_%u", name, bits))
+        return;
+
+    for (size_t i = 0; i < ARRAY_SIZE(sizes); i++)
+    {
+        const int w = sizes[i].width, h = sizes[i].height;
+        /* Use padded pitches, as pictures usually have */
+        const ptrdiff_t src_pitch = ((w << order) + 31) & ~31;
+        const int dst_w = swap ? h : w, dst_h = swap ? w : h;
+        const ptrdiff_t dst_pitch = ((dst_w << order) + 31) & ~31;
+
+        checkasm_randomize(src, MAX_BYTES);
+        memset(dst_ref, 0, MAX_BYTES);
+        memset(dst_new, 0, MAX_BYTES);
+
+        checkasm_call_ref(dst_ref, dst_pitch, src, src_pitch, w, h);
+        checkasm_call_new(dst_new, dst_pitch, src, src_pitch, w, h);
+        checkasm_check2d(uint8_t, dst_ref, dst_pitch, dst_new, dst_pitch,
+                         dst_w << order, dst_h, "dst");
+    }
+
+    checkasm_bench_new(dst_new, MAX_SIZE << order, src, MAX_SIZE << order,
+                       MAX_SIZE, MAX_SIZE);
+}
+
+void checkasm_check_transform(void)
+{
+    struct plane_transforms t = {
+        { hflip_8, hflip_16, hflip_32, hflip_64, },
+        { transpose_8, transpose_16, transpose_32, transpose_64, },
+    };
+    uint8_t *src = malloc(MAX_BYTES);
+    uint8_t *dst_ref = malloc(MAX_BYTES);
+    uint8_t *dst_new = malloc(MAX_BYTES);
+
+    if (unlikely(src == NULL || dst_ref == NULL || dst_new == NULL))
+        abort();
+
+    vlc_CPU_functions_init("video transform", &t);
+
+    for (unsigned order = 0; order <= PLANE_TRANSFORM_MAX_ORDER; order++)
+        check_plane(t.hflip[order], "hflip", order, false,
+                    src, dst_ref, dst_new);
+    checkasm_report("hflip");
+
+    for (unsigned order = 0; order <= PLANE_TRANSFORM_MAX_ORDER; order++)
+        check_plane(t.transpose[order], "transpose", order, true,
+                    src, dst_ref, dst_new);
+    checkasm_report("transpose");
+
+    free(dst_new);
+    free(dst_ref);
+    free(src);
+}
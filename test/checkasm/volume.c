@@ -0,0 +1,144 @@
+/*****************************************************************************
+ * volume.c: audio amplification kernels test and benchmark
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <string.h>
+
+#include <vlc_common.h>
+#include <vlc_aout.h>
+#include <vlc_aout_volume.h>
+#include <vlc_block.h>
+#include <vlc_modules.h>
+
+#include "checkasm.h"
+
+#define SAMPLES 4096
+
+static void FillBlock(block_t *block, vlc_fourcc_t format)
+{
+    const size_t samples = block->i_buffer / aout_BitsPerSample(format) * 8;
+
+    /* Keep floating point samples finite, so as to compare them bitwise */
+    switch (format)
+    {
+        case VLC_CODEC_FL32:
+            checkasm_randomize_rangef((float *)block->p_buffer, samples, 1.f);
+            break;
+        case VLC_CODEC_FL64:
+            checkasm_randomize_range((double *)block->p_buffer, samples, 1.);
+            break;
+        default:
+            checkasm_randomize(block->p_buffer, block->i_buffer);
+    }
+}
+
+static void CheckBlocks(const block_t *ref, const block_t *new,
+                        vlc_fourcc_t format)
+{
+    const size_t samples = ref->i_buffer / aout_BitsPerSample(format) * 8;
+
+    switch (format)
+    {
+        case VLC_CODEC_U8:
+            checkasm_check1d(uint8_t, ref->p_buffer, new->p_buffer,
+                             samples, "samples");
+            break;
+        case VLC_CODEC_S16N:
+            checkasm_check1d(int16_t, (const int16_t *)ref->p_buffer,
+                             (const int16_t *)new->p_buffer,
+                             samples, "samples");
+            break;
+        case VLC_CODEC_S32N:
+            checkasm_check1d(int32_t, (const int32_t *)ref->p_buffer,
+                             (const int32_t *)new->p_buffer,
+                             samples, "samples");
+            break;
+        default: /* floating point, bitwise */
+            checkasm_check1d(uint32_t, (const uint32_t *)ref->p_buffer,
+                             (const uint32_t *)new->p_buffer,
+                             ref->i_buffer / 4, "samples");
+    }
+}
+
+static void check_amplify(vlc_fourcc_t format, const char *name)
+{
+    static const float gains[] = { 0.f, .25f, .5f, .999f, 1.001f, 2.f, 8.f };
+    audio_volume_t *volume = vlc_object_create(checkasm_vlc_object(),
+                                               sizeof (*volume));
+    if (unlikely(volume == NULL))
+        return;
+
+    volume->format = format;
+
+    module_t *module = module_need(volume, "audio volume", NULL, false);
+    if (module == NULL)
+    {
+        vlc_object_delete(volume);
+        return;
+    }
+
+    checkasm_declare(void, audio_volume_t *, block_t *, float);
+
+    if (checkasm_check_func(volume->amplify, "amplify_%s", name))
+    {
+        const size_t size = SAMPLES * aout_BitsPerSample(format) / 8;
+        block_t *src = block_Alloc(size);
+        block_t *ref = block_Alloc(size);
+        block_t *new = block_Alloc(size);
+
+        if (unlikely(src == NULL || ref == NULL || new == NULL))
+            abort();
+
+        for (size_t i = 0; i < ARRAY_SIZE(gains); i++)
+        {
+            FillBlock(src, format);
+            memcpy(ref->p_buffer, src->p_buffer, size);
+            memcpy(new->p_buffer, src->p_buffer, size);
+
+            checkasm_call_ref(volume, ref, gains[i]);
+            checkasm_call_new(volume, new, gains[i]);
+            CheckBlocks(ref, new, format);
+        }
+
+        /* Alternate gains so that samples neither vanish nor saturate */
+        FillBlock(new, format);
+        checkasm_bench_new(volume, new, checkasm_alternate(2.f, .5f));
+
+        block_Release(new);
+        block_Release(ref);
+        block_Release(src);
+    }
+
+    module_unneed(volume, module);
+    vlc_object_delete(volume);
+}
+
+void checkasm_check_volume(void)
+{
+    check_amplify(VLC_CODEC_FL32, "fl32");
+    check_amplify(VLC_CODEC_FL64, "fl64");
+    check_amplify(VLC_CODEC_S32N, "s32n");
+    check_amplify(VLC_CODEC_S16N, "s16n");
+    check_amplify(VLC_CODEC_U8, "u8");
+    checkasm_report("amplify");
+}
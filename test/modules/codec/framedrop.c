@@ -0,0 +1,114 @@
+/*****************************************************************************
+ * framedrop.c: video decoder degradation policy unit tests
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <vlc_common.h>
+
+#include "../../../modules/codec/framedrop.h"
+
+#include "../../libvlc/test.h"
+
+const char vlc_module_name[] = "framedrop_test";
+
+#define PERIOD VLC_TICK_FROM_MS(40)
+
+static void feed(framedrop_policy_t *policy, vlc_tick_t cost_p,
+                 vlc_tick_t cost_b)
+{
+    framedrop_AddDecodeTime(policy, FRAMEDROP_TYPE_P, cost_p);
+    framedrop_AddDecodeTime(policy, FRAMEDROP_TYPE_B, cost_b);
+}
+
+static void test_in_time(void)
+{
+    framedrop_policy_t policy;
+
+    framedrop_Init(&policy);
+    feed(&policy, VLC_TICK_FROM_MS(50), VLC_TICK_FROM_MS(40));
+    for (int i = 0; i < 100; i++)
+        assert(framedrop_Update(&policy, PERIOD / 2, PERIOD)
+               == FRAMEDROP_LEVEL_NONE);
+}
+
+static void test_degrade_recover(void)
+{
+    framedrop_policy_t policy;
+
+    framedrop_Init(&policy);
+    feed(&policy, VLC_TICK_FROM_MS(50), VLC_TICK_FROM_MS(40));
+
+    /* A single late picture is tolerated */
+    assert(framedrop_Update(&policy, PERIOD, PERIOD) == FRAMEDROP_LEVEL_NONE);
+    assert(framedrop_Update(&policy, 0, PERIOD) == FRAMEDROP_LEVEL_NONE);
+
+    /* Steady lateness degrades step by step */
+    for (int i = 0; i < 3; i++)
+        framedrop_Update(&policy, PERIOD, PERIOD);
+    assert(policy.level == FRAMEDROP_LEVEL_LOOPFILTER_NONREF);
+    for (int i = 0; i < 3; i++)
+        framedrop_Update(&policy, PERIOD, PERIOD);
+    assert(policy.level == FRAMEDROP_LEVEL_SKIP_NONREF);
+
+    /* Way too late degrades at once, up to the last level */
+    for (int i = 0; i < 10; i++)
+        framedrop_Update(&policy, 3 * PERIOD, PERIOD);
+    assert(policy.level == FRAMEDROP_LEVEL_MAX);
+
+    /* Do not recover while decoding is still too slow */
+    for (int i = 0; i < 200; i++)
+        framedrop_Update(&policy, 0, PERIOD);
+    assert(policy.level == FRAMEDROP_LEVEL_MAX);
+
+    /* Recover one step for each period of time in time */
+    for (int i = 0; i < 100; i++)
+        feed(&policy, VLC_TICK_FROM_MS(10), VLC_TICK_FROM_MS(10));
+    for (int i = 0; i < 50; i++)
+        framedrop_Update(&policy, 0, PERIOD);
+    assert(policy.level == FRAMEDROP_LEVEL_SKIP_NONREF);
+    for (int i = 0; i < 100; i++)
+        framedrop_Update(&policy, 0, PERIOD);
+    assert(policy.level == FRAMEDROP_LEVEL_NONE);
+}
+
+static void test_cheap_nonref(void)
+{
+    framedrop_policy_t policy;
+
+    framedrop_Init(&policy);
+    feed(&policy, VLC_TICK_FROM_MS(60), VLC_TICK_FROM_MS(10));
+
+    /* Skipping cheap non-reference frames would not help */
+    framedrop_Update(&policy, 3 * PERIOD, PERIOD);
+    assert(policy.level == FRAMEDROP_LEVEL_LOOPFILTER_NONREF);
+    framedrop_Update(&policy, 3 * PERIOD, PERIOD);
+    assert(policy.level == FRAMEDROP_LEVEL_LOOPFILTER_NONKEY);
+}
+
+int main(void)
+{
+    test_init();
+
+    test_in_time();
+    test_degrade_recover();
+    test_cheap_nonref();
+    return 0;
+}
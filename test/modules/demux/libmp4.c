@@ -714,6 +714,122 @@ failed:
     return 1;
 }
 
+#define SIZES_BIG_COUNT   70000  /* stsz table left in the file */
+#define SIZES_NIBBLE_COUNT 600001 /* stz2 4 bits table left in the file */
+#define SIZES_SMALL_COUNT 16     /* stsz table loaded with its box */
+
+static uint8_t *PutBoxHeader(uint8_t *p, uint32_t size, const char type[4])
+{
+    SetDWBE(p, size);
+    memcpy(&p[4], type, 4);
+    return &p[8];
+}
+
+static uint32_t SizeBig(uint32_t i) { return i * 7 % 100000; }
+static uint32_t SizeNibble(uint32_t i) { return i * 3 % 16; }
+
+static int check_MP4_SampleSizes(vlc_object_t *obj)
+{
+    const uint32_t stsz_big = 8 + 12 + 4 * SIZES_BIG_COUNT;
+    const uint32_t stz2_big = 8 + 12 + (SIZES_NIBBLE_COUNT + 1) / 2;
+    const uint32_t stsz_small = 8 + 12 + 4 * SIZES_SMALL_COUNT;
+    const uint32_t stbl = 8 + stsz_big + stz2_big + stsz_small;
+    const uint32_t total = 4 * 8 + stbl;
+
+    MP4_Box_t *root = NULL;
+    stream_t *stream = NULL;
+    uint32_t *sizes = NULL;
+    uint8_t *file = calloc(1, total);
+    if(!file)
+        return 1;
+
+    uint8_t *p = file;
+    p = PutBoxHeader(p, total, "moov");
+    p = PutBoxHeader(p, total - 8, "trak");
+    p = PutBoxHeader(p, total - 16, "mdia");
+    p = PutBoxHeader(p, total - 24, "minf");
+    p = PutBoxHeader(p, stbl, "stbl");
+
+    p = PutBoxHeader(p, stsz_big, "stsz");
+    SetDWBE(&p[8], SIZES_BIG_COUNT);
+    p += 12;
+    for(uint32_t i = 0; i < SIZES_BIG_COUNT; i++, p += 4)
+        SetDWBE(p, SizeBig(i));
+
+    p = PutBoxHeader(p, stz2_big, "stz2");
+    p[7] = 4;
+    SetDWBE(&p[8], SIZES_NIBBLE_COUNT);
+    p += 12;
+    for(uint32_t i = 0; i < SIZES_NIBBLE_COUNT; i++)
+        p[i / 2] |= (i & 1) ? SizeNibble(i) : SizeNibble(i) << 4;
+    p += (SIZES_NIBBLE_COUNT + 1) / 2;
+
+    p = PutBoxHeader(p, stsz_small, "stsz");
+    SetDWBE(&p[8], SIZES_SMALL_COUNT);
+    p += 12;
+    for(uint32_t i = 0; i < SIZES_SMALL_COUNT; i++, p += 4)
+        SetDWBE(p, i + 1);
+    assert(p == &file[total]);
+
+    stream = vlc_stream_MemoryNew(obj, file, total, true);
+    EXPECT(stream);
+    root = MP4_BoxGetRoot(stream);
+    EXPECT(root);
+
+    sizes = malloc(sizeof(*sizes) * SIZES_NIBBLE_COUNT);
+    EXPECT(sizes);
+
+    /* Large tables are only read on demand */
+    const MP4_Box_t *box = MP4_BoxGet(root, "moov/trak/mdia/minf/stbl/stsz");
+    EXPECT(box && box->data.p_stsz);
+    EXPECT(box->data.p_stsz->i_sample_count == SIZES_BIG_COUNT);
+    EXPECT(box->data.p_stsz->i_entry_size == NULL);
+    EXPECT(MP4_ReadSampleSizes(stream, box, 0, SIZES_BIG_COUNT, sizes) == VLC_SUCCESS);
+    for(uint32_t i = 0; i < SIZES_BIG_COUNT; i++)
+        EXPECT(sizes[i] == SizeBig(i));
+    EXPECT(MP4_ReadSampleSizes(stream, box, 4097, 3, sizes) == VLC_SUCCESS);
+    for(uint32_t i = 0; i < 3; i++)
+        EXPECT(sizes[i] == SizeBig(4097 + i));
+    EXPECT(MP4_ReadSampleSizes(stream, box, SIZES_BIG_COUNT - 1, 2, sizes) != VLC_SUCCESS);
+
+    box = MP4_BoxGet(root, "moov/trak/mdia/minf/stbl/stz2");
+    EXPECT(box && box->data.p_stsz);
+    EXPECT(box->data.p_stsz->i_sample_count == SIZES_NIBBLE_COUNT);
+    EXPECT(box->data.p_stsz->i_entry_size == NULL);
+    EXPECT(MP4_ReadSampleSizes(stream, box, 0, SIZES_NIBBLE_COUNT, sizes) == VLC_SUCCESS);
+    for(uint32_t i = 0; i < SIZES_NIBBLE_COUNT; i++)
+        EXPECT(sizes[i] == SizeNibble(i));
+    /* odd first sample, within a byte */
+    EXPECT(MP4_ReadSampleSizes(stream, box, 12345, 4, sizes) == VLC_SUCCESS);
+    for(uint32_t i = 0; i < 4; i++)
+        EXPECT(sizes[i] == SizeNibble(12345 + i));
+    EXPECT(MP4_ReadSampleSizes(stream, box, SIZES_NIBBLE_COUNT - 1, 1, sizes) == VLC_SUCCESS);
+    EXPECT(sizes[0] == SizeNibble(SIZES_NIBBLE_COUNT - 1));
+
+    /* Small tables are loaded with their box */
+    box = MP4_BoxGet(root, "moov/trak/mdia/minf/stbl/stsz[1]");
+    EXPECT(box && box->data.p_stsz);
+    EXPECT(box->data.p_stsz->i_entry_size != NULL);
+    for(uint32_t i = 0; i < SIZES_SMALL_COUNT; i++)
+        EXPECT(box->data.p_stsz->i_entry_size[i] == i + 1);
+    EXPECT(MP4_ReadSampleSizes(stream, box, 2, 3, sizes) == VLC_SUCCESS);
+    EXPECT(sizes[0] == 3 && sizes[2] == 5);
+
+    free(sizes);
+    MP4_BoxFree(root);
+    vlc_stream_Delete(stream);
+    free(file);
+    return 0;
+
+failed:
+    free(sizes);
+    MP4_BoxFree(root);
+    if(stream)
+        vlc_stream_Delete(stream);
+    free(file);
+    return 1;
+}
+
 int main(void)
 {
     test_init();
@@ -734,6 +850,9 @@ int main(void)
     if( !ret )
       ret = check_MP4_Frag(&vlc->p_libvlc_int->obj);
 
+    if( !ret )
+      ret = check_MP4_SampleSizes(&vlc->p_libvlc_int->obj);
+
     libvlc_release(vlc);
     return ret;
 }
@@ -184,7 +184,7 @@ stream_close( struct reader *p_reader )
 }
 
 static struct reader *
-stream_open( const char *psz_url )
+stream_open( const char *psz_url, const char *psz_filter )
 {
     libvlc_instance_t *p_vlc;
     struct reader *p_reader;
@@ -211,6 +211,18 @@ stream_open( const char *psz_url )
         free( p_reader );
         return NULL;
     }
+    if( psz_filter )
+    {
+        stream_t *p_filter = vlc_stream_FilterNew( p_reader->u.s, psz_filter );
+        if( !p_filter )
+        {
+            vlc_stream_Delete( p_reader->u.s );
+            libvlc_release( p_vlc );
+            free( p_reader );
+            return NULL;
+        }
+        p_reader->u.s = p_filter;
+    }
     p_reader->pf_close = stream_close;
     p_reader->pf_getsize = stream_getsize;
     p_reader->pf_read = stream_read;
@@ -218,7 +230,7 @@ stream_open( const char *psz_url )
     p_reader->pf_tell = stream_tell;
     p_reader->pf_seek = stream_seek;
     p_reader->p_data = p_vlc;
-    p_reader->psz_name = "stream";
+    p_reader->psz_name = psz_filter ? psz_filter : "stream";
     return p_reader;
 }
 
@@ -383,15 +395,16 @@ main( void )
     test_log( "Generating random file...\n" );
     i_tmp_fd = vlc_mkstemp( psz_tmp_path );
     fill_rand( i_tmp_fd, RAND_FILE_SIZE );
-    test_log( "Testing random file with libc, and stream...\n" );
+    test_log( "Testing random file with libc, stream and readahead...\n" );
     assert( i_tmp_fd != -1 );
     assert( asprintf( &psz_url, "file://%s", psz_tmp_path ) != -1 );
 
     assert( ( pp_readers[0] = libc_open( psz_tmp_path ) ) );
-    assert( ( pp_readers[1] = stream_open( psz_url ) ) );
+    assert( ( pp_readers[1] = stream_open( psz_url, NULL ) ) );
+    assert( ( pp_readers[2] = stream_open( psz_url, "readahead" ) ) );
 
-    test( pp_readers, 2, NULL );
-    for( unsigned int i = 0; i < 2; ++i )
+    test( pp_readers, 3, NULL );
+    for( unsigned int i = 0; i < 3; ++i )
         pp_readers[i]->pf_close( pp_readers[i] );
     free( psz_url );
 
@@ -400,7 +413,7 @@ main( void )
 
     test_log( "Testing http url with stream...\n" );
     alarm( 0 );
-    if( !( pp_readers[0] = stream_open( HTTP_URL ) ) )
+    if( !( pp_readers[0] = stream_open( HTTP_URL, NULL ) ) )
     {
         test_log( "WARNING: can't test http url" );
         return 0;